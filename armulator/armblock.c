@@ -0,0 +1,1000 @@
+/*  armblock.c -- Predecoded basic-block cache for ARMul_Emulate26.
+    Copyright (C) 2022 Matt Evans
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA. */
+
+/* Guest code is split into basic blocks, each decoded once into an array
+   of ARMul_BlockOps holding a handler, the condition code, the register
+   numbers and any immediate already looked up in ARMul_ImmedTable.  The
+   runner then walks those arrays instead of fetching and decoding every
+   instruction through the pipeline in armemu.c.
+
+   Only the common user-mode instructions get a handler of their own.
+   Everything else (PC writes, PSR transfers, SWIs, coprocessor ops, ...)
+   goes through Generic(), which sets up Reg[15] and NextInstr as the
+   pipeline would and hands the instruction to ARMul_Execute26.  Cycle
+   counts are not kept exactly in this mode.
+
+   A bitmap records which words of memory have been translated; a store
+   to one of them (see ARMul_BlockWriteCheck) flushes the whole cache.
+
+   Blocks which run JIT_THRESHOLD times are handed to armjit.c, and from
+   then on run as native code where the host supports it.  */
+
+#include "armdefs.h"
+#include "armemu.h"
+#include "armblock.h"
+#include "armjit.h"
+#include "ansidecl.h"
+#include "armmem.h"
+
+
+#define ROUNDUP8(x) (((x) + 7) & ~7UL)
+
+/***************************************************************************\
+*                            Operand helpers                                *
+\***************************************************************************/
+
+static inline int
+CondPassed (ARMul_State * state, unsigned cond)
+{
+  switch (cond)
+    {
+    case EQ:
+      return ZFLAG;
+    case NE:
+      return !ZFLAG;
+    case CS:
+      return CFLAG;
+    case CC:
+      return !CFLAG;
+    case MI:
+      return NFLAG;
+    case PL:
+      return !NFLAG;
+    case VS:
+      return VFLAG;
+    case VC:
+      return !VFLAG;
+    case HI:
+      return CFLAG && !ZFLAG;
+    case LS:
+      return !CFLAG || ZFLAG;
+    case GE:
+      return NFLAG == VFLAG;
+    case LT:
+      return NFLAG != VFLAG;
+    case GT:
+      return !ZFLAG && NFLAG == VFLAG;
+    case LE:
+      return ZFLAG || NFLAG != VFLAG;
+    case AL:
+      return TRUE;
+    default:
+      return FALSE;
+    }
+}
+
+/* Rm shifted by a constant, as GetDPRegRHS.  ASR is never predecoded. */
+static inline ARMword
+ShiftRm (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  ARMword base = state->Reg[op->rm];
+
+  switch (op->shift)
+    {
+    case LSL:
+      return base << op->shamt;
+    case LSR:
+      return op->shamt ? base >> op->shamt : 0;
+    default:
+      if (op->shamt == 0)	/* RRX */
+	return (base >> 1) | (CFLAG << 31);
+      return ROTATER (base, op->shamt);
+    }
+}
+
+/* The same, setting C from the shifter as GetDPSRegRHS. */
+static inline ARMword
+ShiftSRm (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  ARMword base = state->Reg[op->rm], c;
+
+  switch (op->shift)
+    {
+    case LSL:
+      ASSIGNC ((base >> (32 - op->shamt)) & 1);
+      return base << op->shamt;
+    case LSR:
+      if (op->shamt == 0)
+	{
+	  ASSIGNC (base >> 31);
+	  return 0;
+	}
+      ASSIGNC ((base >> (op->shamt - 1)) & 1);
+      return base >> op->shamt;
+    default:
+      if (op->shamt == 0)
+	{			/* RRX */
+	  c = CFLAG;
+	  ASSIGNC (base & 1);
+	  return (base >> 1) | (c << 31);
+	}
+      ASSIGNC ((base >> (op->shamt - 1)) & 1);
+      return ROTATER (base, op->shamt);
+    }
+}
+
+/***************************************************************************\
+*                  Instructions left to ARMul_Execute26                     *
+\***************************************************************************/
+
+static ARMword
+Generic (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  ARMword next;
+
+  state->Reg[15] = op->pc + 8;
+  state->NextInstr = SEQ;
+  ARMul_Execute26 (state, op->instr, op->pc);
+
+  if (state->NextInstr >= PRIMEPIPE)
+    next = R15PC;
+  else if (state->NextInstr & PCINCEDSEQ)
+    next = R15PC - 8;
+  else
+    next = R15PC - 4;
+
+  if (next != op->pc + 4 || state->Emulate != RUN
+      || state->BlockCache->flushed)
+    return next;
+  return BLOCK_NEXT;
+}
+
+/* After a store, leave the block if it has just been flushed. */
+static inline ARMword
+Stored (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  return state->BlockCache->flushed ? op->pc + 4 : BLOCK_NEXT;
+}
+
+/***************************************************************************\
+*                          Data processing                                  *
+\***************************************************************************/
+
+#define RHS_IMM  rhs = op->imm
+#define RHS_SIMM rhs = op->imm; \
+                 if (op->immc) \
+                   ASSIGNC (rhs >> 31)
+#define RHS_REG  rhs = state->Reg[op->rm]
+#define RHS_SH   rhs = ShiftRm (state, op)
+#define RHS_SSH  rhs = ShiftSRm (state, op)
+
+#define WRITE(d) dest = (d); \
+                 state->Reg[op->rd] = dest
+
+#define DEST_NZ(d) state->Reg[op->rd] = (d); \
+                   SETNZ (d)
+#define DEST_ADD(a, b, d) state->Reg[op->rd] = (d); \
+                          SETADD (a, b, d)
+#define DEST_SUB(a, b, d) state->Reg[op->rd] = (d); \
+                          SETSUB (a, b, d)
+
+#define DP_FORM(name, suffix, RHS, body)				\
+static ARMword								\
+name##suffix (ARMul_State * state, const ARMul_BlockOp * op)		\
+{									\
+  ARMword lhs = state->Reg[op->rn], rhs, dest;				\
+  RHS;									\
+  body;									\
+  return BLOCK_NEXT;							\
+}
+
+#define DP_OP(name, body) \
+  DP_FORM (name, _imm, RHS_IMM, body) \
+  DP_FORM (name, _reg, RHS_REG, body) \
+  DP_FORM (name, _sh, RHS_SH, body)
+
+/* Logical ops with S take C from the shifter */
+#define DP_LOGICAL_S(name, body) \
+  DP_FORM (name, _imm, RHS_SIMM, body) \
+  DP_FORM (name, _reg, RHS_REG, body) \
+  DP_FORM (name, _sh, RHS_SSH, body)
+
+DP_OP (And, WRITE (lhs & rhs))
+DP_OP (Eor, WRITE (lhs ^ rhs))
+DP_OP (Sub, WRITE (lhs - rhs))
+DP_OP (Rsb, WRITE (rhs - lhs))
+DP_OP (Add, WRITE (lhs + rhs))
+DP_OP (Adc, WRITE (lhs + rhs + CFLAG))
+DP_OP (Sbc, WRITE (lhs - rhs - !CFLAG))
+DP_OP (Rsc, WRITE (rhs - lhs - !CFLAG))
+DP_OP (Orr, WRITE (lhs | rhs))
+DP_OP (Mov, (void) lhs; WRITE (rhs))
+DP_OP (Bic, WRITE (lhs & ~rhs))
+DP_OP (Mvn, (void) lhs; WRITE (~rhs))
+
+DP_LOGICAL_S (Ands, dest = lhs & rhs; DEST_NZ (dest))
+DP_LOGICAL_S (Eors, dest = lhs ^ rhs; DEST_NZ (dest))
+DP_LOGICAL_S (Orrs, dest = lhs | rhs; DEST_NZ (dest))
+DP_LOGICAL_S (Movs, (void) lhs; dest = rhs; DEST_NZ (dest))
+DP_LOGICAL_S (Bics, dest = lhs & ~rhs; DEST_NZ (dest))
+DP_LOGICAL_S (Mvns, (void) lhs; dest = ~rhs; DEST_NZ (dest))
+DP_LOGICAL_S (Tst, dest = lhs & rhs; SETNZ (dest))
+DP_LOGICAL_S (Teq, dest = lhs ^ rhs; SETNZ (dest))
+
+DP_OP (Subs, dest = lhs - rhs; DEST_SUB (lhs, rhs, dest))
+DP_OP (Rsbs, dest = rhs - lhs; DEST_SUB (rhs, lhs, dest))
+DP_OP (Adds, dest = lhs + rhs; DEST_ADD (lhs, rhs, dest))
+DP_OP (Adcs, dest = lhs + rhs + CFLAG; DEST_ADD (lhs, rhs, dest))
+DP_OP (Sbcs, dest = lhs - rhs - !CFLAG; DEST_SUB (lhs, rhs, dest))
+DP_OP (Rscs, dest = rhs - lhs - !CFLAG; DEST_SUB (rhs, lhs, dest))
+DP_OP (Cmp, dest = lhs - rhs; SETSUB (lhs, rhs, dest))
+DP_OP (Cmn, dest = lhs + rhs; SETADD (lhs, rhs, dest))
+
+#define DP_ENTRY(name) { name##_imm, name##_reg, name##_sh }
+#define DP_NONE { NULL, NULL, NULL }
+
+/* Indexed by opcode, S bit and operand form (immediate, register,
+   shifted register).  TST..CMN without S are PSR transfers or SWP.  */
+static ARMul_BlockFn *const DPHandlers[16][2][3] = {
+  {DP_ENTRY (And), DP_ENTRY (Ands)},
+  {DP_ENTRY (Eor), DP_ENTRY (Eors)},
+  {DP_ENTRY (Sub), DP_ENTRY (Subs)},
+  {DP_ENTRY (Rsb), DP_ENTRY (Rsbs)},
+  {DP_ENTRY (Add), DP_ENTRY (Adds)},
+  {DP_ENTRY (Adc), DP_ENTRY (Adcs)},
+  {DP_ENTRY (Sbc), DP_ENTRY (Sbcs)},
+  {DP_ENTRY (Rsc), DP_ENTRY (Rscs)},
+  {DP_NONE, DP_ENTRY (Tst)},
+  {DP_NONE, DP_ENTRY (Teq)},
+  {DP_NONE, DP_ENTRY (Cmp)},
+  {DP_NONE, DP_ENTRY (Cmn)},
+  {DP_ENTRY (Orr), DP_ENTRY (Orrs)},
+  {DP_ENTRY (Mov), DP_ENTRY (Movs)},
+  {DP_ENTRY (Bic), DP_ENTRY (Bics)},
+  {DP_ENTRY (Mvn), DP_ENTRY (Mvns)},
+};
+
+#define FORM_IMM 0
+#define FORM_REG 1
+#define FORM_SH 2
+
+/***************************************************************************\
+*                              Multiply                                     *
+\***************************************************************************/
+
+static ARMword
+Mul (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  state->Reg[op->rd] = state->Reg[op->rm] * state->Reg[op->rs];
+  return BLOCK_NEXT;
+}
+
+static ARMword
+Muls (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  ARMword dest = state->Reg[op->rm] * state->Reg[op->rs];
+
+  DEST_NZ (dest);
+  return BLOCK_NEXT;
+}
+
+static ARMword
+Mla (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  state->Reg[op->rd] =
+    state->Reg[op->rm] * state->Reg[op->rs] + state->Reg[op->rn];
+  return BLOCK_NEXT;
+}
+
+static ARMword
+Mlas (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  ARMword dest =
+    state->Reg[op->rm] * state->Reg[op->rs] + state->Reg[op->rn];
+
+  DEST_NZ (dest);
+  return BLOCK_NEXT;
+}
+
+/***************************************************************************\
+*                       Single data transfer                                *
+\***************************************************************************/
+
+#define OFF_IMM off = op->imm
+#define OFF_REG off = state->Reg[op->rm]; \
+                if (op->down) \
+                  off = -off
+#define OFF_SH  off = ShiftRm (state, op); \
+                if (op->down) \
+                  off = -off
+
+#define LOAD_WORD(a, d) d = ARMul_LoadWordN (state, a); \
+                        if ((a) & 3) \
+                          d = ARMul_Align (state, a, d)
+#define LOAD_BYTE(a, d) d = ARMul_LoadByte (state, a)
+#define STORE_WORD(a, d) ARMul_StoreWordN (state, a, d)
+#define STORE_BYTE(a, d) ARMul_StoreByte (state, a, d)
+
+/* As in LoadWord(), a loaded base register is not written back */
+#define LS_LOAD(name, OFF, LOAD)					\
+static ARMword								\
+name##_pre (ARMul_State * state, const ARMul_BlockOp * op)		\
+{									\
+  ARMword off, addr, data;						\
+  OFF;									\
+  addr = state->Reg[op->rn] + off;					\
+  LOAD (addr, data);							\
+  state->Reg[op->rd] = data;						\
+  return BLOCK_NEXT;							\
+}									\
+static ARMword								\
+name##_prewb (ARMul_State * state, const ARMul_BlockOp * op)		\
+{									\
+  ARMword off, addr, data;						\
+  OFF;									\
+  addr = state->Reg[op->rn] + off;					\
+  LOAD (addr, data);							\
+  state->Reg[op->rd] = data;						\
+  if (op->rd != op->rn)							\
+    state->Reg[op->rn] = addr;						\
+  return BLOCK_NEXT;							\
+}									\
+static ARMword								\
+name##_post (ARMul_State * state, const ARMul_BlockOp * op)		\
+{									\
+  ARMword off, addr, data;						\
+  OFF;				/* before Rd == Rm is loaded */		\
+  addr = state->Reg[op->rn];						\
+  LOAD (addr, data);							\
+  state->Reg[op->rd] = data;						\
+  if (op->rd != op->rn)							\
+    state->Reg[op->rn] = addr + off;					\
+  return BLOCK_NEXT;							\
+}
+
+/* Stores to the vectors abort, so are left to the emulator */
+#define LS_STORE(name, OFF, STORE)					\
+static ARMword								\
+name##_pre (ARMul_State * state, const ARMul_BlockOp * op)		\
+{									\
+  ARMword off, addr;							\
+  OFF;									\
+  addr = state->Reg[op->rn] + off;					\
+  if (VECTORACCESS (addr))						\
+    return Generic (state, op);						\
+  STORE (addr, state->Reg[op->rd]);					\
+  return Stored (state, op);						\
+}									\
+static ARMword								\
+name##_prewb (ARMul_State * state, const ARMul_BlockOp * op)		\
+{									\
+  ARMword off, addr;							\
+  OFF;									\
+  addr = state->Reg[op->rn] + off;					\
+  if (VECTORACCESS (addr))						\
+    return Generic (state, op);						\
+  STORE (addr, state->Reg[op->rd]);					\
+  state->Reg[op->rn] = addr;						\
+  return Stored (state, op);						\
+}									\
+static ARMword								\
+name##_post (ARMul_State * state, const ARMul_BlockOp * op)		\
+{									\
+  ARMword off, addr;							\
+  addr = state->Reg[op->rn];						\
+  if (VECTORACCESS (addr))						\
+    return Generic (state, op);						\
+  STORE (addr, state->Reg[op->rd]);					\
+  OFF;									\
+  state->Reg[op->rn] = addr + off;					\
+  return Stored (state, op);						\
+}
+
+#define LS_FORMS(name, LS, XFER) \
+  LS (name##_imm, OFF_IMM, XFER) \
+  LS (name##_reg, OFF_REG, XFER) \
+  LS (name##_sh, OFF_SH, XFER)
+
+LS_FORMS (Ldr, LS_LOAD, LOAD_WORD)
+LS_FORMS (Ldrb, LS_LOAD, LOAD_BYTE)
+LS_FORMS (Str, LS_STORE, STORE_WORD)
+LS_FORMS (Strb, LS_STORE, STORE_BYTE)
+
+/* PC relative loads, the address worked out when decoding */
+static ARMword
+Ldr_lit (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  ARMword data;
+
+  LOAD_WORD (op->imm, data);
+  state->Reg[op->rd] = data;
+  return BLOCK_NEXT;
+}
+
+static ARMword
+Ldrb_lit (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  state->Reg[op->rd] = ARMul_LoadByte (state, op->imm);
+  return BLOCK_NEXT;
+}
+
+#define LS_MODES(name) \
+  { name##_pre, name##_prewb, name##_post }
+#define LS_ENTRY(name) \
+  { LS_MODES (name##_imm), LS_MODES (name##_reg), LS_MODES (name##_sh) }
+
+/* Indexed by L, B, operand form and addressing mode */
+static ARMul_BlockFn *const LSHandlers[2][2][3][3] = {
+  {LS_ENTRY (Str), LS_ENTRY (Strb)},
+  {LS_ENTRY (Ldr), LS_ENTRY (Ldrb)},
+};
+
+#define MODE_PRE 0
+#define MODE_PREWB 1
+#define MODE_POST 2
+
+/***************************************************************************\
+*                       Block data transfer                                 *
+\***************************************************************************/
+
+/* LDM/STM without the S bit or PC in the list; op->imm is the offset of
+   the lowest address from the base and op->wb that of the new base.  */
+
+static inline void
+LoadRegs (ARMul_State * state, ARMword address, ARMword list)
+{
+  unsigned reg;
+
+  for (reg = 0; !(list & 1); reg++)
+    list >>= 1;
+  state->Reg[reg] = ARMul_LoadWordN (state, address);
+  for (reg++, list >>= 1; list != 0; reg++, list >>= 1)
+    if (list & 1)
+      {
+	address += 4;
+	state->Reg[reg] = ARMul_LoadWordS (state, address);
+      }
+}
+
+static ARMword
+Ldm (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  LoadRegs (state, state->Reg[op->rn] + op->imm, op->instr & 0xffff);
+  return BLOCK_NEXT;
+}
+
+static ARMword
+Ldm_wb (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  ARMword base = state->Reg[op->rn];
+
+  /* Written back first, so a loaded base wins as in LoadMult() */
+  state->Reg[op->rn] = base + op->wb;
+  LoadRegs (state, base + op->imm, op->instr & 0xffff);
+  return BLOCK_NEXT;
+}
+
+static ARMword
+Stm_common (ARMul_State * state, const ARMul_BlockOp * op, int writeback)
+{
+  ARMword base = state->Reg[op->rn];
+  ARMword address = base + op->imm;
+  ARMword list = op->instr & 0xffff;
+  unsigned reg;
+
+  if (VECTORACCESS (address))
+    return Generic (state, op);
+
+  /* The first register goes before the base is written back, as in
+     StoreMult() */
+  for (reg = 0; !(list & 1); reg++)
+    list >>= 1;
+  ARMul_StoreWordN (state, address, state->Reg[reg]);
+  if (writeback)
+    state->Reg[op->rn] = base + op->wb;
+  for (reg++, list >>= 1; list != 0; reg++, list >>= 1)
+    if (list & 1)
+      {
+	address += 4;
+	ARMul_StoreWordS (state, address, state->Reg[reg]);
+      }
+  return Stored (state, op);
+}
+
+static ARMword
+Stm (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  return Stm_common (state, op, FALSE);
+}
+
+static ARMword
+Stm_wb (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  return Stm_common (state, op, TRUE);
+}
+
+/***************************************************************************\
+*                              Branches                                     *
+\***************************************************************************/
+
+static ARMword
+Branch (ARMul_State * state ATTRIBUTE_UNUSED, const ARMul_BlockOp * op)
+{
+  return op->imm;
+}
+
+static ARMword
+BranchLink (ARMul_State * state, const ARMul_BlockOp * op)
+{
+  state->Reg[14] = (op->pc + 4) | ECC | ER15INT | EMODE;
+  return op->imm;
+}
+
+/***************************************************************************\
+*                              Decoding                                     *
+\***************************************************************************/
+
+/* Fill in op for the data processing instruction; form is FORM_IMM, or
+   FORM_REG for any register operand.  */
+static void
+DecodeDP (ARMul_BlockOp * op, ARMword instr, ARMword pc, int form)
+{
+  unsigned opcode = BITS (21, 24);
+  unsigned s = BIT (20);
+
+  if (op->rd == 15)
+    return;			/* writes the PC, or TSTP and friends */
+
+  if (form == FORM_IMM)
+    {
+      op->imm = ARMul_ImmedTable[BITS (0, 11)];
+      op->immc = BITS (0, 11) > 255;
+    }
+  else
+    {
+      if (op->rm == 15 || op->shift == ASR)
+	return;
+      if (op->shift != LSL || op->shamt != 0)
+	form = FORM_SH;
+    }
+
+  if (op->rn == 15 && opcode != 13 && opcode != 15)
+    {
+      /* ADR: PC relative address arithmetic becomes a constant */
+      if (form != FORM_IMM || s || (opcode != 2 && opcode != 4))
+	return;
+      op->imm = opcode == 4 ? pc + 8 + op->imm : pc + 8 - op->imm;
+      opcode = 13;
+    }
+
+  if (DPHandlers[opcode][s][form] != NULL)
+    {
+      op->fn = DPHandlers[opcode][s][form];
+      op->kind = BLOCK_DP;
+    }
+}
+
+static void
+DecodeLS (ARMul_BlockOp * op, ARMword instr, ARMword pc, int form)
+{
+  int mode;
+
+  if (!BIT (24) && BIT (21))
+    return;			/* LDRT/STRT */
+  if (op->rd == 15)
+    return;
+
+  if (form == FORM_IMM)
+    op->imm = BIT (23) ? BITS (0, 11) : -BITS (0, 11);
+  else
+    {
+      if (BIT (4) || op->rm == 15 || op->shift == ASR)
+	return;
+      if (op->shift != LSL || op->shamt != 0)
+	form = FORM_SH;
+      op->down = !BIT (23);
+    }
+
+  if (op->rn == 15)
+    {
+      if (form == FORM_IMM && BIT (24) && !BIT (21) && BIT (20))
+	{
+	  op->imm = pc + 8 + op->imm;
+	  op->fn = BIT (22) ? Ldrb_lit : Ldr_lit;
+	  op->kind = BLOCK_LS;
+	}
+      return;
+    }
+
+  mode = !BIT (24) ? MODE_POST : BIT (21) ? MODE_PREWB : MODE_PRE;
+  op->fn = LSHandlers[BIT (20)][BIT (22)][form][mode];
+  op->kind = BLOCK_LS;
+}
+
+static void
+DecodeLSM (ARMul_BlockOp * op, ARMword instr)
+{
+  ARMword n = LSMNumRegs;
+
+  if (BIT (22) || BIT (15) || op->rn == 15 || BITS (0, 15) == 0)
+    return;
+
+  if (BIT (24))			/* pre */
+    op->imm = BIT (23) ? 4 : -n;
+  else
+    op->imm = BIT (23) ? 0 : 4 - n;
+  op->wb = BIT (23) ? n : -n;
+
+  if (BIT (20))
+    op->fn = BIT (21) ? Ldm_wb : Ldm;
+  else
+    op->fn = BIT (21) ? Stm_wb : Stm;
+  op->kind = BLOCK_LSM;
+}
+
+static void
+DecodeMul (ARMul_BlockOp * op, ARMword instr)
+{
+  op->rd = MULDESTReg;
+  op->rm = MULLHSReg;
+  op->rs = MULRHSReg;
+  op->rn = MULACCReg;
+
+  if (op->rd == 15 || op->rd == op->rm || op->rm == 15 || op->rs == 15
+      || (BIT (21) && op->rn == 15))
+    return;
+
+  if (BIT (21))
+    op->fn = BIT (20) ? Mlas : Mla;
+  else
+    op->fn = BIT (20) ? Muls : Mul;
+  op->kind = BLOCK_MUL;
+}
+
+/* Decode one instruction into op, returning TRUE if it ends the block */
+static int
+Decode (ARMul_BlockOp * op, ARMword instr, ARMword pc)
+{
+  memset (op, 0, sizeof (*op));
+  op->fn = Generic;
+  op->instr = instr;
+  op->pc = pc;
+  op->cond = TOPBITS (28);
+  op->rd = DESTReg;
+  op->rn = LHSReg;
+  op->rm = RHSReg;
+  op->shift = BITS (5, 6);
+  op->shamt = BITS (7, 11);
+
+  if (op->cond == NV)
+    return FALSE;
+
+  switch (BITS (25, 27))
+    {
+    case 0:
+      if (BITS (4, 7) == 9)
+	{
+	  if (BITS (22, 27) == 0)
+	    DecodeMul (op, instr);
+	  return FALSE;
+	}
+      if (!BIT (4))
+	DecodeDP (op, instr, pc, FORM_REG);
+      return op->rd == 15 && (BITS (23, 24) != 2 || !BIT (20));
+
+    case 1:
+      DecodeDP (op, instr, pc, FORM_IMM);
+      return op->rd == 15 && (BITS (23, 24) != 2 || !BIT (20));
+
+    case 2:
+    case 3:
+      DecodeLS (op, instr, pc, BIT (25) ? FORM_REG : FORM_IMM);
+      return op->rd == 15 && BIT (20);
+
+    case 4:
+      DecodeLSM (op, instr);
+      return BIT (15) && BIT (20);
+
+    case 5:
+      op->imm = (pc + 8 + (BIT (23) ? NEGBRANCH : POSBRANCH)) & R15PCBITS;
+      op->fn = BIT (24) ? BranchLink : Branch;
+      op->kind = BLOCK_BRANCH;
+      return TRUE;
+
+    case 6:
+      return FALSE;		/* LDC/STC, left to the coprocessor */
+
+    default:			/* CDP/MRC/MCR, SWI */
+      return BIT (24);
+    }
+}
+
+/***************************************************************************\
+*                          Cache management                                 *
+\***************************************************************************/
+
+void
+ARMul_BlockInit (ARMul_State * state, ARMword memsize)
+{
+  ARMul_BlockCache *bc;
+
+  bc = (ARMul_BlockCache *) calloc (1, sizeof (ARMul_BlockCache));
+  if (bc == NULL)
+    return;
+  bc->arena = (unsigned char *) malloc (BLOCK_ARENA_SIZE);
+  bc->codemap = (uint32_t *) calloc (memsize / 128, sizeof (uint32_t));
+  if (bc->arena == NULL || bc->codemap == NULL)
+    {
+      free (bc->arena);
+      free (bc->codemap);
+      free (bc);
+      return;			/* just interpret */
+    }
+  bc->limit = memsize;
+  bc->map_lo = ~0;
+  state->BlockCache = bc;
+}
+
+void
+ARMul_BlockExit (ARMul_State * state)
+{
+  ARMul_BlockCache *bc = state->BlockCache;
+
+  if (bc == NULL)
+    return;
+  ARMul_JitExit (state);
+  free (bc->arena);
+  free (bc->codemap);
+  free (bc);
+  state->BlockCache = NULL;
+}
+
+void
+ARMul_BlockFlush (ARMul_State * state)
+{
+  ARMul_BlockCache *bc = state->BlockCache;
+
+  memset (bc->hash, 0, sizeof (bc->hash));
+  bc->arena_used = 0;
+  if (bc->map_lo <= bc->map_hi)
+    memset (&bc->codemap[bc->map_lo], 0,
+	    (bc->map_hi - bc->map_lo + 1) * sizeof (uint32_t));
+  bc->map_lo = ~0;
+  bc->map_hi = 0;
+  bc->flushed = 1;
+  if (bc->jit != NULL)
+    ARMul_JitFlush (state);
+}
+
+/* Host writes to guest memory (e.g. read()) must be reported here */
+void
+ARMul_BlockInvalidate (ARMul_State * state, ARMword address, ARMword len)
+{
+  ARMul_BlockCache *bc = state->BlockCache;
+  ARMword a, end;
+
+  if (bc == NULL || len == 0)
+    return;
+  end = address + len;
+  if (end > bc->limit || end < address)
+    end = bc->limit;
+  for (a = address & ~3; a < end; a += 4)
+    {
+      if (!(a & 127) && bc->codemap[a >> 7] == 0)
+	{
+	  a += 124;		/* skip an empty bitmap word */
+	  continue;
+	}
+      if (bc->codemap[a >> 7] & (1u << ((a >> 2) & 31)))
+	{
+	  ARMul_BlockFlush (state);
+	  return;
+	}
+    }
+}
+
+/* Forget the blocks for code in [lo, hi), keeping the rest, when that
+   memory is replaced wholesale (e.g. exec of a binary that keeps the
+   same libraries).  Their arena and native code space is only reclaimed
+   by the next flush.  */
+void
+ARMul_BlockDiscard (ARMul_State * state, ARMword lo, ARMword hi)
+{
+  ARMul_BlockCache *bc = state->BlockCache;
+  ARMul_Block **pp, *b;
+  ARMword a;
+  unsigned i, n;
+
+  if (bc == NULL || lo >= hi)
+    return;
+  for (i = 0; i < BLOCK_HASH_SIZE; i++)
+    for (pp = &bc->hash[i]; (b = *pp) != NULL;)
+      {
+	if (b->pc < hi && b->endpc > lo)
+	  *pp = b->hnext;
+	else
+	  pp = &b->hnext;
+      }
+  for (i = 0; i < BLOCK_HASH_SIZE; i++)
+    for (b = bc->hash[i]; b != NULL; b = b->hnext)
+      for (n = 0; n < 2; n++)
+	if (b->link[n] != NULL && b->link[n]->pc < hi && b->link[n]->endpc > lo)
+	  b->link[n] = NULL;
+
+  if (hi > bc->limit)
+    hi = bc->limit;
+  for (a = lo & ~3; a < hi; a += 4)
+    {
+      if (!(a & 127) && a + 128 <= hi)
+	{
+	  bc->codemap[a >> 7] = 0;
+	  a += 124;
+	  continue;
+	}
+      bc->codemap[a >> 7] &= ~(1u << ((a >> 2) & 31));
+    }
+  bc->flushed = 1;		/* the runner's previous block may have gone */
+}
+
+static inline ARMul_Block *
+Lookup (ARMul_BlockCache * bc, ARMword pc)
+{
+  ARMul_Block *b;
+
+  for (b = bc->hash[(pc >> 2) & (BLOCK_HASH_SIZE - 1)]; b; b = b->hnext)
+    if (b->pc == pc)
+      return b;
+  return NULL;
+}
+
+static ARMul_Block *
+Translate (ARMul_State * state, ARMword pc)
+{
+  ARMul_BlockCache *bc = state->BlockCache;
+  ARMul_Block *b;
+  unsigned n, end;
+
+  if (bc->arena_used + sizeof (ARMul_Block)
+      + BLOCK_MAX_OPS * sizeof (ARMul_BlockOp) > BLOCK_ARENA_SIZE)
+    ARMul_BlockFlush (state);
+
+  b = (ARMul_Block *) (bc->arena + bc->arena_used);
+  b->pc = pc;
+  b->link[0] = b->link[1] = NULL;
+  b->native = NULL;
+  b->hits = 0;
+  n = 0;
+  do
+    {
+      end = Decode (&b->ops[n], ARMul_ReLoadInstr (state, pc, 4), pc);
+      if (pc < bc->limit)
+	{
+	  bc->codemap[pc >> 7] |= 1u << ((pc >> 2) & 31);
+	  if ((pc >> 7) < bc->map_lo)
+	    bc->map_lo = pc >> 7;
+	  if ((pc >> 7) > bc->map_hi)
+	    bc->map_hi = pc >> 7;
+	}
+      n++;
+      pc += 4;
+    }
+  while (!end && n < BLOCK_MAX_OPS);
+  b->nops = n;
+  b->endpc = pc;
+
+  b->hnext = bc->hash[(b->pc >> 2) & (BLOCK_HASH_SIZE - 1)];
+  bc->hash[(b->pc >> 2) & (BLOCK_HASH_SIZE - 1)] = b;
+  bc->arena_used +=
+    ROUNDUP8 (sizeof (ARMul_Block) + n * sizeof (ARMul_BlockOp));
+  return b;
+}
+
+/***************************************************************************\
+*                              The runner                                   *
+\***************************************************************************/
+
+/* Run blocks until something needs the full emulator: a mode change,
+   stop request, exception or debugger.  Leaves the pipeline primed
+   to continue from the returned PC.  */
+ARMword
+ARMul_BlockRun (ARMul_State * state)
+{
+  ARMul_BlockCache *bc = state->BlockCache;
+  ARMul_Block *b, *prev = NULL;
+  const ARMul_BlockOp *op, *end;
+  ARMword pc, next;
+
+  state->isize = 4;
+  if (state->NextInstr >= PRIMEPIPE)
+    pc = R15PC;
+  else if (state->NextInstr & PCINCEDSEQ)
+    pc = R15PC - 8;
+  else
+    pc = R15PC - 4;
+
+  bc->flushed = 0;
+  while (state->Emulate == RUN && !state->Exception
+	 && !state->EventSet && !state->CallDebug)
+    {
+      if (bc->flushed)
+	{			/* prev has gone */
+	  bc->flushed = 0;
+	  prev = NULL;
+	}
+      if (state->NumInstrs >= state->ProfileNext)
+	ARMul_ProfileSample (state, pc);
+      /* Branched here (though not round a one-block loop again) */
+      if (prev == NULL || (pc != prev->endpc && pc != prev->pc))
+	ARMul_FlightRecord (state, pc, ARMUL_FLIGHT_BRANCH);
+
+      b = NULL;
+      if (prev != NULL)
+	{
+	  if (prev->link[0] != NULL && prev->link[0]->pc == pc)
+	    b = prev->link[0];
+	  else if (prev->link[1] != NULL && prev->link[1]->pc == pc)
+	    b = prev->link[1];
+	}
+      if (b == NULL)
+	{
+	  b = Lookup (bc, pc);
+	  if (b == NULL)
+	    {
+	      b = Translate (state, pc);
+	      if (bc->flushed)
+		{
+		  bc->flushed = 0;
+		  prev = NULL;
+		}
+	    }
+	  if (prev != NULL)
+	    {
+	      prev->link[1] = prev->link[0];
+	      prev->link[0] = b;
+	    }
+	}
+
+      if (b->native != NULL)
+	{
+	  FLAGSYNC;		/* native code keeps NFlag..VFlag up to date */
+	  pc = b->native (state);
+	  prev = b;
+	  continue;
+	}
+      if (++b->hits == JIT_THRESHOLD && bc->jit != NULL)
+	ARMul_JitCompile (state, b);
+
+      next = b->endpc;
+      for (op = b->ops, end = op + b->nops; op < end; op++)
+	{
+	  state->NumInstrs++;
+	  if (op->cond != AL && !CondPassed (state, op->cond))
+	    continue;
+	  if ((pc = op->fn (state, op)) != BLOCK_NEXT)
+	    {
+	      next = pc;
+	      break;
+	    }
+	}
+      pc = next;
+      prev = b;
+    }
+
+  state->Reg[15] = pc;
+  state->NextInstr = PRIMEPIPE;
+  return pc;
+}
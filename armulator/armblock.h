@@ -0,0 +1,114 @@
+/*  armblock.h -- Predecoded basic-block cache for ARMul_Emulate26.
+    Copyright (C) 2022 Matt Evans
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA. */
+
+#ifndef ARMBLOCK_H
+#define ARMBLOCK_H
+
+/***************************************************************************\
+*                         Predecoded instructions                           *
+\***************************************************************************/
+
+typedef struct ARMul_BlockOp ARMul_BlockOp;
+
+/* A handler returns BLOCK_NEXT to carry on with the following op, or
+   the address execution continues from if the block must be left.  */
+typedef ARMword ARMul_BlockFn (ARMul_State * state, const ARMul_BlockOp * op);
+
+#define BLOCK_NEXT 1		/* never a valid (word aligned) PC */
+
+/* What an op's handler does, so that armjit.c can compile it */
+#define BLOCK_GENERIC 0		/* left to ARMul_Execute26 */
+#define BLOCK_DP 1
+#define BLOCK_MUL 2
+#define BLOCK_LS 3
+#define BLOCK_LSM 4
+#define BLOCK_BRANCH 5
+
+struct ARMul_BlockOp
+{
+  ARMul_BlockFn *fn;		/* handler */
+  ARMword instr;		/* the original instruction */
+  ARMword pc;			/* its address */
+  ARMword imm;			/* immediate operand, offset or branch target */
+  ARMword wb;			/* LDM/STM writeback offset */
+  unsigned char kind;		/* BLOCK_GENERIC etc. */
+  unsigned char cond;		/* condition code, TOPBITS (28) */
+  unsigned char rd, rn, rm;	/* preresolved register numbers */
+  unsigned char rs;		/* MUL Rs */
+  unsigned char shift, shamt;	/* immediate shift of Rm */
+  unsigned char immc;		/* rotated immediate, sets C in logical ops */
+  unsigned char down;		/* register offset is subtracted */
+};
+
+typedef struct ARMul_Block ARMul_Block;
+
+/* Compiled blocks run everything and return the next PC */
+typedef ARMword ARMul_BlockNative (ARMul_State * state);
+
+struct ARMul_Block
+{
+  ARMword pc;			/* address of the first instruction */
+  ARMword endpc;		/* address following the last one */
+  ARMul_Block *hnext;		/* hash chain */
+  ARMul_Block *link[2];		/* most recent successors */
+  ARMul_BlockNative *native;	/* compiled code, see armjit.c */
+  unsigned hits;		/* times run before being compiled */
+  unsigned nops;
+  ARMul_BlockOp ops[];
+};
+
+/***************************************************************************\
+*                              The cache                                    *
+\***************************************************************************/
+
+#define BLOCK_HASH_SIZE 16384
+#define BLOCK_ARENA_SIZE (16 * 1024 * 1024)
+#define BLOCK_MAX_OPS 64
+
+typedef struct ARMul_BlockCache
+{
+  ARMul_Block *hash[BLOCK_HASH_SIZE];
+  unsigned char *arena;		/* blocks are carved from here... */
+  unsigned long arena_used;	/* ...until it fills, then all are flushed */
+  ARMword limit;		/* size of the memory covered by codemap */
+  uint32_t *codemap;		/* one bit per word containing cached code */
+  ARMword map_lo, map_hi;	/* range of codemap words with bits set */
+  unsigned flushed;		/* set by a flush, so the runner drops blocks */
+  struct ARMul_Jit *jit;	/* native code buffer, or NULL */
+} ARMul_BlockCache;
+
+extern void ARMul_BlockInit (ARMul_State * state, ARMword memsize);
+extern void ARMul_BlockExit (ARMul_State * state);
+extern ARMword ARMul_BlockRun (ARMul_State * state);
+extern void ARMul_BlockFlush (ARMul_State * state);
+extern void ARMul_BlockInvalidate (ARMul_State * state, ARMword address,
+				   ARMword len);
+extern void ARMul_BlockDiscard (ARMul_State * state, ARMword lo, ARMword hi);
+
+/* Called for every word stored, so that code which is overwritten is
+   not executed stale from the cache.  */
+static inline void
+ARMul_BlockWriteCheck (ARMul_State * state, ARMword address)
+{
+  ARMul_BlockCache *bc = state->BlockCache;
+
+  if (bc != NULL && address < bc->limit
+      && (bc->codemap[address >> 7] & (1u << ((address >> 2) & 31))))
+    ARMul_BlockFlush (state);
+}
+
+#endif
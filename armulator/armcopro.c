@@ -16,6 +16,7 @@
     Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA. */
 
 #include "armdefs.h"
+#include "armfpa.h"
 #include "ansidecl.h"
 
 extern unsigned ARMul_CoProInit (ARMul_State * state);
@@ -50,11 +51,15 @@ controls 32/26 bit program space, bit 5 controls 32/26 bit data space,
 bit 6 controls late abort timimg and bit 7 controls big/little endian.
 */
 
-static ARMword MMUReg[8];
+/* The registers are per-state, in CPData[15] */
+#define MMUReg ((ARMword *) state->CPData[15])
 
 static unsigned
 MMUInit (ARMul_State * state)
 {
+  state->CPData[15] = (unsigned char *) calloc (8, sizeof (ARMword));
+  if (state->CPData[15] == NULL)
+    return (FALSE);
   MMUReg[1] = state->prog32Sig << 4 |
     state->data32Sig << 5 | state->lateabtSig << 6 | state->bigendSig << 7;
   ARMul_ConsolePrint (state, ", MMU present");
@@ -62,7 +67,15 @@ MMUInit (ARMul_State * state)
 }
 
 static unsigned
-MMUMRC (ARMul_State * state ATTRIBUTE_UNUSED, unsigned type ATTRIBUTE_UNUSED, ARMword instr, ARMword * value)
+MMUExit (ARMul_State * state)
+{
+  free (state->CPData[15]);
+  state->CPData[15] = NULL;
+  return (TRUE);
+}
+
+static unsigned
+MMUMRC (ARMul_State * state, unsigned type ATTRIBUTE_UNUSED, ARMword instr, ARMword * value)
 {
   int reg = BITS (16, 19) & 7;
 
@@ -92,7 +105,7 @@ MMUMCR (ARMul_State * state, unsigned type ATTRIBUTE_UNUSED, ARMword instr, ARMw
 
 
 static unsigned
-MMURead (ARMul_State * state ATTRIBUTE_UNUSED, unsigned reg, ARMword * value)
+MMURead (ARMul_State * state, unsigned reg, ARMword * value)
 {
   if (reg == 0)
     *value = 0x41440110;
@@ -129,22 +142,44 @@ way, CDP 3 and 4 turn of the FIQ and IRQ source, and CDP 5 stores a 32
 bit time value in a CP register (actually it's the total number of N, S,
 I, C and F cyles) */
 
-static ARMword ValReg[16];
+/* Both CP 4 and CP 5 use the state kept in CPData[4] */
+typedef struct
+{
+  ARMword Reg[16];
+  unsigned LDCWords, STCWords;
+  unsigned long ValFinish, IntFinish;
+} ARMul_Val;
+
+#define VAL(state) ((ARMul_Val *) (state)->CPData[4])
+#define ValReg (VAL (state)->Reg)
+
+static unsigned
+ValInit (ARMul_State * state)
+{
+  state->CPData[4] = (unsigned char *) calloc (1, sizeof (ARMul_Val));
+  return (state->CPData[4] != NULL);
+}
 
 static unsigned
-ValLDC (ARMul_State * state ATTRIBUTE_UNUSED, unsigned type, ARMword instr, ARMword data)
+ValExit (ARMul_State * state)
 {
-  static unsigned words;
+  free (state->CPData[4]);
+  state->CPData[4] = NULL;
+  return (TRUE);
+}
 
+static unsigned
+ValLDC (ARMul_State * state, unsigned type, ARMword instr, ARMword data)
+{
   if (type != ARMul_DATA)
     {
-      words = 0;
+      VAL (state)->LDCWords = 0;
       return (ARMul_DONE);
     }
   if (BIT (22))
     {				/* it's a long access, get two words */
       ValReg[BITS (12, 15)] = data;
-      if (words++ == 4)
+      if (VAL (state)->LDCWords++ == 4)
 	return (ARMul_DONE);
       else
 	return (ARMul_INC);
@@ -157,19 +192,17 @@ ValLDC (ARMul_State * state ATTRIBUTE_UNUSED, unsigned type, ARMword instr, ARMw
 }
 
 static unsigned
-ValSTC (ARMul_State * state ATTRIBUTE_UNUSED, unsigned type, ARMword instr, ARMword * data)
+ValSTC (ARMul_State * state, unsigned type, ARMword instr, ARMword * data)
 {
-  static unsigned words;
-
   if (type != ARMul_DATA)
     {
-      words = 0;
+      VAL (state)->STCWords = 0;
       return (ARMul_DONE);
     }
   if (BIT (22))
     {				/* it's a long access, get two words */
       *data = ValReg[BITS (12, 15)];
-      if (words++ == 4)
+      if (VAL (state)->STCWords++ == 4)
 	return (ARMul_DONE);
       else
 	return (ARMul_INC);
@@ -182,14 +215,14 @@ ValSTC (ARMul_State * state ATTRIBUTE_UNUSED, unsigned type, ARMword instr, ARMw
 }
 
 static unsigned
-ValMRC (ARMul_State * state ATTRIBUTE_UNUSED, unsigned type ATTRIBUTE_UNUSED, ARMword instr, ARMword * value)
+ValMRC (ARMul_State * state, unsigned type ATTRIBUTE_UNUSED, ARMword instr, ARMword * value)
 {
   *value = ValReg[BITS (16, 19)];
   return (ARMul_DONE);
 }
 
 static unsigned
-ValMCR (ARMul_State * state ATTRIBUTE_UNUSED, unsigned type ATTRIBUTE_UNUSED, ARMword instr, ARMword value)
+ValMCR (ARMul_State * state, unsigned type ATTRIBUTE_UNUSED, ARMword instr, ARMword value)
 {
   ValReg[BITS (16, 19)] = value;
   return (ARMul_DONE);
@@ -198,7 +231,6 @@ ValMCR (ARMul_State * state ATTRIBUTE_UNUSED, unsigned type ATTRIBUTE_UNUSED, AR
 static unsigned
 ValCDP (ARMul_State * state, unsigned type, ARMword instr)
 {
-  static unsigned long finish = 0;
   ARMword howlong;
 
   howlong = ValReg[BITS (0, 3)];
@@ -206,7 +238,7 @@ ValCDP (ARMul_State * state, unsigned type, ARMword instr)
     {
       if (type == ARMul_FIRST)
 	{			/* First cycle of a busy wait */
-	  finish = ARMul_Time (state) + howlong;
+	  VAL (state)->ValFinish = ARMul_Time (state) + howlong;
 	  if (howlong == 0)
 	    return (ARMul_DONE);
 	  else
@@ -214,7 +246,7 @@ ValCDP (ARMul_State * state, unsigned type, ARMword instr)
 	}
       else if (type == ARMul_BUSY)
 	{
-	  if (ARMul_Time (state) >= finish)
+	  if (ARMul_Time (state) >= VAL (state)->ValFinish)
 	    return (ARMul_DONE);
 	  else
 	    return (ARMul_BUSY);
@@ -242,7 +274,6 @@ DoAIRQ (ARMul_State * state)
 static unsigned
 IntCDP (ARMul_State * state, unsigned type, ARMword instr)
 {
-  static unsigned long finish;
   ARMword howlong;
 
   howlong = ValReg[BITS (0, 3)];
@@ -251,7 +282,7 @@ IntCDP (ARMul_State * state, unsigned type, ARMword instr)
     case 0:
       if (type == ARMul_FIRST)
 	{			/* First cycle of a busy wait */
-	  finish = ARMul_Time (state) + howlong;
+	  VAL (state)->IntFinish = ARMul_Time (state) + howlong;
 	  if (howlong == 0)
 	    return (ARMul_DONE);
 	  else
@@ -259,7 +290,7 @@ IntCDP (ARMul_State * state, unsigned type, ARMword instr)
 	}
       else if (type == ARMul_BUSY)
 	{
-	  if (ARMul_Time (state) >= finish)
+	  if (ARMul_Time (state) >= VAL (state)->IntFinish)
 	    return (ARMul_DONE);
 	  else
 	    return (ARMul_BUSY);
@@ -311,15 +342,23 @@ ARMul_CoProInit (ARMul_State * state)
      CDP routine, Read Reg routine, Write Reg routine) ;
    */
 
-  ARMul_CoProAttach (state, 4, NULL, NULL,
+  ARMul_CoProAttach (state, 4, ValInit, ValExit,
 		     ValLDC, ValSTC, ValMRC, ValMCR, ValCDP, NULL, NULL);
 
   ARMul_CoProAttach (state, 5, NULL, NULL,
 		     NULL, NULL, ValMRC, ValMCR, IntCDP, NULL, NULL);
 
-  ARMul_CoProAttach (state, 15, MMUInit, NULL,
+  ARMul_CoProAttach (state, 15, MMUInit, MMUExit,
 		     NULL, NULL, MMUMRC, MMUMCR, NULL, MMURead, MMUWrite);
 
+  /* Floating point, see armfpa.c */
+  ARMul_CoProAttach (state, FPA_CP, ARMul_FPAInit, ARMul_FPAExit,
+		     ARMul_FPALDC, ARMul_FPASTC, ARMul_FPAMRC, ARMul_FPAMCR,
+		     ARMul_FPACDP, NULL, NULL);
+
+  ARMul_CoProAttach (state, FPA_CP_LFM, NULL, NULL,
+		     ARMul_FPALDC, ARMul_FPASTC, NULL, NULL, NULL, NULL, NULL);
+
 
   /* No handlers below here */
 
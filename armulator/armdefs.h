@@ -37,6 +37,24 @@ typedef char *VoidStar;
 typedef uint32_t ARMword;	/* must be 32 bits wide */
 typedef struct ARMul_State ARMul_State;
 
+/* The flight recorder keeps the last ARMUL_FLIGHT (a power of 2) branch
+   targets and SWIs, for the host to show after a crash.  */
+#define ARMUL_FLIGHT 128
+#define ARMUL_FLIGHT_BRANCH 0xffffffff	/* .swi of a branch target */
+
+typedef struct
+{
+  ARMword pc;			/* branched to, or the SWI's address */
+  ARMword swi;			/* its number, or ARMUL_FLIGHT_BRANCH */
+} ARMul_FlightEntry;
+
+#define ARMul_FlightRecord(state, where, what) do {			\
+    ARMul_FlightEntry *fe_ =						\
+      &(state)->Flight[(state)->FlightPos++ & (ARMUL_FLIGHT - 1)];	\
+    fe_->pc = (where);							\
+    fe_->swi = (what);							\
+  } while (0)
+
 typedef unsigned ARMul_CPInits (ARMul_State * state);
 typedef unsigned ARMul_CPExits (ARMul_State * state);
 typedef unsigned ARMul_LDCs (ARMul_State * state, unsigned type,
@@ -64,15 +82,24 @@ struct ARMul_State
   ARMword Cpsr;			/* the current psr */
   ARMword Spsr[7];		/* the exception psr's */
   ARMword NFlag, ZFlag, CFlag, VFlag, IFFlags;	/* dummy flags for speed */
+  unsigned FlagOp;		/* LAZY_*, flags still to come from below */
+  ARMword FlagA, FlagB, FlagRes;	/* operands and result of the last S op */
 #ifdef MODET
   ARMword TFlag;		/* Thumb state */
 #endif
+  ARMword isize;		/* instruction size, 2 in Thumb state */
   ARMword Bank;			/* the current register bank */
   ARMword Mode;			/* the current mode */
   ARMword instr, pc, temp;	/* saved register state */
   ARMword loaded, decoded;	/* saved pipeline state */
   unsigned long NumScycles, NumNcycles, NumIcycles, NumCcycles, NumFcycles;	/* emulated cycles used */
   unsigned long NumInstrs;	/* the number of instructions executed */
+  unsigned long ProfileNext;	/* NumInstrs to call ARMul_ProfileSample at */
+  unsigned ProfileCalls;	/* set to call ARMul_ProfileCall/Return */
+  unsigned long PerfNext;	/* NumInstrs to call ARMul_PerfSample at */
+  unsigned long NextEvent;	/* the sooner of the two (or before it) */
+  unsigned Trace;		/* set to call ARMul_TraceInstr */
+  unsigned FlightPos;		/* entries recorded, mod 2^32 */
   unsigned NextInstr;
   unsigned VectorCatch;		/* caught exception mask */
   unsigned CallDebug;		/* set to call the debugger */
@@ -87,6 +114,7 @@ struct ARMul_State
   unsigned char *MemOutPtr;	/* the Data Out bus (which you may not need */
   unsigned char *MemSparePtr;	/* extra space */
   ARMword MemSize;
+  unsigned char *MemBase;	/* host copy of guest memory, see armmem.h */
 
   unsigned char *OSptr;		/* OS Handle */
   char *CommandLine;		/* Command Line from ARMsd */
@@ -128,7 +156,11 @@ struct ARMul_State
 
   const struct Dbg_HostosInterface *hostif;
 
+  struct ARMul_BlockCache *BlockCache;	/* predecoded blocks, see armblock.c */
+
   int verbose;			/* non-zero means print various messages like the banner */
+
+  ARMul_FlightEntry Flight[ARMUL_FLIGHT];	/* see ARMul_FlightRecord */
 };
 
 #define ResetPin NresetSig
@@ -364,6 +396,11 @@ extern unsigned ARMul_OSHandleSWI (ARMul_State * state, ARMword number);
 extern ARMword ARMul_OSLastErrorP (ARMul_State * state);
 
 extern ARMword ARMul_Debug (ARMul_State * state, ARMword pc, ARMword instr);
+extern void ARMul_ProfileSample (ARMul_State * state, ARMword pc);
+extern void ARMul_ProfileCall (ARMul_State * state, ARMword pc, ARMword to);
+extern void ARMul_ProfileReturn (ARMul_State * state, ARMword pc, ARMword to);
+extern void ARMul_PerfSample (ARMul_State * state, ARMword pc, ARMword instr);
+extern void ARMul_TraceInstr (ARMul_State * state, ARMword pc, ARMword instr);
 extern unsigned ARMul_OSException (ARMul_State * state, ARMword vector,
 				   ARMword pc);
 extern int rdi_log;
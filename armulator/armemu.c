@@ -19,6 +19,8 @@
 #include "armdefs.h"
 #include "armemu.h"
 #include "armos.h"
+#include "armblock.h"
+#include "armmem.h"
 
 static ARMword GetDPRegRHS (ARMul_State * state, ARMword instr);
 static ARMword GetDPSRegRHS (ARMul_State * state, ARMword instr);
@@ -67,7 +69,6 @@ static long ui_loop_hook_counter = UI_LOOP_POLL_INTERVAL;
 extern int (*ui_loop_hook) (int);
 #endif /* NEED_UI_LOOP_HOOK */
 
-extern int stop_simulator;
 
 /***************************************************************************\
 *               short-hand macros for LDR/STR                               *
@@ -265,25 +266,51 @@ extern int stop_simulator;
 *                             EMULATION of ARM6                             *
 \***************************************************************************/
 
-/* The PC pipeline value depends on whether ARM or Thumb instructions
-   are being executed: */
-ARMword isize;
-
-#ifdef MODE32
-ARMword
-ARMul_Emulate32 (register ARMul_State * state)
+/* The loop below is built in three variants.  EMU_DEBUG is the original,
+   checking for events, exceptions (interrupts and reset) and the debugger
+   before every instruction.  EMU_TRACE checks only for the instruction
+   trace, and EMU_FAST for none of them; ARMul_DoProg picks one of these
+   when nothing has asked for the rest.  */
+#define EMU_FAST 0
+#define EMU_TRACE 1
+#define EMU_DEBUG 2
+
+/* Take the profile or perf sample that's due before the instruction at
+   pc, then work out when the next one is.  Whoever brings ProfileNext or
+   PerfNext forward brings NextEvent forward too, so that the loop below
+   has just the one comparison to make.  */
+static void __attribute__ ((noinline))
+InstrEvents (ARMul_State * state, ARMword pc, ARMword instr)
 {
-#else
-ARMword
-ARMul_Emulate26 (register ARMul_State * state)
+  if (state->NumInstrs >= state->ProfileNext)
+    ARMul_ProfileSample (state, pc);
+  if (state->NumInstrs >= state->PerfNext)
+    ARMul_PerfSample (state, pc, instr);
+  state->NextEvent = state->ProfileNext < state->PerfNext
+    ? state->ProfileNext : state->PerfNext;
+}
+
+static inline __attribute__ ((always_inline)) ARMword
+Emulate (register ARMul_State * state, const int variant)
 {
-#endif
   register ARMword instr,	/* the current instruction */
-    dest = 0,			/* almost the DestBus */
-    temp,			/* ubiquitous third hand */
     pc = 0;			/* the address of the current instruction */
-  ARMword lhs, rhs;		/* almost the ABus and BBus */
+#ifdef ARMUL_CYCLES
   ARMword decoded = 0, loaded = 0;	/* instruction pipeline */
+#endif
+
+#ifndef MODE32
+  /* Use the predecoded block cache when nobody is watching closely */
+  if (state->BlockCache != NULL && state->Emulate == RUN
+      && (variant == EMU_FAST
+	  || (!state->verbose && !state->Trace && !state->Exception
+	      && !state->EventSet && !state->CallDebug)))
+    {
+      pc = ARMul_BlockRun (state);
+      if (state->Emulate != RUN)
+	return (pc);
+    }
+#endif
 
 /***************************************************************************\
 *                        Execute the next instruction                       *
@@ -291,8 +318,10 @@ ARMul_Emulate26 (register ARMul_State * state)
 
   if (state->NextInstr < PRIMEPIPE)
     {
+#ifdef ARMUL_CYCLES
       decoded = state->decoded;
       loaded = state->loaded;
+#endif
       pc = state->pc;
     }
 
@@ -301,43 +330,44 @@ ARMul_Emulate26 (register ARMul_State * state)
 #ifdef MODET
       if (TFLAG)
 	{
-	  isize = 2;
+	  state->isize = 2;
 	}
       else
+	state->isize = 4;
 #endif
-	isize = 4;
+#ifdef ARMUL_CYCLES
       switch (state->NextInstr)
 	{
 	case SEQ:
-	  state->Reg[15] += isize;	/* Advance the pipeline, and an S cycle */
-	  pc += isize;
+	  state->Reg[15] += ISIZE;	/* Advance the pipeline, and an S cycle */
+	  pc += ISIZE;
 	  instr = decoded;
 	  decoded = loaded;
-	  loaded = ARMul_LoadInstrS (state, pc + (isize * 2), isize);
+	  loaded = ARMul_LoadInstrS (state, pc + (ISIZE * 2), ISIZE);
 	  break;
 
 	case NONSEQ:
-	  state->Reg[15] += isize;	/* Advance the pipeline, and an N cycle */
-	  pc += isize;
+	  state->Reg[15] += ISIZE;	/* Advance the pipeline, and an N cycle */
+	  pc += ISIZE;
 	  instr = decoded;
 	  decoded = loaded;
-	  loaded = ARMul_LoadInstrN (state, pc + (isize * 2), isize);
+	  loaded = ARMul_LoadInstrN (state, pc + (ISIZE * 2), ISIZE);
 	  NORMALCYCLE;
 	  break;
 
 	case PCINCEDSEQ:
-	  pc += isize;		/* Program counter advanced, and an S cycle */
+	  pc += ISIZE;		/* Program counter advanced, and an S cycle */
 	  instr = decoded;
 	  decoded = loaded;
-	  loaded = ARMul_LoadInstrS (state, pc + (isize * 2), isize);
+	  loaded = ARMul_LoadInstrS (state, pc + (ISIZE * 2), ISIZE);
 	  NORMALCYCLE;
 	  break;
 
 	case PCINCEDNONSEQ:
-	  pc += isize;		/* Program counter advanced, and an N cycle */
+	  pc += ISIZE;		/* Program counter advanced, and an N cycle */
 	  instr = decoded;
 	  decoded = loaded;
-	  loaded = ARMul_LoadInstrN (state, pc + (isize * 2), isize);
+	  loaded = ARMul_LoadInstrN (state, pc + (ISIZE * 2), ISIZE);
 	  NORMALCYCLE;
 	  break;
 
@@ -346,11 +376,11 @@ ARMul_Emulate26 (register ARMul_State * state)
 #ifndef MODE32
 	  pc = pc & R15PCBITS;
 #endif
-	  state->Reg[15] = pc + (isize * 2);
+	  state->Reg[15] = pc + (ISIZE * 2);
 	  state->Aborted = 0;
-	  instr = ARMul_ReLoadInstr (state, pc, isize);
-	  decoded = ARMul_ReLoadInstr (state, pc + isize, isize);
-	  loaded = ARMul_ReLoadInstr (state, pc + isize * 2, isize);
+	  instr = ARMul_ReLoadInstr (state, pc, ISIZE);
+	  decoded = ARMul_ReLoadInstr (state, pc + ISIZE, ISIZE);
+	  loaded = ARMul_ReLoadInstr (state, pc + ISIZE * 2, ISIZE);
 	  NORMALCYCLE;
 	  break;
 
@@ -359,19 +389,52 @@ ARMul_Emulate26 (register ARMul_State * state)
 #ifndef MODE32
 	  pc = pc & R15PCBITS;
 #endif
-	  state->Reg[15] = pc + (isize * 2);
+	  ARMul_FlightRecord (state, pc, ARMUL_FLIGHT_BRANCH);
+	  state->Reg[15] = pc + (ISIZE * 2);
 	  state->Aborted = 0;
-	  instr = ARMul_LoadInstrN (state, pc, isize);
-	  decoded = ARMul_LoadInstrS (state, pc + (isize), isize);
-	  loaded = ARMul_LoadInstrS (state, pc + (isize * 2), isize);
+	  instr = ARMul_LoadInstrN (state, pc, ISIZE);
+	  decoded = ARMul_LoadInstrS (state, pc + (ISIZE), ISIZE);
+	  loaded = ARMul_LoadInstrS (state, pc + (ISIZE * 2), ISIZE);
 	  NORMALCYCLE;
 	  break;
 	}
-      if (state->EventSet)
+#else
+      /* No pipeline:  R15 still reads as pc + 8, but each instruction is
+         fetched from the PC just before it runs.  */
+      switch (state->NextInstr)
+	{
+	case SEQ:
+	case NONSEQ:
+	  state->Reg[15] += ISIZE;
+	  pc += ISIZE;
+	  break;
+
+	case PCINCEDSEQ:
+	case PCINCEDNONSEQ:
+	  pc += ISIZE;
+	  break;
+
+	default:		/* The program counter has been changed */
+	  pc = state->Reg[15];
+#ifndef MODE32
+	  pc = pc & R15PCBITS;
+#endif
+	  ARMul_FlightRecord (state, pc, ARMUL_FLIGHT_BRANCH);
+	  state->Reg[15] = pc + (ISIZE * 2);
+	  state->Aborted = 0;
+	  break;
+	}
+      NORMALCYCLE;
+      instr = ARMul_LoadInstrS (state, pc, ISIZE);
+#endif
+      if (variant == EMU_DEBUG && state->EventSet)
 	ARMul_EnvokeEvent (state);
 
+      if (variant != EMU_FAST && state->Trace)
+	ARMul_TraceInstr (state, pc, instr);
+
 #if 1
-      if (state->verbose) {
+      if (variant != EMU_FAST && state->verbose) {
               /* Enable this for a helpful bit of debugging when tracing is needed.  */
               fprintf (stderr, "pc: %08x, instr: %08x\n", pc & ~1, instr);
               if (instr == 0) {
@@ -382,7 +445,7 @@ ARMul_Emulate26 (register ARMul_State * state)
       }
 #endif
 
-      if (state->Exception)
+      if (variant == EMU_DEBUG && state->Exception)
 	{			/* Any exceptions */
 	  if (state->NresetSig == LOW)
 	    {
@@ -401,7 +464,7 @@ ARMul_Emulate26 (register ARMul_State * state)
 	    }
 	}
 
-      if (state->CallDebug > 0)
+      if (variant == EMU_DEBUG && state->CallDebug > 0)
 	{
 	  instr = ARMul_Debug (state, pc, instr);
 	  if (state->Emulate < ONCE)
@@ -422,6 +485,8 @@ ARMul_Emulate26 (register ARMul_State * state)
 	  break;
 	}
 
+      if (state->NumInstrs >= state->NextEvent)
+	InstrEvents (state, pc, instr);
       state->NumInstrs++;
 
 #ifdef MODET
@@ -451,2434 +516,2323 @@ ARMul_Emulate26 (register ARMul_State * state)
 	}
 #endif
 
+#ifdef MODE32
+      ARMul_Execute32 (state, instr, pc);
+#else
+      ARMul_Execute26 (state, instr, pc);
+#endif
+
+#ifdef MODET
+    donext:
+#endif
+
+#ifdef NEED_UI_LOOP_HOOK
+      if (ui_loop_hook != NULL && ui_loop_hook_counter-- < 0)
+	{
+	  ui_loop_hook_counter = UI_LOOP_POLL_INTERVAL;
+	  ui_loop_hook (0);
+	}
+#endif /* NEED_UI_LOOP_HOOK */
+
+      if (state->Emulate == ONCE)
+	state->Emulate = STOP;
+      else if (state->Emulate != RUN)
+	break;
+    }
+  while (TRUE);			/* do loop */
+
+#ifdef ARMUL_CYCLES
+  state->decoded = decoded;
+  state->loaded = loaded;
+#endif
+  state->pc = pc;
+  return (pc);
+}				/* Emulate 26/32 in instruction based mode */
+
+#ifdef MODE32
+ARMword
+ARMul_Emulate32 (ARMul_State * state)
+{
+  return Emulate (state, EMU_DEBUG);
+}
+
+ARMword
+ARMul_Emulate32Trace (ARMul_State * state)
+{
+  return Emulate (state, EMU_TRACE);
+}
+
+ARMword
+ARMul_Emulate32Fast (ARMul_State * state)
+{
+  return Emulate (state, EMU_FAST);
+}
+#else
+ARMword
+ARMul_Emulate26 (ARMul_State * state)
+{
+  return Emulate (state, EMU_DEBUG);
+}
+
+ARMword
+ARMul_Emulate26Trace (ARMul_State * state)
+{
+  return Emulate (state, EMU_TRACE);
+}
+
+ARMword
+ARMul_Emulate26Fast (ARMul_State * state)
+{
+  return Emulate (state, EMU_FAST);
+}
+#endif
+
 /***************************************************************************\
-*                       Check the condition codes                           *
+* Execute one instruction that has already been fetched.  The caller must   *
+* have set Reg[15] to pc + 8 (pc + 4 for Thumb) and left NextInstr in a     *
+* normal state; on return NextInstr says how the pipeline should advance.   *
+* It is inlined into the loop above, and also called from armblock.c.       *
 \***************************************************************************/
-      if ((temp = TOPBITS (28)) == AL)
-	goto mainswitch;	/* vile deed in the need for speed */
 
-      switch ((int) TOPBITS (28))
-	{			/* check the condition code */
-	case AL:
-	  temp = TRUE;
-	  break;
-	case NV:
-	  temp = FALSE;
-	  break;
-	case EQ:
-	  temp = ZFLAG;
-	  break;
-	case NE:
-	  temp = !ZFLAG;
-	  break;
-	case VS:
-	  temp = VFLAG;
-	  break;
-	case VC:
-	  temp = !VFLAG;
-	  break;
-	case MI:
-	  temp = NFLAG;
-	  break;
-	case PL:
-	  temp = !NFLAG;
-	  break;
-	case CS:
-	  temp = CFLAG;
-	  break;
-	case CC:
-	  temp = !CFLAG;
-	  break;
-	case HI:
-	  temp = (CFLAG && !ZFLAG);
-	  break;
-	case LS:
-	  temp = (!CFLAG || ZFLAG);
-	  break;
-	case GE:
-	  temp = ((!NFLAG && !VFLAG) || (NFLAG && VFLAG));
-	  break;
-	case LT:
-	  temp = ((NFLAG && !VFLAG) || (!NFLAG && VFLAG));
-	  break;
-	case GT:
-	  temp = ((!NFLAG && !VFLAG && !ZFLAG) || (NFLAG && VFLAG && !ZFLAG));
-	  break;
-	case LE:
-	  temp = ((NFLAG && !VFLAG) || (!NFLAG && VFLAG)) || ZFLAG;
-	  break;
-	}			/* cc check */
+#ifdef MODE32
+inline __attribute__ ((always_inline)) void
+ARMul_Execute32 (ARMul_State * state, ARMword instr, ARMword pc)
+#else
+inline __attribute__ ((always_inline)) void
+ARMul_Execute26 (ARMul_State * state, ARMword instr, ARMword pc)
+#endif
+{
+  ARMword dest = 0,		/* almost the DestBus */
+    temp;			/* ubiquitous third hand */
+  ARMword lhs, rhs;		/* almost the ABus and BBus */
+
+/***************************************************************************\
+*                       Check the condition codes                           *
+\***************************************************************************/
+  if ((temp = TOPBITS (28)) == AL)
+    goto mainswitch;	/* vile deed in the need for speed */
+
+  switch ((int) TOPBITS (28))
+    {			/* check the condition code */
+    case AL:
+      temp = TRUE;
+      break;
+    case NV:
+      temp = FALSE;
+      break;
+    case EQ:
+      temp = ZFLAG;
+      break;
+    case NE:
+      temp = !ZFLAG;
+      break;
+    case VS:
+      temp = VFLAG;
+      break;
+    case VC:
+      temp = !VFLAG;
+      break;
+    case MI:
+      temp = NFLAG;
+      break;
+    case PL:
+      temp = !NFLAG;
+      break;
+    case CS:
+      temp = CFLAG;
+      break;
+    case CC:
+      temp = !CFLAG;
+      break;
+    case HI:
+      temp = (CFLAG && !ZFLAG);
+      break;
+    case LS:
+      temp = (!CFLAG || ZFLAG);
+      break;
+    case GE:
+      temp = ((!NFLAG && !VFLAG) || (NFLAG && VFLAG));
+      break;
+    case LT:
+      temp = ((NFLAG && !VFLAG) || (!NFLAG && VFLAG));
+      break;
+    case GT:
+      temp = ((!NFLAG && !VFLAG && !ZFLAG) || (NFLAG && VFLAG && !ZFLAG));
+      break;
+    case LE:
+      temp = ((NFLAG && !VFLAG) || (!NFLAG && VFLAG)) || ZFLAG;
+      break;
+    }			/* cc check */
 
 /***************************************************************************\
 *               Actual execution of instructions begins here                *
 \***************************************************************************/
 
-      if (temp)
-	{			/* if the condition codes don't match, stop here */
-	mainswitch:
+  if (temp)
+    {			/* if the condition codes don't match, stop here */
+    mainswitch:
 
 
-	  switch ((int) BITS (20, 27))
-	    {
+      switch ((int) BITS (20, 27))
+	{
 
 /***************************************************************************\
 *                 Data Processing Register RHS Instructions                 *
 \***************************************************************************/
 
-	    case 0x00:		/* AND reg and MUL */
+	case 0x00:		/* AND reg and MUL */
 #ifdef MODET
-	      if (BITS (4, 11) == 0xB)
-		{
-		  /* STRH register offset, no write-back, down, post indexed */
-		  SHDOWNWB ();
-		  break;
-		}
-	      /* TODO: CHECK: should 0xD and 0xF generate undefined intruction aborts? */
-#endif
-	      if (BITS (4, 7) == 9)
-		{		/* MUL */
-		  rhs = state->Reg[MULRHSReg];
-		  if (MULLHSReg == MULDESTReg)
-		    {
-		      UNDEF_MULDestEQOp1;
-		      state->Reg[MULDESTReg] = 0;
-		    }
-		  else if (MULDESTReg != 15)
-		    state->Reg[MULDESTReg] = state->Reg[MULLHSReg] * rhs;
-		  else
-		    {
-		      UNDEF_MULPCDest;
-		    }
-		  for (dest = 0, temp = 0; dest < 32; dest++)
-		    if (rhs & (1L << dest))
-		      temp = dest;	/* mult takes this many/2 I cycles */
-		  ARMul_Icycles (state, ARMul_MultTable[temp], 0L);
-		}
-	      else
-		{		/* AND reg */
-		  rhs = DPRegRHS;
-		  dest = LHS & rhs;
-		  WRITEDEST (dest);
-		}
+	  if (BITS (4, 11) == 0xB)
+	    {
+	      /* STRH register offset, no write-back, down, post indexed */
+	      SHDOWNWB ();
 	      break;
-
-	    case 0x01:		/* ANDS reg and MULS */
-#ifdef MODET
-	      if ((BITS (4, 11) & 0xF9) == 0x9)
-		{
-		  /* LDR register offset, no write-back, down, post indexed */
-		  LHPOSTDOWN ();
-		  /* fall through to rest of decoding */
-		}
+	    }
+	  /* TODO: CHECK: should 0xD and 0xF generate undefined intruction aborts? */
 #endif
-	      if (BITS (4, 7) == 9)
-		{		/* MULS */
-		  rhs = state->Reg[MULRHSReg];
-		  if (MULLHSReg == MULDESTReg)
-		    {
-		      UNDEF_MULDestEQOp1;
-		      state->Reg[MULDESTReg] = 0;
-		      CLEARN;
-		      SETZ;
-		    }
-		  else if (MULDESTReg != 15)
-		    {
-		      dest = state->Reg[MULLHSReg] * rhs;
-		      ARMul_NegZero (state, dest);
-		      state->Reg[MULDESTReg] = dest;
-		    }
-		  else
-		    {
-		      UNDEF_MULPCDest;
-		    }
-		  for (dest = 0, temp = 0; dest < 32; dest++)
-		    if (rhs & (1L << dest))
-		      temp = dest;	/* mult takes this many/2 I cycles */
-		  ARMul_Icycles (state, ARMul_MultTable[temp], 0L);
+	  if (BITS (4, 7) == 9)
+	    {		/* MUL */
+	      rhs = state->Reg[MULRHSReg];
+	      if (MULLHSReg == MULDESTReg)
+		{
+		  UNDEF_MULDestEQOp1;
+		  state->Reg[MULDESTReg] = 0;
 		}
+	      else if (MULDESTReg != 15)
+		state->Reg[MULDESTReg] = state->Reg[MULLHSReg] * rhs;
 	      else
-		{		/* ANDS reg */
-		  rhs = DPSRegRHS;
-		  dest = LHS & rhs;
-		  WRITESDEST (dest);
+		{
+		  UNDEF_MULPCDest;
 		}
-	      break;
+	      MULCYCLES (rhs);
+	    }
+	  else
+	    {		/* AND reg */
+	      rhs = DPRegRHS;
+	      dest = LHS & rhs;
+	      WRITEDEST (dest);
+	    }
+	  break;
 
-	    case 0x02:		/* EOR reg and MLA */
+	case 0x01:		/* ANDS reg and MULS */
 #ifdef MODET
-	      if (BITS (4, 11) == 0xB)
+	  if ((BITS (4, 11) & 0xF9) == 0x9)
+	    {
+	      /* LDR register offset, no write-back, down, post indexed */
+	      LHPOSTDOWN ();
+	      /* fall through to rest of decoding */
+	    }
+#endif
+	  if (BITS (4, 7) == 9)
+	    {		/* MULS */
+	      rhs = state->Reg[MULRHSReg];
+	      if (MULLHSReg == MULDESTReg)
 		{
-		  /* STRH register offset, write-back, down, post indexed */
-		  SHDOWNWB ();
-		  break;
+		  UNDEF_MULDestEQOp1;
+		  state->Reg[MULDESTReg] = 0;
+		  CLEARN;
+		  SETZ;
 		}
-#endif
-	      if (BITS (4, 7) == 9)
-		{		/* MLA */
-		  rhs = state->Reg[MULRHSReg];
-		  if (MULLHSReg == MULDESTReg)
-		    {
-		      UNDEF_MULDestEQOp1;
-		      state->Reg[MULDESTReg] = state->Reg[MULACCReg];
-		    }
-		  else if (MULDESTReg != 15)
-		    state->Reg[MULDESTReg] =
-		      state->Reg[MULLHSReg] * rhs + state->Reg[MULACCReg];
-		  else
-		    {
-		      UNDEF_MULPCDest;
-		    }
-		  for (dest = 0, temp = 0; dest < 32; dest++)
-		    if (rhs & (1L << dest))
-		      temp = dest;	/* mult takes this many/2 I cycles */
-		  ARMul_Icycles (state, ARMul_MultTable[temp], 0L);
+	      else if (MULDESTReg != 15)
+		{
+		  dest = state->Reg[MULLHSReg] * rhs;
+		  SETNZ (dest);
+		  state->Reg[MULDESTReg] = dest;
 		}
 	      else
 		{
-		  rhs = DPRegRHS;
-		  dest = LHS ^ rhs;
-		  WRITEDEST (dest);
+		  UNDEF_MULPCDest;
 		}
-	      break;
+	      MULCYCLES (rhs);
+	    }
+	  else
+	    {		/* ANDS reg */
+	      rhs = DPSRegRHS;
+	      dest = LHS & rhs;
+	      WRITESDEST (dest);
+	    }
+	  break;
 
-	    case 0x03:		/* EORS reg and MLAS */
+	case 0x02:		/* EOR reg and MLA */
 #ifdef MODET
-	      if ((BITS (4, 11) & 0xF9) == 0x9)
-		{
-		  /* LDR register offset, write-back, down, post-indexed */
-		  LHPOSTDOWN ();
-		  /* fall through to rest of the decoding */
-		}
+	  if (BITS (4, 11) == 0xB)
+	    {
+	      /* STRH register offset, write-back, down, post indexed */
+	      SHDOWNWB ();
+	      break;
+	    }
 #endif
-	      if (BITS (4, 7) == 9)
-		{		/* MLAS */
-		  rhs = state->Reg[MULRHSReg];
-		  if (MULLHSReg == MULDESTReg)
-		    {
-		      UNDEF_MULDestEQOp1;
-		      dest = state->Reg[MULACCReg];
-		      ARMul_NegZero (state, dest);
-		      state->Reg[MULDESTReg] = dest;
-		    }
-		  else if (MULDESTReg != 15)
-		    {
-		      dest =
-			state->Reg[MULLHSReg] * rhs + state->Reg[MULACCReg];
-		      ARMul_NegZero (state, dest);
-		      state->Reg[MULDESTReg] = dest;
-		    }
-		  else
-		    {
-		      UNDEF_MULPCDest;
-		    }
-		  for (dest = 0, temp = 0; dest < 32; dest++)
-		    if (rhs & (1L << dest))
-		      temp = dest;	/* mult takes this many/2 I cycles */
-		  ARMul_Icycles (state, ARMul_MultTable[temp], 0L);
+	  if (BITS (4, 7) == 9)
+	    {		/* MLA */
+	      rhs = state->Reg[MULRHSReg];
+	      if (MULLHSReg == MULDESTReg)
+		{
+		  UNDEF_MULDestEQOp1;
+		  state->Reg[MULDESTReg] = state->Reg[MULACCReg];
 		}
+	      else if (MULDESTReg != 15)
+		state->Reg[MULDESTReg] =
+		  state->Reg[MULLHSReg] * rhs + state->Reg[MULACCReg];
 	      else
-		{		/* EORS Reg */
-		  rhs = DPSRegRHS;
-		  dest = LHS ^ rhs;
-		  WRITESDEST (dest);
-		}
-	      break;
-
-	    case 0x04:		/* SUB reg */
-#ifdef MODET
-	      if (BITS (4, 7) == 0xB)
 		{
-		  /* STRH immediate offset, no write-back, down, post indexed */
-		  SHDOWNWB ();
-		  break;
+		  UNDEF_MULPCDest;
 		}
-#endif
+	      MULCYCLES (rhs);
+	    }
+	  else
+	    {
 	      rhs = DPRegRHS;
-	      dest = LHS - rhs;
+	      dest = LHS ^ rhs;
 	      WRITEDEST (dest);
-	      break;
+	    }
+	  break;
 
-	    case 0x05:		/* SUBS reg */
+	case 0x03:		/* EORS reg and MLAS */
 #ifdef MODET
-	      if ((BITS (4, 7) & 0x9) == 0x9)
+	  if ((BITS (4, 11) & 0xF9) == 0x9)
+	    {
+	      /* LDR register offset, write-back, down, post-indexed */
+	      LHPOSTDOWN ();
+	      /* fall through to rest of the decoding */
+	    }
+#endif
+	  if (BITS (4, 7) == 9)
+	    {		/* MLAS */
+	      rhs = state->Reg[MULRHSReg];
+	      if (MULLHSReg == MULDESTReg)
 		{
-		  /* LDR immediate offset, no write-back, down, post indexed */
-		  LHPOSTDOWN ();
-		  /* fall through to the rest of the instruction decoding */
+		  UNDEF_MULDestEQOp1;
+		  dest = state->Reg[MULACCReg];
+		  SETNZ (dest);
+		  state->Reg[MULDESTReg] = dest;
 		}
-#endif
-	      lhs = LHS;
-	      rhs = DPRegRHS;
-	      dest = lhs - rhs;
-	      if ((lhs >= rhs) || ((rhs | lhs) >> 31))
+	      else if (MULDESTReg != 15)
 		{
-		  ARMul_SubCarry (state, lhs, rhs, dest);
-		  ARMul_SubOverflow (state, lhs, rhs, dest);
+		  dest =
+		    state->Reg[MULLHSReg] * rhs + state->Reg[MULACCReg];
+		  SETNZ (dest);
+		  state->Reg[MULDESTReg] = dest;
 		}
 	      else
 		{
-		  CLEARC;
-		  CLEARV;
+		  UNDEF_MULPCDest;
 		}
+	      MULCYCLES (rhs);
+	    }
+	  else
+	    {		/* EORS Reg */
+	      rhs = DPSRegRHS;
+	      dest = LHS ^ rhs;
 	      WRITESDEST (dest);
-	      break;
+	    }
+	  break;
 
-	    case 0x06:		/* RSB reg */
+	case 0x04:		/* SUB reg */
 #ifdef MODET
-	      if (BITS (4, 7) == 0xB)
-		{
-		  /* STRH immediate offset, write-back, down, post indexed */
-		  SHDOWNWB ();
-		  break;
-		}
-#endif
-	      rhs = DPRegRHS;
-	      dest = rhs - LHS;
-	      WRITEDEST (dest);
+	  if (BITS (4, 7) == 0xB)
+	    {
+	      /* STRH immediate offset, no write-back, down, post indexed */
+	      SHDOWNWB ();
 	      break;
+	    }
+#endif
+	  rhs = DPRegRHS;
+	  dest = LHS - rhs;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x07:		/* RSBS reg */
+	case 0x05:		/* SUBS reg */
 #ifdef MODET
-	      if ((BITS (4, 7) & 0x9) == 0x9)
-		{
-		  /* LDR immediate offset, write-back, down, post indexed */
-		  LHPOSTDOWN ();
-		  /* fall through to remainder of instruction decoding */
-		}
+	  if ((BITS (4, 7) & 0x9) == 0x9)
+	    {
+	      /* LDR immediate offset, no write-back, down, post indexed */
+	      LHPOSTDOWN ();
+	      /* fall through to the rest of the instruction decoding */
+	    }
 #endif
-	      lhs = LHS;
-	      rhs = DPRegRHS;
-	      dest = rhs - lhs;
-	      if ((rhs >= lhs) || ((rhs | lhs) >> 31))
-		{
-		  ARMul_SubCarry (state, rhs, lhs, dest);
-		  ARMul_SubOverflow (state, rhs, lhs, dest);
-		}
-	      else
-		{
-		  CLEARC;
-		  CLEARV;
-		}
-	      WRITESDEST (dest);
-	      break;
+	  lhs = LHS;
+	  rhs = DPRegRHS;
+	  dest = lhs - rhs;
+	  WRITESUBDEST (lhs, rhs, dest);
+	  break;
 
-	    case 0x08:		/* ADD reg */
+	case 0x06:		/* RSB reg */
 #ifdef MODET
-	      if (BITS (4, 11) == 0xB)
-		{
-		  /* STRH register offset, no write-back, up, post indexed */
-		  SHUPWB ();
-		  break;
-		}
+	  if (BITS (4, 7) == 0xB)
+	    {
+	      /* STRH immediate offset, write-back, down, post indexed */
+	      SHDOWNWB ();
+	      break;
+	    }
 #endif
+	  rhs = DPRegRHS;
+	  dest = rhs - LHS;
+	  WRITEDEST (dest);
+	  break;
+
+	case 0x07:		/* RSBS reg */
 #ifdef MODET
-	      if (BITS (4, 7) == 0x9)
-		{		/* MULL */
-		  /* 32x32 = 64 */
-		  ARMul_Icycles (state,
-				 Multiply64 (state, instr, LUNSIGNED,
-					     LDEFAULT), 0L);
-		  break;
-		}
+	  if ((BITS (4, 7) & 0x9) == 0x9)
+	    {
+	      /* LDR immediate offset, write-back, down, post indexed */
+	      LHPOSTDOWN ();
+	      /* fall through to remainder of instruction decoding */
+	    }
 #endif
-	      rhs = DPRegRHS;
-	      dest = LHS + rhs;
-	      WRITEDEST (dest);
-	      break;
+	  lhs = LHS;
+	  rhs = DPRegRHS;
+	  dest = rhs - lhs;
+	  WRITESUBDEST (rhs, lhs, dest);
+	  break;
 
-	    case 0x09:		/* ADDS reg */
+	case 0x08:		/* ADD reg */
 #ifdef MODET
-	      if ((BITS (4, 11) & 0xF9) == 0x9)
-		{
-		  /* LDR register offset, no write-back, up, post indexed */
-		  LHPOSTUP ();
-		  /* fall through to remaining instruction decoding */
-		}
+	  if (BITS (4, 11) == 0xB)
+	    {
+	      /* STRH register offset, no write-back, up, post indexed */
+	      SHUPWB ();
+	      break;
+	    }
 #endif
 #ifdef MODET
-	      if (BITS (4, 7) == 0x9)
-		{		/* MULL */
-		  /* 32x32=64 */
-		  ARMul_Icycles (state,
-				 Multiply64 (state, instr, LUNSIGNED, LSCC),
-				 0L);
-		  break;
-		}
-#endif
-	      lhs = LHS;
-	      rhs = DPRegRHS;
-	      dest = lhs + rhs;
-	      ASSIGNZ (dest == 0);
-	      if ((lhs | rhs) >> 30)
-		{		/* possible C,V,N to set */
-		  ASSIGNN (NEG (dest));
-		  ARMul_AddCarry (state, lhs, rhs, dest);
-		  ARMul_AddOverflow (state, lhs, rhs, dest);
-		}
-	      else
-		{
-		  CLEARN;
-		  CLEARC;
-		  CLEARV;
-		}
-	      WRITESDEST (dest);
+	  if (BITS (4, 7) == 0x9)
+	    {		/* MULL */
+	      /* 32x32 = 64 */
+	      ARMul_Icycles (state,
+			     Multiply64 (state, instr, LUNSIGNED,
+					 LDEFAULT), 0L);
 	      break;
+	    }
+#endif
+	  rhs = DPRegRHS;
+	  dest = LHS + rhs;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x0a:		/* ADC reg */
+	case 0x09:		/* ADDS reg */
 #ifdef MODET
-	      if (BITS (4, 11) == 0xB)
-		{
-		  /* STRH register offset, write-back, up, post-indexed */
-		  SHUPWB ();
-		  break;
-		}
+	  if ((BITS (4, 11) & 0xF9) == 0x9)
+	    {
+	      /* LDR register offset, no write-back, up, post indexed */
+	      LHPOSTUP ();
+	      /* fall through to remaining instruction decoding */
+	    }
 #endif
 #ifdef MODET
-	      if (BITS (4, 7) == 0x9)
-		{		/* MULL */
-		  /* 32x32=64 */
-		  ARMul_Icycles (state,
-				 MultiplyAdd64 (state, instr, LUNSIGNED,
-						LDEFAULT), 0L);
-		  break;
-		}
-#endif
-	      rhs = DPRegRHS;
-	      dest = LHS + rhs + CFLAG;
-	      WRITEDEST (dest);
+	  if (BITS (4, 7) == 0x9)
+	    {		/* MULL */
+	      /* 32x32=64 */
+	      ARMul_Icycles (state,
+			     Multiply64 (state, instr, LUNSIGNED, LSCC),
+			     0L);
 	      break;
+	    }
+#endif
+	  lhs = LHS;
+	  rhs = DPRegRHS;
+	  dest = lhs + rhs;
+	  WRITEADDDEST (lhs, rhs, dest);
+	  break;
 
-	    case 0x0b:		/* ADCS reg */
+	case 0x0a:		/* ADC reg */
 #ifdef MODET
-	      if ((BITS (4, 11) & 0xF9) == 0x9)
-		{
-		  /* LDR register offset, write-back, up, post indexed */
-		  LHPOSTUP ();
-		  /* fall through to remaining instruction decoding */
-		}
+	  if (BITS (4, 11) == 0xB)
+	    {
+	      /* STRH register offset, write-back, up, post-indexed */
+	      SHUPWB ();
+	      break;
+	    }
 #endif
 #ifdef MODET
-	      if (BITS (4, 7) == 0x9)
-		{		/* MULL */
-		  /* 32x32=64 */
-		  ARMul_Icycles (state,
-				 MultiplyAdd64 (state, instr, LUNSIGNED,
-						LSCC), 0L);
-		  break;
-		}
-#endif
-	      lhs = LHS;
-	      rhs = DPRegRHS;
-	      dest = lhs + rhs + CFLAG;
-	      ASSIGNZ (dest == 0);
-	      if ((lhs | rhs) >> 30)
-		{		/* possible C,V,N to set */
-		  ASSIGNN (NEG (dest));
-		  ARMul_AddCarry (state, lhs, rhs, dest);
-		  ARMul_AddOverflow (state, lhs, rhs, dest);
-		}
-	      else
-		{
-		  CLEARN;
-		  CLEARC;
-		  CLEARV;
-		}
-	      WRITESDEST (dest);
+	  if (BITS (4, 7) == 0x9)
+	    {		/* MULL */
+	      /* 32x32=64 */
+	      ARMul_Icycles (state,
+			     MultiplyAdd64 (state, instr, LUNSIGNED,
+					    LDEFAULT), 0L);
 	      break;
+	    }
+#endif
+	  rhs = DPRegRHS;
+	  dest = LHS + rhs + CFLAG;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x0c:		/* SBC reg */
+	case 0x0b:		/* ADCS reg */
 #ifdef MODET
-	      if (BITS (4, 7) == 0xB)
-		{
-		  /* STRH immediate offset, no write-back, up post indexed */
-		  SHUPWB ();
-		  break;
-		}
+	  if ((BITS (4, 11) & 0xF9) == 0x9)
+	    {
+	      /* LDR register offset, write-back, up, post indexed */
+	      LHPOSTUP ();
+	      /* fall through to remaining instruction decoding */
+	    }
 #endif
 #ifdef MODET
-	      if (BITS (4, 7) == 0x9)
-		{		/* MULL */
-		  /* 32x32=64 */
-		  ARMul_Icycles (state,
-				 Multiply64 (state, instr, LSIGNED, LDEFAULT),
-				 0L);
-		  break;
-		}
-#endif
-	      rhs = DPRegRHS;
-	      dest = LHS - rhs - !CFLAG;
-	      WRITEDEST (dest);
+	  if (BITS (4, 7) == 0x9)
+	    {		/* MULL */
+	      /* 32x32=64 */
+	      ARMul_Icycles (state,
+			     MultiplyAdd64 (state, instr, LUNSIGNED,
+					    LSCC), 0L);
 	      break;
+	    }
+#endif
+	  lhs = LHS;
+	  rhs = DPRegRHS;
+	  dest = lhs + rhs + CFLAG;
+	  WRITEADDDEST (lhs, rhs, dest);
+	  break;
 
-	    case 0x0d:		/* SBCS reg */
+	case 0x0c:		/* SBC reg */
 #ifdef MODET
-	      if ((BITS (4, 7) & 0x9) == 0x9)
-		{
-		  /* LDR immediate offset, no write-back, up, post indexed */
-		  LHPOSTUP ();
-		}
+	  if (BITS (4, 7) == 0xB)
+	    {
+	      /* STRH immediate offset, no write-back, up post indexed */
+	      SHUPWB ();
+	      break;
+	    }
 #endif
 #ifdef MODET
-	      if (BITS (4, 7) == 0x9)
-		{		/* MULL */
-		  /* 32x32=64 */
-		  ARMul_Icycles (state,
-				 Multiply64 (state, instr, LSIGNED, LSCC),
-				 0L);
-		  break;
-		}
-#endif
-	      lhs = LHS;
-	      rhs = DPRegRHS;
-	      dest = lhs - rhs - !CFLAG;
-	      if ((lhs >= rhs) || ((rhs | lhs) >> 31))
-		{
-		  ARMul_SubCarry (state, lhs, rhs, dest);
-		  ARMul_SubOverflow (state, lhs, rhs, dest);
-		}
-	      else
-		{
-		  CLEARC;
-		  CLEARV;
-		}
-	      WRITESDEST (dest);
+	  if (BITS (4, 7) == 0x9)
+	    {		/* MULL */
+	      /* 32x32=64 */
+	      ARMul_Icycles (state,
+			     Multiply64 (state, instr, LSIGNED, LDEFAULT),
+			     0L);
 	      break;
+	    }
+#endif
+	  rhs = DPRegRHS;
+	  dest = LHS - rhs - !CFLAG;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x0e:		/* RSC reg */
+	case 0x0d:		/* SBCS reg */
 #ifdef MODET
-	      if (BITS (4, 7) == 0xB)
-		{
-		  /* STRH immediate offset, write-back, up, post indexed */
-		  SHUPWB ();
-		  break;
-		}
+	  if ((BITS (4, 7) & 0x9) == 0x9)
+	    {
+	      /* LDR immediate offset, no write-back, up, post indexed */
+	      LHPOSTUP ();
+	    }
 #endif
 #ifdef MODET
-	      if (BITS (4, 7) == 0x9)
-		{		/* MULL */
-		  /* 32x32=64 */
-		  ARMul_Icycles (state,
-				 MultiplyAdd64 (state, instr, LSIGNED,
-						LDEFAULT), 0L);
-		  break;
-		}
-#endif
-	      rhs = DPRegRHS;
-	      dest = rhs - LHS - !CFLAG;
-	      WRITEDEST (dest);
+	  if (BITS (4, 7) == 0x9)
+	    {		/* MULL */
+	      /* 32x32=64 */
+	      ARMul_Icycles (state,
+			     Multiply64 (state, instr, LSIGNED, LSCC),
+			     0L);
 	      break;
+	    }
+#endif
+	  lhs = LHS;
+	  rhs = DPRegRHS;
+	  dest = lhs - rhs - !CFLAG;
+	  WRITESUBDEST (lhs, rhs, dest);
+	  break;
 
-	    case 0x0f:		/* RSCS reg */
+	case 0x0e:		/* RSC reg */
 #ifdef MODET
-	      if ((BITS (4, 7) & 0x9) == 0x9)
-		{
-		  /* LDR immediate offset, write-back, up, post indexed */
-		  LHPOSTUP ();
-		  /* fall through to remaining instruction decoding */
-		}
+	  if (BITS (4, 7) == 0xB)
+	    {
+	      /* STRH immediate offset, write-back, up, post indexed */
+	      SHUPWB ();
+	      break;
+	    }
 #endif
 #ifdef MODET
-	      if (BITS (4, 7) == 0x9)
-		{		/* MULL */
-		  /* 32x32=64 */
-		  ARMul_Icycles (state,
-				 MultiplyAdd64 (state, instr, LSIGNED, LSCC),
-				 0L);
-		  break;
-		}
+	  if (BITS (4, 7) == 0x9)
+	    {		/* MULL */
+	      /* 32x32=64 */
+	      ARMul_Icycles (state,
+			     MultiplyAdd64 (state, instr, LSIGNED,
+					    LDEFAULT), 0L);
+	      break;
+	    }
 #endif
-	      lhs = LHS;
-	      rhs = DPRegRHS;
-	      dest = rhs - lhs - !CFLAG;
-	      if ((rhs >= lhs) || ((rhs | lhs) >> 31))
-		{
-		  ARMul_SubCarry (state, rhs, lhs, dest);
-		  ARMul_SubOverflow (state, rhs, lhs, dest);
-		}
-	      else
-		{
-		  CLEARC;
-		  CLEARV;
-		}
-	      WRITESDEST (dest);
+	  rhs = DPRegRHS;
+	  dest = rhs - LHS - !CFLAG;
+	  WRITEDEST (dest);
+	  break;
+
+	case 0x0f:		/* RSCS reg */
+#ifdef MODET
+	  if ((BITS (4, 7) & 0x9) == 0x9)
+	    {
+	      /* LDR immediate offset, write-back, up, post indexed */
+	      LHPOSTUP ();
+	      /* fall through to remaining instruction decoding */
+	    }
+#endif
+#ifdef MODET
+	  if (BITS (4, 7) == 0x9)
+	    {		/* MULL */
+	      /* 32x32=64 */
+	      ARMul_Icycles (state,
+			     MultiplyAdd64 (state, instr, LSIGNED, LSCC),
+			     0L);
 	      break;
+	    }
+#endif
+	  lhs = LHS;
+	  rhs = DPRegRHS;
+	  dest = rhs - lhs - !CFLAG;
+	  WRITESUBDEST (rhs, lhs, dest);
+	  break;
 
-	    case 0x10:		/* TST reg and MRS CPSR and SWP word */
+	case 0x10:		/* TST reg and MRS CPSR and SWP word */
 #ifdef MODET
-	      if (BITS (4, 11) == 0xB)
-		{
-		  /* STRH register offset, no write-back, down, pre indexed */
-		  SHPREDOWN ();
-		  break;
-		}
+	  if (BITS (4, 11) == 0xB)
+	    {
+	      /* STRH register offset, no write-back, down, pre indexed */
+	      SHPREDOWN ();
+	      break;
+	    }
 #endif
-	      if (BITS (4, 11) == 9)
-		{		/* SWP */
-		  UNDEF_SWPPC;
-		  temp = LHS;
-		  BUSUSEDINCPCS;
+	  if (BITS (4, 11) == 9)
+	    {		/* SWP */
+	      UNDEF_SWPPC;
+	      temp = LHS;
+	      BUSUSEDINCPCS;
 #ifndef MODE32
-		  if (VECTORACCESS (temp) || ADDREXCEPT (temp))
-		    {
-		      INTERNALABORT (temp);
-		      (void) ARMul_LoadWordN (state, temp);
-		      (void) ARMul_LoadWordN (state, temp);
-		    }
-		  else
-#endif
-		    dest = ARMul_SwapWord (state, temp, state->Reg[RHSReg]);
-		  if (temp & 3)
-		    DEST = ARMul_Align (state, temp, dest);
-		  else
-		    DEST = dest;
-		  if (state->abortSig || state->Aborted)
-		    {
-		      TAKEABORT;
-		    }
-		}
-	      else if ((BITS (0, 11) == 0) && (LHSReg == 15))
-		{		/* MRS CPSR */
-		  UNDEF_MRSPC;
-		  DEST = ECC | EINT | EMODE;
+	      if (VECTORACCESS (temp) || ADDREXCEPT (temp))
+		{
+		  INTERNALABORT (temp);
+		  (void) ARMul_LoadWordN (state, temp);
+		  (void) ARMul_LoadWordN (state, temp);
 		}
 	      else
+#endif
+		dest = ARMul_SwapWord (state, temp, state->Reg[RHSReg]);
+	      if (temp & 3)
+		DEST = ARMul_Align (state, temp, dest);
+	      else
+		DEST = dest;
+	      if (state->abortSig || state->Aborted)
 		{
-		  UNDEF_Test;
+		  TAKEABORT;
 		}
-	      break;
+	    }
+	  else if ((BITS (0, 11) == 0) && (LHSReg == 15))
+	    {		/* MRS CPSR */
+	      UNDEF_MRSPC;
+	      DEST = ECC | EINT | EMODE;
+	    }
+	  else
+	    {
+	      UNDEF_Test;
+	    }
+	  break;
 
-	    case 0x11:		/* TSTP reg */
+	case 0x11:		/* TSTP reg */
 #ifdef MODET
-	      if ((BITS (4, 11) & 0xF9) == 0x9)
-		{
-		  /* LDR register offset, no write-back, down, pre indexed */
-		  LHPREDOWN ();
-		  /* continue with remaining instruction decode */
-		}
+	  if ((BITS (4, 11) & 0xF9) == 0x9)
+	    {
+	      /* LDR register offset, no write-back, down, pre indexed */
+	      LHPREDOWN ();
+	      /* continue with remaining instruction decode */
+	    }
 #endif
-	      if (DESTReg == 15)
-		{		/* TSTP reg */
+	  if (DESTReg == 15)
+	    {		/* TSTP reg */
 #ifdef MODE32
-		  state->Cpsr = GETSPSR (state->Bank);
-		  ARMul_CPSRAltered (state);
+	      state->Cpsr = GETSPSR (state->Bank);
+	      ARMul_CPSRAltered (state);
 #else
-		  rhs = DPRegRHS;
-		  temp = LHS & rhs;
-		  SETR15PSR (temp);
+	      rhs = DPRegRHS;
+	      temp = LHS & rhs;
+	      SETR15PSR (temp);
 #endif
-		}
-	      else
-		{		/* TST reg */
-		  rhs = DPSRegRHS;
-		  dest = LHS & rhs;
-		  ARMul_NegZero (state, dest);
-		}
-	      break;
+	    }
+	  else
+	    {		/* TST reg */
+	      rhs = DPSRegRHS;
+	      dest = LHS & rhs;
+	      SETNZ (dest);
+	    }
+	  break;
 
-	    case 0x12:		/* TEQ reg and MSR reg to CPSR (ARM6) */
+	case 0x12:		/* TEQ reg and MSR reg to CPSR (ARM6) */
 #ifdef MODET
-	      if (BITS (4, 11) == 0xB)
-		{
-		  /* STRH register offset, write-back, down, pre indexed */
-		  SHPREDOWNWB ();
-		  break;
-		}
+	  if (BITS (4, 11) == 0xB)
+	    {
+	      /* STRH register offset, write-back, down, pre indexed */
+	      SHPREDOWNWB ();
+	      break;
+	    }
 #endif
 #ifdef MODET
-	      if (BITS (4, 27) == 0x12FFF1)
-		{		/* BX */
-		  /* Branch to the address in RHSReg. If bit0 of
-		     destination address is 1 then switch to Thumb mode: */
-		  ARMword addr = state->Reg[RHSReg];
-
-		  /* If we read the PC then the bottom bit is clear */
-		  if (RHSReg == 15)
-		    addr &= ~1;
-
-		  /* Enable this for a helpful bit of debugging when
-		     GDB is not yet fully working... 
-		     fprintf (stderr, "BX at %x to %x (go %s)\n",
-		     state->Reg[15], addr, (addr & 1) ? "thumb": "arm" ); */
-
-		  if (addr & (1 << 0))
-		    {		/* Thumb bit */
-		      SETT;
-		      state->Reg[15] = addr & 0xfffffffe;
-		      /* NOTE: The other CPSR flag setting blocks do not
-		         seem to update the state->Cpsr state, but just do
-		         the explicit flag. The copy from the seperate
-		         flags to the register must happen later. */
-		      FLUSHPIPE;
-		    }
-		  else
-		    {
-		      CLEART;
-		      state->Reg[15] = addr & 0xfffffffc;
-		      FLUSHPIPE;
-		    }
-		}
-#endif
-	      if (DESTReg == 15 && BITS (17, 18) == 0)
-		{		/* MSR reg to CPSR */
-		  UNDEF_MSRPC;
-		  temp = DPRegRHS;
-		  ARMul_FixCPSR (state, instr, temp);
+	  if (BITS (4, 27) == 0x12FFF1)
+	    {		/* BX */
+	      /* Branch to the address in RHSReg. If bit0 of
+		 destination address is 1 then switch to Thumb mode: */
+	      ARMword addr = state->Reg[RHSReg];
+
+	      /* If we read the PC then the bottom bit is clear */
+	      if (RHSReg == 15)
+		addr &= ~1;
+
+	      /* Enable this for a helpful bit of debugging when
+		 GDB is not yet fully working... 
+		 fprintf (stderr, "BX at %x to %x (go %s)\n",
+		 state->Reg[15], addr, (addr & 1) ? "thumb": "arm" ); */
+
+	      if (addr & (1 << 0))
+		{		/* Thumb bit */
+		  SETT;
+		  state->Reg[15] = addr & 0xfffffffe;
+		  /* NOTE: The other CPSR flag setting blocks do not
+		     seem to update the state->Cpsr state, but just do
+		     the explicit flag. The copy from the seperate
+		     flags to the register must happen later. */
+		  FLUSHPIPE;
 		}
 	      else
 		{
-		  UNDEF_Test;
+		  CLEART;
+		  state->Reg[15] = addr & 0xfffffffc;
+		  FLUSHPIPE;
 		}
-	      break;
+	    }
+#endif
+	  if (DESTReg == 15 && BITS (17, 18) == 0)
+	    {		/* MSR reg to CPSR */
+	      UNDEF_MSRPC;
+	      temp = DPRegRHS;
+	      ARMul_FixCPSR (state, instr, temp);
+	    }
+	  else
+	    {
+	      UNDEF_Test;
+	    }
+	  break;
 
-	    case 0x13:		/* TEQP reg */
+	case 0x13:		/* TEQP reg */
 #ifdef MODET
-	      if ((BITS (4, 11) & 0xF9) == 0x9)
-		{
-		  /* LDR register offset, write-back, down, pre indexed */
-		  LHPREDOWNWB ();
-		  /* continue with remaining instruction decode */
-		}
+	  if ((BITS (4, 11) & 0xF9) == 0x9)
+	    {
+	      /* LDR register offset, write-back, down, pre indexed */
+	      LHPREDOWNWB ();
+	      /* continue with remaining instruction decode */
+	    }
 #endif
-	      if (DESTReg == 15)
-		{		/* TEQP reg */
+	  if (DESTReg == 15)
+	    {		/* TEQP reg */
 #ifdef MODE32
-		  state->Cpsr = GETSPSR (state->Bank);
-		  ARMul_CPSRAltered (state);
+	      state->Cpsr = GETSPSR (state->Bank);
+	      ARMul_CPSRAltered (state);
 #else
-		  rhs = DPRegRHS;
-		  temp = LHS ^ rhs;
-		  SETR15PSR (temp);
+	      rhs = DPRegRHS;
+	      temp = LHS ^ rhs;
+	      SETR15PSR (temp);
 #endif
-		}
-	      else
-		{		/* TEQ Reg */
-		  rhs = DPSRegRHS;
-		  dest = LHS ^ rhs;
-		  ARMul_NegZero (state, dest);
-		}
-	      break;
+	    }
+	  else
+	    {		/* TEQ Reg */
+	      rhs = DPSRegRHS;
+	      dest = LHS ^ rhs;
+	      SETNZ (dest);
+	    }
+	  break;
 
-	    case 0x14:		/* CMP reg and MRS SPSR and SWP byte */
+	case 0x14:		/* CMP reg and MRS SPSR and SWP byte */
 #ifdef MODET
-	      if (BITS (4, 7) == 0xB)
-		{
-		  /* STRH immediate offset, no write-back, down, pre indexed */
-		  SHPREDOWN ();
-		  break;
-		}
+	  if (BITS (4, 7) == 0xB)
+	    {
+	      /* STRH immediate offset, no write-back, down, pre indexed */
+	      SHPREDOWN ();
+	      break;
+	    }
 #endif
-	      if (BITS (4, 11) == 9)
-		{		/* SWP */
-		  UNDEF_SWPPC;
-		  temp = LHS;
-		  BUSUSEDINCPCS;
+	  if (BITS (4, 11) == 9)
+	    {		/* SWP */
+	      UNDEF_SWPPC;
+	      temp = LHS;
+	      BUSUSEDINCPCS;
 #ifndef MODE32
-		  if (VECTORACCESS (temp) || ADDREXCEPT (temp))
-		    {
-		      INTERNALABORT (temp);
-		      (void) ARMul_LoadByte (state, temp);
-		      (void) ARMul_LoadByte (state, temp);
-		    }
-		  else
-#endif
-		    DEST = ARMul_SwapByte (state, temp, state->Reg[RHSReg]);
-		  if (state->abortSig || state->Aborted)
-		    {
-		      TAKEABORT;
-		    }
-		}
-	      else if ((BITS (0, 11) == 0) && (LHSReg == 15))
-		{		/* MRS SPSR */
-		  UNDEF_MRSPC;
-		  DEST = GETSPSR (state->Bank);
+	      if (VECTORACCESS (temp) || ADDREXCEPT (temp))
+		{
+		  INTERNALABORT (temp);
+		  (void) ARMul_LoadByte (state, temp);
+		  (void) ARMul_LoadByte (state, temp);
 		}
 	      else
+#endif
+		DEST = ARMul_SwapByte (state, temp, state->Reg[RHSReg]);
+	      if (state->abortSig || state->Aborted)
 		{
-		  UNDEF_Test;
+		  TAKEABORT;
 		}
-	      break;
+	    }
+	  else if ((BITS (0, 11) == 0) && (LHSReg == 15))
+	    {		/* MRS SPSR */
+	      UNDEF_MRSPC;
+	      DEST = GETSPSR (state->Bank);
+	    }
+	  else
+	    {
+	      UNDEF_Test;
+	    }
+	  break;
 
-	    case 0x15:		/* CMPP reg */
+	case 0x15:		/* CMPP reg */
 #ifdef MODET
-	      if ((BITS (4, 7) & 0x9) == 0x9)
-		{
-		  /* LDR immediate offset, no write-back, down, pre indexed */
-		  LHPREDOWN ();
-		  /* continue with remaining instruction decode */
-		}
+	  if ((BITS (4, 7) & 0x9) == 0x9)
+	    {
+	      /* LDR immediate offset, no write-back, down, pre indexed */
+	      LHPREDOWN ();
+	      /* continue with remaining instruction decode */
+	    }
 #endif
-	      if (DESTReg == 15)
-		{		/* CMPP reg */
+	  if (DESTReg == 15)
+	    {		/* CMPP reg */
 #ifdef MODE32
-		  state->Cpsr = GETSPSR (state->Bank);
-		  ARMul_CPSRAltered (state);
+	      state->Cpsr = GETSPSR (state->Bank);
+	      ARMul_CPSRAltered (state);
 #else
-		  rhs = DPRegRHS;
-		  temp = LHS - rhs;
-		  SETR15PSR (temp);
+	      rhs = DPRegRHS;
+	      temp = LHS - rhs;
+	      SETR15PSR (temp);
 #endif
-		}
-	      else
-		{		/* CMP reg */
-		  lhs = LHS;
-		  rhs = DPRegRHS;
-		  dest = lhs - rhs;
-		  ARMul_NegZero (state, dest);
-		  if ((lhs >= rhs) || ((rhs | lhs) >> 31))
-		    {
-		      ARMul_SubCarry (state, lhs, rhs, dest);
-		      ARMul_SubOverflow (state, lhs, rhs, dest);
-		    }
-		  else
-		    {
-		      CLEARC;
-		      CLEARV;
-		    }
-		}
-	      break;
+	    }
+	  else
+	    {		/* CMP reg */
+	      lhs = LHS;
+	      rhs = DPRegRHS;
+	      dest = lhs - rhs;
+	      SETSUB (lhs, rhs, dest);
+	    }
+	  break;
 
-	    case 0x16:		/* CMN reg and MSR reg to SPSR */
+	case 0x16:		/* CMN reg and MSR reg to SPSR */
 #ifdef MODET
-	      if (BITS (4, 7) == 0xB)
-		{
-		  /* STRH immediate offset, write-back, down, pre indexed */
-		  SHPREDOWNWB ();
-		  break;
-		}
-#endif
-	      if (DESTReg == 15 && BITS (17, 18) == 0)
-		{		/* MSR */
-		  UNDEF_MSRPC;
-		  ARMul_FixSPSR (state, instr, DPRegRHS);
-		}
-	      else
-		{
-		  UNDEF_Test;
-		}
+	  if (BITS (4, 7) == 0xB)
+	    {
+	      /* STRH immediate offset, write-back, down, pre indexed */
+	      SHPREDOWNWB ();
 	      break;
+	    }
+#endif
+	  if (DESTReg == 15 && BITS (17, 18) == 0)
+	    {		/* MSR */
+	      UNDEF_MSRPC;
+	      ARMul_FixSPSR (state, instr, DPRegRHS);
+	    }
+	  else
+	    {
+	      UNDEF_Test;
+	    }
+	  break;
 
-	    case 0x17:		/* CMNP reg */
+	case 0x17:		/* CMNP reg */
 #ifdef MODET
-	      if ((BITS (4, 7) & 0x9) == 0x9)
-		{
-		  /* LDR immediate offset, write-back, down, pre indexed */
-		  LHPREDOWNWB ();
-		  /* continue with remaining instruction decoding */
-		}
+	  if ((BITS (4, 7) & 0x9) == 0x9)
+	    {
+	      /* LDR immediate offset, write-back, down, pre indexed */
+	      LHPREDOWNWB ();
+	      /* continue with remaining instruction decoding */
+	    }
 #endif
-	      if (DESTReg == 15)
-		{
+	  if (DESTReg == 15)
+	    {
 #ifdef MODE32
-		  state->Cpsr = GETSPSR (state->Bank);
-		  ARMul_CPSRAltered (state);
+	      state->Cpsr = GETSPSR (state->Bank);
+	      ARMul_CPSRAltered (state);
 #else
-		  rhs = DPRegRHS;
-		  temp = LHS + rhs;
-		  SETR15PSR (temp);
+	      rhs = DPRegRHS;
+	      temp = LHS + rhs;
+	      SETR15PSR (temp);
 #endif
-		  break;
-		}
-	      else
-		{		/* CMN reg */
-		  lhs = LHS;
-		  rhs = DPRegRHS;
-		  dest = lhs + rhs;
-		  ASSIGNZ (dest == 0);
-		  if ((lhs | rhs) >> 30)
-		    {		/* possible C,V,N to set */
-		      ASSIGNN (NEG (dest));
-		      ARMul_AddCarry (state, lhs, rhs, dest);
-		      ARMul_AddOverflow (state, lhs, rhs, dest);
-		    }
-		  else
-		    {
-		      CLEARN;
-		      CLEARC;
-		      CLEARV;
-		    }
-		}
 	      break;
+	    }
+	  else
+	    {		/* CMN reg */
+	      lhs = LHS;
+	      rhs = DPRegRHS;
+	      dest = lhs + rhs;
+	      SETADD (lhs, rhs, dest);
+	    }
+	  break;
 
-	    case 0x18:		/* ORR reg */
+	case 0x18:		/* ORR reg */
 #ifdef MODET
-	      if (BITS (4, 11) == 0xB)
-		{
-		  /* STRH register offset, no write-back, up, pre indexed */
-		  SHPREUP ();
-		  break;
-		}
-#endif
-	      rhs = DPRegRHS;
-	      dest = LHS | rhs;
-	      WRITEDEST (dest);
+	  if (BITS (4, 11) == 0xB)
+	    {
+	      /* STRH register offset, no write-back, up, pre indexed */
+	      SHPREUP ();
 	      break;
+	    }
+#endif
+	  rhs = DPRegRHS;
+	  dest = LHS | rhs;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x19:		/* ORRS reg */
+	case 0x19:		/* ORRS reg */
 #ifdef MODET
-	      if ((BITS (4, 11) & 0xF9) == 0x9)
-		{
-		  /* LDR register offset, no write-back, up, pre indexed */
-		  LHPREUP ();
-		  /* continue with remaining instruction decoding */
-		}
+	  if ((BITS (4, 11) & 0xF9) == 0x9)
+	    {
+	      /* LDR register offset, no write-back, up, pre indexed */
+	      LHPREUP ();
+	      /* continue with remaining instruction decoding */
+	    }
 #endif
-	      rhs = DPSRegRHS;
-	      dest = LHS | rhs;
-	      WRITESDEST (dest);
-	      break;
+	  rhs = DPSRegRHS;
+	  dest = LHS | rhs;
+	  WRITESDEST (dest);
+	  break;
 
-	    case 0x1a:		/* MOV reg */
+	case 0x1a:		/* MOV reg */
 #ifdef MODET
-	      if (BITS (4, 11) == 0xB)
-		{
-		  /* STRH register offset, write-back, up, pre indexed */
-		  SHPREUPWB ();
-		  break;
-		}
-#endif
-	      dest = DPRegRHS;
-	      WRITEDEST (dest);
+	  if (BITS (4, 11) == 0xB)
+	    {
+	      /* STRH register offset, write-back, up, pre indexed */
+	      SHPREUPWB ();
 	      break;
+	    }
+#endif
+	  dest = DPRegRHS;
+	  WRITEDEST (dest);
+	  if (DESTReg == 15 && state->ProfileCalls)
+	    ARMul_ProfileReturn (state, pc, PC);
+	  break;
 
-	    case 0x1b:		/* MOVS reg */
+	case 0x1b:		/* MOVS reg */
 #ifdef MODET
-	      if ((BITS (4, 11) & 0xF9) == 0x9)
-		{
-		  /* LDR register offset, write-back, up, pre indexed */
-		  LHPREUPWB ();
-		  /* continue with remaining instruction decoding */
-		}
+	  if ((BITS (4, 11) & 0xF9) == 0x9)
+	    {
+	      /* LDR register offset, write-back, up, pre indexed */
+	      LHPREUPWB ();
+	      /* continue with remaining instruction decoding */
+	    }
 #endif
-	      dest = DPSRegRHS;
-	      WRITESDEST (dest);
-	      break;
+	  dest = DPSRegRHS;
+	  WRITESDEST (dest);
+	  if (DESTReg == 15 && state->ProfileCalls)
+	    ARMul_ProfileReturn (state, pc, PC);
+	  break;
 
-	    case 0x1c:		/* BIC reg */
+	case 0x1c:		/* BIC reg */
 #ifdef MODET
-	      if (BITS (4, 7) == 0xB)
-		{
-		  /* STRH immediate offset, no write-back, up, pre indexed */
-		  SHPREUP ();
-		  break;
-		}
-#endif
-	      rhs = DPRegRHS;
-	      dest = LHS & ~rhs;
-	      WRITEDEST (dest);
+	  if (BITS (4, 7) == 0xB)
+	    {
+	      /* STRH immediate offset, no write-back, up, pre indexed */
+	      SHPREUP ();
 	      break;
+	    }
+#endif
+	  rhs = DPRegRHS;
+	  dest = LHS & ~rhs;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x1d:		/* BICS reg */
+	case 0x1d:		/* BICS reg */
 #ifdef MODET
-	      if ((BITS (4, 7) & 0x9) == 0x9)
-		{
-		  /* LDR immediate offset, no write-back, up, pre indexed */
-		  LHPREUP ();
-		  /* continue with instruction decoding */
-		}
+	  if ((BITS (4, 7) & 0x9) == 0x9)
+	    {
+	      /* LDR immediate offset, no write-back, up, pre indexed */
+	      LHPREUP ();
+	      /* continue with instruction decoding */
+	    }
 #endif
-	      rhs = DPSRegRHS;
-	      dest = LHS & ~rhs;
-	      WRITESDEST (dest);
-	      break;
+	  rhs = DPSRegRHS;
+	  dest = LHS & ~rhs;
+	  WRITESDEST (dest);
+	  break;
 
-	    case 0x1e:		/* MVN reg */
+	case 0x1e:		/* MVN reg */
 #ifdef MODET
-	      if (BITS (4, 7) == 0xB)
-		{
-		  /* STRH immediate offset, write-back, up, pre indexed */
-		  SHPREUPWB ();
-		  break;
-		}
-#endif
-	      dest = ~DPRegRHS;
-	      WRITEDEST (dest);
+	  if (BITS (4, 7) == 0xB)
+	    {
+	      /* STRH immediate offset, write-back, up, pre indexed */
+	      SHPREUPWB ();
 	      break;
+	    }
+#endif
+	  dest = ~DPRegRHS;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x1f:		/* MVNS reg */
+	case 0x1f:		/* MVNS reg */
 #ifdef MODET
-	      if ((BITS (4, 7) & 0x9) == 0x9)
-		{
-		  /* LDR immediate offset, write-back, up, pre indexed */
-		  LHPREUPWB ();
-		  /* continue instruction decoding */
-		}
+	  if ((BITS (4, 7) & 0x9) == 0x9)
+	    {
+	      /* LDR immediate offset, write-back, up, pre indexed */
+	      LHPREUPWB ();
+	      /* continue instruction decoding */
+	    }
 #endif
-	      dest = ~DPSRegRHS;
-	      WRITESDEST (dest);
-	      break;
+	  dest = ~DPSRegRHS;
+	  WRITESDEST (dest);
+	  break;
 
 /***************************************************************************\
 *                Data Processing Immediate RHS Instructions                 *
 \***************************************************************************/
 
-	    case 0x20:		/* AND immed */
-	      dest = LHS & DPImmRHS;
-	      WRITEDEST (dest);
-	      break;
-
-	    case 0x21:		/* ANDS immed */
-	      DPSImmRHS;
-	      dest = LHS & rhs;
-	      WRITESDEST (dest);
-	      break;
-
-	    case 0x22:		/* EOR immed */
-	      dest = LHS ^ DPImmRHS;
-	      WRITEDEST (dest);
-	      break;
+	case 0x20:		/* AND immed */
+	  dest = LHS & DPImmRHS;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x23:		/* EORS immed */
-	      DPSImmRHS;
-	      dest = LHS ^ rhs;
-	      WRITESDEST (dest);
-	      break;
+	case 0x21:		/* ANDS immed */
+	  DPSImmRHS;
+	  dest = LHS & rhs;
+	  WRITESDEST (dest);
+	  break;
 
-	    case 0x24:		/* SUB immed */
-	      dest = LHS - DPImmRHS;
-	      WRITEDEST (dest);
-	      break;
+	case 0x22:		/* EOR immed */
+	  dest = LHS ^ DPImmRHS;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x25:		/* SUBS immed */
-	      lhs = LHS;
-	      rhs = DPImmRHS;
-	      dest = lhs - rhs;
-	      if ((lhs >= rhs) || ((rhs | lhs) >> 31))
-		{
-		  ARMul_SubCarry (state, lhs, rhs, dest);
-		  ARMul_SubOverflow (state, lhs, rhs, dest);
-		}
-	      else
-		{
-		  CLEARC;
-		  CLEARV;
-		}
-	      WRITESDEST (dest);
-	      break;
+	case 0x23:		/* EORS immed */
+	  DPSImmRHS;
+	  dest = LHS ^ rhs;
+	  WRITESDEST (dest);
+	  break;
 
-	    case 0x26:		/* RSB immed */
-	      dest = DPImmRHS - LHS;
-	      WRITEDEST (dest);
-	      break;
+	case 0x24:		/* SUB immed */
+	  dest = LHS - DPImmRHS;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x27:		/* RSBS immed */
-	      lhs = LHS;
-	      rhs = DPImmRHS;
-	      dest = rhs - lhs;
-	      if ((rhs >= lhs) || ((rhs | lhs) >> 31))
-		{
-		  ARMul_SubCarry (state, rhs, lhs, dest);
-		  ARMul_SubOverflow (state, rhs, lhs, dest);
-		}
-	      else
-		{
-		  CLEARC;
-		  CLEARV;
-		}
-	      WRITESDEST (dest);
-	      break;
+	case 0x25:		/* SUBS immed */
+	  lhs = LHS;
+	  rhs = DPImmRHS;
+	  dest = lhs - rhs;
+	  WRITESUBDEST (lhs, rhs, dest);
+	  break;
 
-	    case 0x28:		/* ADD immed */
-	      dest = LHS + DPImmRHS;
-	      WRITEDEST (dest);
-	      break;
+	case 0x26:		/* RSB immed */
+	  dest = DPImmRHS - LHS;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x29:		/* ADDS immed */
-	      lhs = LHS;
-	      rhs = DPImmRHS;
-	      dest = lhs + rhs;
-	      ASSIGNZ (dest == 0);
-	      if ((lhs | rhs) >> 30)
-		{		/* possible C,V,N to set */
-		  ASSIGNN (NEG (dest));
-		  ARMul_AddCarry (state, lhs, rhs, dest);
-		  ARMul_AddOverflow (state, lhs, rhs, dest);
-		}
-	      else
-		{
-		  CLEARN;
-		  CLEARC;
-		  CLEARV;
-		}
-	      WRITESDEST (dest);
-	      break;
+	case 0x27:		/* RSBS immed */
+	  lhs = LHS;
+	  rhs = DPImmRHS;
+	  dest = rhs - lhs;
+	  WRITESUBDEST (rhs, lhs, dest);
+	  break;
 
-	    case 0x2a:		/* ADC immed */
-	      dest = LHS + DPImmRHS + CFLAG;
-	      WRITEDEST (dest);
-	      break;
+	case 0x28:		/* ADD immed */
+	  dest = LHS + DPImmRHS;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x2b:		/* ADCS immed */
-	      lhs = LHS;
-	      rhs = DPImmRHS;
-	      dest = lhs + rhs + CFLAG;
-	      ASSIGNZ (dest == 0);
-	      if ((lhs | rhs) >> 30)
-		{		/* possible C,V,N to set */
-		  ASSIGNN (NEG (dest));
-		  ARMul_AddCarry (state, lhs, rhs, dest);
-		  ARMul_AddOverflow (state, lhs, rhs, dest);
-		}
-	      else
-		{
-		  CLEARN;
-		  CLEARC;
-		  CLEARV;
-		}
-	      WRITESDEST (dest);
-	      break;
+	case 0x29:		/* ADDS immed */
+	  lhs = LHS;
+	  rhs = DPImmRHS;
+	  dest = lhs + rhs;
+	  WRITEADDDEST (lhs, rhs, dest);
+	  break;
 
-	    case 0x2c:		/* SBC immed */
-	      dest = LHS - DPImmRHS - !CFLAG;
-	      WRITEDEST (dest);
-	      break;
+	case 0x2a:		/* ADC immed */
+	  dest = LHS + DPImmRHS + CFLAG;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x2d:		/* SBCS immed */
-	      lhs = LHS;
-	      rhs = DPImmRHS;
-	      dest = lhs - rhs - !CFLAG;
-	      if ((lhs >= rhs) || ((rhs | lhs) >> 31))
-		{
-		  ARMul_SubCarry (state, lhs, rhs, dest);
-		  ARMul_SubOverflow (state, lhs, rhs, dest);
-		}
-	      else
-		{
-		  CLEARC;
-		  CLEARV;
-		}
-	      WRITESDEST (dest);
-	      break;
+	case 0x2b:		/* ADCS immed */
+	  lhs = LHS;
+	  rhs = DPImmRHS;
+	  dest = lhs + rhs + CFLAG;
+	  WRITEADDDEST (lhs, rhs, dest);
+	  break;
 
-	    case 0x2e:		/* RSC immed */
-	      dest = DPImmRHS - LHS - !CFLAG;
-	      WRITEDEST (dest);
-	      break;
+	case 0x2c:		/* SBC immed */
+	  dest = LHS - DPImmRHS - !CFLAG;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x2f:		/* RSCS immed */
-	      lhs = LHS;
-	      rhs = DPImmRHS;
-	      dest = rhs - lhs - !CFLAG;
-	      if ((rhs >= lhs) || ((rhs | lhs) >> 31))
-		{
-		  ARMul_SubCarry (state, rhs, lhs, dest);
-		  ARMul_SubOverflow (state, rhs, lhs, dest);
-		}
-	      else
-		{
-		  CLEARC;
-		  CLEARV;
-		}
-	      WRITESDEST (dest);
-	      break;
+	case 0x2d:		/* SBCS immed */
+	  lhs = LHS;
+	  rhs = DPImmRHS;
+	  dest = lhs - rhs - !CFLAG;
+	  WRITESUBDEST (lhs, rhs, dest);
+	  break;
 
-	    case 0x30:		/* TST immed */
-	      UNDEF_Test;
-	      break;
+	case 0x2e:		/* RSC immed */
+	  dest = DPImmRHS - LHS - !CFLAG;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x31:		/* TSTP immed */
-	      if (DESTReg == 15)
-		{		/* TSTP immed */
+	case 0x2f:		/* RSCS immed */
+	  lhs = LHS;
+	  rhs = DPImmRHS;
+	  dest = rhs - lhs - !CFLAG;
+	  WRITESUBDEST (rhs, lhs, dest);
+	  break;
+
+	case 0x30:		/* TST immed */
+	  UNDEF_Test;
+	  break;
+
+	case 0x31:		/* TSTP immed */
+	  if (DESTReg == 15)
+	    {		/* TSTP immed */
 #ifdef MODE32
-		  state->Cpsr = GETSPSR (state->Bank);
-		  ARMul_CPSRAltered (state);
+	      state->Cpsr = GETSPSR (state->Bank);
+	      ARMul_CPSRAltered (state);
 #else
-		  temp = LHS & DPImmRHS;
-		  SETR15PSR (temp);
+	      temp = LHS & DPImmRHS;
+	      SETR15PSR (temp);
 #endif
-		}
-	      else
-		{
-		  DPSImmRHS;	/* TST immed */
-		  dest = LHS & rhs;
-		  ARMul_NegZero (state, dest);
-		}
-	      break;
+	    }
+	  else
+	    {
+	      DPSImmRHS;	/* TST immed */
+	      dest = LHS & rhs;
+	      SETNZ (dest);
+	    }
+	  break;
 
-	    case 0x32:		/* TEQ immed and MSR immed to CPSR */
-	      if (DESTReg == 15 && BITS (17, 18) == 0)
-		{		/* MSR immed to CPSR */
-		  ARMul_FixCPSR (state, instr, DPImmRHS);
-		}
-	      else
-		{
-		  UNDEF_Test;
-		}
-	      break;
+	case 0x32:		/* TEQ immed and MSR immed to CPSR */
+	  if (DESTReg == 15 && BITS (17, 18) == 0)
+	    {		/* MSR immed to CPSR */
+	      ARMul_FixCPSR (state, instr, DPImmRHS);
+	    }
+	  else
+	    {
+	      UNDEF_Test;
+	    }
+	  break;
 
-	    case 0x33:		/* TEQP immed */
-	      if (DESTReg == 15)
-		{		/* TEQP immed */
+	case 0x33:		/* TEQP immed */
+	  if (DESTReg == 15)
+	    {		/* TEQP immed */
 #ifdef MODE32
-		  state->Cpsr = GETSPSR (state->Bank);
-		  ARMul_CPSRAltered (state);
+	      state->Cpsr = GETSPSR (state->Bank);
+	      ARMul_CPSRAltered (state);
 #else
-		  temp = LHS ^ DPImmRHS;
-		  SETR15PSR (temp);
+	      temp = LHS ^ DPImmRHS;
+	      SETR15PSR (temp);
 #endif
-		}
-	      else
-		{
-		  DPSImmRHS;	/* TEQ immed */
-		  dest = LHS ^ rhs;
-		  ARMul_NegZero (state, dest);
-		}
-	      break;
+	    }
+	  else
+	    {
+	      DPSImmRHS;	/* TEQ immed */
+	      dest = LHS ^ rhs;
+	      SETNZ (dest);
+	    }
+	  break;
 
-	    case 0x34:		/* CMP immed */
-	      UNDEF_Test;
-	      break;
+	case 0x34:		/* CMP immed */
+	  UNDEF_Test;
+	  break;
 
-	    case 0x35:		/* CMPP immed */
-	      if (DESTReg == 15)
-		{		/* CMPP immed */
+	case 0x35:		/* CMPP immed */
+	  if (DESTReg == 15)
+	    {		/* CMPP immed */
 #ifdef MODE32
-		  state->Cpsr = GETSPSR (state->Bank);
-		  ARMul_CPSRAltered (state);
+	      state->Cpsr = GETSPSR (state->Bank);
+	      ARMul_CPSRAltered (state);
 #else
-		  temp = LHS - DPImmRHS;
-		  SETR15PSR (temp);
+	      temp = LHS - DPImmRHS;
+	      SETR15PSR (temp);
 #endif
-		  break;
-		}
-	      else
-		{
-		  lhs = LHS;	/* CMP immed */
-		  rhs = DPImmRHS;
-		  dest = lhs - rhs;
-		  ARMul_NegZero (state, dest);
-		  if ((lhs >= rhs) || ((rhs | lhs) >> 31))
-		    {
-		      ARMul_SubCarry (state, lhs, rhs, dest);
-		      ARMul_SubOverflow (state, lhs, rhs, dest);
-		    }
-		  else
-		    {
-		      CLEARC;
-		      CLEARV;
-		    }
-		}
 	      break;
+	    }
+	  else
+	    {
+	      lhs = LHS;	/* CMP immed */
+	      rhs = DPImmRHS;
+	      dest = lhs - rhs;
+	      SETSUB (lhs, rhs, dest);
+	    }
+	  break;
 
-	    case 0x36:		/* CMN immed and MSR immed to SPSR */
-	      if (DESTReg == 15 && BITS (17, 18) == 0)	/* MSR */
-		ARMul_FixSPSR (state, instr, DPImmRHS);
-	      else
-		{
-		  UNDEF_Test;
-		}
-	      break;
+	case 0x36:		/* CMN immed and MSR immed to SPSR */
+	  if (DESTReg == 15 && BITS (17, 18) == 0)	/* MSR */
+	    ARMul_FixSPSR (state, instr, DPImmRHS);
+	  else
+	    {
+	      UNDEF_Test;
+	    }
+	  break;
 
-	    case 0x37:		/* CMNP immed */
-	      if (DESTReg == 15)
-		{		/* CMNP immed */
+	case 0x37:		/* CMNP immed */
+	  if (DESTReg == 15)
+	    {		/* CMNP immed */
 #ifdef MODE32
-		  state->Cpsr = GETSPSR (state->Bank);
-		  ARMul_CPSRAltered (state);
+	      state->Cpsr = GETSPSR (state->Bank);
+	      ARMul_CPSRAltered (state);
 #else
-		  temp = LHS + DPImmRHS;
-		  SETR15PSR (temp);
+	      temp = LHS + DPImmRHS;
+	      SETR15PSR (temp);
 #endif
-		  break;
-		}
-	      else
-		{
-		  lhs = LHS;	/* CMN immed */
-		  rhs = DPImmRHS;
-		  dest = lhs + rhs;
-		  ASSIGNZ (dest == 0);
-		  if ((lhs | rhs) >> 30)
-		    {		/* possible C,V,N to set */
-		      ASSIGNN (NEG (dest));
-		      ARMul_AddCarry (state, lhs, rhs, dest);
-		      ARMul_AddOverflow (state, lhs, rhs, dest);
-		    }
-		  else
-		    {
-		      CLEARN;
-		      CLEARC;
-		      CLEARV;
-		    }
-		}
 	      break;
+	    }
+	  else
+	    {
+	      lhs = LHS;	/* CMN immed */
+	      rhs = DPImmRHS;
+	      dest = lhs + rhs;
+	      SETADD (lhs, rhs, dest);
+	    }
+	  break;
 
-	    case 0x38:		/* ORR immed */
-	      dest = LHS | DPImmRHS;
-	      WRITEDEST (dest);
-	      break;
+	case 0x38:		/* ORR immed */
+	  dest = LHS | DPImmRHS;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x39:		/* ORRS immed */
-	      DPSImmRHS;
-	      dest = LHS | rhs;
-	      WRITESDEST (dest);
-	      break;
+	case 0x39:		/* ORRS immed */
+	  DPSImmRHS;
+	  dest = LHS | rhs;
+	  WRITESDEST (dest);
+	  break;
 
-	    case 0x3a:		/* MOV immed */
-	      dest = DPImmRHS;
-	      WRITEDEST (dest);
-	      break;
+	case 0x3a:		/* MOV immed */
+	  dest = DPImmRHS;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x3b:		/* MOVS immed */
-	      DPSImmRHS;
-	      WRITESDEST (rhs);
-	      break;
+	case 0x3b:		/* MOVS immed */
+	  DPSImmRHS;
+	  WRITESDEST (rhs);
+	  break;
 
-	    case 0x3c:		/* BIC immed */
-	      dest = LHS & ~DPImmRHS;
-	      WRITEDEST (dest);
-	      break;
+	case 0x3c:		/* BIC immed */
+	  dest = LHS & ~DPImmRHS;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x3d:		/* BICS immed */
-	      DPSImmRHS;
-	      dest = LHS & ~rhs;
-	      WRITESDEST (dest);
-	      break;
+	case 0x3d:		/* BICS immed */
+	  DPSImmRHS;
+	  dest = LHS & ~rhs;
+	  WRITESDEST (dest);
+	  break;
 
-	    case 0x3e:		/* MVN immed */
-	      dest = ~DPImmRHS;
-	      WRITEDEST (dest);
-	      break;
+	case 0x3e:		/* MVN immed */
+	  dest = ~DPImmRHS;
+	  WRITEDEST (dest);
+	  break;
 
-	    case 0x3f:		/* MVNS immed */
-	      DPSImmRHS;
-	      WRITESDEST (~rhs);
-	      break;
+	case 0x3f:		/* MVNS immed */
+	  DPSImmRHS;
+	  WRITESDEST (~rhs);
+	  break;
 
 /***************************************************************************\
 *              Single Data Transfer Immediate RHS Instructions              *
 \***************************************************************************/
 
-	    case 0x40:		/* Store Word, No WriteBack, Post Dec, Immed */
-	      lhs = LHS;
-	      if (StoreWord (state, instr, lhs))
-		LSBase = lhs - LSImmRHS;
-	      break;
+	case 0x40:		/* Store Word, No WriteBack, Post Dec, Immed */
+	  lhs = LHS;
+	  if (StoreWord (state, instr, lhs))
+	    LSBase = lhs - LSImmRHS;
+	  break;
 
-	    case 0x41:		/* Load Word, No WriteBack, Post Dec, Immed */
-	      lhs = LHS;
-	      if (LoadWord (state, instr, lhs))
-		LSBase = lhs - LSImmRHS;
-	      break;
+	case 0x41:		/* Load Word, No WriteBack, Post Dec, Immed */
+	  lhs = LHS;
+	  if (LoadWord (state, instr, lhs))
+	    LSBase = lhs - LSImmRHS;
+	  break;
 
-	    case 0x42:		/* Store Word, WriteBack, Post Dec, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      lhs = LHS;
-	      temp = lhs - LSImmRHS;
-	      state->NtransSig = LOW;
-	      if (StoreWord (state, instr, lhs))
-		LSBase = temp;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
-	      break;
+	case 0x42:		/* Store Word, WriteBack, Post Dec, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  lhs = LHS;
+	  temp = lhs - LSImmRHS;
+	  state->NtransSig = LOW;
+	  if (StoreWord (state, instr, lhs))
+	    LSBase = temp;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x43:		/* Load Word, WriteBack, Post Dec, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (LoadWord (state, instr, lhs))
-		LSBase = lhs - LSImmRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
-	      break;
+	case 0x43:		/* Load Word, WriteBack, Post Dec, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  lhs = LHS;
+	  state->NtransSig = LOW;
+	  if (LoadWord (state, instr, lhs))
+	    LSBase = lhs - LSImmRHS;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x44:		/* Store Byte, No WriteBack, Post Dec, Immed */
-	      lhs = LHS;
-	      if (StoreByte (state, instr, lhs))
-		LSBase = lhs - LSImmRHS;
-	      break;
+	case 0x44:		/* Store Byte, No WriteBack, Post Dec, Immed */
+	  lhs = LHS;
+	  if (StoreByte (state, instr, lhs))
+	    LSBase = lhs - LSImmRHS;
+	  break;
 
-	    case 0x45:		/* Load Byte, No WriteBack, Post Dec, Immed */
-	      lhs = LHS;
-	      if (LoadByte (state, instr, lhs, LUNSIGNED))
-		LSBase = lhs - LSImmRHS;
-	      break;
+	case 0x45:		/* Load Byte, No WriteBack, Post Dec, Immed */
+	  lhs = LHS;
+	  if (LoadByte (state, instr, lhs, LUNSIGNED))
+	    LSBase = lhs - LSImmRHS;
+	  break;
 
-	    case 0x46:		/* Store Byte, WriteBack, Post Dec, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (StoreByte (state, instr, lhs))
-		LSBase = lhs - LSImmRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
-	      break;
+	case 0x46:		/* Store Byte, WriteBack, Post Dec, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  lhs = LHS;
+	  state->NtransSig = LOW;
+	  if (StoreByte (state, instr, lhs))
+	    LSBase = lhs - LSImmRHS;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x47:		/* Load Byte, WriteBack, Post Dec, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (LoadByte (state, instr, lhs, LUNSIGNED))
-		LSBase = lhs - LSImmRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
-	      break;
+	case 0x47:		/* Load Byte, WriteBack, Post Dec, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  lhs = LHS;
+	  state->NtransSig = LOW;
+	  if (LoadByte (state, instr, lhs, LUNSIGNED))
+	    LSBase = lhs - LSImmRHS;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x48:		/* Store Word, No WriteBack, Post Inc, Immed */
-	      lhs = LHS;
-	      if (StoreWord (state, instr, lhs))
-		LSBase = lhs + LSImmRHS;
-	      break;
+	case 0x48:		/* Store Word, No WriteBack, Post Inc, Immed */
+	  lhs = LHS;
+	  if (StoreWord (state, instr, lhs))
+	    LSBase = lhs + LSImmRHS;
+	  break;
 
-	    case 0x49:		/* Load Word, No WriteBack, Post Inc, Immed */
-	      lhs = LHS;
-	      if (LoadWord (state, instr, lhs))
-		LSBase = lhs + LSImmRHS;
-	      break;
+	case 0x49:		/* Load Word, No WriteBack, Post Inc, Immed */
+	  lhs = LHS;
+	  if (LoadWord (state, instr, lhs))
+	    LSBase = lhs + LSImmRHS;
+	  break;
 
-	    case 0x4a:		/* Store Word, WriteBack, Post Inc, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (StoreWord (state, instr, lhs))
-		LSBase = lhs + LSImmRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
-	      break;
+	case 0x4a:		/* Store Word, WriteBack, Post Inc, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  lhs = LHS;
+	  state->NtransSig = LOW;
+	  if (StoreWord (state, instr, lhs))
+	    LSBase = lhs + LSImmRHS;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x4b:		/* Load Word, WriteBack, Post Inc, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (LoadWord (state, instr, lhs))
-		LSBase = lhs + LSImmRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
-	      break;
+	case 0x4b:		/* Load Word, WriteBack, Post Inc, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  lhs = LHS;
+	  state->NtransSig = LOW;
+	  if (LoadWord (state, instr, lhs))
+	    LSBase = lhs + LSImmRHS;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x4c:		/* Store Byte, No WriteBack, Post Inc, Immed */
-	      lhs = LHS;
-	      if (StoreByte (state, instr, lhs))
-		LSBase = lhs + LSImmRHS;
-	      break;
+	case 0x4c:		/* Store Byte, No WriteBack, Post Inc, Immed */
+	  lhs = LHS;
+	  if (StoreByte (state, instr, lhs))
+	    LSBase = lhs + LSImmRHS;
+	  break;
 
-	    case 0x4d:		/* Load Byte, No WriteBack, Post Inc, Immed */
-	      lhs = LHS;
-	      if (LoadByte (state, instr, lhs, LUNSIGNED))
-		LSBase = lhs + LSImmRHS;
-	      break;
+	case 0x4d:		/* Load Byte, No WriteBack, Post Inc, Immed */
+	  lhs = LHS;
+	  if (LoadByte (state, instr, lhs, LUNSIGNED))
+	    LSBase = lhs + LSImmRHS;
+	  break;
 
-	    case 0x4e:		/* Store Byte, WriteBack, Post Inc, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (StoreByte (state, instr, lhs))
-		LSBase = lhs + LSImmRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
-	      break;
+	case 0x4e:		/* Store Byte, WriteBack, Post Inc, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  lhs = LHS;
+	  state->NtransSig = LOW;
+	  if (StoreByte (state, instr, lhs))
+	    LSBase = lhs + LSImmRHS;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x4f:		/* Load Byte, WriteBack, Post Inc, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (LoadByte (state, instr, lhs, LUNSIGNED))
-		LSBase = lhs + LSImmRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
-	      break;
+	case 0x4f:		/* Load Byte, WriteBack, Post Inc, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  lhs = LHS;
+	  state->NtransSig = LOW;
+	  if (LoadByte (state, instr, lhs, LUNSIGNED))
+	    LSBase = lhs + LSImmRHS;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
 
-	    case 0x50:		/* Store Word, No WriteBack, Pre Dec, Immed */
-	      (void) StoreWord (state, instr, LHS - LSImmRHS);
-	      break;
+	case 0x50:		/* Store Word, No WriteBack, Pre Dec, Immed */
+	  (void) StoreWord (state, instr, LHS - LSImmRHS);
+	  break;
 
-	    case 0x51:		/* Load Word, No WriteBack, Pre Dec, Immed */
-	      (void) LoadWord (state, instr, LHS - LSImmRHS);
-	      break;
+	case 0x51:		/* Load Word, No WriteBack, Pre Dec, Immed */
+	  (void) LoadWord (state, instr, LHS - LSImmRHS);
+	  break;
 
-	    case 0x52:		/* Store Word, WriteBack, Pre Dec, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      temp = LHS - LSImmRHS;
-	      if (StoreWord (state, instr, temp))
-		LSBase = temp;
-	      break;
+	case 0x52:		/* Store Word, WriteBack, Pre Dec, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  temp = LHS - LSImmRHS;
+	  if (StoreWord (state, instr, temp))
+	    LSBase = temp;
+	  break;
 
-	    case 0x53:		/* Load Word, WriteBack, Pre Dec, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      temp = LHS - LSImmRHS;
-	      if (LoadWord (state, instr, temp))
-		LSBase = temp;
-	      break;
+	case 0x53:		/* Load Word, WriteBack, Pre Dec, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  temp = LHS - LSImmRHS;
+	  if (LoadWord (state, instr, temp))
+	    LSBase = temp;
+	  break;
 
-	    case 0x54:		/* Store Byte, No WriteBack, Pre Dec, Immed */
-	      (void) StoreByte (state, instr, LHS - LSImmRHS);
-	      break;
+	case 0x54:		/* Store Byte, No WriteBack, Pre Dec, Immed */
+	  (void) StoreByte (state, instr, LHS - LSImmRHS);
+	  break;
 
-	    case 0x55:		/* Load Byte, No WriteBack, Pre Dec, Immed */
-	      (void) LoadByte (state, instr, LHS - LSImmRHS, LUNSIGNED);
-	      break;
+	case 0x55:		/* Load Byte, No WriteBack, Pre Dec, Immed */
+	  (void) LoadByte (state, instr, LHS - LSImmRHS, LUNSIGNED);
+	  break;
 
-	    case 0x56:		/* Store Byte, WriteBack, Pre Dec, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      temp = LHS - LSImmRHS;
-	      if (StoreByte (state, instr, temp))
-		LSBase = temp;
-	      break;
+	case 0x56:		/* Store Byte, WriteBack, Pre Dec, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  temp = LHS - LSImmRHS;
+	  if (StoreByte (state, instr, temp))
+	    LSBase = temp;
+	  break;
 
-	    case 0x57:		/* Load Byte, WriteBack, Pre Dec, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      temp = LHS - LSImmRHS;
-	      if (LoadByte (state, instr, temp, LUNSIGNED))
-		LSBase = temp;
-	      break;
+	case 0x57:		/* Load Byte, WriteBack, Pre Dec, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  temp = LHS - LSImmRHS;
+	  if (LoadByte (state, instr, temp, LUNSIGNED))
+	    LSBase = temp;
+	  break;
 
-	    case 0x58:		/* Store Word, No WriteBack, Pre Inc, Immed */
-	      (void) StoreWord (state, instr, LHS + LSImmRHS);
-	      break;
+	case 0x58:		/* Store Word, No WriteBack, Pre Inc, Immed */
+	  (void) StoreWord (state, instr, LHS + LSImmRHS);
+	  break;
 
-	    case 0x59:		/* Load Word, No WriteBack, Pre Inc, Immed */
-	      (void) LoadWord (state, instr, LHS + LSImmRHS);
-	      break;
+	case 0x59:		/* Load Word, No WriteBack, Pre Inc, Immed */
+	  (void) LoadWord (state, instr, LHS + LSImmRHS);
+	  break;
 
-	    case 0x5a:		/* Store Word, WriteBack, Pre Inc, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      temp = LHS + LSImmRHS;
-	      if (StoreWord (state, instr, temp))
-		LSBase = temp;
-	      break;
+	case 0x5a:		/* Store Word, WriteBack, Pre Inc, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  temp = LHS + LSImmRHS;
+	  if (StoreWord (state, instr, temp))
+	    LSBase = temp;
+	  break;
 
-	    case 0x5b:		/* Load Word, WriteBack, Pre Inc, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      temp = LHS + LSImmRHS;
-	      if (LoadWord (state, instr, temp))
-		LSBase = temp;
-	      break;
+	case 0x5b:		/* Load Word, WriteBack, Pre Inc, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  temp = LHS + LSImmRHS;
+	  if (LoadWord (state, instr, temp))
+	    LSBase = temp;
+	  break;
 
-	    case 0x5c:		/* Store Byte, No WriteBack, Pre Inc, Immed */
-	      (void) StoreByte (state, instr, LHS + LSImmRHS);
-	      break;
+	case 0x5c:		/* Store Byte, No WriteBack, Pre Inc, Immed */
+	  (void) StoreByte (state, instr, LHS + LSImmRHS);
+	  break;
 
-	    case 0x5d:		/* Load Byte, No WriteBack, Pre Inc, Immed */
-	      (void) LoadByte (state, instr, LHS + LSImmRHS, LUNSIGNED);
-	      break;
+	case 0x5d:		/* Load Byte, No WriteBack, Pre Inc, Immed */
+	  (void) LoadByte (state, instr, LHS + LSImmRHS, LUNSIGNED);
+	  break;
 
-	    case 0x5e:		/* Store Byte, WriteBack, Pre Inc, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      temp = LHS + LSImmRHS;
-	      if (StoreByte (state, instr, temp))
-		LSBase = temp;
-	      break;
+	case 0x5e:		/* Store Byte, WriteBack, Pre Inc, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  temp = LHS + LSImmRHS;
+	  if (StoreByte (state, instr, temp))
+	    LSBase = temp;
+	  break;
 
-	    case 0x5f:		/* Load Byte, WriteBack, Pre Inc, Immed */
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      temp = LHS + LSImmRHS;
-	      if (LoadByte (state, instr, temp, LUNSIGNED))
-		LSBase = temp;
-	      break;
+	case 0x5f:		/* Load Byte, WriteBack, Pre Inc, Immed */
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  temp = LHS + LSImmRHS;
+	  if (LoadByte (state, instr, temp, LUNSIGNED))
+	    LSBase = temp;
+	  break;
 
 /***************************************************************************\
 *              Single Data Transfer Register RHS Instructions               *
 \***************************************************************************/
 
-	    case 0x60:		/* Store Word, No WriteBack, Post Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      if (StoreWord (state, instr, lhs))
-		LSBase = lhs - LSRegRHS;
+	case 0x60:		/* Store Word, No WriteBack, Post Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  if (StoreWord (state, instr, lhs))
+	    LSBase = lhs - LSRegRHS;
+	  break;
 
-	    case 0x61:		/* Load Word, No WriteBack, Post Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      if (LoadWord (state, instr, lhs))
-		LSBase = lhs - LSRegRHS;
+	case 0x61:		/* Load Word, No WriteBack, Post Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  rhs = LSRegRHS;	/* before a load to Rd == Rm */
+	  if (LoadWord (state, instr, lhs))
+	    LSBase = lhs - rhs;
+	  break;
 
-	    case 0x62:		/* Store Word, WriteBack, Post Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (StoreWord (state, instr, lhs))
-		LSBase = lhs - LSRegRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	case 0x62:		/* Store Word, WriteBack, Post Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  state->NtransSig = LOW;
+	  if (StoreWord (state, instr, lhs))
+	    LSBase = lhs - LSRegRHS;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x63:		/* Load Word, WriteBack, Post Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (LoadWord (state, instr, lhs))
-		LSBase = lhs - LSRegRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	case 0x63:		/* Load Word, WriteBack, Post Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  rhs = LSRegRHS;	/* before a load to Rd == Rm */
+	  state->NtransSig = LOW;
+	  if (LoadWord (state, instr, lhs))
+	    LSBase = lhs - rhs;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x64:		/* Store Byte, No WriteBack, Post Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      if (StoreByte (state, instr, lhs))
-		LSBase = lhs - LSRegRHS;
+	case 0x64:		/* Store Byte, No WriteBack, Post Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  if (StoreByte (state, instr, lhs))
+	    LSBase = lhs - LSRegRHS;
+	  break;
 
-	    case 0x65:		/* Load Byte, No WriteBack, Post Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      if (LoadByte (state, instr, lhs, LUNSIGNED))
-		LSBase = lhs - LSRegRHS;
+	case 0x65:		/* Load Byte, No WriteBack, Post Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  rhs = LSRegRHS;	/* before a load to Rd == Rm */
+	  if (LoadByte (state, instr, lhs, LUNSIGNED))
+	    LSBase = lhs - rhs;
+	  break;
 
-	    case 0x66:		/* Store Byte, WriteBack, Post Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (StoreByte (state, instr, lhs))
-		LSBase = lhs - LSRegRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	case 0x66:		/* Store Byte, WriteBack, Post Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  state->NtransSig = LOW;
+	  if (StoreByte (state, instr, lhs))
+	    LSBase = lhs - LSRegRHS;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x67:		/* Load Byte, WriteBack, Post Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (LoadByte (state, instr, lhs, LUNSIGNED))
-		LSBase = lhs - LSRegRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	case 0x67:		/* Load Byte, WriteBack, Post Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  rhs = LSRegRHS;	/* before a load to Rd == Rm */
+	  state->NtransSig = LOW;
+	  if (LoadByte (state, instr, lhs, LUNSIGNED))
+	    LSBase = lhs - rhs;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x68:		/* Store Word, No WriteBack, Post Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      if (StoreWord (state, instr, lhs))
-		LSBase = lhs + LSRegRHS;
+	case 0x68:		/* Store Word, No WriteBack, Post Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  if (StoreWord (state, instr, lhs))
+	    LSBase = lhs + LSRegRHS;
+	  break;
 
-	    case 0x69:		/* Load Word, No WriteBack, Post Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      if (LoadWord (state, instr, lhs))
-		LSBase = lhs + LSRegRHS;
+	case 0x69:		/* Load Word, No WriteBack, Post Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  rhs = LSRegRHS;	/* before a load to Rd == Rm */
+	  if (LoadWord (state, instr, lhs))
+	    LSBase = lhs + rhs;
+	  break;
 
-	    case 0x6a:		/* Store Word, WriteBack, Post Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (StoreWord (state, instr, lhs))
-		LSBase = lhs + LSRegRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	case 0x6a:		/* Store Word, WriteBack, Post Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  state->NtransSig = LOW;
+	  if (StoreWord (state, instr, lhs))
+	    LSBase = lhs + LSRegRHS;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x6b:		/* Load Word, WriteBack, Post Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (LoadWord (state, instr, lhs))
-		LSBase = lhs + LSRegRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	case 0x6b:		/* Load Word, WriteBack, Post Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
-
-	    case 0x6c:		/* Store Byte, No WriteBack, Post Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      if (StoreByte (state, instr, lhs))
-		LSBase = lhs + LSRegRHS;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  rhs = LSRegRHS;	/* before a load to Rd == Rm */
+	  state->NtransSig = LOW;
+	  if (LoadWord (state, instr, lhs))
+	    LSBase = lhs + rhs;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
+
+	case 0x6c:		/* Store Byte, No WriteBack, Post Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  if (StoreByte (state, instr, lhs))
+	    LSBase = lhs + LSRegRHS;
+	  break;
 
-	    case 0x6d:		/* Load Byte, No WriteBack, Post Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      if (LoadByte (state, instr, lhs, LUNSIGNED))
-		LSBase = lhs + LSRegRHS;
+	case 0x6d:		/* Load Byte, No WriteBack, Post Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  rhs = LSRegRHS;	/* before a load to Rd == Rm */
+	  if (LoadByte (state, instr, lhs, LUNSIGNED))
+	    LSBase = lhs + rhs;
+	  break;
 
-	    case 0x6e:		/* Store Byte, WriteBack, Post Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (StoreByte (state, instr, lhs))
-		LSBase = lhs + LSRegRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	case 0x6e:		/* Store Byte, WriteBack, Post Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  state->NtransSig = LOW;
+	  if (StoreByte (state, instr, lhs))
+	    LSBase = lhs + LSRegRHS;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
-	    case 0x6f:		/* Load Byte, WriteBack, Post Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      lhs = LHS;
-	      state->NtransSig = LOW;
-	      if (LoadByte (state, instr, lhs, LUNSIGNED))
-		LSBase = lhs + LSRegRHS;
-	      state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	case 0x6f:		/* Load Byte, WriteBack, Post Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  lhs = LHS;
+	  rhs = LSRegRHS;	/* before a load to Rd == Rm */
+	  state->NtransSig = LOW;
+	  if (LoadByte (state, instr, lhs, LUNSIGNED))
+	    LSBase = lhs + rhs;
+	  state->NtransSig = (state->Mode & 3) ? HIGH : LOW;
+	  break;
 
 
-	    case 0x70:		/* Store Word, No WriteBack, Pre Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      (void) StoreWord (state, instr, LHS - LSRegRHS);
+	case 0x70:		/* Store Word, No WriteBack, Pre Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  (void) StoreWord (state, instr, LHS - LSRegRHS);
+	  break;
 
-	    case 0x71:		/* Load Word, No WriteBack, Pre Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      (void) LoadWord (state, instr, LHS - LSRegRHS);
+	case 0x71:		/* Load Word, No WriteBack, Pre Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  (void) LoadWord (state, instr, LHS - LSRegRHS);
+	  break;
 
-	    case 0x72:		/* Store Word, WriteBack, Pre Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      temp = LHS - LSRegRHS;
-	      if (StoreWord (state, instr, temp))
-		LSBase = temp;
+	case 0x72:		/* Store Word, WriteBack, Pre Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  temp = LHS - LSRegRHS;
+	  if (StoreWord (state, instr, temp))
+	    LSBase = temp;
+	  break;
 
-	    case 0x73:		/* Load Word, WriteBack, Pre Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      temp = LHS - LSRegRHS;
-	      if (LoadWord (state, instr, temp))
-		LSBase = temp;
+	case 0x73:		/* Load Word, WriteBack, Pre Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  temp = LHS - LSRegRHS;
+	  if (LoadWord (state, instr, temp))
+	    LSBase = temp;
+	  break;
 
-	    case 0x74:		/* Store Byte, No WriteBack, Pre Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      (void) StoreByte (state, instr, LHS - LSRegRHS);
+	case 0x74:		/* Store Byte, No WriteBack, Pre Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  (void) StoreByte (state, instr, LHS - LSRegRHS);
+	  break;
 
-	    case 0x75:		/* Load Byte, No WriteBack, Pre Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      (void) LoadByte (state, instr, LHS - LSRegRHS, LUNSIGNED);
+	case 0x75:		/* Load Byte, No WriteBack, Pre Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  (void) LoadByte (state, instr, LHS - LSRegRHS, LUNSIGNED);
+	  break;
 
-	    case 0x76:		/* Store Byte, WriteBack, Pre Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      temp = LHS - LSRegRHS;
-	      if (StoreByte (state, instr, temp))
-		LSBase = temp;
+	case 0x76:		/* Store Byte, WriteBack, Pre Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  temp = LHS - LSRegRHS;
+	  if (StoreByte (state, instr, temp))
+	    LSBase = temp;
+	  break;
 
-	    case 0x77:		/* Load Byte, WriteBack, Pre Dec, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      temp = LHS - LSRegRHS;
-	      if (LoadByte (state, instr, temp, LUNSIGNED))
-		LSBase = temp;
+	case 0x77:		/* Load Byte, WriteBack, Pre Dec, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  temp = LHS - LSRegRHS;
+	  if (LoadByte (state, instr, temp, LUNSIGNED))
+	    LSBase = temp;
+	  break;
 
-	    case 0x78:		/* Store Word, No WriteBack, Pre Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      (void) StoreWord (state, instr, LHS + LSRegRHS);
+	case 0x78:		/* Store Word, No WriteBack, Pre Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  (void) StoreWord (state, instr, LHS + LSRegRHS);
+	  break;
 
-	    case 0x79:		/* Load Word, No WriteBack, Pre Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      (void) LoadWord (state, instr, LHS + LSRegRHS);
+	case 0x79:		/* Load Word, No WriteBack, Pre Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  (void) LoadWord (state, instr, LHS + LSRegRHS);
+	  break;
 
-	    case 0x7a:		/* Store Word, WriteBack, Pre Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      temp = LHS + LSRegRHS;
-	      if (StoreWord (state, instr, temp))
-		LSBase = temp;
+	case 0x7a:		/* Store Word, WriteBack, Pre Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  temp = LHS + LSRegRHS;
+	  if (StoreWord (state, instr, temp))
+	    LSBase = temp;
+	  break;
 
-	    case 0x7b:		/* Load Word, WriteBack, Pre Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      temp = LHS + LSRegRHS;
-	      if (LoadWord (state, instr, temp))
-		LSBase = temp;
+	case 0x7b:		/* Load Word, WriteBack, Pre Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  temp = LHS + LSRegRHS;
+	  if (LoadWord (state, instr, temp))
+	    LSBase = temp;
+	  break;
 
-	    case 0x7c:		/* Store Byte, No WriteBack, Pre Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      (void) StoreByte (state, instr, LHS + LSRegRHS);
+	case 0x7c:		/* Store Byte, No WriteBack, Pre Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  (void) StoreByte (state, instr, LHS + LSRegRHS);
+	  break;
 
-	    case 0x7d:		/* Load Byte, No WriteBack, Pre Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      (void) LoadByte (state, instr, LHS + LSRegRHS, LUNSIGNED);
+	case 0x7d:		/* Load Byte, No WriteBack, Pre Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  (void) LoadByte (state, instr, LHS + LSRegRHS, LUNSIGNED);
+	  break;
 
-	    case 0x7e:		/* Store Byte, WriteBack, Pre Inc, Reg */
-	      if (BIT (4))
-		{
-		  ARMul_UndefInstr (state, instr);
-		  break;
-		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      temp = LHS + LSRegRHS;
-	      if (StoreByte (state, instr, temp))
-		LSBase = temp;
+	case 0x7e:		/* Store Byte, WriteBack, Pre Inc, Reg */
+	  if (BIT (4))
+	    {
+	      ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  temp = LHS + LSRegRHS;
+	  if (StoreByte (state, instr, temp))
+	    LSBase = temp;
+	  break;
 
-	    case 0x7f:		/* Load Byte, WriteBack, Pre Inc, Reg */
-	      if (BIT (4))
+	case 0x7f:		/* Load Byte, WriteBack, Pre Inc, Reg */
+	  if (BIT (4))
+	    {
+	      /* Check for the special breakpoint opcode.
+		 This value should correspond to the value defined
+		 as ARM_BE_BREAKPOINT in gdb/arm-tdep.c.  */
+	      if (BITS (0, 19) == 0xfdefe)
 		{
-		  /* Check for the special breakpoint opcode.
-		     This value should correspond to the value defined
-		     as ARM_BE_BREAKPOINT in gdb/arm-tdep.c.  */
-		  if (BITS (0, 19) == 0xfdefe)
-		    {
-		      if (!ARMul_OSHandleSWI (state, SWI_Breakpoint))
-			ARMul_Abort (state, ARMul_SWIV);
-		    }
-		  else
-		    ARMul_UndefInstr (state, instr);
-		  break;
+		  if (!ARMul_OSHandleSWI (state, SWI_Breakpoint))
+		    ARMul_Abort (state, ARMul_SWIV);
 		}
-	      UNDEF_LSRBaseEQOffWb;
-	      UNDEF_LSRBaseEQDestWb;
-	      UNDEF_LSRPCBaseWb;
-	      UNDEF_LSRPCOffWb;
-	      temp = LHS + LSRegRHS;
-	      if (LoadByte (state, instr, temp, LUNSIGNED))
-		LSBase = temp;
+	      else
+		ARMul_UndefInstr (state, instr);
 	      break;
+	    }
+	  UNDEF_LSRBaseEQOffWb;
+	  UNDEF_LSRBaseEQDestWb;
+	  UNDEF_LSRPCBaseWb;
+	  UNDEF_LSRPCOffWb;
+	  temp = LHS + LSRegRHS;
+	  if (LoadByte (state, instr, temp, LUNSIGNED))
+	    LSBase = temp;
+	  break;
 
 /***************************************************************************\
 *                   Multiple Data Transfer Instructions                     *
 \***************************************************************************/
 
-	    case 0x80:		/* Store, No WriteBack, Post Dec */
-	      STOREMULT (instr, LSBase - LSMNumRegs + 4L, 0L);
-	      break;
+	case 0x80:		/* Store, No WriteBack, Post Dec */
+	  STOREMULT (instr, LSBase - LSMNumRegs + 4L, 0L);
+	  break;
 
-	    case 0x81:		/* Load, No WriteBack, Post Dec */
-	      LOADMULT (instr, LSBase - LSMNumRegs + 4L, 0L);
-	      break;
+	case 0x81:		/* Load, No WriteBack, Post Dec */
+	  LOADMULT (instr, LSBase - LSMNumRegs + 4L, 0L);
+	  break;
 
-	    case 0x82:		/* Store, WriteBack, Post Dec */
-	      temp = LSBase - LSMNumRegs;
-	      STOREMULT (instr, temp + 4L, temp);
-	      break;
+	case 0x82:		/* Store, WriteBack, Post Dec */
+	  temp = LSBase - LSMNumRegs;
+	  STOREMULT (instr, temp + 4L, temp);
+	  break;
 
-	    case 0x83:		/* Load, WriteBack, Post Dec */
-	      temp = LSBase - LSMNumRegs;
-	      LOADMULT (instr, temp + 4L, temp);
-	      break;
+	case 0x83:		/* Load, WriteBack, Post Dec */
+	  temp = LSBase - LSMNumRegs;
+	  LOADMULT (instr, temp + 4L, temp);
+	  break;
 
-	    case 0x84:		/* Store, Flags, No WriteBack, Post Dec */
-	      STORESMULT (instr, LSBase - LSMNumRegs + 4L, 0L);
-	      break;
+	case 0x84:		/* Store, Flags, No WriteBack, Post Dec */
+	  STORESMULT (instr, LSBase - LSMNumRegs + 4L, 0L);
+	  break;
 
-	    case 0x85:		/* Load, Flags, No WriteBack, Post Dec */
-	      LOADSMULT (instr, LSBase - LSMNumRegs + 4L, 0L);
-	      break;
+	case 0x85:		/* Load, Flags, No WriteBack, Post Dec */
+	  LOADSMULT (instr, LSBase - LSMNumRegs + 4L, 0L);
+	  break;
 
-	    case 0x86:		/* Store, Flags, WriteBack, Post Dec */
-	      temp = LSBase - LSMNumRegs;
-	      STORESMULT (instr, temp + 4L, temp);
-	      break;
+	case 0x86:		/* Store, Flags, WriteBack, Post Dec */
+	  temp = LSBase - LSMNumRegs;
+	  STORESMULT (instr, temp + 4L, temp);
+	  break;
 
-	    case 0x87:		/* Load, Flags, WriteBack, Post Dec */
-	      temp = LSBase - LSMNumRegs;
-	      LOADSMULT (instr, temp + 4L, temp);
-	      break;
+	case 0x87:		/* Load, Flags, WriteBack, Post Dec */
+	  temp = LSBase - LSMNumRegs;
+	  LOADSMULT (instr, temp + 4L, temp);
+	  break;
 
 
-	    case 0x88:		/* Store, No WriteBack, Post Inc */
-	      STOREMULT (instr, LSBase, 0L);
-	      break;
+	case 0x88:		/* Store, No WriteBack, Post Inc */
+	  STOREMULT (instr, LSBase, 0L);
+	  break;
 
-	    case 0x89:		/* Load, No WriteBack, Post Inc */
-	      LOADMULT (instr, LSBase, 0L);
-	      break;
+	case 0x89:		/* Load, No WriteBack, Post Inc */
+	  LOADMULT (instr, LSBase, 0L);
+	  break;
 
-	    case 0x8a:		/* Store, WriteBack, Post Inc */
-	      temp = LSBase;
-	      STOREMULT (instr, temp, temp + LSMNumRegs);
-	      break;
+	case 0x8a:		/* Store, WriteBack, Post Inc */
+	  temp = LSBase;
+	  STOREMULT (instr, temp, temp + LSMNumRegs);
+	  break;
 
-	    case 0x8b:		/* Load, WriteBack, Post Inc */
-	      temp = LSBase;
-	      LOADMULT (instr, temp, temp + LSMNumRegs);
-	      break;
+	case 0x8b:		/* Load, WriteBack, Post Inc */
+	  temp = LSBase;
+	  LOADMULT (instr, temp, temp + LSMNumRegs);
+	  break;
 
-	    case 0x8c:		/* Store, Flags, No WriteBack, Post Inc */
-	      STORESMULT (instr, LSBase, 0L);
-	      break;
+	case 0x8c:		/* Store, Flags, No WriteBack, Post Inc */
+	  STORESMULT (instr, LSBase, 0L);
+	  break;
 
-	    case 0x8d:		/* Load, Flags, No WriteBack, Post Inc */
-	      LOADSMULT (instr, LSBase, 0L);
-	      break;
+	case 0x8d:		/* Load, Flags, No WriteBack, Post Inc */
+	  LOADSMULT (instr, LSBase, 0L);
+	  break;
 
-	    case 0x8e:		/* Store, Flags, WriteBack, Post Inc */
-	      temp = LSBase;
-	      STORESMULT (instr, temp, temp + LSMNumRegs);
-	      break;
+	case 0x8e:		/* Store, Flags, WriteBack, Post Inc */
+	  temp = LSBase;
+	  STORESMULT (instr, temp, temp + LSMNumRegs);
+	  break;
 
-	    case 0x8f:		/* Load, Flags, WriteBack, Post Inc */
-	      temp = LSBase;
-	      LOADSMULT (instr, temp, temp + LSMNumRegs);
-	      break;
+	case 0x8f:		/* Load, Flags, WriteBack, Post Inc */
+	  temp = LSBase;
+	  LOADSMULT (instr, temp, temp + LSMNumRegs);
+	  break;
 
 
-	    case 0x90:		/* Store, No WriteBack, Pre Dec */
-	      STOREMULT (instr, LSBase - LSMNumRegs, 0L);
-	      break;
+	case 0x90:		/* Store, No WriteBack, Pre Dec */
+	  STOREMULT (instr, LSBase - LSMNumRegs, 0L);
+	  break;
 
-	    case 0x91:		/* Load, No WriteBack, Pre Dec */
-	      LOADMULT (instr, LSBase - LSMNumRegs, 0L);
-	      break;
+	case 0x91:		/* Load, No WriteBack, Pre Dec */
+	  LOADMULT (instr, LSBase - LSMNumRegs, 0L);
+	  break;
 
-	    case 0x92:		/* Store, WriteBack, Pre Dec */
-	      temp = LSBase - LSMNumRegs;
-	      STOREMULT (instr, temp, temp);
-	      break;
+	case 0x92:		/* Store, WriteBack, Pre Dec */
+	  temp = LSBase - LSMNumRegs;
+	  STOREMULT (instr, temp, temp);
+	  break;
 
-	    case 0x93:		/* Load, WriteBack, Pre Dec */
-	      temp = LSBase - LSMNumRegs;
-	      LOADMULT (instr, temp, temp);
-	      break;
+	case 0x93:		/* Load, WriteBack, Pre Dec */
+	  temp = LSBase - LSMNumRegs;
+	  LOADMULT (instr, temp, temp);
+	  break;
 
-	    case 0x94:		/* Store, Flags, No WriteBack, Pre Dec */
-	      STORESMULT (instr, LSBase - LSMNumRegs, 0L);
-	      break;
+	case 0x94:		/* Store, Flags, No WriteBack, Pre Dec */
+	  STORESMULT (instr, LSBase - LSMNumRegs, 0L);
+	  break;
 
-	    case 0x95:		/* Load, Flags, No WriteBack, Pre Dec */
-	      LOADSMULT (instr, LSBase - LSMNumRegs, 0L);
-	      break;
+	case 0x95:		/* Load, Flags, No WriteBack, Pre Dec */
+	  LOADSMULT (instr, LSBase - LSMNumRegs, 0L);
+	  break;
 
-	    case 0x96:		/* Store, Flags, WriteBack, Pre Dec */
-	      temp = LSBase - LSMNumRegs;
-	      STORESMULT (instr, temp, temp);
-	      break;
+	case 0x96:		/* Store, Flags, WriteBack, Pre Dec */
+	  temp = LSBase - LSMNumRegs;
+	  STORESMULT (instr, temp, temp);
+	  break;
 
-	    case 0x97:		/* Load, Flags, WriteBack, Pre Dec */
-	      temp = LSBase - LSMNumRegs;
-	      LOADSMULT (instr, temp, temp);
-	      break;
+	case 0x97:		/* Load, Flags, WriteBack, Pre Dec */
+	  temp = LSBase - LSMNumRegs;
+	  LOADSMULT (instr, temp, temp);
+	  break;
 
 
-	    case 0x98:		/* Store, No WriteBack, Pre Inc */
-	      STOREMULT (instr, LSBase + 4L, 0L);
-	      break;
+	case 0x98:		/* Store, No WriteBack, Pre Inc */
+	  STOREMULT (instr, LSBase + 4L, 0L);
+	  break;
 
-	    case 0x99:		/* Load, No WriteBack, Pre Inc */
-	      LOADMULT (instr, LSBase + 4L, 0L);
-	      break;
+	case 0x99:		/* Load, No WriteBack, Pre Inc */
+	  LOADMULT (instr, LSBase + 4L, 0L);
+	  break;
 
-	    case 0x9a:		/* Store, WriteBack, Pre Inc */
-	      temp = LSBase;
-	      STOREMULT (instr, temp + 4L, temp + LSMNumRegs);
-	      break;
+	case 0x9a:		/* Store, WriteBack, Pre Inc */
+	  temp = LSBase;
+	  STOREMULT (instr, temp + 4L, temp + LSMNumRegs);
+	  break;
 
-	    case 0x9b:		/* Load, WriteBack, Pre Inc */
-	      temp = LSBase;
-	      LOADMULT (instr, temp + 4L, temp + LSMNumRegs);
-	      break;
+	case 0x9b:		/* Load, WriteBack, Pre Inc */
+	  temp = LSBase;
+	  LOADMULT (instr, temp + 4L, temp + LSMNumRegs);
+	  break;
 
-	    case 0x9c:		/* Store, Flags, No WriteBack, Pre Inc */
-	      STORESMULT (instr, LSBase + 4L, 0L);
-	      break;
+	case 0x9c:		/* Store, Flags, No WriteBack, Pre Inc */
+	  STORESMULT (instr, LSBase + 4L, 0L);
+	  break;
 
-	    case 0x9d:		/* Load, Flags, No WriteBack, Pre Inc */
-	      LOADSMULT (instr, LSBase + 4L, 0L);
-	      break;
+	case 0x9d:		/* Load, Flags, No WriteBack, Pre Inc */
+	  LOADSMULT (instr, LSBase + 4L, 0L);
+	  break;
 
-	    case 0x9e:		/* Store, Flags, WriteBack, Pre Inc */
-	      temp = LSBase;
-	      STORESMULT (instr, temp + 4L, temp + LSMNumRegs);
-	      break;
+	case 0x9e:		/* Store, Flags, WriteBack, Pre Inc */
+	  temp = LSBase;
+	  STORESMULT (instr, temp + 4L, temp + LSMNumRegs);
+	  break;
 
-	    case 0x9f:		/* Load, Flags, WriteBack, Pre Inc */
-	      temp = LSBase;
-	      LOADSMULT (instr, temp + 4L, temp + LSMNumRegs);
-	      break;
+	case 0x9f:		/* Load, Flags, WriteBack, Pre Inc */
+	  temp = LSBase;
+	  LOADSMULT (instr, temp + 4L, temp + LSMNumRegs);
+	  break;
 
 /***************************************************************************\
 *                            Branch forward                                 *
 \***************************************************************************/
 
-	    case 0xa0:
-	    case 0xa1:
-	    case 0xa2:
-	    case 0xa3:
-	    case 0xa4:
-	    case 0xa5:
-	    case 0xa6:
-	    case 0xa7:
-	      state->Reg[15] = pc + 8 + POSBRANCH;
-	      FLUSHPIPE;
-	      break;
+	case 0xa0:
+	case 0xa1:
+	case 0xa2:
+	case 0xa3:
+	case 0xa4:
+	case 0xa5:
+	case 0xa6:
+	case 0xa7:
+	  state->Reg[15] = pc + 8 + POSBRANCH;
+	  FLUSHPIPE;
+	  break;
 
 /***************************************************************************\
 *                           Branch backward                                 *
 \***************************************************************************/
 
-	    case 0xa8:
-	    case 0xa9:
-	    case 0xaa:
-	    case 0xab:
-	    case 0xac:
-	    case 0xad:
-	    case 0xae:
-	    case 0xaf:
-	      state->Reg[15] = pc + 8 + NEGBRANCH;
-	      FLUSHPIPE;
-	      break;
+	case 0xa8:
+	case 0xa9:
+	case 0xaa:
+	case 0xab:
+	case 0xac:
+	case 0xad:
+	case 0xae:
+	case 0xaf:
+	  state->Reg[15] = pc + 8 + NEGBRANCH;
+	  FLUSHPIPE;
+	  break;
 
 /***************************************************************************\
 *                       Branch and Link forward                             *
 \***************************************************************************/
 
-	    case 0xb0:
-	    case 0xb1:
-	    case 0xb2:
-	    case 0xb3:
-	    case 0xb4:
-	    case 0xb5:
-	    case 0xb6:
-	    case 0xb7:
+	case 0xb0:
+	case 0xb1:
+	case 0xb2:
+	case 0xb3:
+	case 0xb4:
+	case 0xb5:
+	case 0xb6:
+	case 0xb7:
 #ifdef MODE32
-	      state->Reg[14] = pc + 4;	/* put PC into Link */
+	  state->Reg[14] = pc + 4;	/* put PC into Link */
 #else
-	      state->Reg[14] = (pc + 4) | ECC | ER15INT | EMODE;	/* put PC into Link */
+	  state->Reg[14] = (pc + 4) | ECC | ER15INT | EMODE;	/* put PC into Link */
 #endif
-	      state->Reg[15] = pc + 8 + POSBRANCH;
-	      FLUSHPIPE;
-	      break;
+	  state->Reg[15] = pc + 8 + POSBRANCH;
+	  if (state->ProfileCalls)
+	    ARMul_ProfileCall (state, pc, PC);
+	  FLUSHPIPE;
+	  break;
 
 /***************************************************************************\
 *                       Branch and Link backward                            *
 \***************************************************************************/
 
-	    case 0xb8:
-	    case 0xb9:
-	    case 0xba:
-	    case 0xbb:
-	    case 0xbc:
-	    case 0xbd:
-	    case 0xbe:
-	    case 0xbf:
+	case 0xb8:
+	case 0xb9:
+	case 0xba:
+	case 0xbb:
+	case 0xbc:
+	case 0xbd:
+	case 0xbe:
+	case 0xbf:
 #ifdef MODE32
-	      state->Reg[14] = pc + 4;	/* put PC into Link */
+	  state->Reg[14] = pc + 4;	/* put PC into Link */
 #else
-	      state->Reg[14] = (pc + 4) | ECC | ER15INT | EMODE;	/* put PC into Link */
+	  state->Reg[14] = (pc + 4) | ECC | ER15INT | EMODE;	/* put PC into Link */
 #endif
-	      state->Reg[15] = pc + 8 + NEGBRANCH;
-	      FLUSHPIPE;
-	      break;
+	  state->Reg[15] = pc + 8 + NEGBRANCH;
+	  if (state->ProfileCalls)
+	    ARMul_ProfileCall (state, pc, PC);
+	  FLUSHPIPE;
+	  break;
 
 /***************************************************************************\
 *                        Co-Processor Data Transfers                        *
 \***************************************************************************/
 
-	    case 0xc4:
-	    case 0xc0:		/* Store , No WriteBack , Post Dec */
-	      ARMul_STC (state, instr, LHS);
-	      break;
+	case 0xc4:
+	case 0xc0:		/* Store , No WriteBack , Post Dec */
+	  ARMul_STC (state, instr, LHS);
+	  break;
 
-	    case 0xc5:
-	    case 0xc1:		/* Load , No WriteBack , Post Dec */
-	      ARMul_LDC (state, instr, LHS);
-	      break;
+	case 0xc5:
+	case 0xc1:		/* Load , No WriteBack , Post Dec */
+	  ARMul_LDC (state, instr, LHS);
+	  break;
 
-	    case 0xc2:
-	    case 0xc6:		/* Store , WriteBack , Post Dec */
-	      lhs = LHS;
-	      state->Base = lhs - LSCOff;
-	      ARMul_STC (state, instr, lhs);
-	      break;
+	case 0xc2:
+	case 0xc6:		/* Store , WriteBack , Post Dec */
+	  lhs = LHS;
+	  state->Base = lhs - LSCOff;
+	  ARMul_STC (state, instr, lhs);
+	  break;
 
-	    case 0xc3:
-	    case 0xc7:		/* Load , WriteBack , Post Dec */
-	      lhs = LHS;
-	      state->Base = lhs - LSCOff;
-	      ARMul_LDC (state, instr, lhs);
-	      break;
+	case 0xc3:
+	case 0xc7:		/* Load , WriteBack , Post Dec */
+	  lhs = LHS;
+	  state->Base = lhs - LSCOff;
+	  ARMul_LDC (state, instr, lhs);
+	  break;
 
-	    case 0xc8:
-	    case 0xcc:		/* Store , No WriteBack , Post Inc */
-	      ARMul_STC (state, instr, LHS);
-	      break;
+	case 0xc8:
+	case 0xcc:		/* Store , No WriteBack , Post Inc */
+	  ARMul_STC (state, instr, LHS);
+	  break;
 
-	    case 0xc9:
-	    case 0xcd:		/* Load , No WriteBack , Post Inc */
-	      ARMul_LDC (state, instr, LHS);
-	      break;
+	case 0xc9:
+	case 0xcd:		/* Load , No WriteBack , Post Inc */
+	  ARMul_LDC (state, instr, LHS);
+	  break;
 
-	    case 0xca:
-	    case 0xce:		/* Store , WriteBack , Post Inc */
-	      lhs = LHS;
-	      state->Base = lhs + LSCOff;
-	      ARMul_STC (state, instr, LHS);
-	      break;
+	case 0xca:
+	case 0xce:		/* Store , WriteBack , Post Inc */
+	  lhs = LHS;
+	  state->Base = lhs + LSCOff;
+	  ARMul_STC (state, instr, LHS);
+	  break;
 
-	    case 0xcb:
-	    case 0xcf:		/* Load , WriteBack , Post Inc */
-	      lhs = LHS;
-	      state->Base = lhs + LSCOff;
-	      ARMul_LDC (state, instr, LHS);
-	      break;
+	case 0xcb:
+	case 0xcf:		/* Load , WriteBack , Post Inc */
+	  lhs = LHS;
+	  state->Base = lhs + LSCOff;
+	  ARMul_LDC (state, instr, LHS);
+	  break;
 
 
-	    case 0xd0:
-	    case 0xd4:		/* Store , No WriteBack , Pre Dec */
-	      ARMul_STC (state, instr, LHS - LSCOff);
-	      break;
+	case 0xd0:
+	case 0xd4:		/* Store , No WriteBack , Pre Dec */
+	  ARMul_STC (state, instr, LHS - LSCOff);
+	  break;
 
-	    case 0xd1:
-	    case 0xd5:		/* Load , No WriteBack , Pre Dec */
-	      ARMul_LDC (state, instr, LHS - LSCOff);
-	      break;
+	case 0xd1:
+	case 0xd5:		/* Load , No WriteBack , Pre Dec */
+	  ARMul_LDC (state, instr, LHS - LSCOff);
+	  break;
 
-	    case 0xd2:
-	    case 0xd6:		/* Store , WriteBack , Pre Dec */
-	      lhs = LHS - LSCOff;
-	      state->Base = lhs;
-	      ARMul_STC (state, instr, lhs);
-	      break;
+	case 0xd2:
+	case 0xd6:		/* Store , WriteBack , Pre Dec */
+	  lhs = LHS - LSCOff;
+	  state->Base = lhs;
+	  ARMul_STC (state, instr, lhs);
+	  break;
 
-	    case 0xd3:
-	    case 0xd7:		/* Load , WriteBack , Pre Dec */
-	      lhs = LHS - LSCOff;
-	      state->Base = lhs;
-	      ARMul_LDC (state, instr, lhs);
-	      break;
+	case 0xd3:
+	case 0xd7:		/* Load , WriteBack , Pre Dec */
+	  lhs = LHS - LSCOff;
+	  state->Base = lhs;
+	  ARMul_LDC (state, instr, lhs);
+	  break;
 
-	    case 0xd8:
-	    case 0xdc:		/* Store , No WriteBack , Pre Inc */
-	      ARMul_STC (state, instr, LHS + LSCOff);
-	      break;
+	case 0xd8:
+	case 0xdc:		/* Store , No WriteBack , Pre Inc */
+	  ARMul_STC (state, instr, LHS + LSCOff);
+	  break;
 
-	    case 0xd9:
-	    case 0xdd:		/* Load , No WriteBack , Pre Inc */
-	      ARMul_LDC (state, instr, LHS + LSCOff);
-	      break;
+	case 0xd9:
+	case 0xdd:		/* Load , No WriteBack , Pre Inc */
+	  ARMul_LDC (state, instr, LHS + LSCOff);
+	  break;
 
-	    case 0xda:
-	    case 0xde:		/* Store , WriteBack , Pre Inc */
-	      lhs = LHS + LSCOff;
-	      state->Base = lhs;
-	      ARMul_STC (state, instr, lhs);
-	      break;
+	case 0xda:
+	case 0xde:		/* Store , WriteBack , Pre Inc */
+	  lhs = LHS + LSCOff;
+	  state->Base = lhs;
+	  ARMul_STC (state, instr, lhs);
+	  break;
 
-	    case 0xdb:
-	    case 0xdf:		/* Load , WriteBack , Pre Inc */
-	      lhs = LHS + LSCOff;
-	      state->Base = lhs;
-	      ARMul_LDC (state, instr, lhs);
-	      break;
+	case 0xdb:
+	case 0xdf:		/* Load , WriteBack , Pre Inc */
+	  lhs = LHS + LSCOff;
+	  state->Base = lhs;
+	  ARMul_LDC (state, instr, lhs);
+	  break;
 
 /***************************************************************************\
 *            Co-Processor Register Transfers (MCR) and Data Ops             *
 \***************************************************************************/
 
-	    case 0xe2:
-	    case 0xe0:
-	    case 0xe4:
-	    case 0xe6:
-	    case 0xe8:
-	    case 0xea:
-	    case 0xec:
-	    case 0xee:
-	      if (BIT (4))
-		{		/* MCR */
-		  if (DESTReg == 15)
-		    {
-		      UNDEF_MCRPC;
+	case 0xe2:
+	case 0xe0:
+	case 0xe4:
+	case 0xe6:
+	case 0xe8:
+	case 0xea:
+	case 0xec:
+	case 0xee:
+	  if (BIT (4))
+	    {		/* MCR */
+	      if (DESTReg == 15)
+		{
+		  UNDEF_MCRPC;
 #ifdef MODE32
-		      ARMul_MCR (state, instr, state->Reg[15] + isize);
+		  ARMul_MCR (state, instr, state->Reg[15] + ISIZE);
 #else
-		      ARMul_MCR (state, instr, ECC | ER15INT | EMODE |
-				 ((state->Reg[15] + isize) & R15PCBITS));
+		  ARMul_MCR (state, instr, ECC | ER15INT | EMODE |
+			     ((state->Reg[15] + ISIZE) & R15PCBITS));
 #endif
-		    }
-		  else
-		    ARMul_MCR (state, instr, DEST);
 		}
-	      else		/* CDP Part 1 */
-		ARMul_CDP (state, instr);
-	      break;
+	      else
+		ARMul_MCR (state, instr, DEST);
+	    }
+	  else		/* CDP Part 1 */
+	    ARMul_CDP (state, instr);
+	  break;
 
 /***************************************************************************\
 *            Co-Processor Register Transfers (MRC) and Data Ops             *
 \***************************************************************************/
 
-	    case 0xe1:
-	    case 0xe3:
-	    case 0xe5:
-	    case 0xe7:
-	    case 0xe9:
-	    case 0xeb:
-	    case 0xed:
-	    case 0xef:
-	      if (BIT (4))
-		{		/* MRC */
-		  temp = ARMul_MRC (state, instr);
-		  if (DESTReg == 15)
-		    {
-		      ASSIGNN ((temp & NBIT) != 0);
-		      ASSIGNZ ((temp & ZBIT) != 0);
-		      ASSIGNC ((temp & CBIT) != 0);
-		      ASSIGNV ((temp & VBIT) != 0);
-		    }
-		  else
-		    DEST = temp;
-		}
-	      else		/* CDP Part 2 */
-		ARMul_CDP (state, instr);
-	      break;
+	case 0xe1:
+	case 0xe3:
+	case 0xe5:
+	case 0xe7:
+	case 0xe9:
+	case 0xeb:
+	case 0xed:
+	case 0xef:
+	  if (BIT (4))
+	    {		/* MRC */
+	      temp = ARMul_MRC (state, instr);
+	      if (DESTReg == 15)
+		ASSIGNNZCV (temp);
+	      else
+		DEST = temp;
+	    }
+	  else		/* CDP Part 2 */
+	    ARMul_CDP (state, instr);
+	  break;
 
 /***************************************************************************\
 *                             SWI instruction                               *
 \***************************************************************************/
 
-	    case 0xf0:
-	    case 0xf1:
-	    case 0xf2:
-	    case 0xf3:
-	    case 0xf4:
-	    case 0xf5:
-	    case 0xf6:
-	    case 0xf7:
-	    case 0xf8:
-	    case 0xf9:
-	    case 0xfa:
-	    case 0xfb:
-	    case 0xfc:
-	    case 0xfd:
-	    case 0xfe:
-	    case 0xff:
-	      if (instr == ARMul_ABORTWORD && state->AbortAddr == pc)
-		{		/* a prefetch abort */
-		  ARMul_Abort (state, ARMul_PrefetchAbortV);
-		  break;
-		}
-
-	      if (!ARMul_OSHandleSWI (state, BITS (0, 23)))
-		{
-		  ARMul_Abort (state, ARMul_SWIV);
-		}
+	case 0xf0:
+	case 0xf1:
+	case 0xf2:
+	case 0xf3:
+	case 0xf4:
+	case 0xf5:
+	case 0xf6:
+	case 0xf7:
+	case 0xf8:
+	case 0xf9:
+	case 0xfa:
+	case 0xfb:
+	case 0xfc:
+	case 0xfd:
+	case 0xfe:
+	case 0xff:
+	  if (instr == ARMul_ABORTWORD && state->AbortAddr == pc)
+	    {		/* a prefetch abort */
+	      ARMul_Abort (state, ARMul_PrefetchAbortV);
 	      break;
-	    }			/* 256 way main switch */
-	}			/* if temp */
-
-#ifdef MODET
-    donext:
-#endif
-
-#ifdef NEED_UI_LOOP_HOOK
-      if (ui_loop_hook != NULL && ui_loop_hook_counter-- < 0)
-	{
-	  ui_loop_hook_counter = UI_LOOP_POLL_INTERVAL;
-	  ui_loop_hook (0);
-	}
-#endif /* NEED_UI_LOOP_HOOK */
-
-      if (state->Emulate == ONCE)
-	state->Emulate = STOP;
-      else if (state->Emulate != RUN)
-	break;
-    }
-  while (!stop_simulator);	/* do loop */
+	    }
 
-  state->decoded = decoded;
-  state->loaded = loaded;
-  state->pc = pc;
-  return (pc);
-}				/* Emulate 26/32 in instruction based mode */
+	  if (!ARMul_OSHandleSWI (state, BITS (0, 23)))
+	    {
+	      ARMul_Abort (state, ARMul_SWIV);
+	    }
+	  break;
+	}			/* 256 way main switch */
+    }			/* if temp */
+}
 
 
 /***************************************************************************\
@@ -3225,7 +3179,7 @@ GetLS7RHS (ARMul_State * state, ARMword instr)
 static unsigned
 LoadWord (ARMul_State * state, ARMword instr, ARMword address)
 {
-  ARMword dest;
+  ARMword dest, from = PC - 8;	/* this instruction */
 
   BUSUSEDINCPCS;
 #ifndef MODE32
@@ -3243,6 +3197,8 @@ LoadWord (ARMul_State * state, ARMword instr, ARMword address)
   if (address & 3)
     dest = ARMul_Align (state, address, dest);
   WRITEDEST (dest);
+  if (DESTReg == 15 && state->ProfileCalls)
+    ARMul_ProfileReturn (state, from, PC);
   ARMul_Icycles (state, 1, 0L);
 
   return (DESTReg != LHSReg);
@@ -3429,7 +3385,7 @@ StoreByte (ARMul_State * state, ARMword instr, ARMword address)
 static void
 LoadMult (ARMul_State * state, ARMword instr, ARMword address, ARMword WBBase)
 {
-  ARMword dest, temp;
+  ARMword dest, temp, from = PC - 8;	/* this instruction */
 
   UNDEF_LSMNoRegs;
   UNDEF_LSMPCBase;
@@ -3468,6 +3424,8 @@ LoadMult (ARMul_State * state, ARMword instr, ARMword address, ARMword WBBase)
       state->Reg[15] = PC;
 #endif
       FLUSHPIPE;
+      if (state->ProfileCalls)
+	ARMul_ProfileReturn (state, from, PC);
     }
 
   ARMul_Icycles (state, 1, 0L);	/* to write back the final register */
@@ -3491,7 +3449,7 @@ static void
 LoadSMult (ARMul_State * state, ARMword instr,
 	   ARMword address, ARMword WBBase)
 {
-  ARMword dest, temp;
+  ARMword dest, temp, from = PC - 8;	/* this instruction */
 
   UNDEF_LSMNoRegs;
   UNDEF_LSMPCBase;
@@ -3542,16 +3500,13 @@ LoadSMult (ARMul_State * state, ARMword instr,
       state->Reg[15] = PC;
 #else
       if (state->Mode == USER26MODE || state->Mode == USER32MODE)
-	{			/* protect bits in user mode */
-	  ASSIGNN ((state->Reg[15] & NBIT) != 0);
-	  ASSIGNZ ((state->Reg[15] & ZBIT) != 0);
-	  ASSIGNC ((state->Reg[15] & CBIT) != 0);
-	  ASSIGNV ((state->Reg[15] & VBIT) != 0);
-	}
+	ASSIGNNZCV (state->Reg[15]);	/* protect bits in user mode */
       else
 	ARMul_R15Altered (state);
 #endif
       FLUSHPIPE;
+      if (state->ProfileCalls)
+	ARMul_ProfileReturn (state, from, PC);
     }
 
   if (!BIT (15) && state->Mode != USER26MODE && state->Mode != USER32MODE)
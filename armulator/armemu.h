@@ -18,7 +18,6 @@
 #ifndef ARMEMU_H
 #define ARMEMU_H
 
-extern ARMword isize;
 
 /***************************************************************************\
 *                           Condition code values                           *
@@ -78,25 +77,103 @@ extern ARMword isize;
 #define ASSIGNT(res) state->TFlag = res
 #endif
 
-#define NFLAG state->NFlag
-#define SETN state->NFlag = 1
-#define CLEARN state->NFlag = 0
-#define ASSIGNN(res) state->NFlag = res
+/* The condition flags are evaluated lazily.  An S instruction just
+   records its operands and result in FlagA, FlagB and FlagRes, and
+   FlagOp says which of NFlag, ZFlag, CFlag and VFlag are to be derived
+   from them when next read: */
+#define LAZY_NONE 0		/* all four are up to date */
+#define LAZY_NZ 1		/* N and Z from FlagRes, C and V up to date */
+#define LAZY_ADD 2		/* all four from FlagRes = FlagA + FlagB (+ C) */
+#define LAZY_SUB 3		/* all four from FlagRes = FlagA - FlagB (- !C) */
+
+/* The carry and overflow out of the top bit, as ARMul_AddCarry() etc. */
+#define ADDCARRY(a,b,r) ((((a) & (b)) | (((a) | (b)) & ~(r))) >> 31)
+#define SUBCARRY(a,b,r) ((((a) & ~(b)) | (((a) | ~(b)) & ~(r))) >> 31)
+#define ADDOVERFLOW(a,b,r) ((((a) ^ (r)) & ((b) ^ (r))) >> 31)
+#define SUBOVERFLOW(a,b,r) ((((a) ^ (b)) & ((a) ^ (r))) >> 31)
+
+static inline ARMword
+ARMul_LazyN (ARMul_State * state)
+{
+  return state->FlagOp != LAZY_NONE ? state->FlagRes >> 31 : state->NFlag;
+}
+
+static inline ARMword
+ARMul_LazyZ (ARMul_State * state)
+{
+  return state->FlagOp != LAZY_NONE ? state->FlagRes == 0 : state->ZFlag;
+}
 
-#define ZFLAG state->ZFlag
-#define SETZ state->ZFlag = 1
-#define CLEARZ state->ZFlag = 0
-#define ASSIGNZ(res) state->ZFlag = res
+static inline ARMword
+ARMul_LazyC (ARMul_State * state)
+{
+  switch (state->FlagOp)
+    {
+    case LAZY_ADD:
+      return ADDCARRY (state->FlagA, state->FlagB, state->FlagRes);
+    case LAZY_SUB:
+      return SUBCARRY (state->FlagA, state->FlagB, state->FlagRes);
+    default:
+      return state->CFlag;
+    }
+}
 
-#define CFLAG state->CFlag
-#define SETC state->CFlag = 1
-#define CLEARC state->CFlag = 0
-#define ASSIGNC(res) state->CFlag = res
+static inline ARMword
+ARMul_LazyV (ARMul_State * state)
+{
+  switch (state->FlagOp)
+    {
+    case LAZY_ADD:
+      return ADDOVERFLOW (state->FlagA, state->FlagB, state->FlagRes);
+    case LAZY_SUB:
+      return SUBOVERFLOW (state->FlagA, state->FlagB, state->FlagRes);
+    default:
+      return state->VFlag;
+    }
+}
 
-#define VFLAG state->VFlag
-#define SETV state->VFlag = 1
-#define CLEARV state->VFlag = 0
-#define ASSIGNV(res) state->VFlag = res
+/* Bring NFlag..VFlag up to date, before writing one of them, or for code
+   (the JIT) that reads them directly.  FLAGSYNCCV only needs C and V. */
+#define FLAGSYNC if (state->FlagOp != LAZY_NONE) ARMul_FlagSync (state)
+#define FLAGSYNCCV if (state->FlagOp >= LAZY_ADD) ARMul_FlagSync (state)
+
+#define SETNZ(res) do { FLAGSYNCCV; \
+                        state->FlagOp = LAZY_NZ; \
+                        state->FlagRes = (res); } while (0)
+#define SETADD(a,b,res) do { state->FlagOp = LAZY_ADD; \
+                             state->FlagA = (a); \
+                             state->FlagB = (b); \
+                             state->FlagRes = (res); } while (0)
+#define SETSUB(a,b,res) do { state->FlagOp = LAZY_SUB; \
+                             state->FlagA = (a); \
+                             state->FlagB = (b); \
+                             state->FlagRes = (res); } while (0)
+/* All four at once from the top bits of a PSR */
+#define ASSIGNNZCV(psr) do { state->FlagOp = LAZY_NONE; \
+                             state->NFlag = ((psr) & NBIT) != 0; \
+                             state->ZFlag = ((psr) & ZBIT) != 0; \
+                             state->CFlag = ((psr) & CBIT) != 0; \
+                             state->VFlag = ((psr) & VBIT) != 0; } while (0)
+
+#define NFLAG ARMul_LazyN (state)
+#define SETN do { FLAGSYNC; state->NFlag = 1; } while (0)
+#define CLEARN do { FLAGSYNC; state->NFlag = 0; } while (0)
+#define ASSIGNN(res) do { FLAGSYNC; state->NFlag = res; } while (0)
+
+#define ZFLAG ARMul_LazyZ (state)
+#define SETZ do { FLAGSYNC; state->ZFlag = 1; } while (0)
+#define CLEARZ do { FLAGSYNC; state->ZFlag = 0; } while (0)
+#define ASSIGNZ(res) do { FLAGSYNC; state->ZFlag = res; } while (0)
+
+#define CFLAG ARMul_LazyC (state)
+#define SETC do { FLAGSYNCCV; state->CFlag = 1; } while (0)
+#define CLEARC do { FLAGSYNCCV; state->CFlag = 0; } while (0)
+#define ASSIGNC(res) do { FLAGSYNCCV; state->CFlag = res; } while (0)
+
+#define VFLAG ARMul_LazyV (state)
+#define SETV do { FLAGSYNCCV; state->VFlag = 1; } while (0)
+#define CLEARV do { FLAGSYNCCV; state->VFlag = 0; } while (0)
+#define ASSIGNV(res) do { FLAGSYNCCV; state->VFlag = res; } while (0)
 
 
 #define IFLAG (state->IFFlags >> 1)
@@ -167,10 +244,7 @@ extern ARMword isize;
 #define SETCC(d,s) d = ((d) & (INTBITS | MODEBITS)) | ((s) & CCBITS)
 #define SETR15PSR(s) if (state->Mode == USER26MODE) { \
                         state->Reg[15] = ((s) & CCBITS) | R15PC | ER15INT | EMODE ; \
-                        ASSIGNN((state->Reg[15] & NBIT) != 0) ; \
-                        ASSIGNZ((state->Reg[15] & ZBIT) != 0) ; \
-                        ASSIGNC((state->Reg[15] & CBIT) != 0) ; \
-                        ASSIGNV((state->Reg[15] & VBIT) != 0) ; \
+                        ASSIGNNZCV(state->Reg[15]) ; \
                         } \
                      else { \
                         state->Reg[15] = R15PC | ((s) & (CCBITS | R15INTBITS | R15MODEBITS)) ; \
@@ -219,14 +293,36 @@ extern ARMword isize;
 
 #define NORMALCYCLE state->NextInstr = 0
 #define BUSUSEDN state->NextInstr |= 1	/* the next fetch will be an N cycle */
-#define BUSUSEDINCPCS state->Reg[15] += isize ; /* a standard PC inc and an S cycle */ \
+
+/* The PC pipeline value depends on whether ARM or Thumb instructions
+   are being executed: */
+#ifdef MODET
+#define ISIZE state->isize
+#else
+#define ISIZE 4
+#endif
+
+#define BUSUSEDINCPCS state->Reg[15] += ISIZE ; /* a standard PC inc and an S cycle */ \
                       state->NextInstr = (state->NextInstr & 0xff) | 2
-#define BUSUSEDINCPCN state->Reg[15] += isize ; /* a standard PC inc and an N cycle */ \
+#define BUSUSEDINCPCN state->Reg[15] += ISIZE ; /* a standard PC inc and an N cycle */ \
                       state->NextInstr |= 3
-#define INCPC state->Reg[15] += isize ; /* a standard PC inc */ \
+#define INCPC state->Reg[15] += ISIZE ; /* a standard PC inc */ \
               state->NextInstr |= 2
 #define FLUSHPIPE state->NextInstr |= PRIMEPIPE
 
+/* Only the ARMUL_CYCLES build counts cycles (see armopts.h) */
+#ifdef ARMUL_CYCLES
+#define MULCYCLES(rhs) { ARMword bit_, top_ = 0; \
+                         for (bit_ = 0; bit_ < 32; bit_++) \
+                           if ((rhs) & (1L << bit_)) \
+                             top_ = bit_; /* mult takes this many/2 I cycles */ \
+                         ARMul_Icycles (state, ARMul_MultTable[top_], 0L); }
+#else
+#define MULCYCLES(rhs)
+#define ARMul_Icycles(state, number, address)
+#define ARMul_Ccycles(state, number, address)
+#endif
+
 /***************************************************************************\
 *                          Cycle based emulation                            *
 \***************************************************************************/
@@ -326,9 +422,23 @@ extern ARMword isize;
                          WriteSR15(state, d) ; \
                       else { \
                          DEST = d ; \
-                         ARMul_NegZero(state, d) ; \
+                         SETNZ(d) ; \
                          }
 
+#define WRITEADDDEST(a,b,d) if (DESTReg == 15) \
+                               WriteSR15(state, d) ; \
+                            else { \
+                               DEST = d ; \
+                               SETADD(a, b, d) ; \
+                               }
+
+#define WRITESUBDEST(a,b,d) if (DESTReg == 15) \
+                               WriteSR15(state, d) ; \
+                            else { \
+                               DEST = d ; \
+                               SETSUB(a, b, d) ; \
+                               }
+
 #define BYTETOBUS(data) ((data & 0xff) | \
                         ((data & 0xff) << 8) | \
                         ((data & 0xff) << 16) | \
@@ -361,7 +471,13 @@ extern ARMword isize;
 \***************************************************************************/
 
 extern ARMword ARMul_Emulate26 (ARMul_State * state);
+extern ARMword ARMul_Emulate26Trace (ARMul_State * state);
+extern ARMword ARMul_Emulate26Fast (ARMul_State * state);
 extern ARMword ARMul_Emulate32 (ARMul_State * state);
+extern ARMword ARMul_Emulate32Trace (ARMul_State * state);
+extern ARMword ARMul_Emulate32Fast (ARMul_State * state);
+extern void ARMul_Execute26 (ARMul_State * state, ARMword instr, ARMword pc);
+extern void ARMul_Execute32 (ARMul_State * state, ARMword instr, ARMword pc);
 extern unsigned ARMul_MultTable[];	/* Number of I cycles for a mult */
 extern ARMword ARMul_ImmedTable[];	/* immediate DP LHS values */
 extern char ARMul_BitList[];	/* number of bits in a byte table */
@@ -370,6 +486,7 @@ extern void ARMul_Abort32 (ARMul_State * state, ARMword);
 extern unsigned ARMul_NthReg (ARMword instr, unsigned number);
 extern void ARMul_MSRCpsr (ARMul_State * state, ARMword instr, ARMword rhs);
 extern void ARMul_NegZero (ARMul_State * state, ARMword result);
+extern void ARMul_FlagSync (ARMul_State * state);
 extern void ARMul_AddCarry (ARMul_State * state, ARMword a, ARMword b,
 			    ARMword result);
 extern int AddOverflow (ARMword a, ARMword b, ARMword result);
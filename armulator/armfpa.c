@@ -0,0 +1,755 @@
+/*  armfpa.c -- FPA10 floating point coprocessor:  ARM6 Instruction Emulator.
+    Copyright (C) 2022 Matt Evans
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA. */
+
+/* The FPA instruction set done with the host's floating point, rather
+   than by an FPE run from the undefined instruction vector:
+
+   CP1	LDF/STF, the CPDO arithmetic and the CPRT transfers and compares
+   CP2	LFM/SFM
+
+   F0-F7 are held as long double, which on x86 hosts is exactly the FPA's
+   extended precision.  Results are rounded once to the precision the
+   instruction asks for; the basic operations are done in float or
+   double when their operands fit, so that they aren't rounded twice.
+
+   Exceptions are collected from the host's fenv into the FPSR.  One
+   whose trap is enabled makes the instruction undefined, as an FPA10
+   would hand it to its support code.  */
+
+#include <fenv.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "armdefs.h"
+#include "armemu.h"
+#include "armfpa.h"
+#include "ansidecl.h"
+
+typedef struct
+{
+  long double F[8];
+  ARMword fpsr, fpcr;
+  ARMword buf[12];		/* words of an LDF/STF/LFM/SFM */
+  unsigned nwords, word;
+} ARMul_FPA;
+
+#define FPA(state) ((ARMul_FPA *) (state)->CPData[FPA_CP])
+
+/* FPSR: system ID, trap enables (<< 16) and cumulative flags */
+#define FPSR_ID 0x81000000	/* FPA10 */
+#define FPSR_WRITABLE 0x001f1f1f
+#define IVO 0x01
+#define DVZ 0x02
+#define OFL 0x04
+#define UFL 0x08
+#define INX 0x10
+
+/* Precision, from bits 19 and 7 of CPDO/CPRT or 22 and 15 of LDF/STF */
+#define PREC_S 0
+#define PREC_D 1
+#define PREC_E 2
+#define PREC_P 3		/* packed decimal, LDF/STF only */
+
+/* CPDO operations: BITS (20, 23), plus 16 for the monadic ones */
+#define ADF 0
+#define MUF 1
+#define SUF 2
+#define RSF 3
+#define DVF 4
+#define RDF 5
+#define POW 6
+#define RPW 7
+#define RMF 8
+#define FML 9
+#define FDV 10
+#define FRD 11
+#define POL 12
+#define MVF 16
+#define MNF 17
+#define ABS 18
+#define RND 19
+#define SQT 20
+#define LOG 21
+#define LGN 22
+#define EXP 23
+#define SIN 24
+#define COS 25
+#define TAN 26
+#define ASN 27
+#define ACS 28
+#define ATN 29
+#define URD 30
+#define NRM 31
+
+/* CPRT operations, BITS (20, 23) */
+#define FLT 0
+#define FIX 1
+#define WFS 2
+#define RFS 3
+#define WFC 4
+#define RFC 5
+#define CMF 9
+#define CNF 11
+#define CMFE 13
+#define CNFE 15
+
+static const long double Constants[8] = {
+  0.0L, 1.0L, 2.0L, 3.0L, 4.0L, 5.0L, 0.5L, 10.0L
+};
+
+static const int RoundingModes[4] = {
+  FE_TONEAREST, FE_UPWARD, FE_DOWNWARD, FE_TOWARDZERO
+};
+
+/***************************************************************************\
+*                       Rounding and exceptions                             *
+\***************************************************************************/
+
+/* The volatiles keep the compiler from moving arithmetic across the
+   fenv calls.  */
+
+static long double
+Round (long double x, unsigned prec)
+{
+  volatile float f;
+  volatile double d;
+
+  switch (prec)
+    {
+    case PREC_S:
+      f = x;
+      return f;
+    case PREC_D:
+      d = x;
+      return d;
+    default:
+      return x;
+    }
+}
+
+static void
+Begin (ARMword instr)
+{
+  feclearexcept (FE_ALL_EXCEPT);
+  if (BITS (5, 6) != 0)
+    fesetround (RoundingModes[BITS (5, 6)]);
+}
+
+/* Returns TRUE if the instruction must trap, else accumulates flags */
+static int
+End (ARMul_FPA * fpa, ARMword instr, ARMword extra)
+{
+  int raised = fetestexcept (FE_ALL_EXCEPT);
+  ARMword flags = extra;
+
+  if (BITS (5, 6) != 0)
+    fesetround (FE_TONEAREST);
+  if (raised & FE_INVALID)
+    flags |= IVO;
+  if (raised & FE_DIVBYZERO)
+    flags |= DVZ;
+  if (raised & FE_OVERFLOW)
+    flags |= OFL;
+  if (raised & FE_UNDERFLOW)
+    flags |= UFL;
+  if (raised & FE_INEXACT)
+    flags |= INX;
+
+  if (flags & (fpa->fpsr >> 16))
+    return TRUE;
+  fpa->fpsr |= flags;
+  return FALSE;
+}
+
+/***************************************************************************\
+*                             Arithmetic                                    *
+\***************************************************************************/
+
+/* The correctly rounded operations, done at precision type if a and b
+   are representable in it (NaNs never are, and go the long way).  */
+#define FPA_BASIC(name, type, sqrtfn)					\
+static int								\
+name (unsigned op, long double a, long double b, long double *r)	\
+{									\
+  volatile type x = a, y = b, z;					\
+									\
+  if (x != a || y != b)							\
+    return FALSE;							\
+  switch (op)								\
+    {									\
+    case ADF: z = x + y; break;						\
+    case MUF: case FML: z = x * y; break;				\
+    case SUF: z = x - y; break;						\
+    case RSF: z = y - x; break;						\
+    case DVF: case FDV: z = x / y; break;				\
+    case RDF: case FRD: z = y / x; break;				\
+    case MVF: z = y; break;						\
+    case MNF: z = -y; break;						\
+    case ABS: z = signbit (y) ? -y : y; break;				\
+    case SQT: z = sqrtfn (y); break;					\
+    default: return FALSE;						\
+    }									\
+  *r = z;								\
+  return TRUE;								\
+}
+
+FPA_BASIC (BasicS, float, sqrtf)
+FPA_BASIC (BasicD, double, sqrt)
+
+static long double
+Extended (unsigned op, long double a, long double b)
+{
+  volatile long double x = a, y = b;
+
+  switch (op)
+    {
+    case ADF:
+      return x + y;
+    case MUF:
+    case FML:
+      return x * y;
+    case SUF:
+      return x - y;
+    case RSF:
+      return y - x;
+    case DVF:
+    case FDV:
+      return x / y;
+    case RDF:
+    case FRD:
+      return y / x;
+    case POW:
+      return powl (x, y);
+    case RPW:
+      return powl (y, x);
+    case RMF:
+      return remainderl (x, y);
+    case POL:
+      return atan2l (x, y);
+    case MVF:
+    case NRM:
+      return y;
+    case MNF:
+      return -y;
+    case ABS:
+      return fabsl (y);
+    case RND:
+    case URD:
+      return nearbyintl (y);
+    case SQT:
+      return sqrtl (y);
+    case LOG:
+      return log10l (y);
+    case LGN:
+      return logl (y);
+    case EXP:
+      return expl (y);
+    case SIN:
+      return sinl (y);
+    case COS:
+      return cosl (y);
+    case TAN:
+      return tanl (y);
+    case ASN:
+      return asinl (y);
+    case ACS:
+      return acosl (y);
+    default:			/* ATN */
+      return atanl (y);
+    }
+}
+
+/* Fm, or one of the constants if bit 3 is set */
+static long double
+OperandM (ARMul_FPA * fpa, ARMword instr)
+{
+  return BIT (3) ? Constants[BITS (0, 2)] : fpa->F[BITS (0, 2)];
+}
+
+unsigned
+ARMul_FPACDP (ARMul_State * state, unsigned type, ARMword instr)
+{
+  ARMul_FPA *fpa = FPA (state);
+  unsigned op = BITS (20, 23) | (BIT (15) << 4);
+  unsigned prec = (BIT (19) << 1) | BIT (7);
+  long double a, b, r;
+  int done;
+
+  if (type != ARMul_FIRST)
+    return ARMul_DONE;
+  if (CPNum != FPA_CP || prec == PREC_P || (op > POL && op < MVF))
+    return ARMul_CANT;
+  if (op == FML || op == FDV || op == FRD)
+    prec = PREC_S;		/* the fast ones are only single */
+
+  a = fpa->F[BITS (16, 18)];
+  b = OperandM (fpa, instr);
+
+  Begin (instr);
+  if (prec == PREC_S)
+    done = BasicS (op, a, b, &r);
+  else if (prec == PREC_D)
+    done = BasicD (op, a, b, &r);
+  else
+    done = FALSE;
+  if (!done)
+    r = Round (Extended (op, a, b), prec);
+  if (End (fpa, instr, 0))
+    return ARMul_CANT;
+
+  fpa->F[BITS (12, 14)] = r;
+  return ARMul_DONE;
+}
+
+/***************************************************************************\
+*                         Register transfers                                *
+\***************************************************************************/
+
+static int
+Privileged (ARMul_State * state)
+{
+  return state->Mode != USER26MODE && state->Mode != USER32MODE;
+}
+
+unsigned
+ARMul_FPAMCR (ARMul_State * state, unsigned type, ARMword instr,
+	      ARMword value)
+{
+  ARMul_FPA *fpa = FPA (state);
+  long double r;
+
+  if (type != ARMul_FIRST)
+    return ARMul_DONE;
+  switch (BITS (20, 23))
+    {
+    case FLT:
+      if (BIT (19) && BIT (7))
+	return ARMul_CANT;
+      Begin (instr);
+      r = Round ((long double) (int32_t) value, (BIT (19) << 1) | BIT (7));
+      if (End (fpa, instr, 0))
+	return ARMul_CANT;
+      fpa->F[BITS (16, 18)] = r;
+      return ARMul_DONE;
+
+    case WFS:
+      fpa->fpsr = (fpa->fpsr & ~FPSR_WRITABLE) | (value & FPSR_WRITABLE);
+      return ARMul_DONE;
+
+    case WFC:
+      if (!Privileged (state))
+	return ARMul_CANT;
+      fpa->fpcr = value;
+      return ARMul_DONE;
+
+    default:
+      return ARMul_CANT;
+    }
+}
+
+/* Compares go to the ARM flags, as an MRC to R15 */
+static unsigned
+Compare (ARMul_FPA * fpa, ARMword instr, ARMword * value)
+{
+  unsigned op = BITS (20, 23);
+  long double a = fpa->F[BITS (16, 18)], b = OperandM (fpa, instr);
+
+  if (op == CNF || op == CNFE)
+    b = -b;
+
+  Begin (instr);
+  if (isunordered (a, b))
+    {
+      *value = CBIT | VBIT;
+      if (End (fpa, instr, op == CMFE || op == CNFE ? IVO : 0))
+	return ARMul_CANT;
+      return ARMul_DONE;
+    }
+  if (a == b)
+    *value = ZBIT | CBIT;
+  else if (a < b)
+    *value = NBIT;
+  else
+    *value = CBIT;
+  if (End (fpa, instr, 0))
+    return ARMul_CANT;
+  return ARMul_DONE;
+}
+
+unsigned
+ARMul_FPAMRC (ARMul_State * state, unsigned type, ARMword instr,
+	      ARMword * value)
+{
+  ARMul_FPA *fpa = FPA (state);
+  long double x, r;
+  ARMword invalid = 0;
+
+  if (type != ARMul_FIRST)
+    return ARMul_DONE;
+  switch (BITS (20, 23))
+    {
+    case FIX:
+      x = fpa->F[BITS (0, 2)];
+      Begin (instr);
+      r = nearbyintl (x);
+      if (isnan (r) || r > 2147483647.0L || r < -2147483648.0L)
+	{			/* saturate, as the FPA does */
+	  invalid = IVO;
+	  *value = isnan (r) || r > 0 ? 0x7fffffff : 0x80000000;
+	}
+      else
+	*value = (ARMword) (int32_t) r;
+      if (End (fpa, instr, invalid | (r != x && !invalid ? INX : 0)))
+	return ARMul_CANT;
+      return ARMul_DONE;
+
+    case RFS:
+      *value = fpa->fpsr;
+      return ARMul_DONE;
+
+    case RFC:
+      if (!Privileged (state))
+	return ARMul_CANT;
+      *value = fpa->fpcr;
+      return ARMul_DONE;
+
+    case CMF:
+    case CNF:
+    case CMFE:
+    case CNFE:
+      if (BITS (12, 15) != 15)
+	return ARMul_CANT;
+      return Compare (fpa, instr, value);
+
+    default:
+      return ARMul_CANT;
+    }
+}
+
+/***************************************************************************\
+*                           Memory formats                                  *
+\***************************************************************************/
+
+/* Extended: sign and 15 bit exponent in the first word, then the 64 bit
+   mantissa with its explicit integer bit, high word first.  */
+
+static void
+ToExtended (long double x, ARMword * w)
+{
+  ARMword sign = signbit (x) ? 0x80000000 : 0;
+  uint64_t mant;
+  int exp;
+
+  if (isnan (x))
+    {
+      w[0] = sign | 0x7fff;
+      w[1] = 0xc0000000;
+      w[2] = 0;
+      return;
+    }
+  if (isinf (x))
+    {
+      w[0] = sign | 0x7fff;
+      w[1] = 0x80000000;
+      w[2] = 0;
+      return;
+    }
+  if (x == 0)
+    {
+      w[0] = sign;
+      w[1] = w[2] = 0;
+      return;
+    }
+
+  x = frexpl (fabsl (x), &exp);	/* [0.5, 1) */
+  exp += 16382;
+  if (exp <= 0)
+    {				/* denormal: exponent 0, no integer bit */
+      x = ldexpl (x, exp - 1);
+      exp = 0;
+    }
+  mant = (uint64_t) ldexpl (x, 64);
+  w[0] = sign | exp;
+  w[1] = mant >> 32;
+  w[2] = (ARMword) mant;
+}
+
+static long double
+FromExtended (const ARMword * w)
+{
+  uint64_t mant = ((uint64_t) w[1] << 32) | w[2];
+  int exp = w[0] & 0x7fff;
+  long double x;
+
+  if (exp == 0x7fff)
+    x = (mant << 1) ? NAN : INFINITY;
+  else
+    x = ldexpl ((long double) mant, (exp ? exp : 1) - 16383 - 63);
+  return (w[0] & 0x80000000) ? -x : x;
+}
+
+/* Packed decimal: sign in bit 31, exponent sign in bit 30, four BCD
+   exponent digits in bits 27-12, then 19 mantissa digits with the
+   point after the first.  Exponent digits of all ones are an infinity
+   or, with a non-zero mantissa, a NaN.  */
+
+static void
+ToPacked (long double x, ARMword * w)
+{
+  char buf[48], digits[19], *p;
+  int exp, i;
+  ARMword sign = signbit (x) ? 0x80000000 : 0;
+
+  if (isnan (x) || isinf (x))
+    {
+      w[0] = sign | 0x0ffff000;
+      w[1] = 0;
+      w[2] = isnan (x) ? 1 : 0;
+      return;
+    }
+  snprintf (buf, sizeof (buf), "%.18Le", fabsl (x));
+  for (p = buf, i = 0; i < 19; p++)
+    if (*p >= '0' && *p <= '9')
+      digits[i++] = *p - '0';
+  exp = x == 0 ? 0 : atoi (strchr (buf, 'e') + 1);
+
+  w[0] = sign | (exp < 0 ? 0x40000000 : 0);
+  if (exp < 0)
+    exp = -exp;
+  for (i = 0; i < 4; i++, exp /= 10)
+    w[0] |= (exp % 10) << (12 + 4 * i);
+  w[1] = w[2] = 0;
+  for (i = 0; i < 19; i++)
+    {
+      if (i < 3)
+	w[0] |= digits[i] << (4 * (2 - i));
+      else if (i < 11)
+	w[1] |= digits[i] << (4 * (10 - i));
+      else
+	w[2] |= digits[i] << (4 * (18 - i));
+    }
+}
+
+static long double
+FromPacked (const ARMword * w)
+{
+  char buf[48], *p = buf;
+  int i, exp = 0;
+  long double x;
+
+  for (i = 3; i >= 0; i--)
+    exp = exp * 10 + ((w[0] >> (12 + 4 * i)) & 0xf);
+  if ((w[0] & 0x0ffff000) == 0x0ffff000)
+    x = (w[0] & 0xfff) || w[1] || w[2] ? NAN : INFINITY;
+  else
+    {
+      for (i = 2; i >= 0; i--)
+	{
+	  *p++ = '0' + ((w[0] >> (4 * i)) & 0xf);
+	  if (i == 2)
+	    *p++ = '.';
+	}
+      for (i = 7; i >= 0; i--)
+	*p++ = '0' + ((w[1] >> (4 * i)) & 0xf);
+      for (i = 7; i >= 0; i--)
+	*p++ = '0' + ((w[2] >> (4 * i)) & 0xf);
+      sprintf (p, "e%c%d", (w[0] & 0x40000000) ? '-' : '+', exp);
+      x = strtold (buf, NULL);
+    }
+  return (w[0] & 0x80000000) ? -x : x;
+}
+
+/***************************************************************************\
+*                          Memory transfers                                 *
+\***************************************************************************/
+
+/* The precision of LDF/STF, or for LFM/SFM the number of registers */
+#define XFER_FIELD ((BIT (22) << 1) | BIT (15))
+
+static unsigned
+XferWords (ARMword instr)
+{
+  static const unsigned words[4] = { 1, 2, 3, 3 };
+
+  if (CPNum == FPA_CP_LFM)
+    return 3 * (XFER_FIELD ? XFER_FIELD : 4);
+  return words[XFER_FIELD];
+}
+
+/* Registers to buf, for STF/SFM */
+static void
+Pack (ARMul_FPA * fpa, ARMword instr)
+{
+  unsigned fd = BITS (12, 14), i;
+  long double x = fpa->F[fd];
+  volatile float f;
+  volatile double d;
+  uint64_t bits;
+
+  if (CPNum == FPA_CP_LFM)
+    {
+      for (i = 0; i < fpa->nwords; i += 3)
+	ToExtended (fpa->F[(fd + i / 3) & 7], &fpa->buf[i]);
+      return;
+    }
+  switch (XFER_FIELD)
+    {
+    case PREC_S:
+      f = x;
+      memcpy (&fpa->buf[0], (const void *) &f, 4);
+      break;
+    case PREC_D:
+      d = x;
+      memcpy (&bits, (const void *) &d, 8);
+      fpa->buf[0] = bits >> 32;	/* high word first */
+      fpa->buf[1] = (ARMword) bits;
+      break;
+    case PREC_E:
+      ToExtended (x, fpa->buf);
+      break;
+    default:
+      ToPacked (x, fpa->buf);
+      break;
+    }
+}
+
+/* buf to registers, for LDF/LFM */
+static void
+Unpack (ARMul_FPA * fpa, ARMword instr)
+{
+  unsigned fd = BITS (12, 14), i;
+  float f;
+  double d;
+  uint64_t bits;
+
+  if (CPNum == FPA_CP_LFM)
+    {
+      for (i = 0; i < fpa->nwords; i += 3)
+	fpa->F[(fd + i / 3) & 7] = FromExtended (&fpa->buf[i]);
+      return;
+    }
+  switch (XFER_FIELD)
+    {
+    case PREC_S:
+      memcpy (&f, &fpa->buf[0], 4);
+      fpa->F[fd] = f;
+      break;
+    case PREC_D:
+      bits = ((uint64_t) fpa->buf[0] << 32) | fpa->buf[1];
+      memcpy (&d, &bits, 8);
+      fpa->F[fd] = d;
+      break;
+    case PREC_E:
+      fpa->F[fd] = FromExtended (fpa->buf);
+      break;
+    default:
+      fpa->F[fd] = FromPacked (fpa->buf);
+      break;
+    }
+}
+
+unsigned
+ARMul_FPALDC (ARMul_State * state, unsigned type, ARMword instr,
+	      ARMword value)
+{
+  ARMul_FPA *fpa = FPA (state);
+
+  switch (type)
+    {
+    case ARMul_FIRST:
+      fpa->nwords = XferWords (instr);
+      fpa->word = 0;
+      return ARMul_DONE;
+    case ARMul_DATA:
+      fpa->buf[fpa->word++] = value;
+      if (fpa->word < fpa->nwords)
+	return ARMul_INC;
+      Unpack (fpa, instr);
+      return ARMul_DONE;
+    default:
+      return ARMul_DONE;
+    }
+}
+
+unsigned
+ARMul_FPASTC (ARMul_State * state, unsigned type, ARMword instr,
+	      ARMword * value)
+{
+  ARMul_FPA *fpa = FPA (state);
+
+  switch (type)
+    {
+    case ARMul_FIRST:
+      fpa->nwords = XferWords (instr);
+      fpa->word = 0;
+      Pack (fpa, instr);
+      return ARMul_DONE;
+    case ARMul_DATA:
+      *value = fpa->buf[fpa->word++];
+      return fpa->word < fpa->nwords ? ARMul_INC : ARMul_DONE;
+    default:
+      return ARMul_DONE;
+    }
+}
+
+/***************************************************************************\
+*                          Initialisation                                   *
+\***************************************************************************/
+
+unsigned
+ARMul_FPAInit (ARMul_State * state)
+{
+  ARMul_FPA *fpa;
+
+  fpa = (ARMul_FPA *) calloc (1, sizeof (ARMul_FPA));
+  if (fpa == NULL)
+    return FALSE;
+  /* Invalid operation, divide by zero and overflow trap, as under
+     the FPE */
+  fpa->fpsr = FPSR_ID | ((IVO | DVZ | OFL) << 16);
+  state->CPData[FPA_CP] = (unsigned char *) fpa;
+  ARMul_ConsolePrint (state, ", FPA present");
+  return TRUE;
+}
+
+unsigned
+ARMul_FPAExit (ARMul_State * state)
+{
+  free (state->CPData[FPA_CP]);
+  state->CPData[FPA_CP] = NULL;
+  return TRUE;
+}
+
+/* The FPA's registers, as host data (for snapshots): copies them to or
+   from buf, if it's big enough, and returns their size.  */
+
+unsigned
+ARMul_FPASave (ARMul_State * state, void *buf, unsigned len)
+{
+  if (FPA (state) && len >= sizeof (ARMul_FPA))
+    memcpy (buf, FPA (state), sizeof (ARMul_FPA));
+  return sizeof (ARMul_FPA);
+}
+
+unsigned
+ARMul_FPARestore (ARMul_State * state, const void *buf, unsigned len)
+{
+  if (FPA (state) && len == sizeof (ARMul_FPA))
+    memcpy (FPA (state), buf, sizeof (ARMul_FPA));
+  return sizeof (ARMul_FPA);
+}
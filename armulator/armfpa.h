@@ -0,0 +1,37 @@
+/*  armfpa.h -- FPA10 floating point coprocessor:  ARM6 Instruction Emulator.
+    Copyright (C) 2022 Matt Evans
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA. */
+
+#ifndef ARMFPA_H
+#define ARMFPA_H
+
+/* The FPA is CP1, with LFM/SFM on CP2 */
+#define FPA_CP 1
+#define FPA_CP_LFM 2
+
+/* Handlers for ARMul_CoProAttach(), see armcopro.c */
+extern ARMul_CPInits ARMul_FPAInit;
+extern ARMul_CPExits ARMul_FPAExit;
+extern ARMul_LDCs ARMul_FPALDC;
+extern ARMul_STCs ARMul_FPASTC;
+extern ARMul_MRCs ARMul_FPAMRC;
+extern ARMul_MCRs ARMul_FPAMCR;
+extern ARMul_CDPs ARMul_FPACDP;
+extern unsigned ARMul_FPASave (ARMul_State * state, void *buf, unsigned len);
+extern unsigned ARMul_FPARestore (ARMul_State * state, const void *buf,
+				  unsigned len);
+
+#endif
@@ -1,1356 +0,0 @@
-/*  armfpe.h -- ARMulator pre-compiled FPE:  ARM6 Instruction Emulator.
-    Copyright (C) 1994 Advanced RISC Machines Ltd.
- 
-    This program is free software; you can redistribute it and/or modify
-    it under the terms of the GNU General Public License as published by
-    the Free Software Foundation; either version 2 of the License, or
-    (at your option) any later version.
- 
-    This program is distributed in the hope that it will be useful,
-    but WITHOUT ANY WARRANTY; without even the implied warranty of
-    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-    GNU General Public License for more details.
- 
-    You should have received a copy of the GNU General Public License
-    along with this program; if not, write to the Free Software
-    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA. */
-
-/* Array containing the Floating Point Emualtor (FPE). */
-
-#include <inttypes.h>
-uint32_t fpecode[] = {
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00070000, 0x00000000, 0xe92d400e, 0xeb0013ef,
-  0xe28f00d4, 0xe1a00120, 0xe38004ea, 0xe3a01004,
-  0xe5912000, 0xe24f3028, 0xe1500002, 0x15832000,
-  0x15810000, 0xe3a00001, 0xe8bd800e, 0xe28d9040,
-  0xe1a0a00e, 0xe24f7048, 0xe597b000, 0xe20b74ee,
-  0xe14f8000, 0xe2088040, 0xe388809b, 0xe121f008,
-  0xe35704ea, 0x004bb007, 0x01a0b10b, 0x028bf00c,
-  0xe20b733b, 0xe3570339, 0x01a0ba0b, 0x01a0ba2b,
-  0x059bb00c, 0x0249800c, 0x08880e00, 0x0919ff80,
-  0xe24f7094, 0xe1a0f007, 0xe14f8000, 0xe2088040,
-  0xe3888093, 0xe121f008, 0xe8dd7fff, 0xe1a00000,
-  0xe28dd03c, 0xe8fd8000, 0xe14f8000, 0xe2088040,
-  0xe3888093, 0xe121f008, 0xe8bd1fff, 0xe28dd00c,
-  0xe1b0f00e, 0xe14f8000, 0xe2088040, 0xe3888093,
-  0xe121f008, 0xe28dd01c, 0xe8bd1f80, 0xe28dd00c,
-  0xe1b0f00e, 0x00002100, 0xe90d4007, 0xe14f0000,
-  0xe24d1010, 0xe10f2000, 0xe20220c0, 0xe3822003,
-  0xe121f002, 0xe169f000, 0xe8914007, 0xe24dd040,
-  0xe8cd7fff, 0xe24fcf6b, 0xe58de03c, 0xe24ea004,
-  // ME removed: 0xe14f9000, 0xe20990c0, 0xe3899003, 0xe121f009,
-  // Was: mrs/and/or/msr to "change" to SVC (we're there already on arm26)
-  // Added the following before the ldrt of the instruction:
-  0xe1a00000, 0xe1a00000, 0xe3caa003, 0xe3caa33f,
-  // Now: NOP, NOP, r10 &= ~0xfc000003 to get LR as raw addr that's then loaded
-  0xe4ba9008, 0xe20987fe, 0xe2197010, 0xe0077aa9,
-  0xe0288a07, 0x02097402, 0x00077509, 0x00888007,
-  0xe2097c0f, 0xe3370c01, 0x0209733e, 0x0337033a,
-  0x008ff8a8, 0xea00009f, 0xea0003b7, 0xea0003b6,
-  0xea000307, 0xea000306, 0xea0003b3, 0xea0003b2,
-  0xea000303, 0xea000302, 0xea0003c3, 0xea0003c2,
-  0xea00030d, 0xea00030c, 0xea0003bf, 0xea0003be,
-  0xea000309, 0xea000308, 0xea0003cf, 0xea0003ce,
-  0xea000314, 0xea000313, 0xea0003cb, 0xea0003ca,
-  0xea000310, 0xea00030f, 0xea0003db, 0xea0003da,
-  0xea00031a, 0xea000319, 0xea0003d7, 0xea0003d6,
-  0xea000316, 0xea000315, 0xea0003e7, 0xea0003e6,
-  0xea000321, 0xea000320, 0xea0003f7, 0xea0003f6,
-  0xea00032b, 0xea00032a, 0xea000449, 0xea000448,
-  0xea000335, 0xea000334, 0xea000459, 0xea000458,
-  0xea000340, 0xea00033f, 0xea000469, 0xea000468,
-  0xea00034b, 0xea00034a, 0xea000479, 0xea000478,
-  0xea000355, 0xea000354, 0xea000489, 0xea000488,
-  0xea00035f, 0xea00035e, 0xea000499, 0xea000498,
-  0xea00036a, 0xea000369, 0xea000ac8, 0xea000ac5,
-  0xea000c3d, 0xea000c3a, 0xea000b7b, 0xea000b78,
-  0xea000b79, 0xea000b76, 0xea000d34, 0xea000d31,
-  0xea000d08, 0xea000d05, 0xea000e34, 0xea000e31,
-  0xea000e1c, 0xea000e19, 0xea000ecf, 0xea000ecc,
-  0xea000c2d, 0xea000c2a, 0xea000d28, 0xea000d25,
-  0xea000cfc, 0xea000cf9, 0xea00123d, 0xea00123a,
-  0xeaffff55, 0xeaffff54, 0xeaffff53, 0xeaffff52,
-  0xeaffff51, 0xeaffff50, 0xea0007b8, 0xea0007ec,
-  0xea00073c, 0xea00073b, 0xea000806, 0xea000805,
-  0xea00080f, 0xea00080e, 0xeaffff47, 0xeaffff46,
-  0xeaffff45, 0xeaffff44, 0xeaffff43, 0xeaffff42,
-  0xeaffff41, 0xeaffff40, 0xeaffff3f, 0xeaffff3e,
-  0xea00086f, 0xea00086e, 0xeaffff3b, 0xeaffff3a,
-  0xea00086b, 0xea00086a, 0xeaffff37, 0xeaffff36,
-  0xea0007ff, 0xea0007fe, 0xeaffff33, 0xeaffff32,
-  0xea0007fb, 0xea0007fa, 0xea000914, 0xea0008f3,
-  0xea00091f, 0xea0008fb, 0xea00092b, 0xea000904,
-  0xea0009dc, 0xea0009d9, 0xea0009fd, 0xea0009fa,
-  0xea000ef8, 0xea000ef5, 0xea000ef6, 0xea000ef3,
-  0xea000f9d, 0xea000f9a, 0xea00111e, 0xea00111b,
-  0xea00111c, 0xea001119, 0xea00104e, 0xea00104b,
-  0xea001147, 0xea001144, 0xea001145, 0xea001142,
-  0xea00125a, 0xea001257, 0xeaffff13, 0xeaffff12,
-  0xeaffff11, 0xeaffff10, 0xe3190c0e, 0x1affff0e,
-  0xe3190c01, 0x13190302, 0x0affff0b, 0xe28fb016,
-  0xe79b7d27, 0xe14fb000, 0xe1a0be2b, 0xe28bb010,
-  0xe1170b37, 0x0affff51, 0xeaffff29, 0x8000f0f0,
-  0x80000f0f, 0x8000cccc, 0x80003333, 0x8000ff00,
-  0x800000ff, 0x8000aaaa, 0x80005555, 0x8000cfcf,
-  0x80003030, 0x800055aa, 0x8000aa55, 0x80005faf,
-  0x8000a050, 0x80000000, 0x8000ffff, 0xe1300007,
-  0x5a000002, 0xea00004a, 0xe3100102, 0x1a000048,
-  0xe053400b, 0x4a00002d, 0xe2745020, 0xda00001b,
-  0xe092243a, 0x20822518, 0x30922518, 0xe0b11438,
-  0xe1a0451a, 0x2a000006, 0xe0922fa4, 0xe2b11000,
-  0x31b0f00e, 0xe3a01102, 0xe2833001, 0xe1a040a4,
-  0xe1b0f00e, 0xe2833001, 0xe1a040a4, 0xe1844f82,
-  0xe1a020a2, 0xe1822f81, 0xe1a01061, 0xe0922fa4,
-  0xe2a11000, 0xe1b0f00e, 0xe1a04538, 0xe0922fa4,
-  0xe2b11000, 0x23a01102, 0x22833001, 0xe1b0f00e,
-  0xe2545040, 0xaafffff7, 0xe2444020, 0xe2645020,
-  0xe0922438, 0xe2b11000, 0xe1a04518, 0xe184443a,
-  0x2affffe7, 0xe0922fa4, 0xe2b11000, 0x31b0f00e,
-  0xe3a01102, 0xe2833001, 0xe1a040a4, 0xe1b0f00e,
-  0xe2644000, 0xe1a0300b, 0xe1a05001, 0xe1a01008,
-  0xe1a08005, 0xe1a05002, 0xe1a0200a, 0xe1a0a005,
-  0xe2745020, 0xdaffffe5, 0xe092243a, 0x20822518,
-  0x30922518, 0xe0b11438, 0xe1a0451a, 0x2affffd0,
-  0xe0922fa4, 0xe2b11000, 0x31b0f00e, 0xe3a01102,
-  0xe2833001, 0xe1a040a4, 0xe1b0f00e, 0xe3100102,
-  0x1affffb6, 0xe053600b, 0x4a00003d, 0x01510008,
-  0x0152000a, 0x0a00004f, 0x3a000039, 0xe3a04000,
-  0xe2765020, 0xda00001a, 0xe054451a, 0xe0d2263a,
-  0x30422518, 0x20522518, 0xe0d11638, 0x5a000002,
-  0xe0922fa4, 0xe2a11000, 0xe1b0f00e, 0xe0944004,
-  0xe0b22002, 0xe0b11001, 0xe2433001, 0x5afffffa,
-  0xe0922fa4, 0xe2b11000, 0x31b0f00e, 0xe3a01102,
-  0xe2833001, 0xe1a040a4, 0xe1b0f00e, 0xe0544538,
-  0x41b0f00e, 0xe2d22000, 0xe2d11000, 0x41b0f00e,
-  0xeaffffed, 0xe3a04000, 0xe2565040, 0xaafffff6,
-  0xe2466020, 0xe2665020, 0xe054751a, 0xe0d4463a,
-  0x30444518, 0x20544518, 0xe0d22638, 0xe2d11000,
-  0x5a000002, 0xe0922fa4, 0xe2a11000, 0xe1b0f00e,
-  0xe0977007, 0xe0b44004, 0xe0b22002, 0xe0b11001,
-  0xe2433001, 0x5afffff9, 0xe0922fa4, 0xe2b11000,
-  0x31b0f00e, 0xe3a01102, 0xe2833001, 0xe1a040a4,
-  0xe1b0f00e, 0xe2666000, 0xe2200102, 0xe1a0300b,
-  0xe1a05001, 0xe1a01008, 0xe1a08005, 0xe1a05002,
-  0xe1a0200a, 0xe1a0a005, 0xe3a04000, 0xe2765020,
-  0xdaffffd7, 0xe054451a, 0xe0d2263a, 0x30422518,
-  0x20522518, 0xe0d11638, 0x5affffbf, 0xe0922fa4,
-  0xe2a11000, 0xe1b0f00e, 0xe3a03000, 0xe3a02000,
-  0xe3a01000, 0xe3a04000, 0xe1b0f00e, 0xe1a07000,
-  0xe1a08001, 0xe1a0a002, 0xe1a0b003, 0xe0200007,
-  0xe1914002, 0x1198400a, 0x0afffff2, 0xe3b054ff,
-  0xe0a3300b, 0xe185b425, 0xe043392b, 0xe92c4209,
-  0xe1a04821, 0xe1c1500b, 0xe1a06822, 0xe1c2700b,
-  0xe1c8900b, 0xe1a08828, 0xe1cab00b, 0xe1a0a82a,
-  0xe0030b96, 0xe0020b94, 0xe0010994, 0xe0000a97,
-  0xe0933000, 0xe0000a95, 0xe0b22000, 0xe0000895,
-  0xe0b11000, 0x33a0e000, 0x23a0e001, 0xe0000996,
-  0xe0922000, 0xe2b11000, 0xe2aee000, 0xe0000897,
-  0xe0922000, 0xe2b11000, 0xe2aee000, 0xe18ee803,
-  0xe1a03823, 0xe1833802, 0xe1a02822, 0xe1822801,
-  0xe1a01821, 0xe181180e, 0xe3cee0ff, 0xe0000b95,
-  0xe00b0b97, 0xe09eb00b, 0xe0b33000, 0xe0000896,
-  0xe0b22000, 0xe0000894, 0xe0a11000, 0xe0000a94,
-  0xe00a0a96, 0xe09aa003, 0xe0b22000, 0xe2a11000,
-  0xe0000997, 0xe09a4000, 0xe0000995, 0xe0b22000,
-  0xe2b11000, 0xe8bc4209, 0x4a000005, 0xe09bb00b,
-  0xe0b44004, 0xe0b22002, 0xe0b11001, 0xe2433001,
-  0x5afffff9, 0xe0922fa4, 0xe2b11000, 0x31b0f00e,
-  0xe3a01102, 0xe2833001, 0xe1a040a4, 0xe1b0f00e,
-  0xe1a07000, 0xe1a08001, 0xe1a0a002, 0xe1a0b003,
-  0xe3a00000, 0xe3a01102, 0xe3b02100, 0xe2e23901,
-  0xe0200007, 0xe1914002, 0x1198400a, 0x0affff9d,
-  0xe043300b, 0xe2833901, 0xe2433001, 0xe3a0b000,
-  0xe052500a, 0xe0d14008, 0x23a01003, 0x2a00000c,
-  0xe1a05002, 0xe1a04001, 0xe3a01001, 0xe2433001,
-  0xe0955005, 0xe0b44004, 0xe2abb000, 0xe055700a,
-  0xe0d46008, 0x31b0b0ab, 0x21a05007, 0x21a04006,
-  0xe0a11001, 0xe0955005, 0xe0b44004, 0xe2abb000,
-  0xe055700a, 0xe0d46008, 0x31b0b0ab, 0x21a05007,
-  0x21a04006, 0xe0a11001, 0xe0955005, 0xe0b44004,
-  0xe2abb000, 0xe055700a, 0xe0d46008, 0x31b0b0ab,
-  0x21a05007, 0x21a04006, 0xe0a11001, 0xe0955005,
-  0xe0b44004, 0xe2abb000, 0xe055700a, 0xe0d46008,
-  0x31b0b0ab, 0x21a05007, 0x21a04006, 0xe0b11001,
-  0x3affffda, 0xe1942005, 0x01b0f00e, 0xe3a02001,
-  0xe0955005, 0xe0b44004, 0xe2abb000, 0xe055700a,
-  0xe0d46008, 0x31b0b0ab, 0x21a05007, 0x21a04006,
-  0xe0a22002, 0xe0955005, 0xe0b44004, 0xe2abb000,
-  0xe055700a, 0xe0d46008, 0x31b0b0ab, 0x21a05007,
-  0x21a04006, 0xe0a22002, 0xe0955005, 0xe0b44004,
-  0xe2abb000, 0xe055700a, 0xe0d46008, 0x31b0b0ab,
-  0x21a05007, 0x21a04006, 0xe0a22002, 0xe0955005,
-  0xe0b44004, 0xe2abb000, 0xe055700a, 0xe0d46008,
-  0x31b0b0ab, 0x21a05007, 0x21a04006, 0xe0b22002,
-  0x3affffda, 0xe0955005, 0xe0b44004, 0x2a000001,
-  0xe1540008, 0x0155000a, 0xe2b22000, 0xe2b11000,
-  0x31b0f00e, 0xe2a33000, 0xe3a01102, 0xe1b0f00e,
-  0xe1b04883, 0x0affff37, 0xe2833901, 0xe2433001,
-  0xe1b030a3, 0xe1a05002, 0x32414102, 0x22414101,
-  0x33a07201, 0x23a07202, 0xe3a01102, 0xe0955005,
-  0xe0b44004, 0xe0216007, 0x31540006, 0x20444006,
-  0x20211087, 0xe1b070e7, 0x5afffff7, 0xe1942005,
-  0x01b0f00e, 0xe3a02000, 0xe0955005, 0xe0b44004,
-  0xe0a00000, 0xe0226007, 0xe055a006, 0xe0d48001,
-  0x31b000a0, 0x21a0500a, 0x21a04008, 0x20222087,
-  0x20211fa7, 0xe1b070a7, 0x1afffff2, 0xe0955005,
-  0xe0b44004, 0xe0b70007, 0xe0d5a002, 0xe0d48001,
-  0x31b000a0, 0x21a0500a, 0x21a04008, 0x22222001,
-  0x23a07102, 0xe3a00000, 0xe0977007, 0xe0b55005,
-  0xe0b44004, 0x2a000002, 0xe1540001, 0x01550002,
-  0x03570101, 0xe2b22000, 0xe2b11000, 0xe2a33000,
-  0x23a01102, 0xe1b0f00e, 0xe1b07004, 0x42644000,
-  0xe3a0b901, 0xe3a0a000, 0xe1a08004, 0xe1b04828,
-  0x01a08808, 0x128bb010, 0xe1b04c28, 0x01a08408,
-  0x128bb008, 0xe1b04e28, 0x01a08208, 0x128bb004,
-  0xe1b04f28, 0x01a08108, 0x128bb002, 0xe1b04fa8,
-  0x01a08088, 0x024bb001, 0xe1b0f00e, 0xe1a07000,
-  0xe1a0b003, 0xe24b40fe, 0xe2544c3f, 0xda000011,
-  0xe2745020, 0x4a000003, 0xe3a0a000, 0xe1a08531,
-  0xe1a08518, 0xe1b0f00e, 0xe1a08001, 0xe1a0a002,
-  0xe2745040, 0x41b0f00e, 0xe1a0a53a, 0xe1a0a51a,
-  0xe1b0f00e, 0x03a04001, 0x03a08102, 0xe3a0a000,
-  0x028bb001, 0x01b0f00e, 0xe3a04000, 0xe3a08000,
-  0xe3a0a000, 0xe3a0b000, 0xe1b0f00e, 0xe1a07000,
-  0xe1a0b003, 0xe24b40fe, 0xe2544c3f, 0xdafffff0,
-  0xe2745020, 0x4a000007, 0xe3a0a000, 0xe1b04531,
-  0xe2a44000, 0xe1b08514, 0x31b0f00e, 0xe1a08068,
-  0xe28bb001, 0xe1b0f00e, 0xe1a08001, 0xe1a0a002,
-  0xe2745040, 0xe3e04000, 0x41b0f00e, 0xe1b0a53a,
-  0xe2aaa000, 0xe1b0a51a, 0xe2b88000, 0x31b0f00e,
-  0xe1a0a0aa, 0xe18aaf88, 0xe1a08068, 0xe28bb001,
-  0xe1b0f00e, 0xe38ee101, 0xe24340fe, 0xe2544c3f,
-  0xda000032, 0xe2745020, 0x4a000018, 0xe1a08411,
-  0x01a08002, 0x11a0a002, 0x03a0a000, 0xe3a02000,
-  0xe1a01531, 0xe2194060, 0x1a000007, 0xe19aa088,
-  0x00088f81, 0xe0911fa8, 0x31b01511, 0x31b0f00e,
-  0xe1a01061, 0xe2833001, 0xe1b0f00e, 0xe3540060,
-  0x1198a00a, 0x0a000003, 0xe0304d04, 0x5a000001,
-  0xe2911001, 0xeafffff3, 0xe1a01511, 0xe1b0f00e,
-  0xe2745040, 0xd1b0f00e, 0xe2444020, 0xe1a08412,
-  0xe1b02532, 0xe2194060, 0x1a00000a, 0xe1b0a088,
-  0x00088f82, 0xe0822fa8, 0xe1b02512, 0xe2b11000,
-  0x31b0f00e, 0xe1a020a2, 0xe1822f81, 0xe1a01061,
-  0xe2833001, 0xe1b0f00e, 0xe3540060, 0x13580000,
-  0x0afffff4, 0xe0304d04, 0x42822001, 0xeafffff1,
-  0x0a000011, 0xe2194060, 0x1a000006, 0xe1918002,
-  0x01b0f00e, 0xe3a01000, 0xe3a02000, 0xe3a03000,
-  0xe3a04008, 0xe1a0f00e, 0xe1918002, 0x13540060,
-  0x0afffff5, 0xe0304d04, 0x5afffff3, 0xe3a01102,
-  0xe3b02100, 0xe2e23901, 0xe1b0f00e, 0xe2194060,
-  0x1afffff4, 0xe1924081, 0x1afffff7, 0xeaffffea,
-  0xe1a04000, 0xe1a00007, 0xe1a07004, 0xe1a04001,
-  0xe1a01008, 0xe1a08004, 0xe1a04002, 0xe1a0200a,
-  0xe1a0a004, 0xe1a04003, 0xe1a0300b, 0xe1a0b004,
-  0xe1b0f00e, 0xe209ba07, 0xe08c542b, 0xe209780f,
-  0xe79da727, 0xe21980ff, 0xe04a8108, 0x178d8727,
-  0xe2199902, 0xe3899901, 0xe1a09789, 0xe4ba6004,
-  0x14ba7004, 0xe88503c0, 0xeafffcae, 0xe209ba07,
-  0xe08c542b, 0xe209780f, 0xe79da727, 0xe21980ff,
-  0xe04a8108, 0x178d8727, 0xe2199902, 0xe3899905,
-  0xe1a09789, 0xe4ba6004, 0xe4ba7004, 0xe4ba8000,
-  0xe88503c0, 0xeafffc9f, 0xe209ba07, 0xe08c542b,
-  0xe209780f, 0xe79da727, 0xe21980ff, 0xe08a8108,
-  0x178d8727, 0xe2199902, 0xe3899901, 0xe1a09789,
-  0xe4ba6004, 0x14ba7004, 0xe88503c0, 0xeafffc91,
-  0xe209ba07, 0xe08c542b, 0xe209780f, 0xe79da727,
-  0xe21980ff, 0xe08a8108, 0x178d8727, 0xe2199902,
-  0xe3899905, 0xe1a09789, 0xe4ba6004, 0xe4ba7004,
-  0xe4ba8000, 0xe88503c0, 0xeafffc82, 0xe209ba07,
-  0xe08cc42b, 0xe209780f, 0xe337080f, 0x179da727,
-  0xe21980ff, 0xe04aa108, 0xe2199902, 0xe3899901,
-  0xe1a0b789, 0xe4ba8004, 0x14ba9004, 0xe88c0f00,
-  0xeafffc83, 0xe209ba07, 0xe08c542b, 0xe209780f,
-  0xe79da727, 0xe21980ff, 0xe04aa108, 0x178da727,
-  0xe2199902, 0xe3899901, 0xe1a09789, 0xe4ba6004,
-  0x14ba7004, 0xe88503c0, 0xeafffc66, 0xe209ba07,
-  0xe08cc42b, 0xe209780f, 0xe337080f, 0x179da727,
-  0xe21980ff, 0xe04aa108, 0xe2199902, 0xe3899905,
-  0xe1a0b789, 0xe4ba8004, 0xe4ba9004, 0xe4baa000,
-  0xe88c0f00, 0xeafffc66, 0xe209ba07, 0xe08c542b,
-  0xe209780f, 0xe79da727, 0xe21980ff, 0xe04aa108,
-  0x178da727, 0xe2199902, 0xe3899905, 0xe1a09789,
-  0xe4ba6004, 0xe4ba7004, 0xe4ba8000, 0xe88503c0,
-  0xeafffc48, 0xe209ba07, 0xe08cc42b, 0xe209780f,
-  0xe337080f, 0x179da727, 0xe21980ff, 0xe08aa108,
-  0xe2199902, 0xe3899901, 0xe1a0b789, 0xe4ba8004,
-  0x14ba9004, 0xe88c0f00, 0xeafffc49, 0xe209ba07,
-  0xe08c542b, 0xe209780f, 0xe79da727, 0xe21980ff,
-  0xe08aa108, 0x178da727, 0xe2199902, 0xe3899901,
-  0xe1a09789, 0xe4ba6004, 0x14ba7004, 0xe88503c0,
-  0xeafffc2c, 0xe209ba07, 0xe08cc42b, 0xe209780f,
-  0xe337080f, 0x179da727, 0xe21980ff, 0xe08aa108,
-  0xe2199902, 0xe3899905, 0xe1a0b789, 0xe4ba8004,
-  0xe4ba9004, 0xe4baa000, 0xe88c0f00, 0xeafffc2c,
-  0xe209ba07, 0xe08c542b, 0xe209780f, 0xe79da727,
-  0xe21980ff, 0xe08aa108, 0x178da727, 0xe2199902,
-  0xe3899905, 0xe1a09789, 0xe4ba6004, 0xe4ba7004,
-  0xe4ba8000, 0xe88503c0, 0xeafffc0e, 0xe2095a07,
-  0xe08c5425, 0xe895000f, 0xe3a04002, 0xe0044729,
-  0xe3844001, 0xe1340ea3, 0xe1844d23, 0xe28f7004,
-  0xe28f5f6f, 0x1085f104, 0xe209780f, 0xe79da727,
-  0xe21980ff, 0xe04a8108, 0x178d8727, 0xe4aa0004,
-  0xe3130101, 0x14aa1000, 0xeafffbfa, 0xe2095a07,
-  0xe08c5425, 0xe895000f, 0xe3a04002, 0xe0044729,
-  0xe3844005, 0xe1340ea3, 0xe1844d23, 0xe28f7004,
-  0xe28f5f5b, 0x1085f104, 0xe209780f, 0xe79da727,
-  0xe21980ff, 0xe04a8108, 0x178d8727, 0xe4aa0004,
-  0xe4aa1004, 0xe4aa2000, 0xeafffbe6, 0xe2095a07,
-  0xe08c5425, 0xe895000f, 0xe3a04002, 0xe0044729,
-  0xe3844001, 0xe1340ea3, 0xe1844d23, 0xe28f7004,
-  0xe28f5f47, 0x1085f104, 0xe209780f, 0xe79da727,
-  0xe21980ff, 0xe08a8108, 0x178d8727, 0xe4aa0004,
-  0xe3130101, 0x14aa1000, 0xeafffbd2, 0xe2095a07,
-  0xe08c5425, 0xe895000f, 0xe3a04002, 0xe0044729,
-  0xe3844005, 0xe1340ea3, 0xe1844d23, 0xe28f7004,
-  0xe28f50cc, 0x1085f104, 0xe209780f, 0xe79da727,
-  0xe21980ff, 0xe08a8108, 0x178d8727, 0xe4aa0004,
-  0xe4aa1004, 0xe4aa2000, 0xeafffbbe, 0xe2095a07,
-  0xe08c5425, 0xe895000f, 0xe3a04002, 0xe0044729,
-  0xe3844001, 0xe1340ea3, 0xe1844d23, 0xe28f7004,
-  0xe28f507c, 0x1085f104, 0xe209780f, 0xe337080f,
-  0x179da727, 0xe21980ff, 0xe04aa108, 0xe4aa0004,
-  0xe3130101, 0x14aa1000, 0xeafffbb2, 0xe2095a07,
-  0xe08c5425, 0xe895000f, 0xe3a04002, 0xe0044729,
-  0xe3844001, 0xe1340ea3, 0xe1844d23, 0xe28f7004,
-  0xe28f502c, 0x1085f104, 0xe209780f, 0xe79da727,
-  0xe21980ff, 0xe04aa108, 0x178da727, 0xe4aa0004,
-  0xe3130101, 0x14aa1000, 0xeafffb96, 0xe08ff104,
-  0xeb00036b, 0xe1a0f007, 0xea0000b6, 0xeb000368,
-  0xea0000ea, 0xeb000366, 0xea000123, 0xeb000364,
-  0xea0001ca, 0xea000124, 0xe1a0f007, 0xeb000360,
-  0xea000134, 0xeb00035e, 0xea00014b, 0xeb00035c,
-  0xea0001bd, 0xeb00035a, 0xeb000359, 0xeb000358,
-  0xeb000357, 0xeb000356, 0xeb000355, 0xeb000354,
-  0xeb000353, 0xea000156, 0xea00016f, 0xeb000350,
-  0xe1a0f007, 0xeb00034e, 0xea00018c, 0xeb00034c,
-  0xea0001ad, 0xeb00034a, 0xeb000349, 0xeb000348,
-  0xeb000347, 0xeb000346, 0xeb000345, 0xeb000344,
-  0xeb000343, 0xea00019f, 0xea00008d, 0xeb000340,
-  0xea0000c1, 0xeb00033e, 0xe1a0f007, 0xeb00033c,
-  0xea00019d, 0xeb00033a, 0xeb000339, 0xeb000338,
-  0xeb000337, 0xeb000336, 0xeb000335, 0xeb000334,
-  0xeb000333, 0xea00024f, 0xea00024e, 0xeb000330,
-  0xea00024c, 0xeb00032e, 0xea00024a, 0xeb00032c,
-  0xe1a0f007, 0xe2095a07, 0xe08c5425, 0xe895000f,
-  0xe3a04002, 0xe0044729, 0xe3844005, 0xe1340ea3,
-  0xe1844d23, 0xe28f7004, 0xe24f5f4b, 0x1085f104,
-  0xe209780f, 0xe337080f, 0x179da727, 0xe21980ff,
-  0xe04aa108, 0xe4aa0004, 0xe4aa1004, 0xe4aa2004,
-  0xeafffb48, 0xe2095a07, 0xe08c5425, 0xe895000f,
-  0xe3a04002, 0xe0044729, 0xe3844005, 0xe1340ea3,
-  0xe1844d23, 0xe28f7004, 0xe24f5f5f, 0x1085f104,
-  0xe209780f, 0xe79da727, 0xe21980ff, 0xe04aa108,
-  0x178da727, 0xe4aa0004, 0xe4aa1004, 0xe4aa2000,
-  0xeafffb2c, 0xe2095a07, 0xe08c5425, 0xe895000f,
-  0xe3a04002, 0xe0044729, 0xe3844001, 0xe1340ea3,
-  0xe1844d23, 0xe28f7004, 0xe24f5f73, 0x1085f104,
-  0xe209780f, 0xe337080f, 0x179da727, 0xe21980ff,
-  0xe08aa108, 0xe4aa0004, 0xe3130101, 0x14aa1000,
-  0xeafffb20, 0xe2095a07, 0xe08c5425, 0xe895000f,
-  0xe3a04002, 0xe0044729, 0xe3844001, 0xe1340ea3,
-  0xe1844d23, 0xe28f7004, 0xe24f5f87, 0x1085f104,
-  0xe209780f, 0xe79da727, 0xe21980ff, 0xe08aa108,
-  0x178da727, 0xe4aa0004, 0xe3130101, 0x14aa1000,
-  0xeafffb04, 0xe2095a07, 0xe08c5425, 0xe895000f,
-  0xe3a04002, 0xe0044729, 0xe3844005, 0xe1340ea3,
-  0xe1844d23, 0xe28f7004, 0xe24f5f9b, 0x1085f104,
-  0xe209780f, 0xe337080f, 0x179da727, 0xe21980ff,
-  0xe08aa108, 0xe4aa0004, 0xe4aa1004, 0xe4aa2004,
-  0xeafffaf8, 0xe2095a07, 0xe08c5425, 0xe895000f,
-  0xe3a04002, 0xe0044729, 0xe3844005, 0xe1340ea3,
-  0xe1844d23, 0xe28f7004, 0xe24f5faf, 0x1085f104,
-  0xe209780f, 0xe79da727, 0xe21980ff, 0xe08aa108,
-  0x178da727, 0xe4aa0004, 0xe4aa1004, 0xe4aa2000,
-  0xeafffadc, 0xe3c03102, 0xe2000102, 0xe1b05883,
-  0x12955802, 0x0a00000e, 0xe3320000, 0x01922c81,
-  0xe2012080, 0x000220a1, 0xe0911002, 0x31a01081,
-  0xe2a33000, 0xe2533dfe, 0x9a00001c, 0xe35300ff,
-  0x31800b83, 0x318004a1, 0x33a03202, 0x31a0f007,
-  0xea000008, 0xe1b04c03, 0xe18000a4, 0xe3a03202,
-  0x13c11102, 0x11800421, 0x11a0f007, 0xe1922001,
-  0x01a0f007, 0xea000015, 0xe380047f, 0xe3800502,
-  0xe3a03202, 0xe3a04004, 0xe59c5080, 0xe1855004,
-  0xe58c5080, 0xe1140825, 0x11a00004, 0x1a000e8a,
-  0xe3540004, 0x11a0f007, 0xe3a04010, 0xeafffff5,
-  0xe3730017, 0xda000005, 0xe1a01521, 0xe3811501,
-  0xe2633000, 0xe1800331, 0xe3a03202, 0xe1a0f007,
-  0xe3a03202, 0xe3a04008, 0xeaffffea, 0xe3c03102,
-  0xe2000102, 0xe1b05883, 0x12955802, 0x0a000012,
-  0xe1b04b02, 0xe2024b01, 0x000440a2, 0xe0922004,
-  0xe2b11000, 0xe2a33000, 0xe0922002, 0xe0a11001,
-  0xe2533b0f, 0x9a000019, 0xe2834001, 0xe3540b02,
-  0x31800a03, 0x31800621, 0x31a01a01, 0x31811622,
-  0x33a03206, 0x31a0f007, 0xea00000a, 0xe1b04a83,
-  0xe18000a4, 0xe3a03206, 0x13c11102, 0x118005a1,
-  0x11a01a81, 0x118115a2, 0x11a0f007, 0xe1922001,
-  0x01a0f007, 0xea000014, 0xe380047f, 0xe380060f,
-  0xe3a01000, 0xe3a03206, 0xe3a04004, 0xeaffffc1,
-  0xe3730034, 0xda00000c, 0xe1a026a2, 0xe1822981,
-  0xe1a016a1, 0xe3811702, 0xe2633000, 0xe2534020,
-  0x21a01431, 0x32634020, 0x31800331, 0x31a01411,
-  0x31811332, 0xe3a03206, 0xe1a0f007, 0xe3a01000,
-  0xe3a03206, 0xe3a04008, 0xeaffffae, 0xe2000102,
-  0xe1800003, 0xe3a0320a, 0xe1a0f007, 0xe3a02000,
-  0xe1a03080, 0xe1b03c23, 0x133300ff, 0x11a01400,
-  0x13811102, 0x12833dfe, 0x11a0f007, 0xe1933383,
-  0x11a01400, 0x13c11102, 0x11a0f007, 0xe1b01480,
-  0x01a0f007, 0xe3a03dfe, 0x52433001, 0x51b01081,
-  0x5afffffc, 0xe1a0f007, 0xe1a01e80, 0xe3c03102,
-  0xe2000102, 0xe18001a3, 0xe3a03206, 0xe21026ff,
-  0x133206ff, 0x1280030e, 0x11a0f007, 0xe1800182,
-  0xe3320000, 0x11a0f007, 0xe1912600, 0x01a0f007,
-  0xe1a01a21, 0xe1911600, 0xe2000102, 0xe380030e,
-  0x52400601, 0x51b01081, 0x5afffffc, 0xe1a01081,
-  0xe1800621, 0xe1a01a01, 0xe1a0f007, 0xe3a02000,
-  0xe1a03080, 0xe1b03c23, 0x133300ff, 0xe1a01400,
-  0x13811102, 0x12833dfe, 0xe2000102, 0xe1800003,
-  0xe3a0320a, 0x11a0f007, 0xe1800380, 0xe31000ff,
-  0x13c11102, 0x11a0f007, 0xe1b01081, 0x01a0f007,
-  0xe3800dfe, 0x52400001, 0x51b01081, 0x5afffffc,
-  0xe1a0f007, 0xe1a03080, 0xe1b03aa3, 0x12834001,
-  0x13340b02, 0xe1a02581, 0xe1a01aa1, 0xe1811580,
-  0x13811102, 0x12833b0f, 0x11a0f007, 0xe1933203,
-  0x11a0f007, 0xe0922002, 0xe0a11001, 0xe1924001,
-  0x01a0f007, 0xe3a03b0f, 0xe1b01001, 0x52433001,
-  0xe3a04000, 0x51844fa2, 0x51844081, 0x51a02082,
-  0x51b01004, 0x5afffff8, 0xe1a0f007, 0xe1a03080,
-  0xe1b03aa3, 0x12834001, 0x13340b02, 0x0a00000f,
-  0xe1b04201, 0xe1a01a21, 0xe1811600, 0xe2014c01,
-  0x000440a1, 0xe0911004, 0xe2a33000, 0xe2000102,
-  0xe2533d0e, 0x9affff49, 0xe35300ff, 0x31800b83,
-  0x318004a1, 0x33a03202, 0x31a0f007, 0xeaffff35,
-  0xe1812600, 0xe1a01a21, 0xe1811600, 0xe2000102,
-  0xe1b04c03, 0xe18000a4, 0xe3a03202, 0x118004a1,
-  0x11a0f007, 0xe3320000, 0x01a0f007, 0xeaffff3f,
-  0xe1a03080, 0xe1b03aa3, 0x12834001, 0x13340b02,
-  0xe1a02581, 0xe1a01aa1, 0xe1811580, 0x13811102,
-  0x12833b0f, 0xe2000102, 0xe1800003, 0xe3a0320a,
-  0x11a0f007, 0xe1800200, 0xe31000ff, 0x11a0f007,
-  0xe0922002, 0xe0a11001, 0xe1924001, 0x01a0f007,
-  0xe3800b0f, 0xe1b01001, 0x52400001, 0xe3a04000,
-  0x51844fa2, 0x51844081, 0x51a02082, 0x51b01004,
-  0x5afffff8, 0xe1a0f007, 0xe3c03102, 0xe1a0f007,
-  0x9a209a84, 0xfbcff799, 0x00003ffd, 0xe92c0080,
-  0xe28f7004, 0xe3c44007, 0xeafffe2b, 0xe8bc0080,
-  0xe1b05883, 0x12955802, 0x0a000099, 0xe3a05901,
-  0xe2455001, 0xe1530005, 0x3a000006, 0xe2855003,
-  0xe1530005, 0x0351020a, 0x33a04000, 0x33a05000,
-  0x392c4ff0, 0x3a000021, 0xe92c4fcf, 0xe3a00902,
-  0xe2404003, 0xe0644083, 0xebfffc46, 0xe24bb001,
-  0xe24f4078, 0xe894000e, 0xebfffb4b, 0xe3a04901,
-  0xe2444002, 0xe0434004, 0xe2644020, 0xe1a09431,
-  0xe1510419, 0x03520000, 0x1210b102, 0x12899001,
-  0xe200b102, 0xe8bc000f, 0xe92c0a00, 0xeb0000bf,
-  0xe59c4004, 0xe1b04004, 0x5bfffb90, 0x4bfffb3a,
-  0xe3a05901, 0xe2455001, 0xe1530005, 0x3a000051,
-  0xe2855003, 0xe1530005, 0x0351020a, 0x2a000040,
-  0xe3a04901, 0xe2844002, 0xe0544003, 0xe2645020,
-  0xe1a03512, 0x11a02432, 0x11822511, 0x11a01431,
-  0xe1a04e21, 0xe3a07003, 0xe3c1120f, 0xe0933003,
-  0xe0b22002, 0xe0a11001, 0xe1a08101, 0xe1888f22,
-  0xe1a0a102, 0xe18aaf23, 0xe092200a, 0xe0a11008,
-  0xe2577001, 0x11a04204, 0x11844e21, 0x1afffff1,
-  0xe1915002, 0x03a06000, 0x0a000019, 0xe3a0700f,
-  0xe1a05205, 0xe1855e26, 0xe1a06206, 0xe1866e21,
-  0xe3c1120f, 0xe0922002, 0xe0a11001, 0xe1a08101,
-  0xe1888f22, 0xe0922102, 0xe0a11008, 0xe2577001,
-  0x1afffff2, 0xe1a05205, 0xe1855e26, 0xe1a06206,
-  0xe1866e21, 0xe1b01281, 0x3a000005, 0xe2866001,
-  0xe1911002, 0x03c66001, 0xe206100f, 0xe351000a,
-  0x02466001, 0xe8bc0008, 0xeb000023, 0xe2000102,
-  0xe1800221, 0xe8bc0080, 0xe18000a7, 0xe1800004,
-  0xe1a01005, 0xe1a02006, 0xe3a0320e, 0xe8bc4fc0,
-  0xe1a0f007, 0xe8bc0030, 0xe3150102, 0x12644000,
-  0xe2844001, 0xe2145102, 0x12644000, 0xe92c0030,
-  0xe3a07901, 0xe3a0820a, 0xe3a0a000, 0xe287b002,
-  0xebfffb3a, 0xeaffffb1, 0xe8bc0030, 0xe3150102,
-  0x12644000, 0xe2444001, 0xe2145102, 0x12644000,
-  0xe92c0030, 0xe3a07901, 0xe3a0820a, 0xe3a0a000,
-  0xe287b002, 0xebfffad8, 0xeaffffa4, 0xe1a02003,
-  0xe3a03010, 0xe0922002, 0x3352020a, 0x2242220a,
-  0xe0b33003, 0x3afffffa, 0xe1a01622, 0xe3530064,
-  0xa2433064, 0xa2811201, 0xaafffffb, 0xe353000a,
-  0xa243300a, 0xa2811401, 0xaafffffb, 0xe1811a03,
-  0xe1b0f00e, 0xe3530000, 0x1a00000a, 0xe1915002,
-  0x03a0320e, 0x03a00000, 0x01a0f007, 0xe3110102,
-  0x1affff5d, 0xe0922002, 0xe0b11001, 0xe2433001,
-  0x5afffffb, 0xeaffff58, 0xe2000102, 0xe1800603,
-  0xe3800302, 0xe18009a1, 0xe1a01681, 0xe18119a2,
-  0xe1a02682, 0xe3a0320e, 0xe1a0f007, 0x9392ee8e,
-  0x921d5d07, 0x00003fc3, 0xe1915002, 0x01b05a00,
-  0x1200540f, 0x1355040f, 0x0a0000ac, 0xe92c4fd0,
-  0xe3a07000, 0xe3a06000, 0xe1a04a00, 0xe3a05003,
-  0xeb00009a, 0xe1a04001, 0xe3a05008, 0xeb000097,
-  0xe1a04002, 0xe3a05008, 0xeb000094, 0xe1a02007,
-  0xe1b01006, 0xe3a0303e, 0xe2833901, 0x4a000003,
-  0xe0922002, 0xe0b11001, 0xe2433001, 0x5afffffb,
-  0xe3a06000, 0xe3a07000, 0xe1a04200, 0xe3a05004,
-  0xeb000086, 0xe1a09007, 0xeb00000c, 0xe3100101,
-  0x1bfffade, 0x0bfffa88, 0xe24f70a4, 0xe8970d00,
-  0xebfffa85, 0xe8bc4fd0, 0xe2935001, 0xda000090,
-  0xe1b057a5, 0x1a0000a7, 0xe2044007, 0xeafffd46,
-  0xe3590014, 0xd28f8084, 0xd0889209, 0xd8990d80,
-  0xd1b0f00e, 0xe92c400f, 0xe3a01102, 0xe3a02000,
-  0xe3a00901, 0xe2403001, 0xe3590000, 0x0a000011,
-  0xe92c000f, 0xe2833003, 0xe3b0120a, 0x3bfffa6a,
-  0xe1b090a9, 0x3afffffc, 0xe8bc0d80, 0x192c000f,
-  0xebfffa69, 0x0a000007, 0xe8bc0d80, 0xe92c000f,
-  0xe1a00007, 0xe1a01008, 0xe1a0200a, 0xe1a0300b,
-  0xebfffa61, 0xeafffff1, 0xe1a07000, 0xe1a08001,
-  0xe1a0a002, 0xe1a0b003, 0xe8bc400f, 0xe1b0f00e,
-  0x00000000, 0x80000000, 0x00000000, 0x00003fff,
-  0x00000000, 0xa0000000, 0x00000000, 0x00004002,
-  0x00000000, 0xc8000000, 0x00000000, 0x00004005,
-  0x00000000, 0xfa000000, 0x00000000, 0x00004008,
-  0x00000000, 0x9c400000, 0x00000000, 0x0000400c,
-  0x00000000, 0xc3500000, 0x00000000, 0x0000400f,
-  0x00000000, 0xf4240000, 0x00000000, 0x00004012,
-  0x00000000, 0x98968000, 0x00000000, 0x00004016,
-  0x00000000, 0xbebc2000, 0x00000000, 0x00004019,
-  0x00000000, 0xee6b2800, 0x00000000, 0x0000401c,
-  0x00000000, 0x9502f900, 0x00000000, 0x00004020,
-  0x00000000, 0xba43b740, 0x00000000, 0x00004023,
-  0x00000000, 0xe8d4a510, 0x00000000, 0x00004026,
-  0x00000000, 0x9184e72a, 0x00000000, 0x0000402a,
-  0x00000000, 0xb5e620f4, 0x80000000, 0x0000402d,
-  0x00000000, 0xe35fa931, 0xa0000000, 0x00004030,
-  0x00000000, 0x8e1bc9bf, 0x04000000, 0x00004034,
-  0x00000000, 0xb1a2bc2e, 0xc5000000, 0x00004037,
-  0x00000000, 0xde0b6b3a, 0x76400000, 0x0000403a,
-  0x00000000, 0x8ac72304, 0x89e80000, 0x0000403e,
-  0x00000000, 0xad78ebc5, 0xac620000, 0x00004041,
-  0xe0977007, 0xe0a66006, 0xe0978107, 0xe0a6af27,
-  0xe08a6106, 0xe1a07008, 0xe0977e24, 0xe2a66000,
-  0xe1a04204, 0xe2555001, 0x1afffff4, 0xe1b0f00e,
-  0xe1a03280, 0xe1a038a3, 0xe1a026a2, 0xe1822981,
-  0xe1a016a1, 0xe1811980, 0xe3c11102, 0xe2044007,
-  0xeafffcb9, 0xe2144007, 0x13540005, 0x0a000003,
-  0xe2000102, 0xe3540001, 0x0afffda0, 0xeafffdda,
-  0xe2633000, 0xe3530040, 0xaa000008, 0xe2735020,
-  0x42435020, 0x41a02531, 0x51a02332, 0x51822511,
-  0xe1a01331, 0xe3a03000, 0xe2044007, 0xeafffca6,
-  0xe2000102, 0xe3a01000, 0xe3a02000, 0xe1a03e84,
-  0xe3a04008, 0xeafffd7b, 0xe2144007, 0x0a000003,
-  0xe3a00000, 0xe3540003, 0x0afffdae, 0xbafffd71,
-  0xe3a01000, 0xe3b02100, 0xe2e23902, 0xe2000102,
-  0xe1800003, 0xe3540000, 0x13a0320a, 0xe3a04004,
-  0xeafffd6c, 0xeafffffe, 0xe209aa0f, 0xe3190008,
-  0x1a000069, 0xe2095007, 0xe08c5205, 0xe895000f,
-  0xe1b04d23, 0xe28f7000, 0x1afffc87, 0xe1b04883,
-  0x12944802, 0x0a00002b, 0x5a000039, 0xe354083e,
-  0xe20448ff, 0x4a000049, 0xe1a048a4, 0xe2199060,
-  0x1a00000e, 0xe2846002, 0xe1922611, 0xe3a02101,
-  0xe0012432, 0x000220a1, 0xe264401f, 0xe1a01431,
-  0xe3320000, 0x12811001, 0xe3100102, 0x12611000,
-  0xe0312000, 0x4a000049, 0xe78d152a, 0xeafff805,
-  0xe3590060, 0x1a000005, 0xe264401f, 0xe1a01431,
-  0xe3100102, 0x12611000, 0xe78d152a, 0xeafff7fd,
-  0xe0307d09, 0x5afffff7, 0xe2846001, 0xe1922611,
-  0x0afffff4, 0xe264401f, 0xe1a01431, 0xe2811001,
-  0xe3100102, 0x12611000, 0xe0312000, 0x4a000033,
-  0xe78d152a, 0xeafff7ef, 0xe31300ff, 0x1a000003,
-  0xe1921001, 0x1a000006, 0xe78d152a, 0xeafff7e9,
-  0xe1921001, 0x0a000029, 0xe28f70bc, 0xe3a04001,
-  0xeafffd28, 0xe02970a9, 0xe3170020, 0x0a000010,
-  0xea000003, 0xe2199060, 0x0a000008, 0xe3590060,
-  0x0a00000b, 0xe0307d09, 0x5a000009, 0xe3a01001,
-  0xe3100102, 0x12611000, 0xe78d152a, 0xeafff7d5,
-  0xe2947802, 0x5a000002, 0xe3510102, 0x03520000,
-  0x8afffff5, 0xe3a01000, 0xe78d152a, 0xea000016,
-  0xe354083e, 0x03510102, 0xe2000102, 0x03500102,
-  0x1a00000a, 0xe3520000, 0x0affffae, 0xe2199060,
-  0x0a000004, 0xe3590060, 0x0affffaa, 0xe0307d09,
-  0x5affffa8, 0xea000001, 0xe3520102, 0x9affffa5,
-  0xe28f7014, 0xe3a04001, 0xeafffcfe, 0xe2091007,
-  0xe3510006, 0xaa000001, 0xe78d152a, 0xeafff7b5,
-  0xe2811003, 0xe351000a, 0x13a01001, 0xe2099060,
-  0x13590020, 0x1affffde, 0xe78d152a, 0xeafff7ad,
-  0xe3190080, 0x1a000034, 0xe2097a0f, 0xe79d8527,
-  0xe209b807, 0xe08cb62b, 0xe1b07008, 0x42688000,
-  0xe3a0a09e, 0xe28aadfe, 0x03a0a01f, 0xe1b0c828,
-  0x01a08808, 0x024aa010, 0xe1b0cc28, 0x01a08408,
-  0x024aa008, 0xe1b0ce28, 0x01a08208, 0x024aa004,
-  0xe1b0cf28, 0x01a08108, 0x024aa002, 0xe1b0cfa8,
-  0x01a08088, 0x024aa001, 0xe1b0cc08, 0x1a000002,
-  0xe3a09000, 0xe88b0780, 0xeafff79d, 0xe2199060,
-  0x1a000008, 0xe1b0c08c, 0xe208c080, 0x000cc0a8,
-  0xe098800c, 0xe2aaa000, 0x23a08102, 0xe3c880ff,
-  0xe88b0780, 0xeafff792, 0xe2399060, 0x0afffffa,
-  0xe027cc89, 0xe20cc102, 0xe0988bac, 0xe2aaa000,
-  0x23a08102, 0xe3a09000, 0xe3c880ff, 0xe88b0780,
-  0xeafff787, 0xe3190080, 0x1afff75f, 0xe2097a0f,
-  0xe79d8527, 0xe209b807, 0xe08cb62b, 0xe1b07008,
-  0x42688000, 0xe3a0a09e, 0xe28aadfe, 0x03a0a01f,
-  0xe1b09828, 0x01a08808, 0x024aa010, 0xe1b09c28,
-  0x01a08408, 0x024aa008, 0xe1b09e28, 0x01a08208,
-  0x024aa004, 0xe1b09f28, 0x01a08108, 0x024aa002,
-  0xe1b09fa8, 0x01a08088, 0x024aa001, 0xe3a09000,
-  0xe88b0780, 0xeafff76a, 0xe2097a0f, 0xe79da527,
-  0xe3ca801f, 0xe3d8881f, 0x1a000002, 0xe38aa000,
-  0xe58ca080, 0xeafff762, 0xe24f700c, 0xe3a04001,
-  0xeafffc94, 0xe2097a0f, 0xe59ca080, 0xe78da527,
-  0xeafff74c, 0xe1b08e09, 0x4a000037, 0xe08c8c28,
-  0xe898000f, 0xe1b04d23, 0xe28f7000, 0x1afffbae,
-  0xe2097807, 0xe1a0b003, 0xe1a0a002, 0xe0208509,
-  0xe1a09001, 0xe08cc627, 0xe89c000f, 0xe1b04d23,
-  0xe28f7000, 0x1afffba4, 0x188c000f, 0xe3a04803,
-  0xe0945883, 0x3094588b, 0x2a000015, 0xe0305008,
-  0x4a000009, 0xe153000b, 0x01510009, 0x0152000a,
-  0xe10f7000, 0xe2077206, 0x33877102, 0x13100102,
-  0x1227720a, 0xe168f007, 0xeafff72a, 0xe19b4003,
-  0x019a4002, 0x01994001, 0x0a000003, 0xe3100102,
-  0x1368f102, 0x0368f202, 0xeafff722, 0xe368f206,
-  0xeafff720, 0xe0945883, 0x3a000001, 0xe1915002,
-  0x1a000003, 0xe094588b, 0x3affffe3, 0xe199500a,
-  0x0affffe1, 0xe368f201, 0xe24fc0c0, 0xe24ccc24,
-  0xe24f7038, 0xe3a04001, 0xeafffc56, 0xe2097807,
-  0xe2095602, 0xe24f6074, 0xe0866c28, 0xe8960f00,
-  0xe0288505, 0xeaffffca, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x80000000,
-  0x00000000, 0x00003fff, 0x00000000, 0x80000000,
-  0x00000000, 0x00004000, 0x00000000, 0xc0000000,
-  0x00000000, 0x00004000, 0x00000000, 0x80000000,
-  0x00000000, 0x00004001, 0x00000000, 0xa0000000,
-  0x00000000, 0x00004001, 0x00000000, 0x80000000,
-  0x00000000, 0x00003ffe, 0x00000000, 0xa0000000,
-  0x00000000, 0x00004002, 0xe2097807, 0xe2095602,
-  0xe24f6e11, 0xe0866c28, 0xe8960f00, 0xe0288505,
-  0xea00000b, 0xe1b08e09, 0x4afffff6, 0xe08c8c28,
-  0xe898000f, 0xe1b04d23, 0xe28f7000, 0x1afffb46,
-  0xe2097807, 0xe1a0b003, 0xe1a0a002, 0xe0208509,
-  0xe1a09001, 0xe08cc627, 0xe89c000f, 0xe1b04d23,
-  0xe28f7000, 0x1afffb3c, 0x188c000f, 0xe3a04803,
-  0xe0945883, 0x3094588b, 0x2a00000b, 0xe0305008,
-  0x4affffa1, 0xe153000b, 0x01510009, 0x0152000a,
-  0xe10f7000, 0xe2077206, 0x33877102, 0x13100102,
-  0x1227720a, 0xe168f007, 0xeafff6c2, 0xe0945883,
-  0x3a000001, 0xe1915002, 0x1a000003, 0xe094588b,
-  0x3affffed, 0xe199500a, 0x0affffeb, 0xe368f201,
-  0xeafff6b8, 0xe2099060, 0xe3590020, 0x03a07209,
-  0x0a000006, 0xe3a00000, 0xe08cb42a, 0xe28f708c,
-  0xe2877c05, 0xea0000de, 0xe357020e, 0x0afffff4,
-  0xe24f8c02, 0xe0887c27, 0xe08cb42a, 0xe8970780,
-  0xe88b0780, 0xeafff6b6, 0xe24f8f85, 0xe0887c27,
-  0xe08cb42a, 0xe8970700, 0xe3a07102, 0xe88b0780,
-  0xeafff6af, 0xe24f7e23, 0xe0878c28, 0xe8980d00,
-  0xe3a04000, 0xea0001f3, 0xe24f7f91, 0xe0878c28,
-  0xe8980d00, 0xe3a04000, 0xea0002a5, 0xe3580102,
-  0x0a00040f, 0xe24f7e26, 0xe0878c28, 0xe8980d00,
-  0xea00035f, 0xe3580102, 0x0a00050f, 0xe24f7f9e,
-  0xe0878c28, 0xe8980d00, 0xea000456, 0xe24f7fa3,
-  0xe0876c26, 0xe896000f, 0xea000463, 0xe3580102,
-  0x0a0005b3, 0xe24f7e2a, 0xe0878c28, 0xe8980d00,
-  0xea000546, 0xe24f7fad, 0xe0876c26, 0xe896000f,
-  0xea000549, 0xe24f8fb1, 0xe0888c27, 0xe08cb42a,
-  0xe898000f, 0xe3570209, 0x9a00018e, 0xea000143,
-  0xe24f8e2e, 0xe0888c27, 0xe898000f, 0xea00063a,
-  0xe24f8e2f, 0xe0888c27, 0xe898000f, 0xea0006dd,
-  0xe24f8c03, 0xe0888c27, 0xe898000f, 0xea000790,
-  0xe24f8e31, 0xe0888c27, 0xe898000f, 0xea000858,
-  0xe3570102, 0x13570209, 0x1357020e, 0x1a0008fe,
-  0xe24f8e33, 0xe0888c27, 0xe898000f, 0xea000880,
-  0xe24f8d0d, 0xe0888c27, 0xe898000f, 0xea000992,
-  0xe24f7e35, 0xe0876c26, 0xe896000f, 0xea000937,
-  0xe24f7fd7, 0xe0878c28, 0xe8980d00, 0xea0005b6,
-  0xe3190080, 0x1afff638, 0xe1b07e09, 0xe209aa07,
-  0x4affff9e, 0xe08c7c27, 0xe08cb42a, 0xe8970780,
-  0xe88b0780, 0xeafff656, 0xe3190080, 0x1afff62e,
-  0xe1b07e09, 0xe209aa07, 0x4affff9a, 0xe08c7c27,
-  0xe08cb42a, 0xe8970780, 0xe2277102, 0xe88b0780,
-  0xeafff64b, 0xe3190080, 0x1afff623, 0xe1b07e09,
-  0xe209aa07, 0x4affff89, 0xe08c7c27, 0xe08cb42a,
-  0xe8970780, 0xe3c77102, 0xe88b0780, 0xeafff640,
-  0xe1b07e09, 0xe209aa07, 0x4affff80, 0xe08c7c27,
-  0xe08ca42a, 0xe897000f, 0xe2098080, 0xe3888040,
-  0xe1580ba3, 0x21b04183, 0x3a00001d, 0xe88a000f,
-  0xeafff62c, 0xe1b07e09, 0xe209aa07, 0x4affff79,
-  0xe08c7c27, 0xe08ca42a, 0xe897000f, 0xe2200102,
-  0xe2098080, 0xe3888040, 0xe1580ba3, 0x21b04183,
-  0x3a00000f, 0xe88a000f, 0xeafff61e, 0xe1b07e09,
-  0xe209aa07, 0x4affff65, 0xe08c7c27, 0xe08ca42a,
-  0xe897000f, 0xe3c00102, 0xe2098080, 0xe3888040,
-  0xe1580ba3, 0x21b04183, 0x3a000001, 0xe88a000f,
-  0xeafff610, 0xe1a04328, 0xe1844d23, 0xe24f7018,
-  0xe3540019, 0x0a00006b, 0xc3c03102, 0xe3140002,
-  0x1a000034, 0xe1b05883, 0x12955802, 0x0a00001c,
-  0xe2195060, 0x1a00000c, 0xe1925c81, 0xe2012080,
-  0x000220a1, 0xe0911002, 0x23a01102, 0xe2a33000,
-  0xe3a02000, 0xe3c110ff, 0xe2535dfe, 0x9a00001a,
-  0xe35500ff, 0x31a0f007, 0xea000012, 0xe3550060,
-  0x11922c01, 0x10305d05, 0x5afffff4, 0xe2911c01,
-  0x23a01102, 0xe2a33000, 0xe3a02000, 0xe3c110ff,
-  0xe2535dfe, 0x9a00000c, 0xe35500ff, 0x31a0f007,
-  0xea000004, 0xe31300ff, 0x11a0f007, 0xe1922001,
-  0x01a0f007, 0xea00000a, 0xe3a030ff, 0xe3833c7f,
-  0xe3a01000, 0xe3a04004, 0xeafffb1a, 0xe3750017,
-  0xda000003, 0xe2655009, 0xe1a01531, 0xe1a01511,
-  0xe1a0f007, 0xe3a03000, 0xe3a02000, 0xe3a01000,
-  0xe3a04008, 0xeafffb0f, 0xe1b05883, 0x12955802,
-  0x0a000022, 0xe2195060, 0x1a00000f, 0xe1b04b02,
-  0xe2024b01, 0x000440a2, 0xe0922004, 0xe2b11000,
-  0xe2a33000, 0x23a01102, 0xe1a025a2, 0xe1a02582,
-  0xe2535b0f, 0x9a00001a, 0xe2854001, 0xe3540b02,
-  0x31a0f007, 0xe3a02000, 0xeaffffda, 0xe3550060,
-  0x11b04a82, 0x10305d05, 0x5afffff2, 0xe2922b02,
-  0xe2b11000, 0x23a01102, 0xe2a33000, 0xe1a025a2,
-  0xe1a02582, 0xe2535b0f, 0x9a000009, 0xe2854001,
-  0xe3540b02, 0x31a0f007, 0xe3a02000, 0xeaffffc9,
-  0xe31300ff, 0x11a0f007, 0xe1922001, 0x01a0f007,
-  0xeaffffcf, 0xe3750034, 0xdaffffcd, 0xe265500c,
-  0xe2554020, 0x21a02431, 0x31a02532, 0x21a01412,
-  0xe1a02512, 0xe1a0f007, 0xe1a03080, 0xe1b03aa3,
-  0x12834001, 0x13340b02, 0x0a000023, 0xe2833b0f,
-  0xe2195060, 0x1a00000f, 0xe1b04201, 0xe1a01aa1,
-  0xe1811580, 0xe3811102, 0xe2014080, 0x000440a1,
-  0xe0911004, 0x23a01102, 0xe2a33000, 0xe3c110ff,
-  0xe3a02000, 0xe2535dfe, 0x9affffab, 0xe35500ff,
-  0x31a0f007, 0xeaffffa3, 0xe1b04181, 0xe1a01aa1,
-  0xe1811580, 0xe3811102, 0x13550060, 0x10305d05,
-  0x5afffff1, 0xe2911c01, 0x23a01102, 0xe2a33000,
-  0xe3a02000, 0xe3c110ff, 0xe2535dfe, 0x9affff9a,
-  0xe35500ff, 0x31a0f007, 0xeaffff92, 0xe1833203,
-  0xe1912600, 0x01a0f007, 0xe1a02581, 0xe1a01aa1,
-  0xe1811580, 0xe31300ff, 0x11a0f007, 0xeaffff94,
-  0xe3190080, 0x1afff54c, 0xe1b07e09, 0xe209aa07,
-  0x4afffeb0, 0xe08c7c27, 0xe08cb42a, 0xe897000f,
-  0xe1b04d23, 0xe28f7000, 0x1afff9c3, 0xe1a04883,
-  0xe2944802, 0x0a00000b, 0xe92c4000, 0xebfff83c,
-  0xe8bc4000, 0xe28f7014, 0x1afffa96, 0xe1898629,
-  0xe3180080, 0x0affff4e, 0xe3190080, 0x1affff81,
-  0xe88b000f, 0xeafff553, 0xe1928001, 0x0a000003,
-  0xe3811101, 0xe24f701c, 0xe3a04001, 0xeafffa89,
-  0xe3a02000, 0xe24f702c, 0xeaffff66, 0xe3190080,
-  0x1afff529, 0xe1b07e09, 0xe209aa07, 0x4afffec0,
-  0xe08c8c27, 0xe08cb42a, 0xe898000f, 0xe1b04d23,
-  0xe28f7000, 0x1afff9a0, 0x1888000f, 0xe1b04883,
-  0x12944802, 0x0a000063, 0xe3100102, 0x1a000059,
-  0xe2833901, 0xe2433001, 0xe1b030a3, 0xe1a05002,
-  0x32414102, 0x22414101, 0x33a07201, 0x23a07202,
-  0xe3a01102, 0xe0955005, 0xe0b44004, 0xe0216007,
-  0x31540006, 0x20444006, 0x20211087, 0xe1b070e7,
-  0x5afffff7, 0xe1942005, 0x11892629, 0x12122080,
-  0x03a07000, 0x0a000018, 0xe3a02000, 0xe0955005,
-  0xe0b44004, 0xe0a00000, 0xe0226007, 0xe055a006,
-  0xe0d48001, 0x31b000a0, 0x21a0500a, 0x21a04008,
-  0x20222087, 0x20211fa7, 0xe1b070a7, 0x1afffff2,
-  0xe0955005, 0xe0b44004, 0xe0b70007, 0xe0d5a002,
-  0xe0d48001, 0x31b000a0, 0x21a0500a, 0x21a04008,
-  0x22222001, 0x23a07102, 0xe3a00000, 0xe3190702,
-  0x1a000008, 0xe1954004, 0x01944007, 0x13822001,
-  0xe28f7044, 0xe3530000, 0xdaffff29, 0xe3190080,
-  0x0afffef7, 0xeaffff2b, 0xe2196060, 0x1a000015,
-  0xe0977007, 0xe0b55005, 0xe0b44004, 0x2a000002,
-  0xe1540001, 0x01550002, 0x03570101, 0xe2b22000,
-  0xe2b11000, 0xe2a33000, 0x23a01102, 0xe59c5080,
-  0xe3150010, 0x0a000001, 0xe88b000f, 0xeafff4ed,
-  0xe3855010, 0xe58c5080, 0xe3150601, 0x0afffff9,
-  0xe3a00010, 0xea0008b4, 0xe1945005, 0x01955007,
-  0x13560060, 0x0afffff0, 0xe1300c86, 0x4affffee,
-  0xe2922001, 0xeaffffe9, 0xe3a014c5, 0xe3a02000,
-  0xe3a030ff, 0xe1833383, 0xe3811101, 0xe24f705c,
-  0xe3a04001, 0xeafffa13, 0xe3530000, 0x1a000008,
-  0xe1914002, 0x0affffe3, 0xe1b01001, 0x4affff95,
-  0xe0922002, 0xe0b11001, 0xe2433001, 0x5afffffb,
-  0xeaffff90, 0xe1914002, 0x1affffee, 0xe3100102,
-  0x0affffd5, 0xeaffffe7, 0xe3190080, 0x1afff4a6,
-  0xe1b08e09, 0x4afffe1a, 0xe08c8c28, 0xe898000f,
-  0xe1b04d23, 0x0a00000b, 0xe28f7024, 0xe3540008,
-  0x1afff91d, 0xe3a02000, 0xe1a03080, 0xe1b03c23,
-  0x133300ff, 0x11a01400, 0x13811102, 0x12833dfe,
-  0x0afffa4d, 0xe888000f, 0xe1a0b003, 0xe1a0a002,
-  0xe1a08001, 0xe2004102, 0xe2096807, 0xe08c6626,
-  0xe896000f, 0xe1340000, 0x4a0000b6, 0xe1b04d23,
-  0x0a00000b, 0xe28f7024, 0xe3540008, 0x1afff906,
-  0xe3a02000, 0xe1a03080, 0xe1b03c23, 0x133300ff,
-  0x11a01400, 0x13811102, 0x12833dfe, 0x0afffa36,
-  0xe886000f, 0xe3a06802, 0xe0965883, 0x3096588b,
-  0x2a000061, 0xe053400b, 0x4a000046, 0xe2745020,
-  0xda00000e, 0xe092243a, 0x20822518, 0x30922518,
-  0xe0b11438, 0xe1a0851a, 0xe1a0a088, 0x2a000011,
-  0xe3190702, 0x1a00001d, 0xe19aa008, 0x13822001,
-  0xe28f7090, 0xe3190080, 0x0afffe7d, 0xeafffeb1,
-  0xe3540040, 0xc18aa008, 0xc3a08000, 0xaa00000b,
-  0xe2444020, 0xe2645020, 0xe0922438, 0xe2b11000,
-  0xe1a08518, 0xe18aa088, 0xe2a33000, 0x218aa008,
-  0x21a08f82, 0x21a020a2, 0x21822f81, 0x21a01061,
-  0xe3190702, 0x1a000005, 0xe19aa008, 0x13822001,
-  0xe28f7030, 0xe3190080, 0x0afffe65, 0xeafffe99,
-  0xe2197060, 0x1a000014, 0xe19aa088, 0x00088f82,
-  0xe0922fa8, 0xe2b11000, 0xe2a33000, 0x23a01102,
-  0xe0965883, 0x0a00003b, 0xe59c5080, 0xe3150010,
-  0x0a000003, 0xe2099a07, 0xe08c9429, 0xe889000f,
-  0xeafff45c, 0xe3855010, 0xe58c5080, 0xe3150601,
-  0x0afffff7, 0xe3a00010, 0xea000823, 0xe19aa008,
-  0x13570060, 0x0affffef, 0xe1300c87, 0x4affffed,
-  0xe2922001, 0xeaffffe6, 0xe2644000, 0xe1a0300b,
-  0xe1a05001, 0xe1a01008, 0xe1a08005, 0xe1a05002,
-  0xe1a0200a, 0xe1a0a005, 0xe2745020, 0xdaffffbf,
-  0xe092243a, 0x20822518, 0x30922518, 0xe0b11438,
-  0xe1a0851a, 0xe1a0a088, 0x2affffc2, 0xe3190702,
-  0x1affffce, 0xe19aa008, 0x13822001, 0xe24f70ac,
-  0xe3190080, 0x0afffe2e, 0xeafffe62, 0xe0965883,
-  0x1a000001, 0xe1925001, 0x1a000006, 0xe096588b,
-  0x1affffcc, 0xe1a0300b, 0xe1a01008, 0xe1a0200a,
-  0xe1915002, 0x0affffc7, 0xe3811101, 0xe24f70ec,
-  0xe3a04001, 0xeafff963, 0xe3a030ff, 0xe1833383,
-  0xe3a02000, 0xe3a01000, 0xe24f7f42, 0xe3a04004,
-  0xeafff95c, 0xe1b04d23, 0x0a00000b, 0xe28f7024,
-  0xe3540008, 0x1afff87c, 0xe3a02000, 0xe1a03080,
-  0xe1b03c23, 0x133300ff, 0x11a01400, 0x13811102,
-  0x12833dfe, 0x0afff9ac, 0xe886000f, 0xe0200589,
-  0xeaffff73, 0xe3190080, 0x1afff3ef, 0xe1b08e09,
-  0x4afffd68, 0xe08c8c28, 0xe898000f, 0xe1b04d23,
-  0x0a00000b, 0xe28f7024, 0xe3540008, 0x1afff866,
-  0xe3a02000, 0xe1a03080, 0xe1b03c23, 0x133300ff,
-  0x11a01400, 0x13811102, 0x12833dfe, 0x0afff996,
-  0xe888000f, 0xe1a0b003, 0xe1a0a002, 0xe1a08001,
-  0xe2004102, 0xe2096807, 0xe08c6626, 0xe896000f,
-  0xe1340000, 0x4affffd2, 0xe1b04d23, 0x0a00000b,
-  0xe28f7024, 0xe3540008, 0x1afff84f, 0xe3a02000,
-  0xe1a03080, 0xe1b03c23, 0x133300ff, 0x11a01400,
-  0x13811102, 0x12833dfe, 0x0afff97f, 0xe886000f,
-  0xe0200589, 0xe3a06802, 0xe0965883, 0x3096588b,
-  0x2a00006b, 0xe053400b, 0x01510008, 0x0152000a,
-  0x0a000078, 0x3a00004c, 0xe3a07000, 0xe2745020,
-  0xda000015, 0xe057651a, 0xe0d2243a, 0x30422518,
-  0x20522518, 0xe0d11438, 0x5a00001b, 0xe3190702,
-  0x1a000029, 0xe1977006, 0x13822001, 0xe28f70c0,
-  0xe3190080, 0x0afffdc2, 0xeafffdf6, 0x13a06102,
-  0xe3a07001, 0xe198500a, 0x0a000029, 0xe2522001,
-  0xe2d11000, 0x5a00000c, 0xea000011, 0xe3a06000,
-  0xe3540040, 0xaafffff4, 0xe2444020, 0xe2645020,
-  0xe057751a, 0xe0d6643a, 0x30466518, 0x20566518,
-  0xe0d22438, 0xe2d11000, 0x4a000005, 0xe0977007,
-  0xe0b66006, 0xe0b22002, 0xe0b11001, 0xe2433001,
-  0x5afffff9, 0xe3190702, 0x1a000007, 0xe3530000,
-  0xda00004c, 0xe1977006, 0x13822001, 0xe28f7030,
-  0xe3190080, 0x0afffd9e, 0xeafffdd2, 0xe2195060,
-  0x1a00000e, 0xe1977086, 0x00066f82, 0xe0922fa6,
-  0xe2b11000, 0xe2a33000, 0x23a01102, 0xe1b03003,
-  0x4a000042, 0xe59c5080, 0xe3150010, 0x0affff3c,
-  0xe2099a07, 0xe08c9429, 0xe889000f, 0xeafff395,
-  0xe1977006, 0x13550060, 0x0afffff3, 0xe1300c85,
-  0x4afffff1, 0xe2922001, 0xeaffffec, 0xe2644000,
-  0xe2200102, 0xe1a0300b, 0xe1a05001, 0xe1a01008,
-  0xe1a08005, 0xe1a05002, 0xe1a0200a, 0xe1a0a005,
-  0xe3a07000, 0xe2745020, 0xdaffffbf, 0xe057651a,
-  0xe0d2243a, 0x30422518, 0x20522518, 0xe0d11438,
-  0x5affffc5, 0xe3190702, 0x1affffd3, 0xe1977006,
-  0x13822001, 0xe24f7098, 0xe3190080, 0x0afffd6c,
-  0xeafffda0, 0xe0965883, 0x1a000005, 0xe1925001,
-  0x1affff44, 0xe153000b, 0x0198500a, 0x03a014c1,
-  0x0affff40, 0xe096588b, 0x1affffcd, 0xe2200102,
-  0xe1a0300b, 0xe1a01008, 0xe1a0200a, 0xe1915002,
-  0x0affffc7, 0xeaffff37, 0xe3a03000, 0xe3a02000,
-  0xe3a01000, 0xeaffffc2, 0xe3a03000, 0xe3a02000,
-  0xe3a01000, 0xe24f7f42, 0xe3a04008, 0xeafff895,
-  0xe2633000, 0xe2734020, 0x42435020, 0x41a02531,
-  0x51a02332, 0x51822411, 0xe1a01331, 0xe3a03000,
-  0xeaffffb3, 0xe3190080, 0x1afff32f, 0xe1b08e09,
-  0x4afffcad, 0xe08c8c28, 0xe898000f, 0xe1b04d23,
-  0x0a00000b, 0xe28f7024, 0xe3540008, 0x1afff7a6,
-  0xe3a02000, 0xe1a03080, 0xe1b03c23, 0x133300ff,
-  0x11a01400, 0x13811102, 0x12833dfe, 0x0afff8d6,
-  0xe888000f, 0xe2000102, 0xe183b000, 0xe1a0a002,
-  0xe1a08001, 0xe2096807, 0xe08c6626, 0xe896000f,
-  0xe1b04d23, 0x0a00000b, 0xe28f7024, 0xe3540008,
-  0x1afff791, 0xe3a02000, 0xe1a03080, 0xe1b03c23,
-  0x133300ff, 0x11a01400, 0x13811102, 0x12833dfe,
-  0x0afff8c1, 0xe886000f, 0xe020000b, 0xe3cbb102,
-  0xe3a06802, 0xe3530000, 0x135b0000, 0x0a00008c,
-  0xe0965883, 0x3096588b, 0x2afffee7, 0xe3b054ff,
-  0xe0a3300b, 0xe185b425, 0xe043392b, 0xe19a4088,
-  0x11924081, 0x0a000064, 0xe92c4209, 0xe1a04821,
-  0xe1c1500b, 0xe1a06822, 0xe1c2700b, 0xe1c8900b,
-  0xe1a08828, 0xe1cab00b, 0xe1a0a82a, 0xe0030b96,
-  0xe0020b94, 0xe0010994, 0xe0000a97, 0xe0933000,
-  0xe0000a95, 0xe0b22000, 0xe0000895, 0xe0b11000,
-  0x33a0e000, 0x23a0e001, 0xe0000996, 0xe0922000,
-  0xe2b11000, 0xe2aee000, 0xe0000897, 0xe0922000,
-  0xe2b11000, 0xe2aee000, 0xe18ee803, 0xe1a03823,
-  0xe1833802, 0xe1a02822, 0xe1822801, 0xe1a01821,
-  0xe181180e, 0xe3cee0ff, 0xe0000b95, 0xe00b0b97,
-  0xe09eb00b, 0xe0b33000, 0xe0000896, 0xe0b22000,
-  0xe0000894, 0xe0a11000, 0xe0000a94, 0xe00a0a96,
-  0xe09aa003, 0xe0b22000, 0xe2a11000, 0xe0000997,
-  0xe09aa000, 0xe0000995, 0xe0b22000, 0xe2b11000,
-  0xe8bc4209, 0x5a000009, 0xe3190702, 0x1a000017,
-  0xe19bb00a, 0x13822001, 0xe3530000, 0xdaffff79,
-  0xe28f7078, 0xe3190080, 0x0afffccd, 0xeafffd01,
-  0xe09bb00b, 0xe0baa00a, 0xe0b22002, 0xe0b11001,
-  0xe2433001, 0x5afffff9, 0xe3190702, 0x1a000007,
-  0xe3530000, 0xdaffff6b, 0xe19bb00a, 0x13822001,
-  0xe28f7038, 0xe3190080, 0x0afffcbd, 0xeafffcf1,
-  0xe2195060, 0x1a00001c, 0xe19bb08a, 0x000aaf82,
-  0xe0922faa, 0xe2b11000, 0xe2a33000, 0x23a01102,
-  0xe2934001, 0xda00001b, 0xe1b047a4, 0x1afffe91,
-  0xe59c5080, 0xe3150010, 0x0afffe59, 0xe2099a07,
-  0xe08c9429, 0xe889000f, 0xeafff2b2, 0xe19a4088,
-  0x11a0200a, 0x11a01008, 0xe2433001, 0xe3190702,
-  0x1affffee, 0xe3530000, 0xdaffff4a, 0xe24f7044,
-  0xe3190080, 0x0afffc9e, 0xeafffcd2, 0xe19bb00a,
-  0x13550060, 0x0affffe5, 0xe1300c85, 0x4affffe3,
-  0xe2922001, 0xeaffffde, 0xe2633000, 0xe3530040,
-  0xaaffff3c, 0xe2734020, 0x42435020, 0x41a02531,
-  0x51a02332, 0x51822411, 0xe1a01331, 0xe3a03000,
-  0xeaffffda, 0xe3530000, 0x1a000003, 0xe1915002,
-  0x0a00000c, 0xe35b0000, 0x1affff6c, 0xe198500a,
-  0x1affff6a, 0xe0965883, 0x33a03000, 0x33a02000,
-  0x33a01000, 0x3affffcd, 0xe1915002, 0x1afffe59,
-  0xe3a014c2, 0xeafffe57, 0xe096588b, 0x3affffc7,
-  0xe198500a, 0x1afffe48, 0xe1a0300b, 0xeafffff7,
-  0xe3190080, 0x1afff25c, 0xe2096807, 0xe08c6626,
-  0xe896000f, 0xe1b04d23, 0x0a00000b, 0xe28f7024,
-  0xe3540008, 0x1afff6d4, 0xe3a02000, 0xe1a03080,
-  0xe1b03c23, 0x133300ff, 0x11a01400, 0x13811102,
-  0x12833dfe, 0x0afff804, 0xe886000f, 0xe2000102,
-  0xe183b000, 0xe1a0a002, 0xe1a08001, 0xe1b06e09,
-  0x4afffbd1, 0xe08c6c26, 0xe896000f, 0xe1b04d23,
-  0x0a000035, 0xe28f7024, 0xe3540008, 0x1afff6be,
-  0xe3a02000, 0xe1a03080, 0xe1b03c23, 0x133300ff,
-  0x11a01400, 0x13811102, 0x12833dfe, 0x0afff7ee,
-  0xe886000f, 0xea000028, 0xe3190080, 0x1afff232,
-  0xe1b08e09, 0x4afffbb6, 0xe08c8c28, 0xe898000f,
-  0xe1b04d23, 0x0a00000b, 0xe28f7024, 0xe3540008,
-  0x1afff6a9, 0xe3a02000, 0xe1a03080, 0xe1b03c23,
-  0x133300ff, 0x11a01400, 0x13811102, 0x12833dfe,
-  0x0afff7d9, 0xe888000f, 0xe2000102, 0xe183b000,
-  0xe1a0a002, 0xe1a08001, 0xe2096807, 0xe08c6626,
-  0xe896000f, 0xe1b04d23, 0x0a00000b, 0xe28f7024,
-  0xe3540008, 0x1afff694, 0xe3a02000, 0xe1a03080,
-  0xe1b03c23, 0x133300ff, 0x11a01400, 0x13811102,
-  0x12833dfe, 0x0afff7c4, 0xe886000f, 0xe020000b,
-  0xe3cbb102, 0xe1b04883, 0x11b0588b, 0x12944802,
-  0x12955802, 0x0a000082, 0xe043300b, 0xe2833901,
-  0xe2433001, 0xe3a0b000, 0xe052500a, 0xe0d14008,
-  0x23a01003, 0x2a00000c, 0xe1a05002, 0xe1a04001,
-  0xe3a01001, 0xe2433001, 0xe0955005, 0xe0b44004,
-  0xe2abb000, 0xe055700a, 0xe0d46008, 0x31b0b0ab,
-  0x21a05007, 0x21a04006, 0xe0a11001, 0xe0955005,
-  0xe0b44004, 0xe2abb000, 0xe055700a, 0xe0d46008,
-  0x31b0b0ab, 0x21a05007, 0x21a04006, 0xe0a11001,
-  0xe0955005, 0xe0b44004, 0xe2abb000, 0xe055700a,
-  0xe0d46008, 0x31b0b0ab, 0x21a05007, 0x21a04006,
-  0xe0a11001, 0xe0955005, 0xe0b44004, 0xe2abb000,
-  0xe055700a, 0xe0d46008, 0x31b0b0ab, 0x21a05007,
-  0x21a04006, 0xe0b11001, 0x3affffda, 0xe1942005,
-  0x11892629, 0x12122080, 0x0a000025, 0xe3a02001,
-  0xe0955005, 0xe0b44004, 0xe2abb000, 0xe055700a,
-  0xe0d46008, 0x31b0b0ab, 0x21a05007, 0x21a04006,
-  0xe0a22002, 0xe0955005, 0xe0b44004, 0xe2abb000,
-  0xe055700a, 0xe0d46008, 0x31b0b0ab, 0x21a05007,
-  0x21a04006, 0xe0a22002, 0xe0955005, 0xe0b44004,
-  0xe2abb000, 0xe055700a, 0xe0d46008, 0x31b0b0ab,
-  0x21a05007, 0x21a04006, 0xe0a22002, 0xe0955005,
-  0xe0b44004, 0xe2abb000, 0xe055700a, 0xe0d46008,
-  0x31b0b0ab, 0x21a05007, 0x21a04006, 0xe0b22002,
-  0x3affffda, 0xe3190702, 0x1a000007, 0xe1954004,
-  0x13822001, 0xe3530000, 0xdafffe62, 0xe28f7048,
-  0xe3190080, 0x0afffbb6, 0xeafffbea, 0xe2197060,
-  0x1a000014, 0xe0955005, 0xe0b44004, 0x2a000002,
-  0xe1540008, 0x0155000a, 0x011500a2, 0xe2b22000,
-  0xe2b11000, 0xe2a33000, 0x23a01102, 0xe2934001,
-  0xdaffff10, 0xe1b047a4, 0x1afffd86, 0xe59c5080,
-  0xe3150010, 0x0afffd4e, 0xe2099a07, 0xe08c9429,
-  0xe889000f, 0xeafff1a7, 0xe1945005, 0x13570060,
-  0x0afffff1, 0xe1300c87, 0x4affffef, 0xe2922001,
-  0xeaffffea, 0xe1b04883, 0x1a000013, 0xe1915002,
-  0x1a00000d, 0xe1b0588b, 0x0198600a, 0x03a014c3,
-  0x03a030ff, 0x01833383, 0x0afffd6a, 0xe2955802,
-  0x1affffe8, 0xe198600a, 0x0affffe6, 0xe1a01008,
-  0xe1a0200a, 0xe1a0300b, 0xeafffd62, 0xe0922002,
-  0xe0b11001, 0xe2433001, 0x5afffffb, 0xe1b0588b,
-  0x1a000010, 0xe198600a, 0x1a00000a, 0xe2944802,
-  0x1a000001, 0xe1916002, 0x1afffd56, 0xe3a01000,
-  0xe3a02000, 0xe3a030ff, 0xe1833383, 0xe24f70bc,
-  0xe3a04002, 0xeafff6b7, 0xe09aa00a, 0xe0b88008,
-  0xe24bb001, 0x5afffffb, 0xe2956802, 0x12946802,
-  0x1affff50, 0xe2946802, 0x1a000006, 0xe1916002,
-  0x1afffd44, 0xe2956802, 0x1affffbf, 0xe198600a,
-  0x03a01331, 0x0afffd3f, 0xe198600a, 0x0afffe09,
-  0xe1a01008, 0xe1a0200a, 0xe1a0300b, 0xeafffd39,
-  0xe3190080, 0x1afff144, 0xe2096807, 0xe08c6626,
-  0xe896000f, 0xe1b04d23, 0xe28f7000, 0x1afff5be,
-  0x1886000f, 0xe2000102, 0xe183b000, 0xe1a0a002,
-  0xe1a08001, 0xe1b06e09, 0x4afffacd, 0xe08c6c26,
-  0xe896000f, 0xe1b04d23, 0xe28f7000, 0x1afff5b2,
-  0x1886000f, 0xea000014, 0xe3190080, 0x1afff12e,
-  0xe1b08e09, 0x4afffabc, 0xe08c8c28, 0xe898000f,
-  0xe1b04d23, 0xe28f7000, 0x1afff5a7, 0x1888000f,
-  0xe2000102, 0xe183b000, 0xe1a0a002, 0xe1a08001,
-  0xe2096807, 0xe08c6626, 0xe896000f, 0xe1b04d23,
-  0xe28f7000, 0x1afff59c, 0x1886000f, 0xe1a0700b,
-  0xe3cbb102, 0xe1b04883, 0x12944802, 0x11b0588b,
-  0x12955802, 0x0a00004e, 0xe92c4200, 0x5a000035,
-  0xe24b4c3f, 0xe24440fe, 0xe3540010, 0xca00002a,
-  0xe19a5418, 0x1a00002f, 0xe2649020, 0xe1a09938,
-  0xe0000f89, 0xe92c0080, 0xe3a08102, 0xe3a0a000,
-  0xe3a07901, 0xe257b001, 0xe92c0d80, 0x3bfff2b6,
-  0xe1b090a9, 0x3afffffc, 0xe8bc0d80, 0x192c000f,
-  0xebfff2b5, 0xe2834001, 0x0a000009, 0xe3540902,
-  0xaa000010, 0xe8bc0d80, 0xe92c000f, 0xe1a00007,
-  0xe1a01008, 0xe1a0200a, 0xe1a0300b, 0xebfff2aa,
-  0xeaffffee, 0xe8bc0080, 0xe3170102, 0x1bfff2f3,
-  0xe8bc4200, 0xe2934001, 0xdafffe6a, 0xe1b047a4,
-  0x1afffce0, 0xea0000cb, 0xe28cc010, 0xe8bc4280,
-  0xe3170102, 0x1afffda3, 0xeafffcda, 0xe3540040,
-  0x2a000012, 0xe2545020, 0x21b0651a, 0x0a000010,
-  0xe19a6418, 0x0a00000e, 0xe3100102, 0x1a00000e,
-  0xe92c0001, 0xe3a00000, 0xe92c0d80, 0xe3c99601,
-  0xeb0000e1, 0xe8bc0d80, 0xebfff28b, 0xeb000166,
-  0xe8bc4201, 0x0a0000b3, 0xe28f7e2f, 0xeafff629,
-  0x13b05100, 0x33a00000, 0xeafffff0, 0xe8bc4200,
-  0xe3a014c7, 0xe3a02000, 0xe3a030ff, 0xe1833383,
-  0xeafffcb8, 0xe3540000, 0x1a00001e, 0xe3530000,
-  0x0a000002, 0xe1916002, 0x1afffcb2, 0xea000001,
-  0xe1916002, 0x1a000010, 0xe1b0588b, 0x1a000006,
-  0xe198600a, 0x03a01102, 0x03a02000, 0x03a00000,
-  0x03a03901, 0x02433001, 0xea000096, 0xe2955802,
-  0x1a000094, 0xe198600a, 0x0a000092, 0xe1a01008,
-  0xe1a0200a, 0xe1a0300b, 0xeafffc9e, 0xe0922002,
-  0xe0b11001, 0xe2433001, 0x5afffffb, 0xe1b0588b,
-  0x12955802, 0x1affff8f, 0xe35b0000, 0x0a000008,
-  0xe1a01008, 0xe1a0200a, 0xe1a00007, 0xe1a0300b,
-  0xe198600a, 0x1afffc8f, 0xe3100102, 0x13a03000,
-  0xea00007c, 0xe198600a, 0x0affffdd, 0xe09aa00a,
-  0xe0b88008, 0xe24bb001, 0x5afffffb, 0xe92c4200,
-  0xeaffffb4, 0xe3190080, 0x1afff08f, 0xe1b08e09,
-  0x4afffa4e, 0xe08c8c28, 0xe898000f, 0xe1b04d23,
-  0xe28f7000, 0x1afff508, 0x1888000f, 0xe2000102,
-  0xe183b000, 0xe1a0a002, 0xe1a08001, 0xe2096807,
-  0xe08c6626, 0xe896000f, 0xe1b04d23, 0xe28f7000,
-  0x1afff4fd, 0x1886000f, 0xe1a0700b, 0xe3cbb102,
-  0xe1b04883, 0x12944802, 0x11b0588b, 0x12955802,
-  0x0a00000a, 0xe92c400f, 0xe92c0d80, 0xebfff27f,
-  0xebfff36f, 0xe8bc0d80, 0xebfff227, 0xe2200102,
-  0xe8bc0d80, 0xebfff178, 0xe8bc4000, 0xea00004d,
-  0xe1b04883, 0x1a000010, 0xe1915002, 0x1a00000a,
-  0xe1b0588b, 0x0198600a, 0x0a000013, 0xe2955802,
-  0x1a000015, 0xe198600a, 0x0a000013, 0xe1a01008,
-  0xe1a0200a, 0xe1a0300b, 0xeafffc4e, 0xe0922002,
-  0xe0b11001, 0xe2433001, 0x5afffffb, 0xe1b0588b,
-  0x1a000012, 0xe198600a, 0x1a00000c, 0xe2944802,
-  0x1a000001, 0xe1916002, 0x1afffc42, 0xe3a01333,
-  0xe3b02100, 0xe2e23902, 0xeafffc3e, 0xe3a00000,
-  0xe3a01000, 0xe3a02000, 0xe3a03000, 0xea000029,
-  0xe09aa00a, 0xe0b88008, 0xe24bb001, 0x5afffffb,
-  0xe2956802, 0x12946802, 0x1affffc9, 0xe2946802,
-  0x1a000008, 0xe1916002, 0x1afffc2e, 0x03a01333,
-  0xe2956802, 0x1afffc2b, 0xe198600a, 0x11a01008,
-  0x11a0200a, 0xeafffc27, 0xe198600a, 0x0a000015,
-  0xe1a01008, 0xe1a0200a, 0xe1a0300b, 0xeafffc21,
-  0xe3190080, 0x1afff02c, 0xe1b07e09, 0x4afff9cb,
-  0xe08c8c27, 0xe898000f, 0xe1b04d23, 0xe28f7000,
-  0x1afff4a5, 0x1888000f, 0xe1b04883, 0x12944802,
-  0x0a00001d, 0xe3100102, 0x1a000016, 0xe92c4000,
-  0xeb000029, 0xe8bc4000, 0xe3190702, 0x1a000005,
-  0xe28f7018, 0xe3530000, 0xdafffa5d, 0xe3190080,
-  0x0afffa2b, 0xeafffa5f, 0xe3530000, 0xba000006,
-  0xe59c5080, 0xe3150010, 0x0afffbd1, 0xe2099a07,
-  0xe08c9429, 0xe889000f, 0xeafff02a, 0xe3730040,
-  0xcafffcce, 0xeafffa4e, 0xe3a014c6, 0xe3a02000,
-  0xe3a030ff, 0xe1833383, 0xeafffbf6, 0xe3530000,
-  0x1a000008, 0xe1914002, 0x0afffff6, 0xe1b01001,
-  0x4affffdb, 0xe0922002, 0xe0b11001, 0xe2433001,
-  0x5afffffb, 0xeaffffd6, 0xe1914002, 0x1afffbe9,
-  0xe3100102, 0x0affffe1, 0xeaffffea, 0xe28f4f52,
-  0xe8940500, 0xe1510008, 0x0152000a, 0xe1a0a0a2,
-  0xe18aaf81, 0xe1a080a1, 0xe3888102, 0xe3a0b0fe,
-  0xe18bb30b, 0xe043400b, 0x92444001, 0xe92c4210,
-  0xe1a0300b, 0x8a000005, 0xe3c88101, 0xe0922002,
-  0xe0b11001, 0xe2433001, 0x5a000003, 0xea000008,
-  0xe3a00102, 0xe2722000, 0xe2f11000, 0x03520000,
-  0x0a000035, 0xe0922002, 0xe0b11001, 0xe2433001,
-  0x5afffff9, 0xe3a07000, 0xebfff1e0, 0xe92c000f,
-  0xebfff185, 0xe92c000f, 0xe28f90c4, 0xe8b90d00,
-  0xebfff125, 0xe89c0d80, 0xebfff183, 0xe8b90d00,
-  0xebfff0d8, 0xe89c0d80, 0xebfff17f, 0xe8b90d00,
-  0xebfff11d, 0xe89c0d80, 0xe92c000f, 0xe3a00102,
-  0xe8b9000e, 0xebfff178, 0xe8b90d00, 0xebfff0cd,
-  0xe28c4010, 0xe8940d80, 0xebfff173, 0xe8b90d00,
-  0xebfff111, 0xe8bc0d80, 0xebfff1c4, 0xe8bc0d80,
-  0xebfff16d, 0xe89c0d80, 0xebfff16b, 0xe8bc0d80,
-  0xebfff0bd, 0xe8bc0010, 0xebfff25e, 0xe92c000f,
-  0xe3a00000, 0xe8b9000e, 0xebfff163, 0xe8bc0d80,
-  0xebfff0b5, 0xe8bc0200, 0xe3190601, 0xe28f7074,
-  0x18970d00, 0x1bfff15c, 0xe8bc8000, 0xe3a00000,
-  0xe3a03000, 0xe28f9050, 0xeaffffed, 0xb504f333,
-  0xf9de6484, 0x8eac025b, 0x3e7076bb, 0x00004004,
-  0x9c041fd0, 0xa933ef60, 0x00004007, 0xc05ff4e0,
-  0x6c83bb96, 0x00004008, 0xca20ad9a, 0xb5e946e9,
-  0x00003ffe, 0x83125100, 0xb57f6509, 0x00004003,
-  0x803ff895, 0x9dacd228, 0x00004005, 0xb17217f7,
-  0xd1cf79ac, 0x00003ffe, 0xde5bd8a9, 0x37287195,
-  0x00003ffd, 0xe3190080, 0x1affef83, 0xe1b07e09,
-  0x4afff926, 0xe08c8c27, 0xe898000f, 0xe1b04d23,
-  0xe28f7000, 0x1afff3fc, 0x1888000f, 0xe1a04883,
-  0xe2944802, 0x0a000005, 0xe92c4000, 0xeb00000a,
-  0xe8bc4000, 0x0affff57, 0xe24f7d0a, 0xeafff4cd,
-  0xe1914002, 0x1afffb63, 0xe3100102, 0x0affff5b,
-  0xe3a00000, 0xe3a03000, 0xeaffff58, 0xe28f4f6e,
-  0xe3100102, 0x128f4f72, 0xe8b40d00, 0xe153000b,
-  0x01510008, 0x0152000a, 0x8a00005d, 0xe8940d00,
-  0xe153000b, 0x01510008, 0x0152000a, 0x3a000052,
-  0xe92c421f, 0xe28f9e1b, 0xe3a07000, 0xe8b90d00,
-  0xebfff111, 0xebfff238, 0xe3170102, 0x12644000,
-  0xe58c4010, 0xe92c0d80, 0xe3a00000, 0xe8b9000e,
-  0xebfff109, 0xe8bc0d80, 0xe92c000f, 0xe8b9000e,
-  0xe3a00102, 0xebfff104, 0xe92c000f, 0xe28c4020,
-  0xe894000f, 0xebfff20c, 0xe3170102, 0x0bfff09e,
-  0x1bfff054, 0xe1a0400c, 0xe92c000f, 0xe894000f,
-  0xebfff04d, 0xe8bc0d80, 0xebfff04b, 0xe28cc010,
-  0xe8bc0d80, 0xebfff048, 0xe88c000f, 0xebfff0ee,
-  0xe92c000f, 0xe3a07000, 0xe8b90d00, 0xebfff0ee,
-  0xe8b90d00, 0xebfff043, 0xe89c0d80, 0xebfff0ea,
-  0xe8b90d00, 0xebfff03f, 0xe89c0d80, 0xebfff0e6,
-  0xe8b90d00, 0xebfff03b, 0xe89c0d80, 0xe92c000f,
-  0xe3a00000, 0xe8b9000e, 0xebfff0df, 0xe8b90d00,
-  0xebfff034, 0xe28c7010, 0xe8970d80, 0xebfff0da,
-  0xe8b90d00, 0xebfff02f, 0xe28c7020, 0xe8970d80,
-  0xebfff0d5, 0xe8bc0d80, 0xe92c000f, 0xe2200102,
-  0xebfff025, 0xe1a07000, 0xe1a08001, 0xe1a0a002,
-  0xe1a0b003, 0xe8bc000f, 0xebfff120, 0xe8b90d00,
-  0xebfff020, 0xe28cc020, 0xe8bc4210, 0xe2844001,
-  0xe0833004, 0xe3b04000, 0xe1a0f00e, 0xe3b00000,
-  0xe3a01102, 0xe3a02000, 0xe3a03901, 0xe2433001,
-  0xe1a0f00e, 0xe3100102, 0xe3a00000, 0xe3a01000,
-  0xe3a02000, 0x13a03000, 0x13a04008, 0x03a030ff,
-  0x01833383, 0x03b04004, 0xe1a0f00e, 0xb17217f7,
-  0xd1cf79ab, 0x0000400c, 0x80000000, 0x00000000,
-  0x00003fbe, 0xb21dfe7f, 0x09e2baa9, 0x0000400c,
-  0x80000000, 0x00000000, 0x00003fbe, 0xb8aa3b29,
-  0x5c17f0bc, 0x00003fff, 0xde8082e3, 0x08654362,
-  0x00003ff2, 0xb1800000, 0x00000000, 0x00003ffe,
-  0xc99b1867, 0x2822a93e, 0x00003fea, 0xa57862e1,
-  0x46a6fb39, 0x00003ff4, 0xe8b9428e, 0xfecff592,
-  0x00003ffa, 0x80000000, 0x00000000, 0x00003ffe,
-  0x845a2157, 0x3490f106, 0x00003ff0, 0xf83a5f91,
-  0x50952c99, 0x00003ff7, 0x80000000, 0x00000000,
-  0x00003ffd, 0x80000000, 0x00000000, 0x00003ffe,
-  0xe3190080, 0x1affeecc, 0xe1b07e09, 0x4afff873,
-  0xe08c8c27, 0xe898000f, 0xe1b04d23, 0xe28f7000,
-  0x1afff345, 0x1888000f, 0xe1a04883, 0xe2944802,
-  0x0a000006, 0xe92c4000, 0xeb000007, 0xe8bc4000,
-  0x0afffea0, 0xe24f705c, 0xe2477c05, 0xeafff415,
-  0xe1914002, 0x03a01332, 0xeafffaaa, 0xe28f4f8f,
-  0xe8b40d00, 0xe153000b, 0x01510008, 0x0152000a,
-  0x8a00006c, 0xe1b01001, 0x5a000063, 0xe92c421f,
-  0xe3190601, 0xe28f9e22, 0xe3a07000, 0xe8b90d00,
-  0xebfff061, 0xebfff188, 0x1b00006d, 0xe58c4010,
-  0xe92c0d80, 0xe3a00000, 0xe8b9000e, 0xebfff05a,
-  0xe8bc0d80, 0xe92c000f, 0xe8b9000e, 0xe3a00102,
-  0xebfff055, 0xe92c000f, 0xe28c4020, 0xe894000f,
-  0xebfff15d, 0xe3170102, 0x0bffefef, 0x1bffefa5,
-  0xe1a0400c, 0xe92c000f, 0xe894000f, 0xebffef9e,
-  0xe8bc0d80, 0xebffef9c, 0xe28cc010, 0xe8bc0d80,
-  0xebffef99, 0xe3a04c3f, 0xe38440df, 0xe1530004,
-  0xba000037, 0xe88c000f, 0xebfff03b, 0xe92c000f,
-  0xe3a07000, 0xe8b90d00, 0xebfff03b, 0xe8b90d00,
-  0xebffefd9, 0xe89c0d80, 0xebfff037, 0xe8b90d00,
-  0xebffef8c, 0xe89c0d80, 0xebfff033, 0xe8b90d00,
-  0xebffefd1, 0xe89c0d80, 0xebfff02f, 0xe8b90d00,
-  0xebffef84, 0xe89c0d80, 0xe92c000f, 0xe3a00102,
-  0xe8b9000e, 0xebfff028, 0xe8b90d00, 0xebffef7d,
-  0xe28c7010, 0xe8970d80, 0xebfff023, 0xe8b90d00,
-  0xebffefc1, 0xe28c7010, 0xe8970d80, 0xebfff01e,
-  0xe28c7020, 0xe8970d80, 0xebfff01b, 0xe28c7020,
-  0xe8970d80, 0xebffef6c, 0xe8bc0d80, 0xe28cc020,
-  0xe8bc0010, 0xe3140001, 0x12200102, 0x1bfff1a7,
-  0xe29b4902, 0x4a000018, 0xe35b0000, 0x0198400a,
-  0x0a000015, 0xebfff061, 0xe8bc4200, 0xe3b04000,
-  0xe1a0f00e, 0xe24cc010, 0xe3a07000, 0xe3a08102,
-  0xe3b0a100, 0xe2eab901, 0xeaffffeb, 0xe1914002,
-  0x0affff99, 0xe2433001, 0xe0922002, 0xe0b11001,
-  0x5afffffb, 0xeaffff94, 0xe3a01332, 0xe3b02100,
-  0xe2f23902, 0xe3a04001, 0xe1a0f00e, 0xe3a01000,
-  0xe3b02100, 0xe2f33902, 0xe3a04004, 0xe8bc4200,
-  0xe1a0f00e, 0xe2844001, 0xe35b0000, 0x03a08102,
-  0xe3a06901, 0x0246b002, 0x01a0f00e, 0xe2466002,
-  0xe04b6006, 0xe3a05102, 0xe153000b, 0x01510008,
-  0x0152000a, 0x20888635, 0x21a0f00e, 0xe0588635,
-  0x51a08088, 0x524bb001, 0xe2444001, 0xe1a0f00e,
-  0xc90fdaa2, 0x00000000, 0x0000401d, 0xa2f9836e,
-  0x4e44152a, 0x00003ffe, 0x95777a5c, 0xf72cece6,
-  0x00003fed, 0xc9100000, 0x00000000, 0x00003fff,
-  0x85bba783, 0xb3c748a9, 0x00003fea, 0xa37b24c8,
-  0x4a42092e, 0x00003ff3, 0xd23cf50b, 0xf10aca84,
-  0x00003ff9, 0xeef5823f, 0xdecea969, 0x00003ffd,
-  0x80000000, 0x00000000, 0x00003fff, 0x95d5b975,
-  0x16391da8, 0x00003fef, 0xe0741531, 0xdd56f650,
-  0x00003ff6, 0x8895af2a, 0x6847fcd5, 0x00003ffc,
-  0xe3190080, 0x1affee00, 0xe1b07e09, 0x4afff7ab,
-  0xe08c8c27, 0xe898000f, 0xe1b04d23, 0xe28f7000,
-  0x1afff279, 0x1888000f, 0xe1a04883, 0xe2944802,
-  0x0a000015, 0xe1c00589, 0xe92c4000, 0xe1914002,
-  0x12433001, 0xebffff38, 0x1a000012, 0xe92c000f,
-  0xebffefa1, 0xe3a08102, 0xe3b0a100, 0xe2eab901,
-  0xebffeef8, 0xe1a07000, 0xe1a08001, 0xe1a0a002,
-  0xe1a0b003, 0xe8bc000f, 0xebffeff0, 0xe1914002,
-  0x12833001, 0xe8bc4000, 0xeafffdc2, 0xe1914002,
-  0x03a014c9, 0xeafff9cf, 0xe8bc4000, 0xe3540004,
-  0x03a03000, 0x03a00000, 0x0afffdba, 0xe3a014c9,
-  0xe3b02100, 0xe2e23902, 0xeafff9c6, 0xe3190080,
-  0x1affedd1, 0xe1b07e09, 0x4afff780, 0xe08c8c27,
-  0xe898000f, 0xe1b04d23, 0xe28f7000, 0x1afff24a,
-  0x1888000f, 0xe1b04883, 0x0a00006b, 0x52944802,
-  0x4a000072, 0xe92c4201, 0xe3a00000, 0xe3a05901,
-  0xe2455002, 0xe1530005, 0xaa000009, 0xe2094501,
-  0xe92c0010, 0xe3a04901, 0xe2444021, 0xe1530004,
-  0xba000049, 0xe92c000f, 0xebffef6b, 0xe92c000f,
-  0xea000012, 0xe2094501, 0xe2244501, 0xe92c0010,
-  0xe3a00102, 0xe3a08102, 0xe3b0a100, 0xe2eab901,
-  0xebffeebc, 0xe1914002, 0x0a00003b, 0xe2433001,
-  0xe24cc010, 0xe92c000f, 0xebfff01c, 0xe2200102,
-  0xe2833001, 0xe28c4010, 0xe884000f, 0xe89c000f,
-  0xe28f9f59, 0xe8b90d00, 0xebffeef7, 0xe89c0d80,
-  0xebffef55, 0xe8b90d00, 0xebffeeaa, 0xe89c0d80,
-  0xebffef51, 0xe8b90d00, 0xebffeeef, 0xe89c0d80,
-  0xebffef4d, 0xe8b90d00, 0xebffeea2, 0xe89c0d80,
-  0xebffef49, 0xe8b90d00, 0xebffeee7, 0xe89c0d80,
-  0xe92c000f, 0xe3a00102, 0xe8b9000e, 0xebffef42,
-  0xe8b90d00, 0xebffee97, 0xe28c7010, 0xe8970d80,
-  0xebffef3d, 0xe8b90d00, 0xebffeedb, 0xe28c7010,
-  0xe8970d80, 0xebffef38, 0xe8b90d00, 0xebffee8d,
-  0xe28c7010, 0xe8970d80, 0xebffef33, 0xe8b90d00,
-  0xebffeed1, 0xe28c7010, 0xe8970d80, 0xebffef2e,
-  0xe8bc0d80, 0xe28cc010, 0xebffef80, 0xe89c0d80,
-  0xebffef29, 0xe8bc0d80, 0xebffee7b, 0xe8bc0230,
-  0xe3190501, 0x0a000008, 0xe3150102, 0x028f5c01,
-  0x128f5f46, 0xe0855924, 0x02200102, 0xe8950d00,
-  0xebffee74, 0xe8bc4000, 0xeafffd46, 0xe3150102,
-  0xe28f50dc, 0xe0855924, 0xe8950d00, 0xebffee6d,
-  0x12200102, 0xe8bc4000, 0xeafffd3e, 0xe1915002,
-  0x0affff93, 0xe1b01001, 0x4affff91, 0xe2433001,
-  0xe0922002, 0xe0b11001, 0x5afffffb, 0xeaffff8c,
-  0xe2f35901, 0x01925081, 0x0affff89, 0xe2944802,
-  0x1a000001, 0xe1914002, 0x1afff93e, 0xe3a014ca,
-  0xe3b02100, 0xe2e23902, 0xeafff93a, 0xbe974377,
-  0xcc30f9e6, 0x00004003, 0x96f3e4b2, 0xc8e37cbc,
-  0x00004006, 0xbeee77e2, 0xb5423cf3, 0x00004007,
-  0xd0927880, 0xf5c2170b, 0x00004007, 0xa43601f1,
-  0x5c3e6196, 0x00004006, 0xb25dedaf, 0x30f3242c,
-  0x00003ffe, 0xa270bb27, 0x61c93957, 0x00004002,
-  0x9ec1654d, 0x36d4f820, 0x00004004, 0xe4d539b0,
-  0x56a451ad, 0x00004004, 0xdaf2ad41, 0xd05311c4,
-  0x00004003, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0xc90fdaa2, 0x2168c235, 0x00003fff,
-  0xc90fdaa2, 0x2168c235, 0x00004000, 0x00000000,
-  0xc90fdaa2, 0x2168c235, 0x00003fff, 0xe3190080,
-  0x1affed19, 0xe2096807, 0xe08c6626, 0xe896000f,
-  0xe1b04d23, 0xe28f7000, 0x1afff193, 0x1886000f,
-  0xe2000102, 0xe183b000, 0xe1a0a002, 0xe1a08001,
-  0xe1b06e09, 0x4afff6c9, 0xe08c6c26, 0xe896000f,
-  0xe1b04d23, 0xe28f7000, 0x1afff187, 0x1886000f,
-  0xe1a0700b, 0xe3cbb102, 0xe1b04883, 0x12944802,
-  0x11b0588b, 0x12955802, 0x192c4281, 0x1bffef0b,
-  0x1a00004e, 0xe1b04883, 0x1a000010, 0xe1915002,
-  0x1a00000a, 0xe1b0588b, 0x0198600a, 0x0a00001f,
-  0xe2955802, 0x1a000016, 0xe198600a, 0x0a000014,
-  0xe1a01008, 0xe1a0200a, 0xe1a0300b, 0xeafff8e1,
-  0xe0922002, 0xe0b11001, 0xe2433001, 0x5afffffb,
-  0xe1b0588b, 0x1a000019, 0xe198600a, 0x1a000013,
-  0xe2944802, 0x1a000001, 0xe1916002, 0x1afff8d5,
-  0xe1a04000, 0xe1a05007, 0xe28f0fbd, 0xe890000e,
-  0xea00008c, 0xe1a04000, 0xe1a05007, 0xe3a00000,
-  0xe3a01000, 0xe3a02000, 0xe3a03000, 0xea00007d,
-  0xe3a014cb, 0xe3b02100, 0xe2e23902, 0xeafff8c5,
-  0xe09aa00a, 0xe0b88008, 0xe24bb001, 0x5afffffb,
-  0xe2956802, 0x12946802, 0x1affffca, 0xe2946802,
-  0x1a000006, 0xe1916002, 0x1afff8ba, 0xe2956802,
-  0x1affffe2, 0xe198600a, 0x03a014cb, 0x0afff8b5,
-  0xe198600a, 0x0affffe2, 0xe1a01008, 0xe1a0200a,
-  0xe1a0300b, 0xeafff8af, 0xe3190080, 0x1affecba,
-  0xe1b07e09, 0x4afff671, 0xe08c8c27, 0xe898000f,
-  0xe1b04d23, 0xe28f7000, 0x1afff133, 0x1888000f,
-  0xe1b04883, 0x12944802, 0x0a000060, 0xe92c4281,
-  0xe3b00100, 0xe2f34901, 0xdbffeeb0, 0xd3a04002,
-  0xc3a04000, 0xe28f9d06, 0xe8b90d00, 0xe153000b,
-  0x01510008, 0x0152000a, 0xc2844001, 0xe92c0010,
-  0xda00000d, 0xe92c000f, 0xe8990d00, 0xebffedad,
-  0xe8bc0d80, 0xe92c000f, 0xe3a00000, 0xe8b9000e,
-  0xebffee51, 0xe3a08102, 0xe3b0a100, 0xe2eab901,
-  0xebffeded, 0xe8bc0d80, 0xebffeea0, 0xe3a04901,
-  0xe2444021, 0xe1530004, 0xba00002c, 0xe92c000f,
-  0xebffee41, 0xe92c000f, 0xe28f9f49, 0xe8b90d00,
-  0xebffed98, 0xe89c0d80, 0xebffee3f, 0xe8b90d00,
-  0xebffed94, 0xe89c0d80, 0xebffee3b, 0xe8b90d00,
-  0xebffed90, 0xe89c0d80, 0xebffee37, 0xe8b90d00,
-  0xebffed8c, 0xe89c0d80, 0xe92c000f, 0xe3a00102,
-  0xe8b9000e, 0xebffee30, 0xe8b90d00, 0xebffedce,
-  0xe28c7010, 0xe8970d80, 0xebffee2b, 0xe8b90d00,
-  0xebffedc9, 0xe28c7010, 0xe8970d80, 0xebffee26,
-  0xe8b90d00, 0xebffedc4, 0xe28c7010, 0xe8970d80,
-  0xebffee21, 0xe8bc0d80, 0xe28cc010, 0xebffee73,
-  0xe89c0d80, 0xebffee1c, 0xe8bc0d80, 0xebffed6e,
-  0xe28f90dc, 0xe8bc0010, 0xe0200f04, 0xe0899204,
-  0xe8990d00, 0xebffed6b, 0xe8bc4230, 0xe3190601,
-  0x10200004, 0x1afffc3b, 0xe3150102, 0x0a000005,
-  0xe92c4010, 0xe2200102, 0xe24f7d0d, 0xe8970d00,
-  0xebffed60, 0xe8bc4010, 0xe0200004, 0xeafffc31,
-  0xe3530000, 0x0afffc2f, 0xe1914002, 0x1afff83d,
-  0xe28f009c, 0xe890000e, 0xeafffc2a, 0x8930a2f4,
-  0xf66ab18a, 0x00003ffd, 0xddb3d742, 0xc265539e,
-  0x00003fff, 0xf0624f0a, 0x56388310, 0x00004002,
-  0xee505190, 0x6d1eb4e8, 0x00004004, 0xac509020,
-  0x5b6d243b, 0x00004005, 0xa443e5e6, 0x24ad4b90,
-  0x00004004, 0xd66bd6cd, 0x8c3de934, 0x00003ffe,
-  0x87e9fae4, 0x6b531a29, 0x00004002, 0xa40bfdcf,
-  0x15e65691, 0x00004003, 0xdb053288, 0x30e70eb4,
-  0x00004002, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x860a91c1, 0x6b9b2c23, 0x00003ffe,
-  0x00000000, 0xc90fdaa2, 0x2168c235, 0x00003fff,
-  0x00000000, 0x860a91c1, 0x6b9b2c23, 0x00003fff,
-  0xe92d5001, 0xe24fc05c, 0xe24ccc50, 0xe3a00807,
-  0xe58c0080, 0xe8bd9001, 0xe1a00000, 0xe3100001,
-  0x128f0e15, 0x1a00000a, 0xe3100004, 0x128f0f47,
-  0x1a000007, 0xe3100002, 0x128f00e0, 0x1a000004,
-  0xe3100008, 0x128f00a8, 0x1a000001, 0xe28f0070,
-  0xeaffffff, 0xe28f101c, 0xe14fb000, 0xe8bd07f8,
-  0xe8a107f8, 0xe8bd07f8, 0xe24aa004, 0xe8a10ff8,
-  0xe28f1000, 0xef000071, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00000000,
-  0x00000000, 0x00000000, 0x00000000, 0x00002278,
-  0xffffffff, 0x80000204, 0x616f6c46, 0x676e6974,
-  0x696f5020, 0x4520746e, 0x70656378, 0x6e6f6974,
-  0x49203a20, 0x6178656e, 0x52207463, 0x6c757365,
-  0x00000074, 0x80000203, 0x616f6c46, 0x676e6974,
-  0x696f5020, 0x4520746e, 0x70656378, 0x6e6f6974,
-  0x55203a20, 0x7265646e, 0x776f6c66, 0x00000000,
-  0x80000202, 0x616f6c46, 0x676e6974, 0x696f5020,
-  0x4520746e, 0x70656378, 0x6e6f6974, 0x44203a20,
-  0x64697669, 0x79422065, 0x72655a20, 0x0000006f,
-  0x80000201, 0x616f6c46, 0x676e6974, 0x696f5020,
-  0x4520746e, 0x70656378, 0x6e6f6974, 0x4f203a20,
-  0x66726576, 0x00776f6c, 0x80000200, 0x616f6c46,
-  0x676e6974, 0x696f5020, 0x4520746e, 0x70656378,
-  0x6e6f6974, 0x49203a20, 0x6c61766e, 0x4f206469,
-  0x61726570, 0x6e6f6974, 0x00000000, 0xfefefeff, 0
-};
-
-unsigned long fpesize = 0x00005300;
@@ -88,6 +88,12 @@ ARMul_NewState (void)
   state->Mode = 0;
 
   state->CallDebug = FALSE;
+  state->ProfileNext = ~0UL;	/* not profiling */
+  state->ProfileCalls = FALSE;
+  state->PerfNext = ~0UL;	/* not measuring */
+  state->NextEvent = ~0UL;
+  state->Trace = FALSE;
+  state->FlightPos = 0;		/* nothing recorded yet */
   state->Debug = FALSE;
   state->VectorCatch = 0;
   state->Aborted = FALSE;
@@ -100,6 +106,8 @@ ARMul_NewState (void)
   state->MemOutPtr = NULL;
   state->MemSparePtr = NULL;
   state->MemSize = 0;
+  state->MemBase = NULL;
+  state->isize = 4;
 
   state->OSptr = NULL;
   state->CommandLine = NULL;
@@ -204,6 +212,22 @@ ARMword
 ARMul_DoProg (ARMul_State * state)
 {
   ARMword pc = 0;
+  ARMword (*emulate26) (ARMul_State *) = ARMul_Emulate26;
+#ifdef MODE32
+  ARMword (*emulate32) (ARMul_State *) = ARMul_Emulate32;
+#endif
+
+  /* Without events, interrupts or a debugger attached, use a loop that
+     doesn't check for them (nor for tracing, unless it's on) */
+  if (!state->EventSet && !state->Exception && !state->CallDebug)
+    {
+      int trace = state->verbose || state->Trace;
+
+      emulate26 = trace ? ARMul_Emulate26Trace : ARMul_Emulate26Fast;
+#ifdef MODE32
+      emulate32 = trace ? ARMul_Emulate32Trace : ARMul_Emulate32Fast;
+#endif
+    }
 
   state->Emulate = RUN;
   while (state->Emulate != STOP)
@@ -211,10 +235,10 @@ ARMul_DoProg (ARMul_State * state)
       state->Emulate = RUN;
 #ifdef MODE32
       if (state->prog32Sig && ARMul_MODE32BIT)
-	pc = ARMul_Emulate32 (state);
+	pc = emulate32 (state);
       else
 #endif
-	pc = ARMul_Emulate26 (state);
+	pc = emulate26 (state);
     }
   return (pc);
 }
@@ -0,0 +1,1137 @@
+/*  armjit.c -- x86-64 native code for hot predecoded blocks.
+    Copyright (C) 2022 Matt Evans
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA. */
+
+/* Once a block from armblock.c has run JIT_THRESHOLD times its ops are
+   compiled to a single x86-64 function, which returns the PC to carry
+   on from just as the runner's loop would have.
+
+   The most used guest registers of the block live in the callee saved
+   host registers rbp and r12-r15 for its duration, and are written back
+   to state->Reg at every exit.  The flags are always stored to NFlag
+   and friends as soon as they are set (they only ever hold 0 or 1, so
+   a setcc into the low byte will do), but are also tracked while still
+   in the host's EFLAGS so that a following condition can test them
+   directly.  The interpreter leaves them pending in FlagOp (armemu.h),
+   so they are brought up to date before entering native code and after
+   calling back into a handler.
+
+   Memory is accessed through the usual ARMul_LoadWordN() and friends,
+   which don't touch the registers.  Anything the block cache leaves to
+   Generic(), and stores to the vectors, calls the op's own handler with
+   the registers written back.  */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "armdefs.h"
+#include "armemu.h"
+#include "armblock.h"
+#include "armjit.h"
+#include "ansidecl.h"
+
+#if defined (__x86_64__)
+
+#include <sys/mman.h>
+
+/* Room enough for one block, the worst case being 64 LDM/STMs */
+#define JIT_OP_MAX 1024
+#define JIT_BLOCK_MAX (BLOCK_MAX_OPS * JIT_OP_MAX + 256)
+
+struct ARMul_Jit
+{
+  unsigned char *code;		/* RWX buffer, emptied with the cache */
+  unsigned long used;
+};
+
+/***************************************************************************\
+*                           x86-64 encoding                                 *
+\***************************************************************************/
+
+#define RAX 0
+#define RCX 1
+#define RDX 2
+#define RBX 3			/* holds state */
+#define RSP 4
+#define RBP 5
+#define RSI 6
+#define RDI 7
+#define R12 12
+#define R13 13
+#define R14 14
+#define R15 15
+
+/* Host registers given to guest registers, callee saved so they
+   survive calls into the emulator */
+#define JIT_CACHED_REGS 5
+static const int CacheRegs[JIT_CACHED_REGS] = { RBP, R12, R13, R14, R15 };
+
+/* Condition codes, as in jcc/setcc */
+#define CC_O 0x0
+#define CC_NO 0x1
+#define CC_B 0x2
+#define CC_AE 0x3
+#define CC_E 0x4
+#define CC_NE 0x5
+#define CC_BE 0x6
+#define CC_A 0x7
+#define CC_S 0x8
+#define CC_NS 0x9
+#define CC_L 0xc
+#define CC_GE 0xd
+#define CC_LE 0xe
+#define CC_G 0xf
+
+/* Opcodes of the "op r/m32, r32" ALU forms; +2 gives "op r32, r/m32" */
+#define X_ADD 0x01
+#define X_OR 0x09
+#define X_ADC 0x11
+#define X_SBB 0x19
+#define X_AND 0x21
+#define X_SUB 0x29
+#define X_XOR 0x31
+#define X_CMP 0x39
+#define X_TEST 0x85
+#define X_MOV 0x89
+
+/* The /digit of the 0x81 (ALU immediate) and 0xc1 (shift) groups */
+#define G_ADD 0
+#define G_AND 4
+#define G_CMP 7
+#define G_ROR 1
+#define G_RCR 3
+#define G_SHL 4
+#define G_SHR 5
+
+/* ARM flags held in EFLAGS */
+#define F_N 8
+#define F_Z 4
+#define F_C 2
+#define F_V 1
+
+#define STATE(field) ((int) offsetof (ARMul_State, field))
+#define REG(n) (STATE (Reg) + 4 * (n))
+
+typedef struct
+{
+  unsigned char *p;		/* next byte of code */
+  unsigned char *epilogue;	/* returns eax */
+  ARMul_BlockCache *bc;
+  int host[16];			/* host register for each guest one, or -1 */
+  unsigned live;		/* F_N etc. valid in EFLAGS */
+  int cinv;			/* CF holds !C, as after a subtract */
+  int clobbered;		/* EFLAGS changed since the op started */
+  unsigned char *pend[4];	/* jumps to the end of the current op */
+  int npend;
+} Emit;
+
+static inline void
+Byte (Emit * e, unsigned b)
+{
+  *e->p++ = b;
+}
+
+static inline void
+Word (Emit * e, uint32_t w)
+{
+  memcpy (e->p, &w, 4);
+  e->p += 4;
+}
+
+static inline void
+Quad (Emit * e, uint64_t q)
+{
+  memcpy (e->p, &q, 8);
+  e->p += 8;
+}
+
+static inline void
+Clobber (Emit * e)
+{
+  e->live = 0;
+  e->clobbered = 1;
+}
+
+static void
+Rex (Emit * e, int reg, int rm)
+{
+  if ((reg | rm) & 8)
+    Byte (e, 0x40 | ((reg & 8) ? 4 : 0) | ((rm & 8) ? 1 : 0));
+}
+
+/* opc with a register rm operand */
+static void
+OpRR (Emit * e, unsigned opc, int reg, int rm)
+{
+  Rex (e, reg, rm);
+  Byte (e, opc);
+  Byte (e, 0xc0 | (reg & 7) << 3 | (rm & 7));
+}
+
+/* opc with rm operand [rbx + disp], i.e. a field of state */
+static void
+OpRM (Emit * e, unsigned opc, int reg, int disp)
+{
+  Rex (e, reg, 0);
+  Byte (e, opc);
+  Byte (e, 0x80 | (reg & 7) << 3 | RBX);
+  Word (e, disp);
+}
+
+static void
+MovRR (Emit * e, int dst, int src)
+{
+  if (dst != src)
+    OpRR (e, X_MOV, src, dst);
+}
+
+static void
+MovRI (Emit * e, int r, ARMword imm)
+{
+  Rex (e, 0, r);
+  Byte (e, 0xb8 + (r & 7));
+  Word (e, imm);
+}
+
+/* mov dword [rbx + disp], imm */
+static void
+MovMI (Emit * e, int disp, ARMword imm)
+{
+  OpRM (e, 0xc7, 0, disp);
+  Word (e, imm);
+}
+
+/* dst = dst op src */
+static void
+Alu (Emit * e, unsigned opc, int dst, int src)
+{
+  OpRR (e, opc, src, dst);
+  Clobber (e);
+}
+
+/* r = r op [rbx + disp] */
+static void
+AluM (Emit * e, unsigned opc, int r, int disp)
+{
+  OpRM (e, opc + 2, r, disp);
+  Clobber (e);
+}
+
+static void
+AluI (Emit * e, int group, int r, ARMword imm)
+{
+  OpRR (e, 0x81, group, r);
+  Word (e, imm);
+  Clobber (e);
+}
+
+static void
+ShiftI (Emit * e, int group, int r, unsigned n)
+{
+  OpRR (e, 0xc1, group, r);
+  Byte (e, n);
+  Clobber (e);
+}
+
+static void
+Not (Emit * e, int r)
+{
+  OpRR (e, 0xf7, 2, r);
+}
+
+static void
+Neg (Emit * e, int r)
+{
+  OpRR (e, 0xf7, 3, r);
+  Clobber (e);
+}
+
+static void
+Imul (Emit * e, int dst, int src)
+{
+  Rex (e, dst, src);
+  Byte (e, 0x0f);
+  Byte (e, 0xaf);
+  Byte (e, 0xc0 | (dst & 7) << 3 | (src & 7));
+  Clobber (e);
+}
+
+/* setcc byte [rbx + disp] */
+static void
+SetFlag (Emit * e, int cc, int disp)
+{
+  Byte (e, 0x0f);
+  OpRM (e, 0x90 | cc, 0, disp);
+}
+
+/* CF = ARM carry, or its inverse for the subtracts */
+static void
+CarryIn (Emit * e, int invert)
+{
+  Byte (e, 0x0f);
+  OpRM (e, 0xba, 4, STATE (CFlag));	/* bt dword [rbx + CFlag], 0 */
+  Byte (e, 0);
+  if (invert)
+    Byte (e, 0xf5);		/* cmc */
+  Clobber (e);
+}
+
+/* The scratch dwords at [rsp] and [rsp + 4] */
+static void
+MovSR (Emit * e, int slot, int r)
+{
+  Byte (e, X_MOV);
+  Byte (e, 0x44 | (r & 7) << 3);
+  Byte (e, 0x24);
+  Byte (e, slot);
+}
+
+static void
+MovRS (Emit * e, int r, int slot)
+{
+  Byte (e, X_MOV + 2);
+  Byte (e, 0x44 | (r & 7) << 3);
+  Byte (e, 0x24);
+  Byte (e, slot);
+}
+
+static unsigned char *
+Jcc (Emit * e, int cc)
+{
+  Byte (e, 0x0f);
+  Byte (e, 0x80 | cc);
+  Word (e, 0);
+  return e->p;
+}
+
+static unsigned char *
+Jmp (Emit * e)
+{
+  Byte (e, 0xe9);
+  Word (e, 0);
+  return e->p;
+}
+
+/* Point the jump ending at "at" to target */
+static void
+Patch (unsigned char *at, unsigned char *target)
+{
+  int32_t rel = target - at;
+
+  memcpy (at - 4, &rel, 4);
+}
+
+/* Call fn (state, esi, edx) */
+static void
+Call (Emit * e, void *fn)
+{
+  Byte (e, 0x48);		/* mov rdi, rbx */
+  OpRR (e, X_MOV, RBX, RDI);
+  Byte (e, 0x48);		/* mov rax, fn */
+  Byte (e, 0xb8);
+  Quad (e, (uint64_t) fn);
+  Byte (e, 0xff);		/* call rax */
+  Byte (e, 0xd0);
+  Clobber (e);
+}
+
+/***************************************************************************\
+*                        Registers and exits                                *
+\***************************************************************************/
+
+static void
+GetReg (Emit * e, int r, unsigned n)
+{
+  if (e->host[n] >= 0)
+    MovRR (e, r, e->host[n]);
+  else
+    OpRM (e, X_MOV + 2, r, REG (n));
+}
+
+static void
+PutReg (Emit * e, unsigned n, int r)
+{
+  if (e->host[n] >= 0)
+    MovRR (e, e->host[n], r);
+  else
+    OpRM (e, X_MOV, r, REG (n));
+}
+
+/* Write the cached registers back to state->Reg */
+static void
+Spill (Emit * e)
+{
+  unsigned n;
+
+  for (n = 0; n < 16; n++)
+    if (e->host[n] >= 0)
+      OpRM (e, X_MOV, e->host[n], REG (n));
+}
+
+static void
+Reload (Emit * e)
+{
+  unsigned n;
+
+  for (n = 0; n < 16; n++)
+    if (e->host[n] >= 0)
+      OpRM (e, X_MOV + 2, e->host[n], REG (n));
+}
+
+/* Leave with eax as the next PC, count ops having been run */
+static void
+ExitCount (Emit * e, unsigned count)
+{
+  Byte (e, 0x48);		/* add qword [rbx + NumInstrs], count */
+  OpRM (e, 0x81, G_ADD, STATE (NumInstrs));
+  Word (e, count);
+  Patch (Jmp (e), e->epilogue);
+}
+
+static void
+ExitTo (Emit * e, ARMword pc, unsigned count)
+{
+  Spill (e);
+  MovRI (e, RAX, pc);
+  ExitCount (e, count);
+}
+
+/* Run the op's C handler, leaving if it doesn't return BLOCK_NEXT */
+static void
+CallOp (Emit * e, const ARMul_BlockOp * op, unsigned count)
+{
+  unsigned char *j;
+
+  Spill (e);
+  Byte (e, 0x48);		/* mov rsi, op */
+  Byte (e, 0xbe);
+  Quad (e, (uint64_t) op);
+  Call (e, (void *) op->fn);
+  AluI (e, G_CMP, RAX, BLOCK_NEXT);
+  j = Jcc (e, CC_E);
+  ExitCount (e, count);
+  Patch (j, e->p);
+  OpRM (e, 0x83, G_CMP, STATE (FlagOp));	/* cmp dword [rbx + FlagOp], 0 */
+  Byte (e, LAZY_NONE);
+  j = Jcc (e, CC_E);
+  Call (e, (void *) ARMul_FlagSync);
+  Patch (j, e->p);
+  Reload (e);
+}
+
+/* Stores to the vectors go through the handler, which aborts them */
+static void
+VectorCheck (Emit * e, const ARMul_BlockOp * op, unsigned count)
+{
+  unsigned char *j;
+
+  AluI (e, G_CMP, RSI, VECTORS);
+  j = Jcc (e, CC_AE);
+  CallOp (e, op, count);
+  e->pend[e->npend++] = Jmp (e);
+  Patch (j, e->p);
+}
+
+/* After a store, leave if it has just flushed the cache */
+static void
+FlushCheck (Emit * e, const ARMul_BlockOp * op, unsigned count)
+{
+  unsigned char *j;
+
+  Byte (e, 0x48);		/* mov rax, &bc->flushed */
+  Byte (e, 0xb8);
+  Quad (e, (uint64_t) & e->bc->flushed);
+  Byte (e, 0x83);		/* cmp dword [rax], 0 */
+  Byte (e, 0x38);
+  Byte (e, 0);
+  Clobber (e);
+  j = Jcc (e, CC_E);
+  ExitTo (e, op->pc + 4, count);
+  Patch (j, e->p);
+}
+
+/***************************************************************************\
+*                             Conditions                                    *
+\***************************************************************************/
+
+/* The jcc for cond if the flags it needs are still in EFLAGS, else -1 */
+static int
+HostCond (Emit * e, unsigned cond)
+{
+  static const unsigned need[16] = {
+    F_Z, F_Z, F_C, F_C, F_N, F_N, F_V, F_V,
+    F_C | F_Z, F_C | F_Z, F_N | F_V, F_N | F_V,
+    F_N | F_Z | F_V, F_N | F_Z | F_V, 0, 0
+  };
+
+  if (need[cond] & ~e->live)
+    return -1;
+  switch (cond)
+    {
+    case EQ:
+      return CC_E;
+    case NE:
+      return CC_NE;
+    case CS:
+      return e->cinv ? CC_AE : CC_B;
+    case CC:
+      return e->cinv ? CC_B : CC_AE;
+    case MI:
+      return CC_S;
+    case PL:
+      return CC_NS;
+    case VS:
+      return CC_O;
+    case VC:
+      return CC_NO;
+    case HI:
+      return e->cinv ? CC_A : -1;
+    case LS:
+      return e->cinv ? CC_BE : -1;
+    case GE:
+      return CC_GE;
+    case LT:
+      return CC_L;
+    case GT:
+      return CC_G;
+    case LE:
+      return CC_LE;
+    default:
+      return -1;
+    }
+}
+
+/* Test cond from the stored flags, returning the jcc taken if it passes */
+static int
+MemCond (Emit * e, unsigned cond)
+{
+  static const int flag[4] = {
+    STATE (ZFlag), STATE (CFlag), STATE (NFlag), STATE (VFlag)
+  };
+
+  switch (cond)
+    {
+    case HI:
+    case LS:
+      OpRM (e, X_MOV + 2, RAX, STATE (ZFlag));
+      AluI (e, 6, RAX, 1);	/* xor */
+      AluM (e, X_AND, RAX, STATE (CFlag));
+      return cond == HI ? CC_NE : CC_E;
+    case GE:
+    case LT:
+      OpRM (e, X_MOV + 2, RAX, STATE (NFlag));
+      AluM (e, X_CMP, RAX, STATE (VFlag));
+      return cond == GE ? CC_E : CC_NE;
+    case GT:
+    case LE:
+      OpRM (e, X_MOV + 2, RAX, STATE (NFlag));
+      AluM (e, X_XOR, RAX, STATE (VFlag));
+      AluM (e, X_OR, RAX, STATE (ZFlag));
+      return cond == GT ? CC_E : CC_NE;
+    default:			/* EQ to VC test a single flag */
+      OpRM (e, 0x83, G_CMP, flag[cond >> 1]);	/* cmp dword [...], 0 */
+      Byte (e, 0);
+      Clobber (e);
+      return cond & 1 ? CC_E : CC_NE;
+    }
+}
+
+/***************************************************************************\
+*                              Operands                                     *
+\***************************************************************************/
+
+/* Apply op's immediate shift to ecx, storing the carry out if setc */
+static void
+Shift (Emit * e, const ARMul_BlockOp * op, int setc)
+{
+  switch (op->shift)
+    {
+    case LSL:
+      ShiftI (e, G_SHL, RCX, op->shamt);
+      break;
+    case LSR:
+      if (op->shamt == 0)
+	{			/* LSR #32 */
+	  if (setc)
+	    {
+	      Byte (e, 0x0f);	/* bt ecx, 31 */
+	      OpRR (e, 0xba, 4, RCX);
+	      Byte (e, 31);
+	      SetFlag (e, CC_B, STATE (CFlag));
+	    }
+	  Alu (e, X_XOR, RCX, RCX);
+	  return;
+	}
+      ShiftI (e, G_SHR, RCX, op->shamt);
+      break;
+    default:			/* ROR; ASR never gets here */
+      if (op->shamt == 0)
+	{			/* RRX */
+	  CarryIn (e, 0);
+	  ShiftI (e, G_RCR, RCX, 1);
+	}
+      else
+	ShiftI (e, G_ROR, RCX, op->shamt);
+      break;
+    }
+  if (setc)
+    SetFlag (e, CC_B, STATE (CFlag));
+}
+
+/* Single data transfer offset into ecx */
+static void
+Offset (Emit * e, const ARMul_BlockOp * op)
+{
+  ARMword instr = op->instr;
+
+  if (!BIT (25))
+    {
+      MovRI (e, RCX, op->imm);
+      return;
+    }
+  GetReg (e, RCX, op->rm);
+  if (op->shift != LSL || op->shamt != 0)
+    Shift (e, op, FALSE);
+  if (op->down)
+    Neg (e, RCX);
+}
+
+/***************************************************************************\
+*                            Instructions                                   *
+\***************************************************************************/
+
+static void
+EmitDP (Emit * e, const ARMul_BlockOp * op)
+{
+  ARMword instr = op->instr;
+  unsigned opcode = BITS (21, 24);
+  unsigned s = BIT (20);
+  int logical, sub = FALSE, res = RAX;
+
+  if (op->rn == 15 && opcode != 13 && opcode != 15)
+    opcode = 13;		/* ADR, op->imm is the address */
+  logical = opcode <= 1 || opcode == 8 || opcode == 9 || opcode >= 12;
+
+  if (BIT (25))
+    {
+      MovRI (e, RCX, op->imm);
+      if (s && logical && op->immc)
+	MovMI (e, STATE (CFlag), op->imm >> 31);
+    }
+  else
+    {
+      GetReg (e, RCX, op->rm);
+      if (op->shift != LSL || op->shamt != 0)
+	Shift (e, op, s && logical);
+    }
+  if (opcode != 13 && opcode != 15)
+    GetReg (e, RAX, op->rn);
+
+  switch (opcode)
+    {
+    case 0:			/* AND */
+    case 8:			/* TST */
+      Alu (e, X_AND, RAX, RCX);
+      break;
+    case 1:			/* EOR */
+    case 9:			/* TEQ */
+      Alu (e, X_XOR, RAX, RCX);
+      break;
+    case 2:			/* SUB */
+    case 10:			/* CMP */
+      Alu (e, X_SUB, RAX, RCX);
+      sub = TRUE;
+      break;
+    case 3:			/* RSB */
+      Alu (e, X_SUB, RCX, RAX);
+      res = RCX;
+      sub = TRUE;
+      break;
+    case 4:			/* ADD */
+    case 11:			/* CMN */
+      Alu (e, X_ADD, RAX, RCX);
+      break;
+    case 5:			/* ADC */
+      CarryIn (e, FALSE);
+      Alu (e, X_ADC, RAX, RCX);
+      break;
+    case 6:			/* SBC */
+      CarryIn (e, TRUE);
+      Alu (e, X_SBB, RAX, RCX);
+      sub = TRUE;
+      break;
+    case 7:			/* RSC */
+      CarryIn (e, TRUE);
+      Alu (e, X_SBB, RCX, RAX);
+      res = RCX;
+      sub = TRUE;
+      break;
+    case 12:			/* ORR */
+      Alu (e, X_OR, RAX, RCX);
+      break;
+    case 13:			/* MOV */
+      res = RCX;
+      if (s)
+	Alu (e, X_TEST, RCX, RCX);
+      break;
+    case 14:			/* BIC */
+      Not (e, RCX);
+      Alu (e, X_AND, RAX, RCX);
+      break;
+    case 15:			/* MVN */
+      Not (e, RCX);
+      res = RCX;
+      if (s)
+	Alu (e, X_TEST, RCX, RCX);
+      break;
+    }
+
+  if (s)
+    {
+      SetFlag (e, CC_S, STATE (NFlag));
+      SetFlag (e, CC_E, STATE (ZFlag));
+      if (logical)
+	e->live = F_N | F_Z;
+      else
+	{
+	  SetFlag (e, sub ? CC_AE : CC_B, STATE (CFlag));
+	  SetFlag (e, CC_O, STATE (VFlag));
+	  e->live = F_N | F_Z | F_C | F_V;
+	  e->cinv = sub;
+	}
+    }
+  if (opcode < 8 || opcode >= 12)
+    PutReg (e, op->rd, res);
+}
+
+static void
+EmitMul (Emit * e, const ARMul_BlockOp * op)
+{
+  ARMword instr = op->instr;
+
+  GetReg (e, RAX, op->rm);
+  GetReg (e, RCX, op->rs);
+  Imul (e, RAX, RCX);
+  if (BIT (21))
+    {
+      GetReg (e, RCX, op->rn);
+      Alu (e, X_ADD, RAX, RCX);
+    }
+  if (BIT (20))
+    {
+      Alu (e, X_TEST, RAX, RAX);
+      SetFlag (e, CC_S, STATE (NFlag));
+      SetFlag (e, CC_E, STATE (ZFlag));
+      e->live = F_N | F_Z;
+    }
+  PutReg (e, op->rd, RAX);
+}
+
+static void
+EmitLS (Emit * e, const ARMul_BlockOp * op, unsigned count)
+{
+  ARMword instr = op->instr;
+  int load = BIT (20), byte = BIT (22), pre = BIT (24);
+  /* As in the handlers, a loaded base register is not written back */
+  int wb = op->rn != 15 && (!pre || BIT (21)) && !(load && op->rd == op->rn);
+
+  if (op->rn == 15)
+    MovRI (e, RSI, op->imm);	/* PC relative, address known */
+  else
+    {
+      GetReg (e, RSI, op->rn);
+      Offset (e, op);
+      if (pre)
+	Alu (e, X_ADD, RSI, RCX);
+      else if (wb)
+	{			/* the new base, before a load to Rd == Rm */
+	  Alu (e, X_ADD, RCX, RSI);
+	  MovSR (e, 4, RCX);
+	}
+    }
+  if (!load)
+    VectorCheck (e, op, count);
+  MovSR (e, 0, RSI);
+
+  if (load)
+    {
+      Call (e, byte ? (void *) ARMul_LoadByte : (void *) ARMul_LoadWordN);
+      if (!byte)
+	{			/* rotate an unaligned word, as ARMul_Align */
+	  MovRS (e, RCX, 0);
+	  AluI (e, G_AND, RCX, 3);
+	  ShiftI (e, G_SHL, RCX, 3);
+	  OpRR (e, 0xd3, G_ROR, RAX);	/* ror eax, cl */
+	}
+      PutReg (e, op->rd, RAX);
+    }
+  else
+    {
+      GetReg (e, RDX, op->rd);
+      Call (e, byte ? (void *) ARMul_StoreByte : (void *) ARMul_StoreWordN);
+    }
+
+  if (wb)
+    {
+      MovRS (e, RAX, pre ? 0 : 4);
+      PutReg (e, op->rn, RAX);
+    }
+
+  if (!load)
+    FlushCheck (e, op, count);
+}
+
+static void
+EmitLSM (Emit * e, const ARMul_BlockOp * op, unsigned count)
+{
+  ARMword instr = op->instr;
+  ARMword list = instr & 0xffff;
+  int load = BIT (20), wb = BIT (21), first = TRUE;
+  unsigned reg;
+
+  GetReg (e, RSI, op->rn);
+  if (wb)
+    {
+      MovRR (e, RAX, RSI);
+      AluI (e, G_ADD, RAX, op->wb);
+    }
+  AluI (e, G_ADD, RSI, op->imm);
+  if (!load)
+    VectorCheck (e, op, count);
+  MovSR (e, 0, RSI);
+  if (wb)
+    {
+      /* Written back first for LDM so a loaded base wins, and after
+         the first register for STM, as in the handlers */
+      if (load)
+	PutReg (e, op->rn, RAX);
+      else
+	MovSR (e, 4, RAX);
+    }
+
+  for (reg = 0; reg < 16; reg++)
+    {
+      if (!(list & (1 << reg)))
+	continue;
+      if (!first)
+	{
+	  Byte (e, 0x83);	/* add dword [rsp], 4 */
+	  Byte (e, 0x04);
+	  Byte (e, 0x24);
+	  Byte (e, 4);
+	  Clobber (e);
+	}
+      MovRS (e, RSI, 0);
+      if (load)
+	{
+	  Call (e, first ? (void *) ARMul_LoadWordN
+		: (void *) ARMul_LoadWordS);
+	  PutReg (e, reg, RAX);
+	}
+      else
+	{
+	  GetReg (e, RDX, reg);
+	  Call (e, first ? (void *) ARMul_StoreWordN
+		: (void *) ARMul_StoreWordS);
+	  if (first && wb)
+	    {
+	      MovRS (e, RAX, 4);
+	      PutReg (e, op->rn, RAX);
+	    }
+	}
+      first = FALSE;
+    }
+
+  if (!load)
+    FlushCheck (e, op, count);
+}
+
+/* BL's return address, with the PSR as in R15 */
+static void
+EmitLink (Emit * e, const ARMul_BlockOp * op)
+{
+  static const struct
+  {
+    int disp;
+    unsigned shift;
+  } psr[] = {
+    { STATE (ZFlag), 30 }, { STATE (CFlag), 29 },
+    { STATE (VFlag), 28 }, { STATE (IFFlags), 26 }
+  };
+  unsigned i;
+
+  OpRM (e, X_MOV + 2, RAX, STATE (NFlag));
+  ShiftI (e, G_SHL, RAX, 31);
+  for (i = 0; i < sizeof (psr) / sizeof (psr[0]); i++)
+    {
+      OpRM (e, X_MOV + 2, RCX, psr[i].disp);
+      ShiftI (e, G_SHL, RCX, psr[i].shift);
+      Alu (e, X_OR, RAX, RCX);
+    }
+  AluM (e, X_OR, RAX, STATE (Mode));
+  AluI (e, 1, RAX, op->pc + 4);	/* or */
+  PutReg (e, 14, RAX);
+}
+
+static void
+EmitOp (Emit * e, const ARMul_BlockOp * op, unsigned count)
+{
+  ARMword instr = op->instr;
+
+  switch (op->kind)
+    {
+    case BLOCK_DP:
+      EmitDP (e, op);
+      break;
+    case BLOCK_MUL:
+      EmitMul (e, op);
+      break;
+    case BLOCK_LS:
+      EmitLS (e, op, count);
+      break;
+    case BLOCK_LSM:
+      EmitLSM (e, op, count);
+      break;
+    case BLOCK_BRANCH:
+      if (BIT (24))
+	EmitLink (e, op);
+      ExitTo (e, op->imm, count);
+      break;
+    default:
+      CallOp (e, op, count);
+      Clobber (e);
+      break;
+    }
+}
+
+/***************************************************************************\
+*                              Compiling                                    *
+\***************************************************************************/
+
+/* Give the host registers to the guest registers most used natively */
+static void
+ChooseRegs (Emit * e, const ARMul_Block * b)
+{
+  unsigned uses[16], n, i;
+  const ARMul_BlockOp *op;
+
+  memset (uses, 0, sizeof (uses));
+  for (op = b->ops; op < b->ops + b->nops; op++)
+    {
+      ARMword instr = op->instr;
+
+      /* Only the operands each op reads or writes, as Emit* does */
+      switch (op->kind)
+	{
+	case BLOCK_DP:
+	  n = BITS (21, 24);
+	  if (n < 8 || n >= 12)
+	    uses[op->rd]++;
+	  if (n != 13 && n != 15)
+	    uses[op->rn]++;
+	  if (!BIT (25))
+	    uses[op->rm]++;
+	  break;
+	case BLOCK_MUL:
+	  uses[op->rd]++;
+	  uses[op->rm]++;
+	  uses[op->rs]++;
+	  if (BIT (21))
+	    uses[op->rn]++;
+	  break;
+	case BLOCK_LS:		/* unlike DP, bit 25 is a register offset */
+	  uses[op->rd]++;
+	  uses[op->rn]++;
+	  if (BIT (25))
+	    uses[op->rm]++;
+	  break;
+	case BLOCK_LSM:
+	  uses[op->rn]++;
+	  for (n = 0; n < 16; n++)
+	    if (op->instr & (1 << n))
+	      uses[n]++;
+	  break;
+	}
+    }
+
+  for (n = 0; n < 16; n++)
+    e->host[n] = -1;
+  uses[15] = 0;
+  for (i = 0; i < JIT_CACHED_REGS; i++)
+    {
+      unsigned best = 0;
+
+      for (n = 1; n < 15; n++)
+	if (uses[n] > uses[best])
+	  best = n;
+      if (uses[best] < 2)
+	break;
+      e->host[best] = CacheRegs[i];
+      uses[best] = 0;
+    }
+}
+
+static const unsigned char Epilogue[] = {
+  0x48, 0x83, 0xc4, 0x08,	/* add rsp, 8 */
+  0x41, 0x5f,			/* pop r15 */
+  0x41, 0x5e,			/* pop r14 */
+  0x41, 0x5d,			/* pop r13 */
+  0x41, 0x5c,			/* pop r12 */
+  0x5d,				/* pop rbp */
+  0x5b,				/* pop rbx */
+  0xc3				/* ret */
+};
+
+static const unsigned char Prologue[] = {
+  0x53,				/* push rbx */
+  0x55,				/* push rbp */
+  0x41, 0x54,			/* push r12 */
+  0x41, 0x55,			/* push r13 */
+  0x41, 0x56,			/* push r14 */
+  0x41, 0x57,			/* push r15 */
+  0x48, 0x83, 0xec, 0x08,	/* sub rsp, 8 (aligns, and the scratch) */
+  0x48, 0x89, 0xfb		/* mov rbx, rdi */
+};
+
+void
+ARMul_JitCompile (ARMul_State * state, ARMul_Block * b)
+{
+  ARMul_BlockCache *bc = state->BlockCache;
+  struct ARMul_Jit *jit = bc->jit;
+  unsigned char *start, *entry;
+  Emit e;
+  unsigned i, j;
+
+  if (jit->used + JIT_BLOCK_MAX > JIT_CODE_SIZE)
+    return;			/* full until the next flush */
+
+  memset (&e, 0, sizeof (e));
+  e.bc = bc;
+  e.p = start = jit->code + jit->used;
+  ChooseRegs (&e, b);
+
+  /* The epilogue goes first, so that exits know where it is */
+  e.epilogue = e.p;
+  memcpy (e.p, Epilogue, sizeof (Epilogue));
+  e.p += sizeof (Epilogue);
+  entry = e.p;
+  memcpy (e.p, Prologue, sizeof (Prologue));
+  e.p += sizeof (Prologue);
+  Reload (&e);
+
+  for (i = 0; i < b->nops; i++)
+    {
+      const ARMul_BlockOp *op = &b->ops[i];
+      unsigned live = 0;
+      int cinv = 0;
+
+      e.npend = 0;
+      e.clobbered = FALSE;
+      if (op->cond != AL)
+	{
+	  int cc = HostCond (&e, op->cond);
+
+	  if (cc < 0)
+	    cc = MemCond (&e, op->cond);
+	  e.pend[e.npend++] = Jcc (&e, cc ^ 1);
+	  live = e.live;
+	  cinv = e.cinv;
+	  e.clobbered = FALSE;
+	}
+
+      EmitOp (&e, op, i + 1);
+
+      for (j = 0; j < e.npend; j++)
+	Patch (e.pend[j], e.p);
+      if (op->cond != AL)
+	{			/* EFLAGS only known if the op left them */
+	  e.live = e.clobbered ? 0 : live;
+	  e.cinv = cinv;
+	}
+    }
+  ExitTo (&e, b->endpc, b->nops);
+
+  jit->used += ((e.p - start) + 15) & ~15UL;
+  b->native = (ARMul_BlockNative *) entry;
+}
+
+void
+ARMul_JitFlush (ARMul_State * state)
+{
+  state->BlockCache->jit->used = 0;
+}
+
+void
+ARMul_JitInit (ARMul_State * state)
+{
+  ARMul_BlockCache *bc = state->BlockCache;
+  struct ARMul_Jit *jit;
+  void *code;
+
+  if (bc == NULL)
+    return;
+  code = mmap (NULL, JIT_CODE_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC,
+	       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (code == MAP_FAILED)
+    return;			/* the block cache alone will do */
+  jit = (struct ARMul_Jit *) calloc (1, sizeof (struct ARMul_Jit));
+  if (jit == NULL)
+    {
+      munmap (code, JIT_CODE_SIZE);
+      return;
+    }
+  jit->code = (unsigned char *) code;
+  bc->jit = jit;
+}
+
+void
+ARMul_JitExit (ARMul_State * state)
+{
+  ARMul_BlockCache *bc = state->BlockCache;
+
+  if (bc->jit == NULL)
+    return;
+  munmap (bc->jit->code, JIT_CODE_SIZE);
+  free (bc->jit);
+  bc->jit = NULL;
+}
+
+#else /* !__x86_64__ */
+
+/* No native code for this host; bc->jit stays NULL */
+
+void
+ARMul_JitInit (ARMul_State * state ATTRIBUTE_UNUSED)
+{
+}
+
+void
+ARMul_JitCompile (ARMul_State * state ATTRIBUTE_UNUSED,
+		  ARMul_Block * b ATTRIBUTE_UNUSED)
+{
+}
+
+void
+ARMul_JitFlush (ARMul_State * state ATTRIBUTE_UNUSED)
+{
+}
+
+void
+ARMul_JitExit (ARMul_State * state ATTRIBUTE_UNUSED)
+{
+}
+
+#endif
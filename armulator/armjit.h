@@ -0,0 +1,34 @@
+/*  armjit.h -- x86-64 native code for hot predecoded blocks.
+    Copyright (C) 2022 Matt Evans
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA. */
+
+#ifndef ARMJIT_H
+#define ARMJIT_H
+
+/* A block is compiled once it has been run this many times */
+#ifndef JIT_THRESHOLD
+#define JIT_THRESHOLD 32
+#endif
+
+#define JIT_CODE_SIZE (32 * 1024 * 1024)
+
+/* Sets up state->BlockCache->jit if the host can run native code */
+extern void ARMul_JitInit (ARMul_State * state);
+extern void ARMul_JitCompile (ARMul_State * state, ARMul_Block * b);
+extern void ARMul_JitFlush (ARMul_State * state);
+extern void ARMul_JitExit (ARMul_State * state);
+
+#endif
@@ -0,0 +1,116 @@
+/*  armmem.h -- inline host memory interface:  ARM6 Instruction Emulator.
+    Copyright (C) 2022 Matt Evans
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA. */
+
+/* The host (rixrun) keeps the whole of guest memory in one flat array at
+   state->MemBase, so a load or store is just a pointer dereference.  This header
+   lets the emulator core do that inline rather than going through
+   ARMul_LoadWordN() -> ARMul_ReadWord() -> GetWord() for every access.
+
+   Build with -DARMUL_CYCLES to keep the armvirt.c path, which counts S/N
+   cycles and supports the ABORTS/VALIDATE memory models.  Stores always
+   go through ARMul_BlockWriteCheck() so that predecoded blocks over
+   modified code are dropped.  */
+
+#ifndef ARMMEM_H
+#define ARMMEM_H
+
+#include "armblock.h"
+#include "ansidecl.h"
+
+#if !defined (ARMUL_CYCLES) && !defined (ABORTS) && !defined (VALIDATE) \
+    && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define ARMUL_FASTMEM
+#endif
+
+#ifdef ARMUL_FASTMEM
+
+static inline ARMword
+ARMul_MemLoadWord (ARMul_State * state, ARMword address)
+{
+  return *(ARMword *) (state->MemBase + (address & ~3));
+}
+
+static inline ARMword
+ARMul_MemLoadInstr (ARMul_State * state, ARMword address, ARMword isize)
+{
+  if ((isize == 2) && (address & 0x2))
+    return *(unsigned short *) (state->MemBase + address)
+      | (*(unsigned short *) (state->MemBase + address + 2) << 16);
+  return ARMul_MemLoadWord (state, address);
+}
+
+static inline ARMword
+ARMul_MemLoadHalfWord (ARMul_State * state, ARMword address)
+{
+  return *(unsigned short *) (state->MemBase + (address & ~1));
+}
+
+static inline ARMword
+ARMul_MemLoadByte (ARMul_State * state, ARMword address)
+{
+  return state->MemBase[address];
+}
+
+static inline void
+ARMul_MemStoreWord (ARMul_State * state, ARMword address, ARMword data)
+{
+  *(ARMword *) (state->MemBase + (address & ~3)) = data;
+  ARMul_BlockWriteCheck (state, address);
+}
+
+static inline void
+ARMul_MemStoreHalfWord (ARMul_State * state, ARMword address, ARMword data)
+{
+  *(unsigned short *) (state->MemBase + (address & ~1)) = data;
+  ARMul_BlockWriteCheck (state, address);
+}
+
+static inline void
+ARMul_MemStoreByte (ARMul_State * state, ARMword address, ARMword data)
+{
+  state->MemBase[address] = data;
+  ARMul_BlockWriteCheck (state, address);
+}
+
+/* Rotate an unaligned LDR, as ARMul_Align() */
+static inline ARMword
+ARMul_MemAlign (ARMul_State * state ATTRIBUTE_UNUSED, ARMword address,
+		ARMword data)
+{
+  address = (address & 3) << 3;
+  return (data >> address) | (data << (32 - address));
+}
+
+/* armvirt.c defines the out-of-line versions (still used by the JIT and
+   LDC/STC) in terms of the above, everyone else gets them inline.  */
+#ifndef ARMMEM_OUTOFLINE
+#define ARMul_LoadInstrS ARMul_MemLoadInstr
+#define ARMul_LoadInstrN ARMul_MemLoadInstr
+#define ARMul_LoadWordS ARMul_MemLoadWord
+#define ARMul_LoadWordN ARMul_MemLoadWord
+#define ARMul_LoadHalfWord ARMul_MemLoadHalfWord
+#define ARMul_LoadByte ARMul_MemLoadByte
+#define ARMul_StoreWordS ARMul_MemStoreWord
+#define ARMul_StoreWordN ARMul_MemStoreWord
+#define ARMul_StoreHalfWord ARMul_MemStoreHalfWord
+#define ARMul_StoreByte ARMul_MemStoreByte
+#define ARMul_Align ARMul_MemAlign
+#endif
+
+#endif /* ARMUL_FASTMEM */
+
+#endif
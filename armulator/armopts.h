@@ -25,4 +25,9 @@
 #endif
 #endif
 
+/* Define ARMUL_CYCLES to model the ARM2 pipeline and count S, N, I and C
+   cycles as ARMulator always did, with memory accesses going through
+   armvirt.c.  Otherwise each instruction is fetched straight from the PC
+   (R15 still reads as PC + 8) and no cycles are counted.  */
+
 #endif
@@ -47,6 +47,7 @@ static ARMword ModeToBank (ARMul_State * state, ARMword mode);
 unsigned ARMul_NthReg (ARMword instr, unsigned number);
 
 void ARMul_NegZero (ARMul_State * state, ARMword result);
+void ARMul_FlagSync (ARMul_State * state);
 void ARMul_AddCarry (ARMul_State * state, ARMword a, ARMword b,
 		     ARMword result);
 void ARMul_AddOverflow (ARMul_State * state, ARMword a, ARMword b,
@@ -127,9 +128,9 @@ ARMword
 ARMul_GetNextPC (ARMul_State * state)
 {
   if (state->Mode > SVC26MODE)
-    return (state->Reg[15] + isize);
+    return (state->Reg[15] + ISIZE);
   else
-    return ((state->Reg[15] + isize) & R15PCBITS);
+    return ((state->Reg[15] + ISIZE) & R15PCBITS);
 }
 
 /***************************************************************************\
@@ -291,10 +292,7 @@ ARMul_CPSRAltered (ARMul_State * state)
     }
 
   ASSIGNINT (state->Cpsr & INTBITS);
-  ASSIGNN ((state->Cpsr & NBIT) != 0);
-  ASSIGNZ ((state->Cpsr & ZBIT) != 0);
-  ASSIGNC ((state->Cpsr & CBIT) != 0);
-  ASSIGNV ((state->Cpsr & VBIT) != 0);
+  ASSIGNNZCV (state->Cpsr);
 #ifdef MODET
   ASSIGNT ((state->Cpsr & TBIT) != 0);
 #endif
@@ -337,10 +335,7 @@ ARMul_R15Altered (ARMul_State * state)
   if (state->Mode > SVC26MODE)
     state->Emulate = CHANGEMODE;
   ASSIGNR15INT (R15INT);
-  ASSIGNN ((state->Reg[15] & NBIT) != 0);
-  ASSIGNZ ((state->Reg[15] & ZBIT) != 0);
-  ASSIGNC ((state->Reg[15] & CBIT) != 0);
-  ASSIGNV ((state->Reg[15] & VBIT) != 0);
+  ASSIGNNZCV (state->Reg[15]);
 }
 
 /***************************************************************************\
@@ -454,21 +449,21 @@ ARMul_NthReg (ARMword instr, unsigned number)
 void
 ARMul_NegZero (ARMul_State * state, ARMword result)
 {
-  if (NEG (result))
-    {
-      SETN;
-      CLEARZ;
-    }
-  else if (result == 0)
-    {
-      CLEARN;
-      SETZ;
-    }
-  else
-    {
-      CLEARN;
-      CLEARZ;
-    };
+  SETNZ (result);
+}
+
+/***************************************************************************\
+* Works out the flags still pending from the last S instruction             *
+\***************************************************************************/
+
+void
+ARMul_FlagSync (ARMul_State * state)
+{
+  state->NFlag = ARMul_LazyN (state);
+  state->ZFlag = ARMul_LazyZ (state);
+  state->CFlag = ARMul_LazyC (state);
+  state->VFlag = ARMul_LazyV (state);
+  state->FlagOp = LAZY_NONE;
 }
 
 /* Compute whether an addition of A and B, giving RESULT, overflowed.  */
@@ -819,9 +814,8 @@ ARMul_ScheduleEvent (ARMul_State * state, unsigned long delay,
 void
 ARMul_EnvokeEvent (ARMul_State * state)
 {
-  static unsigned long then;
+  unsigned long then = state->Now;
 
-  then = state->Now;
   state->Now = ARMul_Time (state) % EVENTLISTSIZE;
   if (then < state->Now)	/* schedule events */
     EnvokeList (state, then, state->Now);
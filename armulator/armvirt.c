@@ -50,6 +50,107 @@ defined to generate aborts. */
 extern ARMword  GetWord(ARMul_State *state, ARMword address);
 extern void     PutWord(ARMul_State *state, ARMword address, ARMword data);
 
+#define ARMMEM_OUTOFLINE
+#include "armmem.h"
+
+#ifdef ARMUL_FASTMEM
+
+/***************************************************************************\
+*     Loads and stores straight onto host memory, no cycles are counted     *
+\***************************************************************************/
+
+ARMword
+ARMul_ReLoadInstr (ARMul_State * state, ARMword address, ARMword isize)
+{
+  return ARMul_MemLoadInstr (state, address, isize);
+}
+
+ARMword
+ARMul_LoadInstrS (ARMul_State * state, ARMword address, ARMword isize)
+{
+  return ARMul_MemLoadInstr (state, address, isize);
+}
+
+ARMword
+ARMul_LoadInstrN (ARMul_State * state, ARMword address, ARMword isize)
+{
+  return ARMul_MemLoadInstr (state, address, isize);
+}
+
+ARMword
+ARMul_ReadWord (ARMul_State * state, ARMword address)
+{
+  return ARMul_MemLoadWord (state, address);
+}
+
+ARMword
+ARMul_LoadWordS (ARMul_State * state, ARMword address)
+{
+  return ARMul_MemLoadWord (state, address);
+}
+
+ARMword
+ARMul_LoadWordN (ARMul_State * state, ARMword address)
+{
+  return ARMul_MemLoadWord (state, address);
+}
+
+ARMword
+ARMul_LoadHalfWord (ARMul_State * state, ARMword address)
+{
+  return ARMul_MemLoadHalfWord (state, address);
+}
+
+ARMword
+ARMul_ReadByte (ARMul_State * state, ARMword address)
+{
+  return ARMul_MemLoadByte (state, address);
+}
+
+ARMword
+ARMul_LoadByte (ARMul_State * state, ARMword address)
+{
+  return ARMul_MemLoadByte (state, address);
+}
+
+void
+ARMul_WriteWord (ARMul_State * state, ARMword address, ARMword data)
+{
+  ARMul_MemStoreWord (state, address, data);
+}
+
+void
+ARMul_StoreWordS (ARMul_State * state, ARMword address, ARMword data)
+{
+  ARMul_MemStoreWord (state, address, data);
+}
+
+void
+ARMul_StoreWordN (ARMul_State * state, ARMword address, ARMword data)
+{
+  ARMul_MemStoreWord (state, address, data);
+}
+
+void
+ARMul_StoreHalfWord (ARMul_State * state, ARMword address, ARMword data)
+{
+  ARMul_MemStoreHalfWord (state, address, data);
+}
+
+void
+ARMul_WriteByte (ARMul_State * state, ARMword address, ARMword data)
+{
+  ARMul_MemStoreByte (state, address, data);
+}
+
+void
+ARMul_StoreByte (ARMul_State * state, ARMword address, ARMword data)
+{
+  ARMul_MemStoreByte (state, address, data);
+}
+
+#else /* !ARMUL_FASTMEM */
+
 
 /***************************************************************************\
 *                   ReLoad Instruction                                     *
@@ -312,6 +413,8 @@ ARMul_StoreByte (ARMul_State * state, ARMword address, ARMword data)
   ARMul_WriteByte (state, address, data);
 }
 
+#endif /* ARMUL_FASTMEM */
+
 /***************************************************************************\
 *                   Swap Word, (Two Non Sequential Cycles)                  *
 \***************************************************************************/
@@ -0,0 +1,453 @@
+/* rixrun batch mode
+ *
+ * Runs a manifest of guest commands, several at once, each in its own
+ * guest process (see proc.c) on a pool of host threads.  This saves a
+ * host process, library chain walk and so on per command, for things
+ * like running the compiler on each file of a build.
+ *
+ * The manifest has one command per line, like env(1):
+ *
+ *      [-C dir] [NAME=value ...] binary [args ...]
+ *
+ * Words are split on whitespace, and can be '-' or "-quoted.  Blank
+ * lines and #comments are skipped.  NAME=value words are added to the
+ * default environment, and -C gives the command a cwd of its own.
+ *
+ * Each command gets its own stdout/stderr, which are either written out
+ * whole (one after the other) as each command finishes, or kept in
+ * files in a given directory.  At the end, the exit status and time of
+ * every command is reported.
+ *
+ * Copyright (C) 2022 Matt Evans
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "armdefs.h"
+#include "rixrun.h"
+
+#define MAX_WORDS       256
+
+struct job {
+        char            *line;          // As given, for the report
+        char            *cwd;
+        int             argc;
+        char            **argv;
+        int             envc;
+        char            **envp;
+        int             status;         // Guest exit status, or -1 if it didn't run
+        uint64_t        ns;
+        unsigned long   instrs;
+        FILE            *out;
+        FILE            *err;
+};
+
+/* Each worker has a deque of jobs: it takes its own from the tail, and
+ * when it runs out, steals from the heads of the others'.  All jobs are
+ * dealt out up front, so when every deque is empty, we're done.
+ */
+struct deque {
+        pthread_mutex_t lock;
+        int             *jobs;
+        int             head;
+        int             tail;
+};
+
+struct batch {
+        char            *rixrun_path;
+        int             verbose;
+        unsigned int    flags;
+        char            *outdir;        // Or NULL to write output as jobs finish
+        struct job      *jobs;
+        int             num_jobs;
+        struct deque    *deques;
+        int             num_workers;
+        pthread_mutex_t out_lock;
+};
+
+struct worker {
+        struct batch    *b;
+        int             id;
+};
+
+static uint64_t now_ns(void)
+{
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Manifest
+
+/* Splits s (in place) into words, returning how many, or -1 if too many */
+static int      split_words(char *s, char **words, int max)
+{
+        int n = 0;
+
+        for (;;) {
+                while (isspace(*s))
+                        s++;
+                if (!*s || *s == '#')
+                        return n;
+                if (n == max)
+                        return -1;
+
+                char *d = s;
+                words[n++] = s;
+                while (*s && !isspace(*s)) {
+                        if (*s == '\'' || *s == '"') {
+                                char q = *s++;
+                                while (*s && *s != q)
+                                        *d++ = *s++;
+                                if (*s)
+                                        s++;
+                        } else {
+                                *d++ = *s++;
+                        }
+                }
+                if (*s)
+                        s++;
+                *d = '\0';
+        }
+}
+
+/* The default env, less anything the job sets, plus what the job sets */
+static char   **job_env(char **words, int nvars, int envc, char *envp[], int *count)
+{
+        char **e = calloc(envc + nvars + 1, sizeof(char *));
+        int n = 0;
+
+        if (!e)
+                return NULL;
+        for (int i = 0; i < envc; i++) {
+                size_t l = strcspn(envp[i], "=");
+                int overridden = 0;
+
+                for (int v = 0; v < nvars; v++) {
+                        if (!strncmp(words[v], envp[i], l) && words[v][l] == '=')
+                                overridden = 1;
+                }
+                if (!overridden)
+                        e[n++] = envp[i];
+        }
+        for (int v = 0; v < nvars; v++)
+                e[n++] = strdup(words[v]);
+        *count = n;
+        return e;
+}
+
+static int      read_manifest(struct batch *b, FILE *f, int envc, char *envp[])
+{
+        char *line = NULL;
+        size_t len = 0;
+        int lnum = 0;
+        char *words[MAX_WORDS];
+
+        while (getline(&line, &len, f) >= 0) {
+                char *copy = strdup(line);
+                int n, w = 0;
+
+                lnum++;
+                copy[strcspn(copy, "\n")] = '\0';
+                n = split_words(line, words, MAX_WORDS);
+                if (n < 0) {
+                        fprintf(stderr, "rixrun: manifest line %d: too many words\n", lnum);
+                        return -1;
+                }
+                if (n == 0) {
+                        free(copy);
+                        continue;
+                }
+
+                struct job *j = realloc(b->jobs, (b->num_jobs + 1) * sizeof(*j));
+                if (!j)
+                        return -1;
+                b->jobs = j;
+                j = &b->jobs[b->num_jobs++];
+                memset(j, 0, sizeof(*j));
+                j->line = copy;
+                j->status = -1;
+
+                if (w + 1 < n && !strcmp(words[w], "-C")) {
+                        j->cwd = strdup(words[w + 1]);
+                        w += 2;
+                }
+                int vars = w;
+                while (w < n && strchr(words[w], '=') && words[w][0] != '=')
+                        w++;
+                j->envp = job_env(&words[vars], w - vars, envc, envp, &j->envc);
+                if (w == n) {
+                        fprintf(stderr, "rixrun: manifest line %d: no command\n", lnum);
+                        return -1;
+                }
+                j->argc = n - w;
+                j->argv = calloc(j->argc + 1, sizeof(char *));
+                for (int i = 0; i < j->argc; i++)
+                        j->argv[i] = strdup(words[w + i]);
+        }
+        free(line);
+        return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Running jobs
+
+static FILE    *job_file(struct batch *b, int n, const char *ext)
+{
+        char path[PATH_MAX];
+        FILE *f;
+
+        if (!b->outdir) {
+                f = tmpfile();
+        } else {
+                snprintf(path, sizeof(path), "%s/%d.%s", b->outdir, n, ext);
+                f = fopen(path, "w+");
+        }
+        // Not for a host command a guest execs (which gets its stdio as 0-2)
+        if (f)
+                fcntl(fileno(f), F_SETFD, FD_CLOEXEC);
+        return f;
+}
+
+/* Copies a job's (temporary) output to ours, in one piece */
+static void     flush_output(FILE *from, FILE *to)
+{
+        char buf[8192];
+        size_t n;
+
+        fflush(from);
+        rewind(from);
+        while ((n = fread(buf, 1, sizeof(buf), from)) > 0)
+                fwrite(buf, 1, n, to);
+        fflush(to);
+}
+
+static void     run_job(struct batch *b, int n)
+{
+        struct job *j = &b->jobs[n];
+        struct rix_proc *p;
+        uint64_t start = now_ns();
+
+        j->out = job_file(b, n + 1, "out");
+        j->err = job_file(b, n + 1, "err");
+        if (!j->out || !j->err) {
+                perror("rixrun: job output");
+                goto done;
+        }
+
+        p = rix_proc_new(b->rixrun_path, b->verbose, b->flags);
+        if (!p)
+                goto done;
+        // Distinct, as things like cc name temporary files after it:
+        p->pid = getpid() + 1 + n;
+        p->stdfd[0] = open("/dev/null", O_RDONLY | O_CLOEXEC);
+        p->stdfd[1] = fileno(j->out);
+        p->stdfd[2] = fileno(j->err);
+
+        if (j->cwd && rix_proc_chdir(p, j->cwd) < 0) {
+                fprintf(j->err, "rixrun: can't chdir to %s\n", j->cwd);
+        } else if (rix_proc_load(p, j->argv[0], j->argc, j->argv,
+                                 j->envc, j->envp) < 0) {
+                fprintf(j->err, "Failed loading %s :(\n", j->argv[0]);
+        } else {
+                j->status = rix_proc_run(p);
+                j->instrs = p->state->NumInstrs;
+        }
+        close(p->stdfd[0]);
+        rix_proc_free(p);
+
+done:
+        j->ns = now_ns() - start;
+        if (!b->outdir && j->out && j->err) {
+                pthread_mutex_lock(&b->out_lock);
+                flush_output(j->out, stdout);
+                flush_output(j->err, stderr);
+                pthread_mutex_unlock(&b->out_lock);
+        }
+        if (j->out)
+                fclose(j->out);
+        if (j->err)
+                fclose(j->err);
+}
+
+/* A guest fork() is a host fork() of the thread running it, so the locks
+ * the other workers might hold are taken around it (see pthread_atfork()).
+ */
+static struct batch *forking;
+
+static void     fork_prepare(void)
+{
+        pthread_mutex_lock(&forking->out_lock);
+        for (int i = 0; i < forking->num_workers; i++)
+                pthread_mutex_lock(&forking->deques[i].lock);
+}
+
+static void     fork_release(void)
+{
+        for (int i = forking->num_workers - 1; i >= 0; i--)
+                pthread_mutex_unlock(&forking->deques[i].lock);
+        pthread_mutex_unlock(&forking->out_lock);
+}
+
+/* Next job for worker id: its own newest, else the oldest of another's */
+static int      next_job(struct batch *b, int id)
+{
+        for (int i = 0; i < b->num_workers; i++) {
+                struct deque *d = &b->deques[(id + i) % b->num_workers];
+                int n = -1;
+
+                pthread_mutex_lock(&d->lock);
+                if (d->head < d->tail)
+                        n = i ? d->jobs[d->head++] : d->jobs[--d->tail];
+                pthread_mutex_unlock(&d->lock);
+                if (n >= 0)
+                        return n;
+        }
+        return -1;
+}
+
+static void    *worker(void *arg)
+{
+        struct worker *w = arg;
+        int n;
+
+        while ((n = next_job(w->b, w->id)) >= 0)
+                run_job(w->b, n);
+        return NULL;
+}
+
+static void     report(struct batch *b, uint64_t ns)
+{
+        int failed = 0;
+
+        fprintf(stderr, "\nrixrun: %d jobs on %d threads, %.3fs wall\n",
+                b->num_jobs, b->num_workers, ns / 1e9);
+        fprintf(stderr, "%5s %6s %9s %12s  %s\n", "job", "status", "secs", "instrs", "command");
+        for (int i = 0; i < b->num_jobs; i++) {
+                struct job *j = &b->jobs[i];
+
+                if (j->status < 0)
+                        fprintf(stderr, "%5d %6s", i + 1, "fail");
+                else
+                        fprintf(stderr, "%5d %6d", i + 1, j->status);
+                fprintf(stderr, " %9.3f %12lu  %s\n", j->ns / 1e9, j->instrs, j->line);
+                if (j->status != 0)
+                        failed++;
+        }
+        if (failed)
+                fprintf(stderr, "rixrun: %d of %d jobs failed\n", failed, b->num_jobs);
+}
+
+static void     usage(void)
+{
+        fprintf(stderr, "rixrun -b [-j jobs] [-o outdir] <manifest>\n");
+}
+
+/* Batch mode entry, with args following the "-b".  Returns 0 if every
+ * job exited 0.
+ */
+int     rix_batch(char *rixrun_path, int verbose, unsigned int flags,
+                  int argc, char *argv[], int envc, char *envp[])
+{
+        struct batch b = {
+                .rixrun_path = rixrun_path,
+                .verbose = verbose,
+                .flags = flags,
+                .out_lock = PTHREAD_MUTEX_INITIALIZER,
+        };
+        int opt;
+        FILE *f;
+
+        b.num_workers = sysconf(_SC_NPROCESSORS_ONLN);
+        while ((opt = getopt(argc, argv, "j:o:")) != -1) {
+                switch (opt) {
+                case 'j':
+                        b.num_workers = atoi(optarg);
+                        break;
+                case 'o':
+                        b.outdir = optarg;
+                        break;
+                default:
+                        usage();
+                        return 1;
+                }
+        }
+        if (optind != argc - 1 || b.num_workers < 1) {
+                usage();
+                return 1;
+        }
+
+        f = strcmp(argv[optind], "-") ? fopen(argv[optind], "r") : stdin;
+        if (!f) {
+                perror(argv[optind]);
+                return 1;
+        }
+        if (read_manifest(&b, f, envc, envp) < 0)
+                return 1;
+        if (f != stdin)
+                fclose(f);
+        if (b.num_workers > b.num_jobs)
+                b.num_workers = b.num_jobs ? b.num_jobs : 1;
+
+        // Deal the jobs out round-robin:
+        b.deques = calloc(b.num_workers, sizeof(struct deque));
+        for (int i = 0; i < b.num_workers; i++) {
+                pthread_mutex_init(&b.deques[i].lock, NULL);
+                b.deques[i].jobs = calloc(b.num_jobs / b.num_workers + 1, sizeof(int));
+        }
+        for (int n = 0; n < b.num_jobs; n++) {
+                struct deque *d = &b.deques[n % b.num_workers];
+                d->jobs[d->tail++] = n;
+        }
+
+        pthread_t threads[b.num_workers];
+        struct worker workers[b.num_workers];
+        uint64_t start = now_ns();
+
+        forking = &b;
+        pthread_atfork(fork_prepare, fork_release, fork_release);
+        rix_global_shared();
+
+        for (int i = 0; i < b.num_workers; i++) {
+                workers[i].b = &b;
+                workers[i].id = i;
+                if (pthread_create(&threads[i], NULL, worker, &workers[i])) {
+                        perror("pthread_create");
+                        return 1;
+                }
+        }
+        for (int i = 0; i < b.num_workers; i++)
+                pthread_join(threads[i], NULL);
+
+        report(&b, now_ns() - start);
+
+        for (int n = 0; n < b.num_jobs; n++) {
+                if (b.jobs[n].status != 0)
+                        return 1;
+        }
+        return 0;
+}
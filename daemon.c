@@ -0,0 +1,243 @@
+/* rixrund, the resident rixrun
+ *
+ * Waits on a Unix socket for commands from rixrun clients (see server.c
+ * for the protocol), and runs each in its own guest process (see proc.c)
+ * on a pool of host threads, as batch mode does.  Each thread keeps its
+ * guest process between jobs, running the next one in it as though it
+ * were exec'd:  shared libraries already loaded there stay loaded, along
+ * with their decoded and compiled code, rather than being found, loaded
+ * and warmed up again by every command of a build.
+ *
+ * Copyright (C) 2022 Matt Evans
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#include "armdefs.h"
+#include "rixrun.h"
+#include "server.h"
+
+#define MAX_QUEUE       256
+
+struct daemon {
+        char            *rixrun_path;
+        int             verbose;
+        unsigned int    flags;
+        int             sock;
+        int             num_workers;
+        unsigned int    num_jobs;       // Run so far, for guest pids
+
+        // Connections waiting for a worker:
+        pthread_mutex_t lock;
+        pthread_cond_t  cond;
+        int             queue[MAX_QUEUE];
+        unsigned int    head;
+        unsigned int    tail;
+};
+
+struct worker {
+        struct daemon   *d;
+        int             id;
+        struct rix_proc *proc;          // Kept warm between jobs
+};
+
+static uint64_t now_ns(void)
+{
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Runs one client's command in w's guest process, returning its exit
+ * status, or -1 if it couldn't be.
+ */
+static int      run_job(struct worker *w, struct srv_req *req, unsigned int n)
+{
+        struct daemon *d = w->d;
+        struct rix_proc *p = w->proc;
+        int r, status = -1;
+
+        if (!p) {
+                p = rix_proc_new(d->rixrun_path, d->verbose, d->flags);
+                if (!p)
+                        return -1;
+        }
+        // Distinct, as things like cc name temporary files after it:
+        p->pid = getpid() + 1 + n;
+        for (int i = 0; i < 3; i++)
+                p->stdfd[i] = req->fds[i];
+
+        if (rix_proc_chdir(p, req->cwd) < 0)
+                r = -1;
+        else if (w->proc)
+                r = rix_proc_reuse(p, req->argv[0], req->argc, req->argv,
+                                   req->envc, req->envp);
+        else
+                r = rix_proc_load(p, req->argv[0], req->argc, req->argv,
+                                  req->envc, req->envp) < 0 ? 1 : 0;
+        if (r == 0)
+                status = rix_proc_run(p);
+        for (int i = 0; i < 3; i++)
+                p->stdfd[i] = i;
+
+        // One that's lost its image (or never had one) starts afresh
+        if (r > 0 || !p->image) {
+                rix_proc_free(p);
+                p = NULL;
+        }
+        w->proc = p;
+        return status;
+}
+
+/* A guest fork() is a host fork() of the thread running it, so the queue
+ * lock is taken around it, as the accepting thread might hold it.
+ */
+static struct daemon *forking;
+
+static void     fork_prepare(void)
+{
+        pthread_mutex_lock(&forking->lock);
+}
+
+static void     fork_release(void)
+{
+        pthread_mutex_unlock(&forking->lock);
+}
+
+static int      next_conn(struct daemon *d)
+{
+        int conn;
+
+        pthread_mutex_lock(&d->lock);
+        while (d->head == d->tail)
+                pthread_cond_wait(&d->cond, &d->lock);
+        conn = d->queue[d->head++ % MAX_QUEUE];
+        pthread_mutex_unlock(&d->lock);
+        return conn;
+}
+
+static void    *worker(void *arg)
+{
+        struct worker *w = arg;
+        struct daemon *d = w->d;
+        struct srv_req req;
+        unsigned int n;
+        uint64_t start;
+        int conn, r;
+
+        for (;;) {
+                conn = next_conn(d);
+                if (srv_recv(conn, &req) < 0) {
+                        close(conn);
+                        continue;
+                }
+                n = __atomic_fetch_add(&d->num_jobs, 1, __ATOMIC_RELAXED);
+                start = now_ns();
+                r = run_job(w, &req, n);
+                if (d->verbose)
+                        fprintf(stderr, "rixrund: [%d] %s in %s: %d, %.3fs\n", w->id,
+                                req.argv[0], req.cwd, r, (now_ns() - start) / 1e9);
+                srv_req_free(&req);
+                srv_reply(conn, r);
+                close(conn);
+        }
+        return NULL;
+}
+
+static void     usage(void)
+{
+        fprintf(stderr, "rixrund [-j jobs] <socket>\n");
+}
+
+/* rixrund entry.  Only returns if it can't start. */
+int     rix_daemon(char *rixrun_path, int verbose, unsigned int flags,
+                   int argc, char *argv[])
+{
+        struct daemon d = {
+                .rixrun_path = rixrun_path,
+                .verbose = verbose,
+                .flags = flags,
+                .lock = PTHREAD_MUTEX_INITIALIZER,
+                .cond = PTHREAD_COND_INITIALIZER,
+        };
+        int opt, conn;
+
+        d.num_workers = sysconf(_SC_NPROCESSORS_ONLN);
+        while ((opt = getopt(argc, argv, "j:")) != -1) {
+                switch (opt) {
+                case 'j':
+                        d.num_workers = atoi(optarg);
+                        break;
+                default:
+                        usage();
+                        return 1;
+                }
+        }
+        if (optind != argc - 1 || d.num_workers < 1) {
+                usage();
+                return 1;
+        }
+        d.sock = srv_listen(argv[optind]);
+        if (d.sock < 0)
+                return 1;
+        // A guest writing to a closed pipe mustn't take the others with it
+        signal(SIGPIPE, SIG_IGN);
+
+        pthread_t threads[d.num_workers];
+        struct worker workers[d.num_workers];
+
+        forking = &d;
+        pthread_atfork(fork_prepare, fork_release, fork_release);
+        rix_global_shared();
+
+        for (int i = 0; i < d.num_workers; i++) {
+                workers[i] = (struct worker){ .d = &d, .id = i };
+                if (pthread_create(&threads[i], NULL, worker, &workers[i])) {
+                        perror("pthread_create");
+                        return 1;
+                }
+        }
+        for (;;) {
+                conn = accept(d.sock, NULL, NULL);
+                if (conn < 0) {
+                        if (errno == EINTR || errno == ECONNABORTED)
+                                continue;
+                        perror("rixrund: accept");
+                        return 1;
+                }
+                pthread_mutex_lock(&d.lock);
+                if (d.tail - d.head == MAX_QUEUE) {
+                        // Too busy, so the client can run it itself
+                        pthread_mutex_unlock(&d.lock);
+                        srv_reply(conn, -1);
+                        close(conn);
+                        continue;
+                }
+                d.queue[d.tail++ % MAX_QUEUE] = conn;
+                pthread_cond_signal(&d.cond);
+                pthread_mutex_unlock(&d.lock);
+        }
+}
@@ -0,0 +1,164 @@
+/* rixrun flight recorder
+ *
+ * ARMulator keeps a ring of the last ARMUL_FLIGHT branch targets in
+ * state->Flight (see ARMul_FlightRecord()):  the block runner records a
+ * block it enters other than by falling through from the last, and the
+ * interpreter each change of PC, which costs a store or two per block.
+ * ARMul_OSHandleSWI() adds the syscalls.
+ *
+ * When the guest faults (see os_fault()), or rixrun dies from panic() or a
+ * fatal signal, the ring of the process (for the last two, the one running
+ * on that host thread) is printed to its stderr, oldest first, with the
+ * addresses named from its symbols (see syms.c):  how the guest got to
+ * where it died.
+ *
+ * Copyright (C) 2022 Matt Evans
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include "armdefs.h"
+#include "rixrun.h"
+#include "rix_os.h"
+#include "syms.h"
+#include "snap.h"
+#include "flight.h"
+
+#define FLIGHT_NAME_LEN 128
+
+static const int fatal_signals[] = { SIGSEGV, SIGBUS, SIGILL, SIGFPE, SIGABRT };
+
+// The process running on this host thread, if any
+static __thread struct rix_proc *current;
+
+/* Straight to fd, as this may be in a signal handler with stdio in an
+ * unknown state.
+ */
+static void     say(int fd, const char *format, ...)
+{
+        char buf[3 * FLIGHT_NAME_LEN];
+        va_list ap;
+        int n;
+
+        va_start(ap, format);
+        n = vsnprintf(buf, sizeof(buf), format, ap);
+        va_end(ap);
+        if (n > (int)sizeof(buf) - 1)
+                n = sizeof(buf) - 1;
+        if (n > 0 && write(fd, buf, n) < 0)
+                return;
+}
+
+static void     say_entry(struct rix_proc *p, const ARMul_FlightEntry *e, unsigned int repeats)
+{
+        char name[FLIGHT_NAME_LEN], what[FLIGHT_NAME_LEN] = "", times[16] = "";
+        const struct rix_sym *s = syms_find(p->syms, e->pc);
+
+        if (s && e->pc == s->addr)
+                snprintf(name, sizeof(name), "%s", s->name);
+        else if (s)
+                snprintf(name, sizeof(name), "%s+0x%x", s->name, e->pc - s->addr);
+        else
+                syms_name(p->syms, e->pc, name, sizeof(name));
+        if (e->swi != ARMUL_FLIGHT_BRANCH) {
+                unsigned int scnum = e->swi & 0xfffff;
+                const char *sc = os_sc_name(scnum);
+
+                snprintf(what, sizeof(what), "  syscall %u (%s)", scnum, sc ? sc : "?");
+        }
+        if (repeats > 1)
+                snprintf(times, sizeof(times), "  x%u", repeats);
+        say(p->stdfd[2], "  %08x  %s%s%s\n", e->pc, name, what, times);
+}
+
+/* Prints p's recent branches and syscalls, oldest first, to its stderr */
+void    flight_dump(struct rix_proc *p)
+{
+        ARMul_State *state = p->state;
+        unsigned int pos = state->FlightPos;
+        unsigned int n = pos < ARMUL_FLIGHT ? pos : ARMUL_FLIGHT;
+        const ARMul_FlightEntry *last = NULL;
+        unsigned int repeats = 0;
+
+        say(p->stdfd[2], "*** Last %u branch targets and syscalls of pid %d, oldest first:\n",
+            n, p->pid);
+        for (unsigned int i = pos - n; i != pos; i++) {
+                const ARMul_FlightEntry *e = &state->Flight[i & (ARMUL_FLIGHT - 1)];
+
+                if (last && e->pc == last->pc && e->swi == last->swi) {
+                        repeats++;
+                        continue;
+                }
+                if (last)
+                        say_entry(p, last, repeats);
+                last = e;
+                repeats = 1;
+        }
+        if (last)
+                say_entry(p, last, repeats);
+}
+
+/* From panic():  dumps the process on this thread, if any */
+void    flight_crash(void)
+{
+        struct rix_proc *p = current;
+
+        // Once only, should dumping it crash too
+        current = NULL;
+        if (p)
+                flight_dump(p);
+}
+
+static void     fatal(int sig, siginfo_t *si, void *uc)
+{
+        // A guest touching args kept from it until a snapshot carries on
+        if (sig == SIGSEGV && current && snap_fault(current, si->si_addr))
+                return;
+        say(2, "*** %s\n", strsignal(sig));
+        flight_crash();
+        // Die of it, as we would have
+        signal(sig, SIG_DFL);
+        raise(sig);
+}
+
+/* Installs the handlers that dump the flight recorder on a crash */
+void    flight_init(void)
+{
+        struct sigaction sa = { .sa_sigaction = fatal, .sa_flags = SA_SIGINFO };
+
+        sigemptyset(&sa.sa_mask);
+        for (unsigned int i = 0; i < sizeof(fatal_signals) / sizeof(fatal_signals[0]); i++)
+                sigaction(fatal_signals[i], &sa, NULL);
+}
+
+/* p runs on this thread until flight_leave(), given what this returns */
+struct rix_proc *flight_enter(struct rix_proc *p)
+{
+        struct rix_proc *prev = current;
+
+        current = p;
+        return prev;
+}
+
+void    flight_leave(struct rix_proc *prev)
+{
+        current = prev;
+}
@@ -0,0 +1,12 @@
+#ifndef FLIGHT_H
+#define FLIGHT_H
+
+#include "rixrun.h"
+
+void    flight_init(void);
+struct rix_proc *flight_enter(struct rix_proc *p);
+void    flight_leave(struct rix_proc *prev);
+void    flight_dump(struct rix_proc *p);
+void    flight_crash(void);
+
+#endif
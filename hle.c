@@ -0,0 +1,528 @@
+/* rixrun high-level emulation of libc routines
+ *
+ * The guest's memcpy() and friends run one emulated byte or word at a
+ * time, and the Norcroft divide helpers loop over shift-and-subtract
+ * steps; cpp/cc spend a large share of their time in them.  When the
+ * a.out symbol table of a loaded object (the shared libc, or a binary)
+ * names one of these routines, its entry point is overwritten with a
+ * SWI that does the whole job on the host, straight onto mem_base, and
+ * then returns to the caller as the routine's own MOVS pc, lr would.
+ *
+ * Stripped objects don't have a symbol table, but identical copies of
+ * routines found by name elsewhere are hooked too.
+ *
+ * Copyright (C) 2022 Matt Evans
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <signal.h>
+
+#include "utils.h"
+#include "armdefs.h"
+#include "armemu.h"
+#include "armblock.h"
+#include "rixrun.h"
+#include "zload.h"
+#include "hle.h"
+#include "rix_os.h"
+
+#define HLE_TRACE(x...)         do { if (hle->verbose) fprintf(stderr, "HLE: " x); } while(0)
+
+enum {
+        HLE_MEMCPY,
+        HLE_MEMMOVE,
+        HLE_MEMSET,
+        HLE_STRLEN,
+        HLE_STRCMP,
+        HLE_STRCPY,
+        HLE_SDIV,
+        HLE_UDIV,
+        HLE_NUM
+};
+
+static const char *hle_names[HLE_NUM] = {
+        "memcpy", "memmove", "memset", "strlen", "strcmp", "strcpy",
+        "sdiv", "udiv"
+};
+
+/* Symbols for each routine; a leading '_' (from the C compiler) is ignored.
+ * x$divide is the older Norcroft name for __rt_sdiv.
+ */
+static const struct {
+        const char      *sym;
+        int             fn;
+} hle_syms[] = {
+        { "memcpy",     HLE_MEMCPY },
+        { "memmove",    HLE_MEMMOVE },
+        { "memset",     HLE_MEMSET },
+        { "strlen",     HLE_STRLEN },
+        { "strcmp",     HLE_STRCMP },
+        { "strcpy",     HLE_STRCPY },
+        { "x$divide",   HLE_SDIV },
+        { "__rt_sdiv",  HLE_SDIV },
+        { "x$udivide",  HLE_UDIV },
+        { "__rt_udiv",  HLE_UDIV },
+};
+
+#define HLE_MAX_HOOKS   64
+#define HLE_MAX_SIGS    16
+#define HLE_SIG_WORDS   256
+#define HLE_SIG_MIN     8               // Words, to be distinctive
+
+/* A hooked entry point, and the instruction the SWI replaced */
+struct hle_hook {
+        addr_t          addr;
+        uint32_t        orig;
+        int             fn;
+        int             disarmed;       // orig is back, for one call in guest code
+};
+
+/* The code of a routine found by name, to the next symbol (so all of it,
+ * with its literals), so that identical copies can be found in objects that
+ * have no symbols.
+ */
+struct hle_sig {
+        int             fn;
+        unsigned int    len;
+        uint32_t        words[HLE_SIG_WORDS];
+};
+
+/* Per-process: the hooks live in that guest's memory */
+struct rix_hle {
+        int             verbose;
+        struct hle_hook hooks[HLE_MAX_HOOKS];
+        unsigned int    num_hooks;
+        unsigned int    num_disarmed;   // Or more, if some since discarded
+        struct hle_sig  sigs[HLE_MAX_SIGS];
+        unsigned int    num_sigs;
+};
+
+void    hle_init(ARMul_State *state, int verbose)
+{
+        struct rix_hle *hle = calloc(1, sizeof(*hle));
+
+        if (!hle)
+                return;         // Just don't hook anything
+        hle->verbose = verbose;
+        PROC(state)->hle = hle;
+}
+
+void    hle_free(ARMul_State *state)
+{
+        free(PROC(state)->hle);
+        PROC(state)->hle = NULL;
+}
+
+/* Forgets hooks in [lo, hi), as that memory has been replaced (by exec).
+ * What was learned about the routines is kept.
+ */
+void    hle_discard(ARMul_State *state, addr_t lo, addr_t hi)
+{
+        struct rix_hle *hle = PROC(state)->hle;
+
+        if (!hle)
+                return;
+        for (unsigned int i = 0; i < hle->num_hooks; ) {
+                if (hle->hooks[i].addr >= lo && hle->hooks[i].addr < hi)
+                        hle->hooks[i] = hle->hooks[--hle->num_hooks];
+                else
+                        i++;
+        }
+}
+
+/* A snapshot (see snap.c) of guest memory has the hooks in it, so keeps
+ * the table of them, too.
+ */
+int     hle_snap_write(ARMul_State *state, FILE *f)
+{
+        struct rix_hle none = { 0 };
+        struct rix_hle *hle = PROC(state)->hle ? PROC(state)->hle : &none;
+
+        fwrite(&hle->num_hooks, sizeof(hle->num_hooks), 1, f);
+        fwrite(hle->hooks, sizeof(hle->hooks[0]), hle->num_hooks, f);
+        fwrite(&hle->num_sigs, sizeof(hle->num_sigs), 1, f);
+        fwrite(hle->sigs, sizeof(hle->sigs[0]), hle->num_sigs, f);
+        return ferror(f) ? -1 : 0;
+}
+
+/* Call once guest memory is restored:  without HLE, the hooks in it are
+ * put back to the original instructions.
+ */
+int     hle_snap_read(ARMul_State *state, FILE *f)
+{
+        struct rix_hle *hle = PROC(state)->hle;
+        struct rix_hle *h = calloc(1, sizeof(*h));
+        int r = -1;
+
+        if (!h)
+                return -1;
+        if (fread(&h->num_hooks, sizeof(h->num_hooks), 1, f) != 1 ||
+            h->num_hooks > HLE_MAX_HOOKS ||
+            fread(h->hooks, sizeof(h->hooks[0]), h->num_hooks, f) != h->num_hooks ||
+            fread(&h->num_sigs, sizeof(h->num_sigs), 1, f) != 1 ||
+            h->num_sigs > HLE_MAX_SIGS ||
+            fread(h->sigs, sizeof(h->sigs[0]), h->num_sigs, f) != h->num_sigs)
+                goto out;
+        for (unsigned int i = 0; i < h->num_hooks; i++) {
+                if (h->hooks[i].addr >= MEM_SIZE)
+                        goto out;
+        }
+        if (hle) {
+                h->verbose = hle->verbose;
+                h->num_disarmed = h->num_hooks;         // Rearm any disarmed
+                *hle = *h;
+        } else {
+                for (unsigned int i = 0; i < h->num_hooks; i++)
+                        *(uint32_t *)(state->MemBase + h->hooks[i].addr) = h->hooks[i].orig;
+        }
+        r = 0;
+out:
+        free(h);
+        return r;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Finding the routines
+
+static int      is_hle_swi(uint32_t insn)
+{
+        return (insn & 0xff000000) == 0xef000000 && (insn & HLE_SWI_MASK) == HLE_SWI_BASE;
+}
+
+static void     hle_hook(struct rix_hle *hle, uint8_t *mem_base, int fn, addr_t addr, const char *how)
+{
+        uint32_t *insn = (uint32_t *)(mem_base + addr);
+
+        // Already hooked, e.g. by the lib and its user or via an alias
+        if (is_hle_swi(*insn))
+                return;
+        if (hle->num_hooks == HLE_MAX_HOOKS) {
+                HLE_TRACE("Too many hooks, not hooking %s at %08x\n", hle_names[fn], addr);
+                return;
+        }
+        HLE_TRACE("%s at %08x, %s (was %08x)\n", hle_names[fn], addr, how, *insn);
+        hle->hooks[hle->num_hooks++] = (struct hle_hook){ addr, *insn, fn, 0 };
+        *insn = 0xef000000 | (HLE_SWI_BASE + fn);
+}
+
+static int      is_return(uint32_t insn)
+{
+        return (insn & 0xfffffff0) == 0xe1a0f000 ||    // MOV pc, Rm
+                (insn & 0xfffffff0) == 0xe1b0f000 ||   // MOVS pc, Rm
+                (insn & 0xfe108000) == 0xe8108000;     // LDM Rn, {..., pc}
+}
+
+/* Which bits of word i of a routine len words long must match in a copy of
+ * it elsewhere:  a branch or PC-relative load or store to outside the
+ * routine has an offset that depends on where the copy is, so that's left
+ * out.  Those within the routine move with it.
+ */
+static uint32_t sig_mask(uint32_t insn, unsigned int i, unsigned int len)
+{
+        int32_t to;
+
+        if ((insn & 0x0e000000) == 0x0a000000) {                // B, BL
+                to = i + 2 + ((int32_t)(insn << 8) >> 8);
+                if (to < 0 || to >= (int32_t)len)
+                        return 0xff000000;
+        } else if ((insn & 0x0e0f0000) == 0x040f0000) {         // LDR/STR [pc, #imm]
+                to = i + 2 + (int32_t)((insn & 0x00800000) ? (insn & 0xfff) : -(insn & 0xfff)) / 4;
+                if (to < 0 || to >= (int32_t)len)
+                        return 0xfffff000;
+        }
+        return 0xffffffff;
+}
+
+static int      sig_match(const struct hle_sig *sig, const uint32_t *code)
+{
+        for (unsigned int i = 0; i < sig->len; i++) {
+                uint32_t m = sig_mask(sig->words[i], i, sig->len);
+
+                if ((code[i] ^ sig->words[i]) & m)
+                        return 0;
+        }
+        return 1;
+}
+
+/* Learns the routine at [addr, end) */
+static void     hle_learn_sig(struct rix_hle *hle, uint8_t *mem_base, int fn,
+                              addr_t addr, addr_t end)
+{
+        uint32_t *code = (uint32_t *)(mem_base + addr);
+        struct hle_sig *sig = &hle->sigs[hle->num_sigs];
+        unsigned int len = (end - addr) / 4, returns = 0;
+
+        // Too long to keep, or too short to be distinctive:
+        if (hle->num_sigs == HLE_MAX_SIGS || len > HLE_SIG_WORDS || len < HLE_SIG_MIN)
+                return;
+        for (unsigned int i = 0; i < len; i++)
+                returns += is_return(code[i]);
+        if (!returns)
+                return;
+        sig->fn = fn;
+        sig->len = len;
+        memcpy(sig->words, code, len * 4);
+        for (unsigned int i = 0; i < hle->num_sigs; i++) {
+                if (hle->sigs[i].len == sig->len &&
+                    !memcmp(hle->sigs[i].words, sig->words, sig->len * 4))
+                        return;
+        }
+        hle->num_sigs++;
+}
+
+/* Hook copies of the routines learned so far, anywhere in the text loaded */
+static void     hle_scan_sigs(struct rix_hle *hle, uint8_t *mem_base,
+                              addr_t text_start, addr_t text_end)
+{
+        for (unsigned int i = 0; i < hle->num_sigs; i++) {
+                struct hle_sig *sig = &hle->sigs[i];
+
+                for (addr_t a = text_start; a + sig->len*4 <= text_end; a += 4) {
+                        uint32_t *code = (uint32_t *)(mem_base + a);
+
+                        if (code[0] == sig->words[0] && sig_match(sig, code))
+                                hle_hook(hle, mem_base, sig->fn, a, "by signature");
+                }
+        }
+}
+
+/* Where the routine at addr ends:  at the next text symbol, or text_end */
+static addr_t   routine_end(const struct rix_nlist *syms, unsigned int n, addr_t addr,
+                            addr_t text_end)
+{
+        addr_t end = text_end;
+
+        for (unsigned int i = 0; i < n; i++) {
+                if ((syms[i].n_type & RIX_N_TYPE) == RIX_N_TEXT &&
+                    syms[i].n_value > addr && syms[i].n_value < end)
+                        end = syms[i].n_value;
+        }
+        return end;
+}
+
+static int      hle_sym_fn(char *name)
+{
+        for (unsigned int i = 0; i < sizeof(hle_syms)/sizeof(hle_syms[0]); i++) {
+                if (!strcmp(name, hle_syms[i].sym) ||
+                    (name[0] == '_' && !strcmp(name + 1, hle_syms[i].sym)))
+                        return hle_syms[i].fn;
+        }
+        return -1;
+}
+
+void    hle_load_symbols(ARMul_State *state, int fd, const struct exec_hdr *hdr,
+                         const char *filename, addr_t text_start, addr_t text_end)
+{
+        struct rix_hle *hle = PROC(state)->hle;
+        uint8_t *mem_base = state->MemBase;
+        struct rix_nlist *syms = NULL;
+        char *strs = NULL;
+        uint32_t strsize;
+        unsigned int n;
+
+        if (!hle)
+                return;
+        n = zmagic_read_symbols(fd, hdr, &syms, &strs, &strsize);
+        for (unsigned int i = 0; i < n; i++) {
+                struct rix_nlist *s = &syms[i];
+                int fn;
+
+                if (s->n_type != (RIX_N_TEXT | RIX_N_EXT) || s->n_strx >= strsize)
+                        continue;
+                if (s->n_value & 3 || s->n_value < text_start || s->n_value >= text_end)
+                        continue;
+                fn = hle_sym_fn(strs + s->n_strx);
+                if (fn < 0 || is_hle_swi(*(uint32_t *)(mem_base + s->n_value)))
+                        continue;
+                hle_learn_sig(hle, mem_base, fn, s->n_value,
+                              routine_end(syms, n, s->n_value, text_end));
+                hle_hook(hle, mem_base, fn, s->n_value, filename);
+        }
+        hle_scan_sigs(hle, mem_base, text_start, text_end);
+        free(strs);
+        free(syms);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Running them
+
+/* Faults the guest (as it would have, running the routine) if [a, a+len)
+ * isn't guest memory
+ */
+static int      bad_range(ARMul_State *state, int fn, addr_t a, uint32_t len)
+{
+        if (a <= MEM_SIZE && len <= MEM_SIZE - a)
+                return 0;
+        os_fault(state, SIGSEGV, "*** HLE %s: bad address %08x (+%x) from PC %08x\n",
+                 hle_names[fn], a, len, ARMul_GetReg(state, state->Mode, 14) & R15PCBITS);
+        return 1;
+}
+
+static int      guest_strlen(ARMul_State *state, int fn, addr_t a, uint32_t *len)
+{
+        if (bad_range(state, fn, a, 0))
+                return -1;
+        *len = strnlen((char *)(state->MemBase + a), MEM_SIZE - a);
+        return bad_range(state, fn, a, *len + 1) ? -1 : 0;
+}
+
+/* Something the host can't do as the routine would (such as divide by zero,
+ * which traps), so this call of it runs the guest's code instead:  the
+ * original instruction is put back, until hle_rearm().
+ */
+static void     hle_disarm(ARMul_State *state, int fn, addr_t addr)
+{
+        struct rix_hle *hle = PROC(state)->hle;
+
+        for (unsigned int i = 0; i < hle->num_hooks; i++) {
+                if (hle->hooks[i].addr != addr)
+                        continue;
+                HLE_TRACE("%s at %08x running guest code, this call\n", hle_names[fn], addr);
+                *(uint32_t *)(state->MemBase + addr) = hle->hooks[i].orig;
+                ARMul_BlockInvalidate(state, addr, 4);
+                hle->hooks[i].disarmed = 1;
+                hle->num_disarmed++;
+                ARMul_SetR15(state, addr | ECC | R15INTMODE);
+                return;
+        }
+        os_fault(state, SIGILL, "*** HLE %s: no hook at %08x\n", hle_names[fn], addr);
+}
+
+/* From the next SWI (syscall or HLE) after hle_disarm():  by then the
+ * routine's first instruction has run, so the hook can go back in.
+ */
+void    hle_rearm(ARMul_State *state)
+{
+        struct rix_hle *hle = PROC(state)->hle;
+
+        if (!hle || !hle->num_disarmed)
+                return;
+        for (unsigned int i = 0; i < hle->num_hooks; i++) {
+                struct hle_hook *h = &hle->hooks[i];
+                uint32_t *insn = (uint32_t *)(state->MemBase + h->addr);
+
+                if (!h->disarmed || *insn != h->orig)
+                        continue;
+                *insn = 0xef000000 | (HLE_SWI_BASE + h->fn);
+                ARMul_BlockInvalidate(state, h->addr, 4);
+                h->disarmed = 0;
+        }
+        hle->num_disarmed = 0;
+}
+
+void    hle_swi(ARMul_State *state, ARMword number)
+{
+        struct rix_hle *hle = PROC(state)->hle;
+        uint8_t *mem_base = state->MemBase;
+        int fn = number - HLE_SWI_BASE;
+        uint32_t a0 = ARMul_GetReg(state, state->Mode, 0);
+        uint32_t a1 = ARMul_GetReg(state, state->Mode, 1);
+        uint32_t a2 = ARMul_GetReg(state, state->Mode, 2);
+        uint32_t r = a0;
+        uint32_t len;
+        ARMword lr;
+
+        switch (fn) {
+        case HLE_MEMCPY:
+        case HLE_MEMMOVE:
+                HLE_TRACE("%s(%08x, %08x, %d)\n", hle_names[fn], a0, a1, a2);
+                if (bad_range(state, fn, a0, a2) || bad_range(state, fn, a1, a2))
+                        return;
+                memmove(mem_base + a0, mem_base + a1, a2);
+                ARMul_BlockInvalidate(state, a0, a2);
+                break;
+
+        case HLE_MEMSET:
+                HLE_TRACE("memset(%08x, %d, %d)\n", a0, a1, a2);
+                if (bad_range(state, fn, a0, a2))
+                        return;
+                memset(mem_base + a0, a1 & 0xff, a2);
+                ARMul_BlockInvalidate(state, a0, a2);
+                break;
+
+        case HLE_STRLEN:
+                if (guest_strlen(state, fn, a0, &r) < 0)
+                        return;
+                HLE_TRACE("strlen(%08x) = %d\n", a0, r);
+                break;
+
+        case HLE_STRCMP: {
+                const unsigned char *p = mem_base + a0;
+                const unsigned char *q = mem_base + a1;
+
+                if (guest_strlen(state, fn, a0, &len) < 0 ||
+                    guest_strlen(state, fn, a1, &len) < 0)
+                        return;
+                r = 0;
+                if (strcmp((char *)p, (char *)q) != 0) {
+                        // The guest returns the difference of the first differing chars
+                        while (*p && *p == *q) {
+                                p++;
+                                q++;
+                        }
+                        r = *p - *q;
+                }
+                HLE_TRACE("strcmp(%08x, %08x) = %d\n", a0, a1, r);
+                break;
+        }
+
+        case HLE_STRCPY:
+                HLE_TRACE("strcpy(%08x, %08x)\n", a0, a1);
+                if (guest_strlen(state, fn, a1, &len) < 0 || bad_range(state, fn, a0, ++len))
+                        return;
+                memmove(mem_base + a0, mem_base + a1, len);
+                ARMul_BlockInvalidate(state, a0, len);
+                break;
+
+        case HLE_SDIV:
+        case HLE_UDIV: {
+                // a2 / a1: quotient to a1, remainder (sign of dividend) to a2
+                uint32_t n = a1, d = a0;
+                int neg_q = 0, neg_r = 0;
+
+                if (d == 0) {
+                        hle_disarm(state, fn, R15PC - 8);
+                        return;
+                }
+                if (fn == HLE_SDIV) {
+                        neg_r = (int32_t)n < 0;
+                        neg_q = neg_r != ((int32_t)d < 0);
+                        n = neg_r ? -n : n;
+                        d = ((int32_t)d < 0) ? -d : d;
+                }
+                r = neg_q ? -(n / d) : n / d;
+                ARMul_SetReg(state, state->Mode, 1, neg_r ? -(n % d) : n % d);
+                HLE_TRACE("%s(%08x, %08x) = %08x\n", hle_names[fn], a0, a1, r);
+                break;
+        }
+
+        default:
+                os_fault(state, SIGILL, "*** Unknown HLE SWI %x at PC %08lx\n",
+                         number, ARMul_GetPC(state));
+                return;
+        }
+
+        ARMul_SetReg(state, state->Mode, 0, r);
+        // Return as MOVS pc, lr would, restoring the caller's flags
+        lr = ARMul_GetReg(state, state->Mode, 14);
+        if (state->ProfileCalls)
+                ARMul_ProfileReturn(state, R15PC - 8, lr & R15PCBITS);
+        ARMul_SetR15(state, (lr & (CCBITS | R15PCBITS)) | R15INTMODE);
+}
@@ -0,0 +1,23 @@
+#ifndef HLE_H
+#define HLE_H
+
+#include <stdio.h>
+#include "armdefs.h"
+#include "rixrun.h"
+#include "zload.h"
+
+/* Hooked entry points are overwritten with SWI (HLE_SWI_BASE + fn) */
+#define HLE_SWI_BASE    0x7f0000
+#define HLE_SWI_MASK    0xffff00
+
+void    hle_init(ARMul_State *state, int verbose);
+void    hle_free(ARMul_State *state);
+void    hle_discard(ARMul_State *state, addr_t lo, addr_t hi);
+void    hle_load_symbols(ARMul_State *state, int fd, const struct exec_hdr *hdr,
+                         const char *filename, addr_t text_start, addr_t text_end);
+void    hle_swi(ARMul_State *state, ARMword number);
+void    hle_rearm(ARMul_State *state);
+int     hle_snap_write(ARMul_State *state, FILE *f);
+int     hle_snap_read(ARMul_State *state, FILE *f);
+
+#endif
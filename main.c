@@ -34,27 +34,22 @@
 #include <stdarg.h>
 #include <string.h>
 #include <signal.h>
+#include <libgen.h>
 #include "armdefs.h"
 #include "armemu.h"
+#include "armblock.h"
+#include "armjit.h"
 #include "ansidecl.h"
 #include "rixrun.h"
 #include "rix_os.h"
 #include "zload.h"
+#include "hle.h"
+#include "prof.h"
+#include "perf.h"
+#include "trace.h"
 
 
-/* The memory "strategy" is currently extremely dumb.
- * Because there's a max of 32MB in the user address space, I've
- * just used a huge flat array (in BSS) rather than individually
- * mmapping() sections in from the RISCiX binary.  Ideally,
- * the loader (and sbreak) would at least mprotect() to catch
- * wild pointers, but "assuming no input binary bugs", this
- * is OK to get going with.  More fiddly implementations can
- * make things more robust in future.
- */
-static uint8_t memory[MEM_SIZE];
-uint8_t *mem_base = memory;
 static int verbose = 0;        // 0, 1, 2
-int stop_simulator = 0;
 
 
 /* FIXME: get this from params, config, env */
@@ -67,10 +62,39 @@ int     their_envc;
 static void usage(char *thisbin)
 {
         printf("%s <filename>\n", thisbin);
+        printf("%s -b [-j jobs] [-o outdir] <manifest>\n", thisbin);
+        printf("%s -s <socket> <filename>\n", thisbin);
+        printf("rixrund [-j jobs] <socket>\n");
 }
 
 // Magic debug variable:
 #define MAGIC_DEBUG     "RIX_VERBOSE"
+// Set to run everything through the plain interpreter:
+#define MAGIC_INTERP    "RIX_INTERP"
+// Set to keep hot blocks out of the JIT:
+#define MAGIC_NOJIT     "RIX_NOJIT"
+// Set to run libc's memcpy() etc. as guest code rather than natively:
+#define MAGIC_NOHLE     "RIX_NOHLE"
+// Set to dump syscall counts/times at exit, as a table (or "json"):
+#define MAGIC_SCSTATS   "RIX_SCSTATS"
+// Set to a file to start from a snapshot in, or to write one to:
+#define MAGIC_SNAPSHOT  "RIX_SNAPSHOT"
+// ... taken by default at the entry point, or before this syscall, or at this 0x PC:
+#define MAGIC_SNAPSHOT_AT "RIX_SNAPSHOT_AT"
+// Set to a file to write a profile of the guest's call stacks to:
+#define MAGIC_PROFILE   "RIX_PROFILE"
+// ... sampled every so many instructions, rather than on a CPU timer:
+#define MAGIC_PROFILE_EVERY "RIX_PROFILE_EVERY"
+// ... or set to count every call exactly, in the interpreter:
+#define MAGIC_PROFILE_CALLS "RIX_PROFILE_CALLS"
+// Set to measure the host cost of guest instructions, or of 1 in this many:
+#define MAGIC_PERF      "RIX_PERF"
+// Set to a file to write a binary trace of every instruction run to:
+#define MAGIC_TRACE     "RIX_TRACE"
+// ... with the registers each changes, too:
+#define MAGIC_TRACE_REGS "RIX_TRACE_REGS"
+// Set to a fork server's socket, to have it run the binary if it can:
+#define MAGIC_SERVER    "RIX_SERVER"
 
 static void     check_debug(void)
 {
@@ -85,23 +109,49 @@ static void     check_debug(void)
 
 int     main(int argc, char *argv[])
 {
-        struct ARMul_State *state;
+        struct rix_proc *proc;
+        unsigned int flags = 0;
 
         check_debug();
 
         if (verbose)
                 printf("Init armulator");
 
-        ARMul_EmulateInit();
-        state = ARMul_NewState();
-        state->verbose = (verbose == 2);
-        state->bigendSig = LOW;
-        ARMul_CoProInit(state);
-        os_init(state, realpath(argv[0], NULL), verbose);
-
+        rix_global_init();
         if (verbose)
                 printf(".  Done.\n\n");
 
+        if (getenv(MAGIC_INTERP))
+                flags |= RIX_PROC_INTERP;
+        if (getenv(MAGIC_NOJIT))
+                flags |= RIX_PROC_NOJIT;
+        if (getenv(MAGIC_NOHLE))
+                flags |= RIX_PROC_NOHLE;
+        for (their_envc = 0; their_envp[their_envc]; their_envc++);
+
+        // Batch mode runs many guests, each with its own rix_proc:
+        if (argc > 1 && !strcmp(argv[1], "-b"))
+                return rix_batch(realpath(argv[0], NULL), verbose, flags,
+                                 argc - 1, &argv[1], their_envc, their_envp);
+        // As does rixrund, with one per thread, kept between clients' commands:
+        if (!strcmp(basename(argv[0]), "rixrund"))
+                return rix_daemon(realpath(argv[0], NULL), verbose, flags, argc, argv);
+        // As does a fork server, by forking one that's already started:
+        if (argc > 1 && !strcmp(argv[1], "-s"))
+                return rix_serve(realpath(argv[0], NULL), verbose, flags,
+                                 getenv(MAGIC_SNAPSHOT_AT),
+                                 argc - 2, &argv[2], their_envc, their_envp);
+        if (argc > 1 && getenv(MAGIC_SERVER)) {
+                int r = rix_client(getenv(MAGIC_SERVER), argc - 1, &argv[1],
+                                   their_envc, their_envp);
+                if (r >= 0)
+                        return r;
+        }
+
+        proc = rix_proc_new(realpath(argv[0], NULL), verbose, flags);
+        if (!proc)
+                return 1;
+
         if (argc < 2) {
                 usage(argv[0]);
                 return 0;
@@ -111,20 +161,52 @@ int     main(int argc, char *argv[])
         char  **their_argv = &argv[1];
         int     their_argc = argc-1;
 
-        for (their_envc = 0; their_envp[their_envc]; their_envc++);
+        char   *snapshot = getenv(MAGIC_SNAPSHOT);
+        char   *profile = getenv(MAGIC_PROFILE);
+        char   *perf = getenv(MAGIC_PERF);
+        char   *trace = getenv(MAGIC_TRACE);
+        char   *scstats = getenv(MAGIC_SCSTATS);
+        int     r = 1;
 
-        int r = load_zmagic_binary(state, fname, verbose,
-                                   their_argc, their_argv,
-                                   their_envc, their_envp);
+        if (profile && getenv(MAGIC_PROFILE_CALLS)) {
+                rix_proc_profile_calls(proc, profile);
+        } else if (profile) {
+                char *every = getenv(MAGIC_PROFILE_EVERY);
 
+                rix_proc_profile(proc, profile, every ? strtoul(every, NULL, 0) : 0);
+        }
+        if (perf)
+                rix_proc_perf(proc, strtoul(perf, NULL, 0));
+        if (trace)
+                rix_proc_trace(proc, trace, getenv(MAGIC_TRACE_REGS) != NULL);
+        // Forked children dump their own, at their exit
+        if (scstats)
+                proc->scstats = strcmp(scstats, "json") ? 1 : 2;
+
+        if (snapshot)
+                r = rix_proc_restore(proc, snapshot, fname, their_argc, their_argv,
+                                     their_envc, their_envp);
+        if (r > 0) {
+                // No snapshot to start from, so take one on the way
+                if (snapshot)
+                        rix_proc_snapshot_at(proc, snapshot, getenv(MAGIC_SNAPSHOT_AT));
+                r = rix_proc_load(proc, fname, their_argc, their_argv,
+                                  their_envc, their_envp);
+        }
         if (r < 0) {
                 printf("Failed loading %s :(\n", fname);
                 return 1;
         }
         if (verbose > 1)
-                dump_state(state);
-        ARMul_DoProg(state);
-        return 0;
+                dump_state(proc->state);
+        r = rix_proc_run(proc);
+
+        if (proc->scstats)
+                os_sc_stats_dump(proc->state, proc->scstats == 2);
+        prof_dump(proc);
+        perf_dump(proc);
+        trace_free(proc);
+        return r;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -149,10 +231,11 @@ ARMword         ARMul_Debug(ARMul_State *state ATTRIBUTE_UNUSED,
 
 ARMword GetWord(ARMul_State *state, ARMword address)
 {
-        return ((uint32_t *)memory)[address/4];
+        return ((uint32_t *)state->MemBase)[address/4];
 }
 
 void    PutWord(ARMul_State *state, ARMword address, ARMword data)
 {
-        ((uint32_t *)memory)[address/4] = data;
+        ((uint32_t *)state->MemBase)[address/4] = data;
+        ARMul_BlockWriteCheck(state, address);
 }
@@ -22,19 +22,36 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/time.h>
+#include <sys/select.h>
+#include <sys/wait.h>
+#include <sys/syscall.h>
+#include <limits.h>
+#include <time.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <string.h>
+#include <stdarg.h>
+#include <signal.h>
+#include <poll.h>
+#include <pthread.h>
 
 #include "utils.h"
 #include "armdefs.h"
 #include "armemu.h"
+#include "armblock.h"
 #include "rixrun.h"
 #include "rix_os.h"
+#include "hle.h"
+#include "snap.h"
+#include "prof.h"
+#include "perf.h"
+#include "trace.h"
+#include "flight.h"
 
 #ifdef __APPLE__
 #include <libkern/OSByteOrder.h>
@@ -48,9 +65,9 @@
 
 #define SC_TRACE
 #ifdef SC_TRACE
-#define SYSTRACE(x...)          do { if (sc_trace) fprintf(stderr, "SC: " x); } while(0)
-#define SYSTRACE_OUT(x...)      do { if (sc_trace) fprintf(stderr, x); } while(0)
-#define SDBG(x...)              do { if (sc_trace) fprintf(stderr, x); } while(0)
+#define SYSTRACE(x...)          do { if (OS(state)->trace) fprintf(stderr, "SC: " x); } while(0)
+#define SYSTRACE_OUT(x...)      do { if (OS(state)->trace) fprintf(stderr, x); } while(0)
+#define SDBG(x...)              do { if (OS(state)->trace) fprintf(stderr, x); } while(0)
 #else
 #define SYSTRACE(x...)          do { } while(0);
 #define SYSTRACE_OUT(x...)      do { } while(0);
@@ -89,11 +106,44 @@
         } while(0)
 
 
-static  char    *path_to_rixrun;
-static  int     sc_trace = 0;
+#define SC_MAX                  256
+#define MAX_CHILDREN            64
+#define SC_HIST_BUCKETS         32      // log2 of latency in ns
+
+struct sc_stats {
+        uint64_t        calls;
+        uint64_t        ns;             // Host time in the syscall
+        uint64_t        bytes;          // Moved by read/write
+        uint64_t        instrs;         // Guest instructions since previous syscall
+        uint32_t        hist[SC_HIST_BUCKETS];
+};
+
+/* Per-process OS state */
+struct rix_os {
+        char            *path_to_rixrun;
+        int             trace;
+        int             vfork_fd;       // Closed at exec/exit, to resume the vfork() parent
+        pid_t           children[MAX_CHILDREN];
+        int             num_children;
+        addr_t          current_sbrk;
+        struct sc_stats sc_stats[SC_MAX];
+        unsigned long   sc_last_instrs;
+        unsigned long   sc_start_instrs;        // NumInstrs when the stats were reset
+        uint64_t        sc_start_ns;
+        fd_set          open_fds;       // Closed by os_free() if the guest doesn't
+};
+
+#define OS(state)       (PROC(state)->os)
+
+static int      os_shared;      // Other guests run in this process too (see os_set_shared())
+
+static uint64_t sc_now_ns(void)
+{
+        struct timespec ts;
 
-static ARMul_State state_vfork_backup;
-static int vfork_ret_status = 0;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 // Mappings of stuff
@@ -165,47 +215,114 @@ static void     host_to_rix_stat(struct rix_stat *osb, struct stat *isb)
         /*      osb->st_blksize, osb->st_blocks); */
 }
 
-static  uint32_t        read32(addr_t a)
+static  uint32_t        read32(ARMul_State *state, addr_t a)
 {
-        return le32toh(*(uint32_t *)(mem_base + a));
+        return le32toh(*(uint32_t *)(state->MemBase + a));
 }
 
-static  uint8_t         read8(addr_t a)
+static  uint8_t         read8(ARMul_State *state, addr_t a)
 {
-        return *(uint8_t *)(mem_base + a);
+        return *(uint8_t *)(state->MemBase + a);
+}
+
+static  void        	write32(ARMul_State *state, addr_t a, uint32_t data)
+{
+        *(uint32_t *)(state->MemBase + a) = htole32(data);
+}
+
+/* Guest stdin/stdout/stderr can be any host fds (see struct rix_proc);
+ * other fds are the host's own, as opened for the guest.  Any other host
+ * fd (rixrun's own, or in batch mode or rixrund, another guest's) is -1,
+ * so that using it is EBADF.
+ */
+static int      host_fd(ARMul_State *state, uint32_t fd)
+{
+        if (fd <= 2)
+                return PROC(state)->stdfd[fd];
+        return fd < FD_SETSIZE && FD_ISSET(fd, &OS(state)->open_fds) ? (int)fd : -1;
+}
+
+/* Makes fd, just opened, the guest's, returning it (or -1, with errno) */
+static int      fd_opened(ARMul_State *state, int fd)
+{
+        if (fd >= FD_SETSIZE) {
+                close(fd);
+                errno = EMFILE;
+                return -1;
+        }
+        FD_SET(fd, &OS(state)->open_fds);
+        return fd;
 }
 
-static  void        	write32(addr_t a, uint32_t data)
+static void     fd_closed(ARMul_State *state, int fd)
 {
-        *(uint32_t *)(mem_base + a) = htole32(data);
+        if (fd >= 0 && fd < FD_SETSIZE)
+                FD_CLR(fd, &OS(state)->open_fds);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
+static void     os_exit(ARMul_State *state, int status)
+{
+        // A forked process is a host process of its own, so ends here:
+        if (PROC(state)->forked) {
+                if (PROC(state)->scstats)
+                        os_sc_stats_dump(state, PROC(state)->scstats == 2);
+                prof_dump(PROC(state));
+                perf_dump(PROC(state));
+                trace_free(PROC(state));
+                _exit(status);
+        }
+
+        // Otherwise, stop this guest, leaving the rest of the host process be:
+        PROC(state)->exited = 1;
+        PROC(state)->exit_status = status;
+        state->Emulate = STOP;
+}
+
+/* The guest has done something that RISCiX would kill it with sig for, so
+ * stop it as though it had been.  Only this guest stops:  in batch mode or
+ * rixrund, others share the host process.
+ */
+void    os_fault(ARMul_State *state, int sig, const char *format, ...)
+{
+        struct rix_proc *p = PROC(state);
+        va_list ap;
+
+        fflush(stdout);
+        va_start(ap, format);
+        vdprintf(p->stdfd[2], format, ap);
+        va_end(ap);
+        flight_dump(p);
+        os_exit(state, 128 + sig);
+}
+
 void    rix_sc_exit(ARMul_State *state)
 {
         SC_1ARG;
-        SYSTRACE("exit(%d)", a0);
-
-        exit(a0);
+        SYSTRACE("exit(%d)\n", a0);
+        os_exit(state, a0);
 }
 
 void    rix_sc_read(ARMul_State *state)
 {
         SC_3ARG;
         SYSTRACE("read(%d, %08x, %08x)", a0, a1, a2);
-        int r = read(a0, mem_base + a1, a2);
+        int r = read(host_fd(state, a0), state->MemBase + a1, a2);
         if (r < 0)
                 SC_RET_ERROR(host_to_rix_errno(errno));
-        else
+        else {
+                /* Might be loading code over code that's been cached */
+                ARMul_BlockInvalidate(state, a1, r);
                 SC_RET_VAL("%d", r);
+        }
 }
 
 void    rix_sc_write(ARMul_State *state)
 {
         SC_3ARG;
         SYSTRACE("write(%d, %08x, %08x)", a0, a1, a2);
-        int r = write(a0, mem_base + a1, a2);
+        int r = write(host_fd(state, a0), state->MemBase + a1, a2);
         if (r < 0)
                 SC_RET_ERROR(host_to_rix_errno(errno));
         else
@@ -217,10 +334,15 @@ void    rix_sc_close(ARMul_State *state)
         SC_1ARG;
         SYSTRACE("close(%d)", a0);
         int r;
-        if (a0 > 2)
-                r = close(a0);
-        else
+        if (a0 > 2) {
+                int fd = host_fd(state, a0);
+
+                errno = EBADF;
+                r = fd < 0 ? -1 : close(fd);
+                fd_closed(state, fd);
+        } else {
                 r = 0;
+        }
 
         if (r < 0)
                 SC_RET_ERROR(host_to_rix_errno(errno));
@@ -231,19 +353,24 @@ void    rix_sc_close(ARMul_State *state)
 void    rix_sc_creat(ARMul_State *state)
 {
         SC_2ARG;
-        SYSTRACE("creat(\"%s\", %08x)", mem_base + a0, a1);
-        int r = creat((char *)(mem_base + a0), a1);
-        if (r < 0)
+        SYSTRACE("creat(\"%s\", %08x)", state->MemBase + a0, a1);
+        int r = openat(PROC(state)->cwd, (char *)(state->MemBase + a0),
+                       O_CREAT | O_WRONLY | O_TRUNC, a1);
+        if (r >= 0)
+                r = fd_opened(state, r);
+        if (r < 0) {
                 SC_RET_ERROR(host_to_rix_errno(errno));
-        else
+        } else {
                 SC_RET_VAL("%d", r);
+        }
 }
 
 void    rix_sc_link(ARMul_State *state)
 {
         SC_2ARG;
-        SYSTRACE("link(\"%s\", \"%s\")", mem_base + a0, mem_base + a1);
-        int r = link((char *)(mem_base + a0), (char *)(mem_base + a1));
+        SYSTRACE("link(\"%s\", \"%s\")", state->MemBase + a0, state->MemBase + a1);
+        int r = linkat(PROC(state)->cwd, (char *)(state->MemBase + a0),
+                       PROC(state)->cwd, (char *)(state->MemBase + a1), 0);
         if (r < 0)
                 SC_RET_ERROR(host_to_rix_errno(errno));
         else
@@ -253,41 +380,101 @@ void    rix_sc_link(ARMul_State *state)
 void    rix_sc_unlink(ARMul_State *state)
 {
         SC_1ARG;
-        SYSTRACE("unlink(\"%s\")", mem_base + a0);
-        int r = unlink((char *)(mem_base + a0));
+        SYSTRACE("unlink(\"%s\")", state->MemBase + a0);
+        int r = unlinkat(PROC(state)->cwd, (char *)(state->MemBase + a0), 0);
         if (r < 0)
                 SC_RET_ERROR(host_to_rix_errno(errno));
         else
                 SC_RET_VAL("%d", r);
 }
 
-void    rix_sc_waitpid(ARMul_State *state)
+static void     forget_child(ARMul_State *state, pid_t pid)
 {
-        SC_3ARG;
-        SYSTRACE("waitpid(%d, 0x%x, 0x%x)", a0, a1, a2);
-        int r = -1;
+        struct rix_os *os = OS(state);
 
-        if (a0 < 1 || a0 == 1234) {       /* magic vfork PID */
-                if (a1) {
-                        write32(a1, vfork_ret_status);
+        for (int i = 0; i < os->num_children; i++) {
+                if (os->children[i] == pid) {
+                        os->children[i] = os->children[--os->num_children];
+                        return;
                 }
-                // Fake success
-                r = 1234;
         }
+}
+
+/* Sleeps until one of this process' children might have changed state.
+ * A pidfd is readable once its process has exited; stopping (WUNTRACED)
+ * isn't seen, so that's polled for.
+ */
+static void     wait_children(struct rix_os *os, int options)
+{
+        struct pollfd pfd[MAX_CHILDREN];
+        int n = 0;
+
+#ifdef SYS_pidfd_open
+        for (int i = 0; i < os->num_children; i++) {
+                int fd = syscall(SYS_pidfd_open, os->children[i], 0);
+
+                if (fd >= 0)
+                        pfd[n++] = (struct pollfd){ .fd = fd, .events = POLLIN };
+        }
+#endif
+        poll(pfd, n, n < os->num_children || (options & WUNTRACED) ? 10 : -1);
+        for (int i = 0; i < n; i++)
+                close(pfd[i].fd);
+}
 
-        if (r < 0)
+/* Waits for one of this process' own children.  In batch mode and
+ * rixrund, other guests' children are the host's too, so pid -1 can't
+ * just be passed on to the host.
+ */
+static pid_t    wait_child(ARMul_State *state, pid_t pid, int *status, int options)
+{
+        struct rix_os *os = OS(state);
+
+        if (pid > 0 || !os_shared)
+                return waitpid(pid, status, options);
+        if (os->num_children == 0) {
+                errno = ECHILD;
+                return -1;
+        }
+        if (os->num_children == 1)      // The usual vfork/exec/wait
+                return waitpid(os->children[0], status, options);
+        for (;;) {
+                for (int i = 0; i < os->num_children; i++) {
+                        pid_t r = waitpid(os->children[i], status, options | WNOHANG);
+                        if (r != 0)
+                                return r;
+                }
+                if (options & WNOHANG)
+                        return 0;
+                wait_children(os, options);
+        }
+}
+
+void    rix_sc_waitpid(ARMul_State *state)
+{
+        SC_3ARG;
+        SYSTRACE("waitpid(%d, 0x%x, 0x%x)", a0, a1, a2);
+        int status;
+        // WNOHANG/WUNTRACED, and the status, are the same as BSD's:
+        pid_t r = wait_child(state, (int32_t)a0, &status, a2 & (WNOHANG | WUNTRACED));
+
+        if (r < 0) {
                 SC_RET_ERROR(host_to_rix_errno(errno));
-        else
+        } else {
+                if (r > 0 && (WIFEXITED(status) || WIFSIGNALED(status)))
+                        forget_child(state, r);
+                if (r > 0 && a1)
+                        write32(state, a1, status);
                 SC_RET_VAL("%d", r);
+        }
 }
 
 void    rix_sc_sbreak(ARMul_State *state)
 {
-        static addr_t current_sbrk = 0;
         SC_1ARG;
         SYSTRACE("sbreak(%08x)", a0);
-        addr_t old_sbrk = current_sbrk;
-        current_sbrk = (int)a0; // FIXME: check for ludicrous values (or negative..)
+        addr_t old_sbrk = OS(state)->current_sbrk;
+        OS(state)->current_sbrk = (int)a0; // FIXME: check for ludicrous values (or negative..)
         SC_RET_VAL("%08x", 0); // FIXME: Check mem limit, return error (ENOMEM?)
 }
 
@@ -295,7 +482,7 @@ void    rix_sc_lseek(ARMul_State *state)
 {
         SC_3ARG;
         SYSTRACE("lseek(%d, %08x, %d)", a0, a1, a2);
-        int r = lseek(a0, a1, a2);
+        int r = lseek(host_fd(state, a0), a1, a2);
         if (r < 0)
                 SC_RET_ERROR(host_to_rix_errno(errno));
         else
@@ -306,28 +493,31 @@ void    rix_sc_getpid(ARMul_State *state)
 {
         // Need a 16b PID, waah!  This is broken on modern systems.
         SYSTRACE("getpid()");
-        SC_RET_VAL("%d", getpid());
+        SC_RET_VAL("%d", PROC(state)->pid);
 }
 
 void    rix_sc_open(ARMul_State *state)
 {
         SC_3ARG;
-        char *pathname = (char *)(mem_base + a0); // Note, not remapped
+        char *pathname = (char *)(state->MemBase + a0); // Note, not remapped
         SYSTRACE("open(\"%s\", %08x, %08x)", pathname, a1, a2);
-        int r = open(pathname, rix_to_host_openflags(a1), a2);
+        int r = openat(PROC(state)->cwd, pathname, rix_to_host_openflags(a1), a2);
 
-        if (r < 0)
+        if (r >= 0)
+                r = fd_opened(state, r);
+        if (r < 0) {
                 SC_RET_ERROR(host_to_rix_errno(errno));
-        else
+        } else {
                 SC_RET_VAL("%d", r);
+        }
 }
 
 void    rix_sc_access(ARMul_State *state)
 {
         SC_2ARG;
-        char *pathname = (char *)(mem_base + a0); // Note, not remapped
+        char *pathname = (char *)(state->MemBase + a0); // Note, not remapped
         SYSTRACE("access(\"%s\", %08x)", pathname, a1);
-        int r = access(pathname, a1); // Note flags same on Linux :p
+        int r = faccessat(PROC(state)->cwd, pathname, a1, 0); // Note flags same on Linux :p
 
         if (r < 0)
                 SC_RET_ERROR(host_to_rix_errno(errno));
@@ -335,38 +525,108 @@ void    rix_sc_access(ARMul_State *state)
                 SC_RET_VAL("%d", r);
 }
 
-int     rix_execve_handler(ARMul_State *state, uint32_t a1, uint32_t a2);
+/* Copies a guest argv/envp array out of guest memory (before exec
+ * replaces it), returning a NULL-terminated host array.
+ */
+static char   **copy_strv(ARMul_State *state, addr_t a, int *count)
+{
+        int n = 0;
+
+        while (read32(state, a + n * 4))
+                n++;
+        char **v = calloc(n + 1, sizeof(char *));
+        for (int i = 0; v && i < n; i++)
+                v[i] = strdup((char *)(state->MemBase + read32(state, a + i * 4)));
+        *count = n;
+        return v;
+}
 
-void    rix_sc_execve(ARMul_State *state)
+static void     free_strv(char **v)
 {
-        SC_3ARG;
-        SYSTRACE("execve(\"%s\", %08x, %08x)\n", mem_base + a0, a1, a2);
+        for (int i = 0; v && v[i]; i++)
+                free(v[i]);
+        free(v);
+}
+
+/* The guest exec's RISCiX programs, so an absolute path is looked for in
+ * RIX_ROOT first (else "/bin/ld" is the host's ld).
+ */
+static void     exec_path(ARMul_State *state, char *path, char *hpath)
+{
+        char *rootpath = getenv("RIX_ROOT");
 
-        int r = rix_execve_handler(state, a1, a2);
+        if (path[0] == '/' && rootpath) {
+                snprintf(hpath, PATH_MAX, "%s%s", rootpath, path);
+                if (access(hpath, R_OK) == 0)
+                        return;
+        }
+        snprintf(hpath, PATH_MAX, "%s", path);
+}
 
-        if (r) {
-                // Dump args/env:
-                addr_t p = read32(a1);
+/* Runs a command on the host in place of the guest, as exec would */
+static int      host_exec(ARMul_State *state, char *cmd)
+{
+        SDBG("execve: host command %s\n", cmd);
+        if (!PROC(state)->forked) {
+                // Don't replace the whole of rixrun; run it, then exit with it
+                int r = system(cmd);
+                os_exit(state, WIFEXITED(r) ? WEXITSTATUS(r) : 127);
+                return 0;
+        }
+        // The host's cwd and stdio aren't necessarily this process':
+        if (PROC(state)->cwd >= 0 && fchdir(PROC(state)->cwd) < 0)
+                return -errno;
+        for (int i = 0; i < 3; i++) {
+                if (PROC(state)->stdfd[i] != i)
+                        dup2(PROC(state)->stdfd[i], i);
+        }
+        execl("/bin/sh", "sh", "-c", cmd, (char *)NULL);
+        return -errno;
+}
+
+void    rix_sc_execve(ARMul_State *state)
+{
+        SC_3ARG;
+        char *path = (char *)(state->MemBase + a0);
+        char hpath[PATH_MAX];
+        char cmd_buff[4096];
+        int argc, envc, r;
+
+        SYSTRACE("execve(\"%s\", %08x, %08x)\n", path, a1, a2);
+        char **argv = copy_strv(state, a1, &argc);
+        char **envp = copy_strv(state, a2, &envc);
+
+        for (int i = 0; i < argc; i++)
+                SDBG("  arg[%d] '%s'\n", i, argv[i]);
+
+        if (argc >= 3 && !strcmp(argv[0], "sh") && !strcmp(argv[1], "-c") &&
+            !strncmp(argv[2], "/sbin/cp ", 9)) {
+                /* unsqueeze system()s a cp, and RISCiX's sh is squeezed,
+                 * so do that one on the host:
+                 */
+                snprintf(cmd_buff, sizeof(cmd_buff), "cp %s", argv[2] + 9);
+                r = host_exec(state, cmd_buff);
+        } else {
+                exec_path(state, path, hpath);
+                r = rix_proc_exec(PROC(state), hpath, argc, argv, envc, envp);
+        }
+        free_strv(argv);
+        free_strv(envp);
 
-                int i = 0;
-                while (p) {
-                        printf("Arg[%d]@%08x=%08x='%s'\n", i++, a1, p, mem_base + p);
-                        a1 += 4;
-                        p = read32(a1);
+        if (r < 0) {
+                SC_RET_ERROR(host_to_rix_errno(-r));
+        } else {
+                if (r > 0) {
+                        fprintf(stderr, "rixrun: execve: can't load %s\n", hpath);
+                        os_exit(state, 127);
                 }
-                p = read32(a2);
-                i = 0;
-                while (p) {
-                        printf("Env[%d]@%08x=%08x='%s'\n", i++, a2, p, mem_base + p);
-                        a2 += 4;
-                        p = read32(a2);
+                // The new image is running, so let the vfork() parent go:
+                if (OS(state)->vfork_fd >= 0) {
+                        close(OS(state)->vfork_fd);
+                        OS(state)->vfork_fd = -1;
                 }
-                fprintf(stderr, "rix_sc_execve: not implemented!\n");
-                SC_RET_ERROR(ENOENT);
+                OS(state)->current_sbrk = 0;
         }
-        /* Otherwise, the handler has munged CPU state to "return in the parent"
-         * with a PID.
-         */
 }
 
 void    rix_sc_fstat(ARMul_State *state)
@@ -374,11 +634,11 @@ void    rix_sc_fstat(ARMul_State *state)
         SC_2ARG;
         SYSTRACE("fstat(%d, %08x)", a0, a1);
         struct stat sb;
-        int r = fstat(a0, &sb);
+        int r = fstat(host_fd(state, a0), &sb);
         if (r < 0) {
                 SC_RET_ERROR(host_to_rix_errno(errno));
         } else {
-                host_to_rix_stat((struct rix_stat *)(mem_base + a1), &sb);
+                host_to_rix_stat((struct rix_stat *)(state->MemBase + a1), &sb);
                 SC_RET_VAL("%d", r);
         }
 }
@@ -389,23 +649,118 @@ void    rix_sc_getpagesize(ARMul_State *state)
         SC_RET_VAL("%d", 32768);
 }
 
-void    rix_sc_vfork(ARMul_State *state)
+/* Makes the process, having been host-forked, a child in its own right */
+void    os_forked(ARMul_State *state)
 {
-        /* Here lies gross hack #28.  This "implementation" supports the
-         * pattern of some RISCiX utils using system(), i.e. invoking a
-         * UNIX command and waiting for it to complete.
-         *
-         * We stash CPU thread state here, and return as though we're
-         * the child process (without making a new process).  execve
-         * does the command, and when complete that syscall restores
-         * the stashed state fixed up as though returning in the parent
-         * (returns a PID).  The PID is fake, and wait() just consumes
-         * it.  This is all horribly broken except in the one case I
-         * care about when using unsqueeze/cc/etc.
-         */
-        SYSTRACE("vfork()");
-        memcpy(&state_vfork_backup, state, sizeof(*state));
-        SC_RET_VAL("%d", 0);
+        struct rix_os *os = OS(state);
+
+        PROC(state)->forked = 1;
+        PROC(state)->pid = getpid();
+        // A pending snapshot is the parent's to take
+        snap_free(PROC(state));
+        prof_forked(PROC(state));
+        perf_forked(PROC(state));
+        trace_forked(PROC(state));
+        // As are the syscalls so far
+        memset(os->sc_stats, 0, sizeof(os->sc_stats));
+        os->sc_last_instrs = state->NumInstrs;
+        os->sc_start_instrs = state->NumInstrs;
+        os->sc_start_ns = sc_now_ns();
+        os->num_children = 0;
+        // This is the only guest left in the child
+        os_shared = 0;
+        // The vfork() parent's parent isn't waiting on us:
+        if (os->vfork_fd >= 0)
+                close(os->vfork_fd);
+        os->vfork_fd = -1;
+}
+
+/* In batch mode and rixrund, other threads (running other guests) might be
+ * in the middle of printing when a guest forks, and the child mustn't
+ * inherit stdout or stderr locked.
+ */
+static void     stdio_lock_prepare(void)
+{
+        flockfile(stdout);
+        flockfile(stderr);
+}
+
+static void     stdio_lock_release(void)
+{
+        funlockfile(stderr);
+        funlockfile(stdout);
+}
+
+void    os_global_init(void)
+{
+        pthread_atfork(stdio_lock_prepare, stdio_lock_release, stdio_lock_release);
+}
+
+/* From batch mode and rixrund, before starting guests on several threads */
+void    os_set_shared(void)
+{
+        os_shared = 1;
+}
+
+/* fork() and vfork() are both a host fork(), the guest's memory being
+ * copied (copy-on-write) along with the rest of rixrun.  A vfork() parent
+ * then waits until the child has exec'd or exited, as it would on RISCiX
+ * (but the child can't scribble on the parent's memory).
+ */
+void    rix_sc_fork(ARMul_State *state, int is_vfork)
+{
+        struct rix_os *os = OS(state);
+        int vfd[2];
+        pid_t pid;
+
+        SYSTRACE("%s()", is_vfork ? "vfork" : "fork");
+        if (os->num_children == MAX_CHILDREN) {
+                SC_RET_ERROR(EAGAIN);
+                return;
+        }
+        if (is_vfork) {
+                if (pipe(vfd) < 0) {
+                        SC_RET_ERROR(host_to_rix_errno(errno));
+                        return;
+                }
+                // Not to be held by anything exec'd on the host
+                fcntl(vfd[0], F_SETFD, FD_CLOEXEC);
+                fcntl(vfd[1], F_SETFD, FD_CLOEXEC);
+        }
+        // So that anything buffered isn't output twice:
+        fflush(stdout);
+        fflush(stderr);
+
+        pid = fork();
+        if (pid < 0) {
+                int e = errno;
+                if (is_vfork) {
+                        close(vfd[0]);
+                        close(vfd[1]);
+                }
+                SC_RET_ERROR(host_to_rix_errno(e));
+        } else if (pid == 0) {
+                os_forked(state);
+                if (is_vfork) {
+                        close(vfd[0]);
+                        os->vfork_fd = vfd[1];
+                }
+                // Returns pid, and r1 = 1 in the child as on BSD:
+                ARMul_SetReg(state, state->Mode, 1, 1);
+                SC_RET_VAL("%d", 0);
+        } else {
+                os->children[os->num_children++] = pid;
+                if (is_vfork) {
+                        char c;
+
+                        close(vfd[1]);
+                        while (read(vfd[0], &c, 1) < 0 && errno == EINTR)
+                                ;
+                        close(vfd[0]);
+                }
+                ARMul_SetReg(state, state->Mode, 1, 0);
+                SC_RET_VAL("%d", pid);
+        }
 }
 
 void    rix_sc_getdtablesize(ARMul_State *state)
@@ -424,8 +779,8 @@ void    rix_sc_gettimeofday(ARMul_State *state)
         struct timeval tv;
         gettimeofday(&tv, NULL);
         // Do this by proxy to protect against 64b time_t.
-        write32(a0, tv.tv_sec);
-        write32(a0 + 4, tv.tv_usec);
+        write32(state, a0, tv.tv_sec);
+        write32(state, a0 + 4, tv.tv_usec);
         SC_RET_VAL("%d", 0);
 }
 
@@ -435,7 +790,7 @@ void    rix_sc_getrusage(ARMul_State *state)
         SYSTRACE("getrusage(%d, %08x)", a0, a1);
 
         // Basically a NOP, but at least write to the output structure...
-        bzero(mem_base + a1, 8 + // timeval
+        bzero(state->MemBase + a1, 8 + // timeval
               8 + // timeval
               14*4);
 
@@ -447,7 +802,7 @@ void    rix_sc_ftruncate(ARMul_State *state)
         SC_2ARG;
         SYSTRACE("ftruncate(%d, %08x)", a0, a1);
 
-        int r = ftruncate(a0, a1);
+        int r = ftruncate(host_fd(state, a0), a1);
 
         if (r < 0)
                 SC_RET_ERROR(host_to_rix_errno(errno));
@@ -465,48 +820,330 @@ void    rix_sc_NOP(ARMul_State *state, char *name)
 
 
 ////////////////////////////////////////////////////////////////////////////////
+// Syscall accounting
+//
+// Always kept (it's two clock reads per syscall), and dumped at exit if
+// asked for, by os_sc_stats_dump().  This tells us whether a slow run is
+// spending its time emulating, or in the host's syscalls.
+
+static const char       *sc_names[SC_MAX] = {
+        [1] = "exit",           [2] = "fork",           [3] = "read",           [4] = "write",
+        [6] = "close",          [8] = "creat",          [9] = "link",
+        [10] = "unlink",        [11] = "waitpid",       [15] = "chmod",
+        [16] = "chown",         [17] = "sbreak",        [19] = "lseek",
+        [20] = "getpid",        [28] = "open",          [34] = "access",
+        [54] = "ioctl",         [59] = "execve",        [60] = "umask",
+        [62] = "fstat",         [64] = "getpagesize",   [66] = "vfork",
+        [89] = "getdtablesize", [108] = "sigvec",       [109] = "sigblock",
+        [110] = "sigsetmask",   [112] = "sigstack",     [116] = "gettimeofday",
+        [117] = "getrusage",    [130] = "ftruncate",
+};
+
+
+void    os_sc_stats_dump(ARMul_State *state, int json)
+{
+        struct sc_stats *sc_stats = OS(state)->sc_stats;
+        uint64_t total_ns = sc_now_ns() - OS(state)->sc_start_ns;
+        uint64_t sc_ns = 0;
+        unsigned long instrs = state->NumInstrs - OS(state)->sc_start_instrs;
+        int first = 1;
+
+        for (int i = 0; i < SC_MAX; i++)
+                sc_ns += sc_stats[i].ns;
+
+        if (json) {
+                fprintf(stderr, "{\"pid\": %d, \"wall_ns\": %llu, \"syscall_ns\": %llu, "
+                        "\"guest_instrs\": %lu, \"syscalls\": [", PROC(state)->pid,
+                        (unsigned long long)total_ns, (unsigned long long)sc_ns, instrs);
+                for (int i = 0; i < SC_MAX; i++) {
+                        struct sc_stats *st = &sc_stats[i];
+
+                        if (!st->calls)
+                                continue;
+                        fprintf(stderr, "%s\n  {\"nr\": %d, \"name\": \"%s\", \"calls\": %llu, "
+                                "\"ns\": %llu, \"bytes\": %llu, \"instrs\": %llu, \"hist_log2_ns\": [",
+                                first ? "" : ",", i, sc_names[i] ? sc_names[i] : "?",
+                                (unsigned long long)st->calls, (unsigned long long)st->ns,
+                                (unsigned long long)st->bytes, (unsigned long long)st->instrs);
+                        for (int b = 0; b < SC_HIST_BUCKETS; b++)
+                                fprintf(stderr, "%s%u", b ? ", " : "", st->hist[b]);
+                        fprintf(stderr, "]}");
+                        first = 0;
+                }
+                fprintf(stderr, "\n]}\n");
+                return;
+        }
 
-// From GDB's sim/arm/armos.h:
-#define FPESTART        0x2000L
-#define FPEEND          0x8000L
-#define FPEOLDVECT      FPESTART + 0x100L + 8L * 16L + 4L    /* stack + 8 regs + fpsr */
-#define FPENEWVECT(addr) 0xea000000L + ((addr) >> 2) - 3L       /* branch from 4 to 0x2400 */
+        if (PROC(state)->forked)
+                fprintf(stderr, "\nrixrun: pid %d (forked):", PROC(state)->pid);
+        else
+                fprintf(stderr, "\nrixrun:");
+        fprintf(stderr, " %lu guest instructions, %.3fs wall, %.3fs (%.1f%%) in syscalls\n",
+                instrs, total_ns / 1e9, sc_ns / 1e9,
+                total_ns ? 100.0 * sc_ns / total_ns : 0.0);
+        fprintf(stderr, "%-14s %10s %12s %10s %12s %14s\n",
+                "syscall", "calls", "total ms", "mean us", "bytes", "instrs before");
+        for (int i = 0; i < SC_MAX; i++) {
+                struct sc_stats *st = &sc_stats[i];
+
+                if (!st->calls)
+                        continue;
+                fprintf(stderr, "%-14s %10llu %12.3f %10.3f %12llu %14llu\n",
+                        sc_names[i] ? sc_names[i] : "?", (unsigned long long)st->calls,
+                        st->ns / 1e6, st->ns / 1e3 / st->calls,
+                        (unsigned long long)st->bytes, (unsigned long long)st->instrs);
+                // Latency histogram, "<2^n ns:count" per non-empty bucket
+                int col = 0;
+                for (int b = 0; b < SC_HIST_BUCKETS; b++) {
+                        if (!st->hist[b])
+                                continue;
+                        fprintf(stderr, "%*s <2^%d:%u", col ? 0 : 14, "", b + 1, st->hist[b]);
+                        col = 1;
+                }
+                if (col)
+                        fprintf(stderr, "\n");
+        }
+}
 
-#include "armfpe.h"
+////////////////////////////////////////////////////////////////////////////////
 
 void    os_init(ARMul_State *state, char *me_realpath, int verbose)
 {
-        path_to_rixrun = me_realpath;
-        sc_trace = verbose;
-
-        // Install FPE (based on GDB's armulator's armos.c)
-        int i;
-        for (i = 0; i < fpesize; i += 4)      /* copy the code */
-                write32(FPESTART + i, fpecode[i >> 2]);
-        // Find entry ptr:
-        for (i = FPESTART + fpesize;; i -= 4) {
-                unsigned int j;
-                if ((j = read32(i)) == 0xffffffff)
-                        break;
-        }
-        /* install new vector */
-        write32(4, FPENEWVECT(read32(i - 4)));
-
-        // Set up SVC stack below FPE:
-        ARMul_SetReg(state, SVC26MODE, 13, FPESTART - 4);
+        struct rix_os *os = calloc(1, sizeof(*os));
+
+        if (!os)
+                panic("Can't allocate OS state\n");
+        PROC(state)->os = os;
+        os->path_to_rixrun = me_realpath;
+        os->trace = verbose;
+        os->sc_start_ns = sc_now_ns();
+        os->vfork_fd = -1;
+
+        /* Floating point is done by the FPA coprocessor (armfpa.c), so
+         * there's no FPE to install at the undefined instruction vector.
+         */
 
         // Change to user mode for the running program:
         SETABORT(0, USER26MODE);
         ARMul_CPSRAltered(state);
 }
 
+/* Readies the OS state of a process whose guest has exited for another,
+ * as though it were new:  anything the old guest left open is closed.
+ */
+void    os_reset(ARMul_State *state)
+{
+        struct rix_os *os = OS(state);
+
+        for (int fd = 0; fd < FD_SETSIZE; fd++) {
+                if (FD_ISSET(fd, &os->open_fds))
+                        close(fd);
+        }
+        FD_ZERO(&os->open_fds);
+        // Children that are still going are left to it, bar reaping them
+        for (int i = 0; i < os->num_children; i++)
+                waitpid(os->children[i], NULL, WNOHANG);
+        os->num_children = 0;
+        if (os->vfork_fd >= 0)
+                close(os->vfork_fd);
+        os->vfork_fd = -1;
+        os->current_sbrk = 0;
+        memset(os->sc_stats, 0, sizeof(os->sc_stats));
+        os->sc_last_instrs = 0;
+        os->sc_start_instrs = 0;
+        os->sc_start_ns = sc_now_ns();
+}
+
+void    os_free(ARMul_State *state)
+{
+        for (int fd = 0; fd < FD_SETSIZE; fd++) {
+                if (FD_ISSET(fd, &OS(state)->open_fds))
+                        close(fd);
+        }
+        free(OS(state));
+        PROC(state)->os = NULL;
+}
+
+/* A syscall's name, or NULL */
+const char *os_sc_name(int n)
+{
+        return n >= 0 && n < SC_MAX ? sc_names[n] : NULL;
+}
+
+/* A syscall's number from its name (or number), or -1 */
+int     os_sc_number(const char *name)
+{
+        char *end;
+        long n = strtol(name, &end, 0);
+
+        if (*name && !*end)
+                return n >= 0 && n < SC_MAX ? n : -1;
+        for (int i = 0; i < SC_MAX; i++) {
+                if (sc_names[i] && !strcmp(sc_names[i], name))
+                        return i;
+        }
+        return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Snapshots (see snap.c): the break, and the host files behind guest fds.
+// Guest fds are the host's own (bar stdin/stdout/stderr), so a restored
+// one must get the same number, which it can only if that's still free.
+
+struct os_snap_fd {
+        int32_t         fd;
+        int32_t         flags;
+        int64_t         offset;
+        char            path[PATH_MAX];
+};
+
+static int      fd_path(int fd, char *path)
+{
+#ifdef __APPLE__
+        return fcntl(fd, F_GETPATH, path) < 0 ? -1 : 0;
+#else
+        char link[32];
+        ssize_t l;
+
+        snprintf(link, sizeof(link), "/proc/self/fd/%d", fd);
+        l = readlink(link, path, PATH_MAX - 1);
+        if (l < 0)
+                return -1;
+        path[l] = '\0';
+        return path[0] == '/' ? 0 : -1;        // Not a pipe, socket, etc.
+#endif
+}
+
+int     os_snap_write(ARMul_State *state, FILE *f)
+{
+        struct rix_os *os = OS(state);
+        struct os_snap_fd sf;
+        uint32_t n = 0;
+
+        for (int fd = 0; fd < FD_SETSIZE; fd++)
+                n += !!FD_ISSET(fd, &os->open_fds);
+        fwrite(&os->current_sbrk, sizeof(os->current_sbrk), 1, f);
+        fwrite(&n, sizeof(n), 1, f);
+        for (int fd = 0; fd < FD_SETSIZE; fd++) {
+                if (!FD_ISSET(fd, &os->open_fds))
+                        continue;
+                memset(&sf, 0, sizeof(sf));
+                sf.fd = fd;
+                sf.flags = fcntl(fd, F_GETFL);
+                sf.offset = lseek(fd, 0, SEEK_CUR);
+                if (sf.flags < 0 || fd_path(fd, sf.path) < 0) {
+                        fprintf(stderr, "rixrun: Can't snapshot guest fd %d\n", fd);
+                        return -1;
+                }
+                fwrite(&sf, sizeof(sf), 1, f);
+        }
+        return ferror(f) ? -1 : 0;
+}
+
+struct os_snap {
+        addr_t          sbrk;
+        uint32_t        nfds;
+        struct os_snap_fd fds[];
+};
+
+/* Reads what os_snap_write() wrote, to be restored by os_snap_restore()
+ * (once the snapshot file itself is closed, as it might have the number
+ * of one of the guest's fds).
+ */
+struct os_snap *os_snap_read(ARMul_State *state, FILE *f)
+{
+        struct os_snap hdr, *s;
+
+        if (fread(&hdr.sbrk, sizeof(hdr.sbrk), 1, f) != 1 ||
+            fread(&hdr.nfds, sizeof(hdr.nfds), 1, f) != 1 || hdr.nfds > FD_SETSIZE)
+                return NULL;
+        s = malloc(sizeof(*s) + hdr.nfds * sizeof(s->fds[0]));
+        if (!s)
+                return NULL;
+        *s = hdr;
+        if (fread(s->fds, sizeof(s->fds[0]), s->nfds, f) != s->nfds) {
+                free(s);
+                return NULL;
+        }
+        return s;
+}
+
+/* Reopens the snapshot's files (and frees s), or returns <0 with none of
+ * them open.
+ */
+int     os_snap_restore(ARMul_State *state, struct os_snap *s)
+{
+        fd_set opened;
+        int r = -1;
+
+        FD_ZERO(&opened);
+        for (uint32_t i = 0; i < s->nfds; i++) {
+                struct os_snap_fd *sf = &s->fds[i];
+
+                if (sf->fd < 3 || sf->fd >= FD_SETSIZE)
+                        goto out;
+                sf->path[PATH_MAX - 1] = '\0';
+                if (fcntl(sf->fd, F_GETFD) >= 0)
+                        goto out;       // Taken
+                int fd = open(sf->path, sf->flags & ~(O_CREAT | O_EXCL | O_TRUNC));
+                if (fd < 0)
+                        goto out;
+                if (fd != sf->fd) {
+                        int d = dup2(fd, sf->fd);
+
+                        close(fd);
+                        if (d < 0)
+                                goto out;
+                }
+                FD_SET(sf->fd, &opened);
+                if (lseek(sf->fd, sf->offset, SEEK_SET) < 0 && errno != ESPIPE)
+                        goto out;
+        }
+        for (int fd = 0; fd < FD_SETSIZE; fd++) {
+                if (FD_ISSET(fd, &opened))
+                        fd_opened(state, fd);
+        }
+        OS(state)->current_sbrk = s->sbrk;
+        r = 0;
+out:
+        if (r < 0) {
+                for (int fd = 0; fd < FD_SETSIZE; fd++) {
+                        if (FD_ISSET(fd, &opened))
+                                close(fd);
+                }
+        }
+        free(s);
+        return r;
+}
+
 unsigned int    ARMul_OSHandleSWI(ARMul_State *state, ARMword number)
 {
         /* printf("Got SWI 0x%x at PC %08x\n", number, ARMul_GetPC(state)); */
         unsigned int scnum = number & 0xfffff;
+        struct sc_stats *st;
+        uint64_t t, ns;
+        int b;
+
+        hle_rearm(state);
+        if (PROC(state)->snap && snap_swi(state, number))
+                return 1;
+        if ((number & HLE_SWI_MASK) == HLE_SWI_BASE) {
+                hle_swi(state, number);
+                return 1;
+        }
+
+        ARMul_FlightRecord(state, R15PC - 8, number);
+
+        /* Account before the call, as exit doesn't come back. */
+        st = &OS(state)->sc_stats[scnum < SC_MAX ? scnum : 0];
+        st->calls++;
+        st->instrs += state->NumInstrs - OS(state)->sc_last_instrs;
+        perf_sc_enter(state);
+        t = sc_now_ns();
 
         switch(scnum) {
         case 1:         /* exit         */      rix_sc_exit(state);             break;
+        case 2:         /* fork         */      rix_sc_fork(state, 0);          break;
         case 3:         /* read         */      rix_sc_read(state);             break;
         case 4:         /* write        */      rix_sc_write(state);            break;
         case 6:         /* close        */      rix_sc_close(state);            break;
@@ -526,7 +1163,7 @@ unsigned int    ARMul_OSHandleSWI(ARMul_State *state, ARMword number)
         case 60:        /* umask        */      rix_sc_NOP(state, "umask");     break;
         case 62:        /* fstat        */      rix_sc_fstat(state);            break;
         case 64:        /* getpagesize  */      rix_sc_getpagesize(state);      break;
-        case 66:        /* vfork        */      rix_sc_vfork(state);            break;
+        case 66:        /* vfork        */      rix_sc_fork(state, 1);          break;
         case 89:        /* getdtablesize*/      rix_sc_getdtablesize(state);    break;
         case 108:       /* sigvec       */      rix_sc_NOP(state, "sigvec");    break;
         case 109:       /* sigblock     */      rix_sc_NOP(state, "sigblock");  break;
@@ -537,8 +1174,21 @@ unsigned int    ARMul_OSHandleSWI(ARMul_State *state, ARMword number)
         case 130:       /* ftruncate    */      rix_sc_ftruncate(state);        break;
 
         default:
-                panic("*** Unhandled syscall %d at PC %08lx\n", scnum, ARMul_GetPC(state));
+                os_fault(state, SIGSYS, "*** Unhandled syscall %d at PC %08lx\n",
+                         scnum, ARMul_GetPC(state));
+        }
+
+        ns = sc_now_ns() - t;
+        perf_sc_exit(state, scnum);
+        // A forked child's stats start afresh during its fork(), which is the parent's
+        if (OS(state)->sc_start_ns <= t) {
+                st->ns += ns;
+                b = ns ? 63 - __builtin_clzll(ns) : 0;
+                st->hist[b < SC_HIST_BUCKETS ? b : SC_HIST_BUCKETS - 1]++;
+                if ((scnum == 3 || scnum == 4) && !CFLAG)
+                        st->bytes += ARMul_GetReg(state, state->Mode, 0);
         }
+        OS(state)->sc_last_instrs = state->NumInstrs;
         return 1;
 }
 
@@ -555,75 +1205,26 @@ void dump_state(ARMul_State *state)
 unsigned int    ARMul_OSException(ARMul_State * state, ARMword vector,
                                   ARMword pc)
 {
-        if (vector == 0x4) {    /* Undefined, assume FPE! */
-                if (state->verbose > 1) {
-                        printf("*** UNK exception @PC%08x, calling vector\n", pc);
-                        dump_state(state);
-                }
-                return 0;       // Go to exception vector
+        pc -= 8;        // PC is still ahead in the pipeline
+        if (OS(state)->trace)
+                dump_state(state);
+        if (vector == 0x4) {
+                /* Undefined instruction, or an FP exception whose trap is
+                 * enabled (an FPA instruction on CP1 or CP2), for which
+                 * RISCiX would deliver SIGFPE:
+                 */
+                ARMword instr = pc < MEM_SIZE ? read32(state, pc) : 0;
+                unsigned int cp = (instr >> 8) & 0xf;
+
+                if ((instr & 0x0c000000) == 0x0c000000 && (instr & 0x0f000000) != 0x0f000000 &&
+                    (cp == 1 || cp == 2))
+                        os_fault(state, SIGFPE, "*** FP exception at %08x\n", pc);
+                else
+                        os_fault(state, SIGILL, "*** Undefined instruction at %08x\n", pc);
         } else {
-                panic("Got exception (vector 0x%lx), PC %08x\n",
-                      vector, pc);
+                os_fault(state, vector >= 0xc && vector <= 0x14 ? SIGSEGV : SIGILL,
+                         "*** Got exception (vector 0x%lx), PC %08x\n", vector, pc);
         }
 
         return 1; // Don't do exception vectors, etc.
 }
-
-static char cmd_buff[4096];
-
-int     rix_execve_handler(ARMul_State *state, uint32_t a1, uint32_t a2)
-{
-        const int args_max = 16;
-        char *args[args_max];
-
-        /* Try to spot certain common patterns of system() invocations,
-         * and deal with those alone.
-         *
-         * a1->argv, a2->envv
-         * First, convert args:
-         */
-        int i = 0;
-        addr_t arg = read32(a1);
-        do {
-                if (arg != 0) {
-                        args[i] = mem_base + arg;
-                } else {
-                        args[i] = 0;
-                        break;
-                }
-                i++;
-                a1 += 4;
-                arg = read32(a1);
-        } while(i < args_max);
-        if (i == args_max)
-                return 1;
-
-        /* OK, try to match common 'executions' via system(). */
-        if (!strcmp(args[0], "sh") && !strcmp(args[1], "-c")) {
-                if (!strncmp(args[2], "/sbin/cp ", 9)) {
-                        char *cp_args = (char *)(args[2] + 9);
-                        snprintf(cmd_buff, 4096, "cp %s", cp_args);
-                        vfork_ret_status = system(cmd_buff);
-                        SDBG("execve handler: %s (-> %d)\n", cmd_buff, vfork_ret_status);
-                        goto handled_return;
-                }
-
-                /* FIXME:
-                 * Extend this with the ability to re-invoke rixrun with commands
-                 * relative to RIX_ROOT!
-                 */
-        }
-
-fail:
-        return 1;       /* Unhandled */
-
-handled_return:
-        // Assumes preceeded by one vfork!!!1
-        memcpy(state, &state_vfork_backup, sizeof(*state));
-        /* Returns the process to the state at the vfork; now make it look like
-         * the child was exec'd, and was process 1234.  It's complete of course,
-         * which we'll say via wait() if asked.
-         */
-        SC_RET_VAL("%d", 1234);
-        return 0;       /* Unhandled */
-}
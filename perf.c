@@ -0,0 +1,483 @@
+/* rixrun host performance counters
+ *
+ * Guest instruction counts don't show where the emulator itself spends
+ * the host's time.  This measures the host cost of running each guest
+ * instruction, with the hardware counters (cycles, instructions, branch
+ * misses and L1 data cache misses) that perf_event_open() gives, or with
+ * a clock where there aren't any.  ARMulator calls ARMul_PerfSample()
+ * before an instruction once state->PerfNext instructions have run; this
+ * ends the measurement of the one before and starts that of this one.
+ * Measuring (two counter reads) costs many times more than the instruction
+ * itself, the least of which is taken off each measurement, so measuring
+ * only one instruction in so many (chosen at random) gives much the same
+ * proportions much sooner.
+ *
+ * Measurements are added up by the instruction's opcode class (bits 20-27,
+ * as the interpreter's switch decodes them) and by the range of guest PCs
+ * it's in.  Syscalls are always measured, by ARMul_OSHandleSWI() calling
+ * perf_sc_enter() and perf_sc_exit() around them.  The lot is printed to
+ * stderr at exit.
+ *
+ * Copyright (C) 2022 Matt Evans
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "armdefs.h"
+#include "armemu.h"
+#include "armblock.h"
+#include "rixrun.h"
+#include "rix_os.h"
+#include "perf.h"
+
+#define PERF_NUM        4               // Counters
+#define PERF_CLASSES    512             // Opcode classes, see instr_class()
+#define PERF_RANGE_SHIFT 8              // Guest PC range size (log2)
+#define PERF_RANGES     (MEM_SIZE >> PERF_RANGE_SHIFT)
+#define PERF_SC_MAX     256
+#define PERF_TOP        25
+#define PERF_CALIBRATE  1000            // Reads to find the cost of measuring
+
+/* A sum of measurements */
+struct perf_acc {
+        uint64_t        n;
+        uint64_t        v[PERF_NUM];
+};
+
+struct rix_perf {
+        int             fd[PERF_NUM];   // Leader first; -1 if not there
+        int             num_fds;        // 0 for the clock
+        uint64_t        overhead[PERF_NUM];
+        unsigned long   every;
+        unsigned long   next;           // NumInstrs to measure next
+        uint32_t        rand;
+
+        // The instruction being measured:
+        int             open;
+        ARMword         pc;
+        unsigned int    cls;
+        uint64_t        start[PERF_NUM];
+        uint64_t        sc_start[PERF_NUM];
+
+        struct perf_acc classes[PERF_CLASSES];
+        struct perf_acc syscalls[PERF_SC_MAX];
+        struct perf_acc *ranges;        // PERF_RANGES of them
+};
+
+static const char *counter_names[PERF_NUM] = {
+        "cycles", "instrs", "br-miss", "L1d-miss"
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Counters
+
+#ifdef __linux__
+static int      open_counter(uint32_t type, uint64_t config, int group)
+{
+        struct perf_event_attr a;
+
+        memset(&a, 0, sizeof(a));
+        a.size = sizeof(a);
+        a.type = type;
+        a.config = config;
+        a.exclude_kernel = 1;
+        a.exclude_hv = 1;
+        a.read_format = PERF_FORMAT_GROUP;
+        // This thread, on any CPU
+        return syscall(SYS_perf_event_open, &a, 0, -1, group, 0);
+}
+#endif
+
+/* Opens what counters the host has, leaving num_fds 0 for none */
+static void     open_counters(struct rix_perf *pf)
+{
+        for (int i = 0; i < PERF_NUM; i++)
+                pf->fd[i] = -1;
+        pf->num_fds = 0;
+#ifdef __linux__
+        static const uint64_t config[PERF_NUM] = {
+                PERF_COUNT_HW_CPU_CYCLES,
+                PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_BRANCH_MISSES,
+                PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        };
+
+        pf->fd[0] = open_counter(PERF_TYPE_HARDWARE, config[0], -1);
+        if (pf->fd[0] < 0)
+                return;
+        pf->num_fds = 1;
+        for (int i = 1; i < PERF_NUM; i++) {
+                pf->fd[i] = open_counter(i == 3 ? PERF_TYPE_HW_CACHE : PERF_TYPE_HARDWARE,
+                                         config[i], pf->fd[0]);
+                if (pf->fd[i] >= 0)
+                        pf->num_fds++;
+        }
+#endif
+}
+
+static void     close_counters(struct rix_perf *pf)
+{
+        for (int i = 0; i < PERF_NUM; i++) {
+                if (pf->fd[i] >= 0)
+                        close(pf->fd[i]);
+                pf->fd[i] = -1;
+        }
+        pf->num_fds = 0;
+}
+
+/* Reads the counters (or the clock, into v[0]) */
+static void     read_counters(struct rix_perf *pf, uint64_t *v)
+{
+        if (pf->num_fds) {
+                uint64_t buf[1 + PERF_NUM];
+                int n = 1;
+
+                if (read(pf->fd[0], buf, sizeof(buf)) < (ssize_t)sizeof(uint64_t))
+                        buf[0] = 0;
+                // Values come in the order the group was opened
+                for (int i = 0; i < PERF_NUM; i++)
+                        v[i] = (pf->fd[i] >= 0 && n <= (int)buf[0]) ? buf[n++] : 0;
+        } else {
+                struct timespec ts;
+
+                clock_gettime(CLOCK_MONOTONIC, &ts);
+                v[0] = (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+        }
+}
+
+/* Finds the least that a measurement of nothing comes to */
+static void     calibrate(struct rix_perf *pf)
+{
+        uint64_t a[PERF_NUM] = { 0 }, b[PERF_NUM] = { 0 };
+
+        for (int i = 0; i < PERF_NUM; i++)
+                pf->overhead[i] = ~0ULL;
+        for (int n = 0; n < PERF_CALIBRATE; n++) {
+                read_counters(pf, a);
+                read_counters(pf, b);
+                for (int i = 0; i < PERF_NUM; i++) {
+                        if (b[i] - a[i] < pf->overhead[i])
+                                pf->overhead[i] = b[i] - a[i];
+                }
+        }
+}
+
+static void     add(struct perf_acc *acc, const uint64_t *start, const uint64_t *end,
+                    const uint64_t *overhead)
+{
+        acc->n++;
+        for (int i = 0; i < PERF_NUM; i++) {
+                uint64_t d = end[i] - start[i];
+
+                acc->v[i] += d > overhead[i] ? d - overhead[i] : 0;
+        }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Measuring
+
+/* Bits 20-27, as the interpreter switches on, with the multiplies and
+ * swaps (which share their data processing ops' values) moved above them.
+ */
+static unsigned int instr_class(ARMword instr)
+{
+        unsigned int cls = (instr >> 20) & 0xff;
+
+        if (cls < 0x20 && (instr & 0xf0) == 0x90)
+                cls |= 0x100;
+        return cls;
+}
+
+static void     class_name(unsigned int cls, char *buf, size_t len)
+{
+        static const char *dp[16] = {
+                "AND", "EOR", "SUB", "RSB", "ADD", "ADC", "SBC", "RSC",
+                "TST", "TEQ", "CMP", "CMN", "ORR", "MOV", "BIC", "MVN"
+        };
+        unsigned int op = (cls >> 1) & 0xf;
+
+        if (cls & 0x100)
+                snprintf(buf, len, "%s", (cls & 0x10) ? "SWP" : (cls & 2) ? "MLA" : "MUL");
+        else if (cls < 0x40 && op >= 8 && op < 12 && !(cls & 1))
+                snprintf(buf, len, "%s", (op & 1) ? "MSR" : "MRS");
+        else if (cls < 0x40)
+                snprintf(buf, len, "%s%s %s", dp[op], (cls & 1) ? "S" : "",
+                         (cls & 0x20) ? "imm" : "reg");
+        else if (cls < 0x80)
+                snprintf(buf, len, "%s%s %s", (cls & 1) ? "LDR" : "STR",
+                         (cls & 4) ? "B" : "", (cls & 0x20) ? "reg" : "imm");
+        else if (cls < 0xa0)
+                snprintf(buf, len, "%s", (cls & 1) ? "LDM" : "STM");
+        else if (cls < 0xb0)
+                snprintf(buf, len, "B");
+        else if (cls < 0xc0)
+                snprintf(buf, len, "BL");
+        else if (cls < 0xe0)
+                snprintf(buf, len, "%s", (cls & 1) ? "LDC" : "STC");
+        else if (cls < 0xf0)
+                snprintf(buf, len, "CDP/MRC/MCR");
+        else
+                snprintf(buf, len, "SWI");
+}
+
+/* The next instruction to measure, about every'th on average */
+static void     pick_next(struct rix_perf *pf, unsigned long now)
+{
+        pf->rand ^= pf->rand << 13;
+        pf->rand ^= pf->rand >> 17;
+        pf->rand ^= pf->rand << 5;
+        pf->next = now + 1 + (pf->every > 1 ? pf->rand % (2 * pf->every - 1) : 0);
+}
+
+/* From ARMulator, once state->PerfNext instructions have run, with instr
+ * at pc the next to run.
+ */
+void    ARMul_PerfSample(ARMul_State *state, ARMword pc, ARMword instr)
+{
+        struct rix_perf *pf = PROC(state)->perf;
+        uint64_t now[PERF_NUM] = { 0 };
+
+        if (!pf) {
+                state->PerfNext = ~0UL;
+                return;
+        }
+        if (pf->open) {
+                read_counters(pf, now);
+                add(&pf->classes[pf->cls], pf->start, now, pf->overhead);
+                add(&pf->ranges[(pf->pc & R15PCBITS) >> PERF_RANGE_SHIFT],
+                    pf->start, now, pf->overhead);
+                pf->open = 0;
+        }
+        if (state->NumInstrs < pf->next) {
+                state->PerfNext = pf->next;
+                return;
+        }
+        pick_next(pf, state->NumInstrs);
+        // To end this one's measurement:
+        state->PerfNext = state->NumInstrs + 1;
+        pf->open = 1;
+        pf->pc = pc;
+        pf->cls = instr_class(instr);
+        read_counters(pf, pf->start);
+}
+
+void    perf_sc_enter(ARMul_State *state)
+{
+        struct rix_perf *pf = PROC(state)->perf;
+
+        if (pf)
+                read_counters(pf, pf->sc_start);
+}
+
+void    perf_sc_exit(ARMul_State *state, unsigned int scnum)
+{
+        struct rix_perf *pf = PROC(state)->perf;
+        uint64_t now[PERF_NUM] = { 0 };
+
+        if (!pf)
+                return;
+        read_counters(pf, now);
+        add(&pf->syscalls[scnum < PERF_SC_MAX ? scnum : 0], pf->sc_start, now, pf->overhead);
+}
+
+/* Measures the host cost of one guest instruction in about every (in the
+ * interpreter), for perf_dump() to print.
+ */
+int     rix_proc_perf(struct rix_proc *p, unsigned long every)
+{
+        struct rix_perf *pf = calloc(1, sizeof(*pf));
+
+        if (!pf)
+                return -1;
+        pf->ranges = calloc(PERF_RANGES, sizeof(*pf->ranges));
+        if (!pf->ranges) {
+                free(pf);
+                return -1;
+        }
+        pf->every = every ? every : 1;
+        pf->rand = 2463534242u;
+        open_counters(pf);
+        calibrate(pf);
+        p->perf = pf;
+        // The block cache and JIT run many instructions at once
+        ARMul_BlockExit(p->state);
+        pick_next(pf, p->state->NumInstrs);
+        p->state->PerfNext = pf->next;
+        p->state->NextEvent = 0;
+        return 0;
+}
+
+/* A forked child measures for itself, from here */
+void    perf_forked(struct rix_proc *p)
+{
+        struct rix_perf *pf = p->perf;
+
+        if (!pf)
+                return;
+        // The counters count the parent's thread
+        close_counters(pf);
+        open_counters(pf);
+        calibrate(pf);
+        pf->open = 0;
+        // Ending the fork() it's in
+        read_counters(pf, pf->sc_start);
+        memset(pf->classes, 0, sizeof(pf->classes));
+        memset(pf->syscalls, 0, sizeof(pf->syscalls));
+        memset(pf->ranges, 0, PERF_RANGES * sizeof(*pf->ranges));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Results
+
+struct perf_row {
+        char            name[32];
+        const struct perf_acc *acc;
+};
+
+static int      by_cost(const void *a, const void *b)
+{
+        const struct perf_acc *x = ((const struct perf_row *)a)->acc;
+        const struct perf_acc *y = ((const struct perf_row *)b)->acc;
+
+        return x->v[0] < y->v[0] ? 1 : x->v[0] > y->v[0] ? -1 : 0;
+}
+
+/* Prints rows in order of cost, with each counter's mean per row->acc->n */
+static void     print_rows(struct rix_perf *pf, const char *what, const char *per,
+                           struct perf_row *rows, unsigned int n, unsigned int max)
+{
+        uint64_t total = 0;
+
+        qsort(rows, n, sizeof(*rows), by_cost);
+        for (unsigned int i = 0; i < n; i++)
+                total += rows[i].acc->v[0];
+
+        fprintf(stderr, "%-20s %12s %8s", what, per, "share");
+        for (int i = 0; i < PERF_NUM; i++) {
+                if (pf->num_fds ? pf->fd[i] >= 0 : i == 0)
+                        fprintf(stderr, " %10s", pf->num_fds ? counter_names[i] : "ns");
+        }
+        fprintf(stderr, "  (mean per %s)\n", per);
+        for (unsigned int r = 0; r < n && r < max; r++) {
+                const struct perf_acc *acc = rows[r].acc;
+
+                fprintf(stderr, "%-20s %12" PRIu64 " %7.2f%%", rows[r].name, acc->n,
+                        total ? 100.0 * acc->v[0] / total : 0.0);
+                for (int i = 0; i < PERF_NUM; i++) {
+                        if (pf->num_fds ? pf->fd[i] >= 0 : i == 0)
+                                fprintf(stderr, " %10.2f", (double)acc->v[i] / acc->n);
+                }
+                fprintf(stderr, "\n");
+        }
+}
+
+/* Prints the host cost of the guest instructions measured, by opcode class
+ * and PC range, and of its syscalls.
+ */
+void    perf_dump(struct rix_proc *p)
+{
+        struct rix_perf *pf = p->perf;
+        struct perf_row *rows;
+        unsigned int n = 0;
+        uint64_t measured = 0;
+
+        if (!pf)
+                return;
+        rows = malloc(PERF_RANGES * sizeof(*rows));
+        if (!rows)
+                return;
+
+        // Opcode classes, with those of the same name together
+        struct perf_acc byname[PERF_CLASSES];
+
+        memset(byname, 0, sizeof(byname));
+        for (unsigned int c = 0; c < PERF_CLASSES; c++) {
+                unsigned int i;
+                char name[32];
+
+                if (!pf->classes[c].n)
+                        continue;
+                measured += pf->classes[c].n;
+                class_name(c, name, sizeof(name));
+                for (i = 0; i < n && strcmp(rows[i].name, name); i++)
+                        ;
+                if (i == n) {
+                        strcpy(rows[n].name, name);
+                        rows[n].acc = &byname[n];
+                        n++;
+                }
+                byname[i].n += pf->classes[c].n;
+                for (int j = 0; j < PERF_NUM; j++)
+                        byname[i].v[j] += pf->classes[c].v[j];
+        }
+        fprintf(stderr, "\nrixrun%s: host cost of %" PRIu64 " of %lu guest instructions, "
+                "by %s\n", p->forked ? " (child)" : "", measured, p->state->NumInstrs,
+                pf->num_fds ? "hardware counters" : "clock (no hardware counters)");
+        print_rows(pf, "opcode class", "instr", rows, n, PERF_CLASSES);
+
+        n = 0;
+        for (unsigned int r = 0; r < PERF_RANGES; r++) {
+                if (!pf->ranges[r].n)
+                        continue;
+                snprintf(rows[n].name, sizeof(rows[n].name), "%08x-%08x",
+                         r << PERF_RANGE_SHIFT, ((r + 1) << PERF_RANGE_SHIFT) - 1);
+                rows[n++].acc = &pf->ranges[r];
+        }
+        fprintf(stderr, "\n");
+        print_rows(pf, "guest PC range", "instr", rows, n, PERF_TOP);
+
+        n = 0;
+        for (unsigned int s = 0; s < PERF_SC_MAX; s++) {
+                const char *name = os_sc_name(s);
+
+                if (!pf->syscalls[s].n)
+                        continue;
+                if (name)
+                        snprintf(rows[n].name, sizeof(rows[n].name), "%s", name);
+                else
+                        snprintf(rows[n].name, sizeof(rows[n].name), "%u", s);
+                rows[n++].acc = &pf->syscalls[s];
+        }
+        if (n) {
+                fprintf(stderr, "\n");
+                print_rows(pf, "syscall", "call", rows, n, PERF_SC_MAX);
+        }
+        free(rows);
+}
+
+void    perf_free(struct rix_proc *p)
+{
+        struct rix_perf *pf = p->perf;
+
+        if (!pf)
+                return;
+        p->state->PerfNext = ~0UL;
+        close_counters(pf);
+        free(pf->ranges);
+        free(pf);
+        p->perf = NULL;
+}
@@ -0,0 +1,13 @@
+#ifndef PERF_H
+#define PERF_H
+
+#include "armdefs.h"
+#include "rixrun.h"
+
+void    perf_sc_enter(ARMul_State *state);
+void    perf_sc_exit(ARMul_State *state, unsigned int scnum);
+void    perf_forked(struct rix_proc *p);
+void    perf_dump(struct rix_proc *p);
+void    perf_free(struct rix_proc *p);
+
+#endif
@@ -0,0 +1,244 @@
+/* rixrun guest process instances
+ *
+ * Creating, loading, running and freeing one guest.  Nothing about a
+ * guest is global (here, in os.c, zload.c, hle.c, or the armulator), so
+ * any number of them can exist at once, each run on its own thread.
+ *
+ * Copyright (C) 2022 Matt Evans
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "armdefs.h"
+#include "armemu.h"
+#include "armblock.h"
+#include "armjit.h"
+#include "rixrun.h"
+#include "rix_os.h"
+#include "zload.h"
+#include "hle.h"
+#include "snap.h"
+#include "prof.h"
+#include "perf.h"
+#include "trace.h"
+#include "syms.h"
+#include "flight.h"
+
+/* Call once, before creating any processes */
+void    rix_global_init(void)
+{
+        // The decode tables are shared, and read-only once built
+        ARMul_EmulateInit();
+        // First, as fork handlers' locks are taken in the reverse order
+        // (stdio last, as it's used with the others held):
+        os_global_init();
+        zload_init();
+        flight_init();
+}
+
+/* Call before running processes on several threads (see batch.c) */
+void    rix_global_shared(void)
+{
+        os_set_shared();
+}
+
+/* The guest's 32MB user address space is one reserved VMA, at mem_base.
+ * It starts out as anonymous zero-fill memory (for BSS, heap and stack),
+ * and the loader maps text and data segments over it straight from the
+ * binary and library files (see target_mmap()), copy-on-write.  The rest
+ * of the 26-bit address space above it is reserved PROT_NONE, so a wild
+ * guest pointer faults (see flight.c) rather than scribbling on whatever
+ * the host happened to map next.
+ */
+struct rix_proc *rix_proc_new(char *rixrun_path, int verbose, unsigned int flags)
+{
+        struct rix_proc *p = calloc(1, sizeof(*p));
+        ARMul_State *state;
+
+        if (!p)
+                return NULL;
+        p->verbose = verbose;
+        p->flags = flags;
+        p->pid = getpid();
+        p->cwd = AT_FDCWD;
+        for (int i = 0; i < 3; i++)
+                p->stdfd[i] = i;
+        p->mem_base = mmap(NULL, MEM_SPAN, PROT_NONE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (p->mem_base != MAP_FAILED &&
+            mprotect(p->mem_base, MEM_SIZE, PROT_READ | PROT_WRITE) < 0) {
+                munmap(p->mem_base, MEM_SPAN);
+                p->mem_base = MAP_FAILED;
+        }
+        if (p->mem_base == MAP_FAILED) {
+                perror("Can't reserve guest memory");
+                free(p);
+                return NULL;
+        }
+
+        state = ARMul_NewState();
+        p->state = state;
+        state->OSptr = (unsigned char *)p;
+        state->MemBase = p->mem_base;
+        state->verbose = (verbose == 2);
+        state->bigendSig = LOW;
+        ARMul_CoProInit(state);
+        /* The block cache bypasses the instruction trace, so only use it
+         * when not tracing:
+         */
+        if (!state->verbose && !(flags & RIX_PROC_INTERP))
+                ARMul_BlockInit(state, MEM_SIZE);
+        if (!(flags & RIX_PROC_NOJIT))
+                ARMul_JitInit(state);
+        p->syms = syms_new();
+        os_init(state, rixrun_path, verbose);
+        if (!(flags & RIX_PROC_NOHLE))
+                hle_init(state, verbose);
+        return p;
+}
+
+/* Gives the process its own cwd, which (unlike the host's) isn't shared
+ * with the other processes.  Call before loading.
+ */
+int     rix_proc_chdir(struct rix_proc *p, const char *path)
+{
+        int fd = open(path, O_RDONLY | O_DIRECTORY);
+
+        if (fd < 0)
+                return -1;
+        if (p->cwd >= 0)
+                close(p->cwd);
+        free(p->cwd_path);
+        p->cwd = fd;
+        p->cwd_path = realpath(path, NULL);
+        return 0;
+}
+
+int     rix_proc_load(struct rix_proc *p, char *filename,
+                      int argc, char *argv[], int envc, char *envp[])
+{
+        int r = load_zmagic_binary(p->state, filename, p->verbose, 0,
+                                   argc, argv, envc, envp);
+
+        if (r >= 0 && p->snap)
+                snap_loaded(p, filename);
+        return r;
+}
+
+/* Gives [lo, hi) of guest memory fresh zero-fill pages */
+static int      clear_mem(struct rix_proc *p, addr_t lo, addr_t hi)
+{
+        if (mmap(p->mem_base + lo, hi - lo, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED,
+                 -1, 0) == MAP_FAILED)
+                return -1;
+        ARMul_BlockDiscard(p->state, lo, hi);
+        hle_discard(p->state, lo, hi);
+        prof_discard(p->state, lo, hi);
+        syms_discard(p->state, lo, hi);
+        return 0;
+}
+
+/* Replaces the process' image with another binary, for execve().  If it
+ * can't be loaded, returns <0 (-errno) with the old image left alone, or
+ * >0 if the old image has already gone.
+ *
+ * If the new binary uses the same libraries, their text is kept, with
+ * its decoded (and compiled) blocks and HLE hooks.  Only their data is
+ * refreshed, and the binary loaded after them.
+ */
+int     rix_proc_exec(struct rix_proc *p, char *filename,
+                      int argc, char *argv[], int envc, char *envp[])
+{
+        ARMul_State *state = p->state;
+        addr_t libs_end;
+        int r = check_zmagic_binary(state, filename, &libs_end);
+
+        if (r < 0)
+                return r;
+
+        // It's not the binary a pending snapshot was of
+        snap_free(p);
+        if (libs_end && !(libs_end & (sysconf(_SC_PAGESIZE) - 1))) {
+                if (clear_mem(p, 0, RX_MAP_START_ADDR) < 0 ||
+                    clear_mem(p, libs_end, MEM_SIZE) < 0)
+                        return 1;
+        } else {
+                libs_end = 0;
+                if (clear_mem(p, 0, MEM_SIZE) < 0)
+                        return 1;
+        }
+        for (int i = 0; i < 15; i++)
+                ARMul_SetReg(state, state->Mode, i, 0);
+
+        r = load_zmagic_binary(state, filename, p->verbose, libs_end != 0,
+                               argc, argv, envc, envp);
+        return r < 0 ? 1 : 0;
+}
+
+/* Runs another binary in a process whose guest has exited, as though it
+ * had exec'd it, so that libraries it had loaded (with their decoded and
+ * compiled code) are kept if the new binary uses them too.  Returns as
+ * rix_proc_exec().
+ */
+int     rix_proc_reuse(struct rix_proc *p, char *filename,
+                       int argc, char *argv[], int envc, char *envp[])
+{
+        os_reset(p->state);
+        p->exited = 0;
+        p->exit_status = 0;
+        p->state->NumInstrs = 0;
+        return rix_proc_exec(p, filename, argc, argv, envc, envp);
+}
+
+/* Runs until the guest exits, returning its exit status */
+int     rix_proc_run(struct rix_proc *p)
+{
+        struct rix_proc *prev = flight_enter(p);
+
+        ARMul_DoProg(p->state);
+        flight_leave(prev);
+        return p->exit_status;
+}
+
+void    rix_proc_free(struct rix_proc *p)
+{
+        ARMul_State *state = p->state;
+
+        snap_free(p);
+        prof_free(p);
+        perf_free(p);
+        trace_free(p);
+        syms_free(p->syms);
+        hle_free(state);
+        os_free(state);
+        ARMul_BlockExit(state);
+        ARMul_CoProExit(state);
+        munmap(p->mem_base, MEM_SPAN);
+        if (p->cwd >= 0)
+                close(p->cwd);
+        free(p->cwd_path);
+        free_zmagic_image(p->image);
+        free(state->EventPtr);
+        free(state);
+        free(p);
+}
@@ -0,0 +1,697 @@
+/* rixrun guest profiler
+ *
+ * Samples the guest's PC and call stack, either on a timer of the host
+ * thread's CPU time or every so many guest instructions.  ARMulator calls
+ * ARMul_ProfileSample() between blocks (or instructions, when
+ * interpreting) once state->ProfileNext instructions have run; the timer
+ * sets that (and state->NextEvent) to 0 to take a sample straight away.
+ *
+ * Call stacks come from the APCS frame pointer (r11) chain:  a frame
+ * holds the owning function's saved PC, LR, SP and FP at fp, fp-4, fp-8
+ * and fp-12.  A leaf that hasn't pushed a frame shows up as a PC outside
+ * the function that owns fp, in which case LR is its caller.
+ *
+ * Addresses are named from the text symbols of the binary and its
+ * libraries (see syms.c).  At the end, the stacks are written out folded,
+ * as flamegraph tools take them, and a table of the functions with the
+ * most samples printed.
+ *
+ * Alternatively, every call is counted:  the interpreter reports each BL
+ * to ARMul_ProfileCall() and each MOV, LDR or LDM to the PC (the returns)
+ * to ARMul_ProfileReturn(), and these keep a shadow call stack over a tree
+ * of the distinct paths of calls, each node of which counts its calls and
+ * the instructions run in it.  A return pops back to the frame it returns
+ * to, if any, so those skipped by longjmp() and the like drop out; one to
+ * nowhere on the stack, with LR pointing just after it, is a call through
+ * a pointer.  The results are written out as above, but are exact, and in
+ * instructions.
+ *
+ * Copyright (C) 2022 Matt Evans
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include "armdefs.h"
+#include "armemu.h"
+#include "armblock.h"
+#include "rixrun.h"
+#include "zload.h"
+#include "prof.h"
+#include "syms.h"
+
+#define PROF_MAX_DEPTH  64
+#define PROF_HZ         1000            // Samples per second of CPU time
+#define PROF_EVERY      100000          // Instructions per sample, without a timer
+#define PROF_HASH       4096
+#define PROF_TOP        25
+#define PROF_NAME_LEN   128
+#define PROF_MAX_CALLS  1024            // Depth of the shadow call stack
+
+#if defined(SIGEV_THREAD_ID) && !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+/* A distinct call stack, leaf first, as sampled */
+struct prof_stack {
+        struct prof_stack *next;
+        uint64_t        count;
+        unsigned int    depth;
+        addr_t          pc[];
+};
+
+/* A function, as called by the path of calls to it */
+struct prof_node {
+        struct prof_node *parent;
+        struct prof_node *child;
+        struct prof_node *sibling;
+        addr_t          addr;           // Entry, or 0 for the code that wasn't called
+        uint64_t        calls;
+        uint64_t        instrs;         // Run in it, but not in its callees
+};
+
+struct prof_frame {
+        addr_t          ret;
+        struct prof_node *node;
+};
+
+/* A count by name:  a folded stack's, or a function's for the table */
+struct prof_count {
+        struct prof_count *next;
+        uint64_t        self;
+        uint64_t        total;
+        uint64_t        calls;
+        char            name[];
+};
+
+struct rix_prof {
+        char            *file;
+        unsigned long   every;          // Instructions per sample, or 0 for the timer
+        int             timer_on;
+        timer_t         timer;
+        uint64_t        samples;        // Or instructions, counting calls
+
+        struct rix_syms *syms;          // The process's, see syms.c
+
+        struct prof_stack *stacks[PROF_HASH];   // Not yet named
+
+        // Counting calls:
+        ARMul_State     *state;
+        int             calls;
+        unsigned long   last;           // NumInstrs at the last call or return
+        struct prof_node *root;
+        struct prof_frame frames[PROF_MAX_CALLS];
+        unsigned int    depth;
+
+        struct prof_count *folded[PROF_HASH];
+        struct prof_count *funcs[PROF_HASH];
+};
+
+static uint32_t hash(const void *p, size_t len)
+{
+        const uint8_t *b = p;
+        uint32_t h = 2166136261u;
+
+        while (len--)
+                h = (h ^ *b++) * 16777619u;
+        return h;
+}
+
+static uint32_t *word(ARMul_State *state, addr_t a)
+{
+        return (uint32_t *)(state->MemBase + a);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Sampling
+
+static void     add_stack(struct rix_prof *pr, const addr_t *pc, unsigned int depth)
+{
+        struct prof_stack **h = &pr->stacks[hash(pc, depth * sizeof(*pc)) % PROF_HASH];
+        struct prof_stack *s;
+
+        for (s = *h; s; s = s->next) {
+                if (s->depth == depth && !memcmp(s->pc, pc, depth * sizeof(*pc))) {
+                        s->count++;
+                        return;
+                }
+        }
+        s = malloc(sizeof(*s) + depth * sizeof(*pc));
+        if (!s)
+                return;
+        s->count = 1;
+        s->depth = depth;
+        memcpy(s->pc, pc, depth * sizeof(*pc));
+        s->next = *h;
+        *h = s;
+}
+
+/* Whether fp looks like a frame:  its saved PC has to be in some text */
+static int      frame_ok(ARMul_State *state, struct rix_prof *pr, addr_t fp)
+{
+        return !(fp & 3) && fp >= RX_MAP_START_ADDR + 12 && fp < MEM_SIZE &&
+                syms_obj(pr->syms, *word(state, fp) & R15PCBITS);
+}
+
+/* From ARMulator, once state->ProfileNext instructions have run, with pc
+ * the next to run.
+ */
+void    ARMul_ProfileSample(ARMul_State *state, ARMword pc)
+{
+        struct rix_prof *pr = PROC(state)->prof;
+        addr_t stack[PROF_MAX_DEPTH];
+        unsigned int n = 0;
+        addr_t fp;
+
+        if (!pr) {
+                state->ProfileNext = ~0UL;
+                return;
+        }
+        state->ProfileNext = pr->every ? state->NumInstrs + pr->every : ~0UL;
+        pr->samples++;
+
+        stack[n++] = pc & R15PCBITS;
+        fp = ARMul_GetReg(state, state->Mode, 11);
+        if (frame_ok(state, pr, fp)) {
+                addr_t owner = (*word(state, fp) & R15PCBITS) - 12;
+                addr_t lr = ARMul_GetReg(state, state->Mode, 14) & R15PCBITS;
+
+                if (syms_find(pr->syms, stack[0]) != syms_find(pr->syms, owner) && syms_obj(pr->syms, lr))
+                        stack[n++] = lr;
+        }
+        while (n < PROF_MAX_DEPTH && frame_ok(state, pr, fp)) {
+                addr_t ret = *word(state, fp - 4) & R15PCBITS;
+                addr_t next = *word(state, fp - 12);
+
+                // The outermost frame returns nowhere
+                if (!syms_obj(pr->syms, ret))
+                        break;
+                stack[n++] = ret;
+                if (next <= fp)
+                        break;
+                fp = next;
+        }
+        add_stack(pr, stack, n);
+}
+
+static void     prof_tick(int sig, siginfo_t *si, void *uc)
+{
+        ARMul_State *state = si->si_value.sival_ptr;
+
+        if (state) {
+                state->ProfileNext = 0;
+                state->NextEvent = 0;
+        }
+}
+
+/* Samples on a timer of this thread's CPU time, if the host has one, else
+ * every PROF_EVERY instructions.
+ */
+static void     start_timer(struct rix_proc *p)
+{
+        struct rix_prof *pr = p->prof;
+
+#ifdef SIGEV_THREAD_ID
+        struct sigaction sa = { .sa_sigaction = prof_tick, .sa_flags = SA_SIGINFO | SA_RESTART };
+        struct sigevent sev = {
+                .sigev_notify = SIGEV_THREAD_ID,
+                .sigev_signo = SIGPROF,
+                .sigev_value.sival_ptr = p->state,
+        };
+        struct itimerspec its = {
+                .it_interval.tv_nsec = 1000000000 / PROF_HZ,
+                .it_value.tv_nsec = 1000000000 / PROF_HZ,
+        };
+
+        sev.sigev_notify_thread_id = syscall(SYS_gettid);
+        sigemptyset(&sa.sa_mask);
+        if (sigaction(SIGPROF, &sa, NULL) == 0 &&
+            timer_create(CLOCK_THREAD_CPUTIME_ID, &sev, &pr->timer) == 0) {
+                if (timer_settime(pr->timer, 0, &its, NULL) == 0) {
+                        pr->timer_on = 1;
+                        return;
+                }
+                timer_delete(pr->timer);
+        }
+#endif
+        pr->every = PROF_EVERY;
+        p->state->ProfileNext = p->state->NumInstrs + pr->every;
+        p->state->NextEvent = 0;
+}
+
+static void     stop_timer(struct rix_prof *pr)
+{
+        if (pr->timer_on)
+                timer_delete(pr->timer);
+        pr->timer_on = 0;
+}
+
+/* Profiles the guest, sampling every so many instructions (or, if 0, on
+ * a timer), for prof_dump() to write to file.  Call before loading the
+ * binary, so that its symbols are read.
+ */
+int     rix_proc_profile(struct rix_proc *p, const char *file, unsigned long every)
+{
+        struct rix_prof *pr = calloc(1, sizeof(*pr));
+
+        if (!pr)
+                return -1;
+        pr->file = strdup(file);
+        pr->syms = p->syms;
+        pr->every = every;
+        p->prof = pr;
+        if (every) {
+                p->state->ProfileNext = p->state->NumInstrs + every;
+                p->state->NextEvent = 0;
+        } else
+                start_timer(p);
+        return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Counting calls
+
+static struct prof_node *new_node(struct prof_node *parent, addr_t addr)
+{
+        struct prof_node *n = calloc(1, sizeof(*n));
+
+        if (!n)
+                return NULL;
+        n->parent = parent;
+        n->addr = addr;
+        if (parent) {
+                n->sibling = parent->child;
+                parent->child = n;
+        }
+        return n;
+}
+
+static void     free_nodes(struct prof_node *n)
+{
+        struct prof_node *c, *next;
+
+        for (c = n->child; c; c = next) {
+                next = c->sibling;
+                free_nodes(c);
+        }
+        free(n);
+}
+
+static struct prof_node *cur_node(struct rix_prof *pr)
+{
+        return pr->depth ? pr->frames[pr->depth - 1].node : pr->root;
+}
+
+/* Charges the instructions run since the last call or return to the
+ * function running them.
+ */
+static void     charge(struct rix_prof *pr)
+{
+        cur_node(pr)->instrs += pr->state->NumInstrs - pr->last;
+        pr->last = pr->state->NumInstrs;
+}
+
+static void     push_call(struct rix_prof *pr, addr_t pc, addr_t to)
+{
+        struct prof_node *parent = cur_node(pr), *n;
+
+        // Too deep, so it's charged to its caller
+        if (pr->depth == PROF_MAX_CALLS)
+                return;
+        // What wasn't called is named after where it first calls from
+        if (!pr->depth && !pr->root->addr)
+                pr->root->addr = pc;
+        for (n = parent->child; n && n->addr != to; n = n->sibling)
+                ;
+        if (!n && !(n = new_node(parent, to)))
+                return;
+        n->calls++;
+        pr->frames[pr->depth].ret = pc + 4;
+        pr->frames[pr->depth].node = n;
+        pr->depth++;
+}
+
+/* From ARMulator, when counting calls:  the BL at pc calls to */
+void    ARMul_ProfileCall(ARMul_State *state, ARMword pc, ARMword to)
+{
+        struct rix_prof *pr = PROC(state)->prof;
+
+        charge(pr);
+        push_call(pr, pc, to);
+}
+
+/* ... and the MOV, LDR or LDM at pc has jumped to, probably returning there */
+void    ARMul_ProfileReturn(ARMul_State *state, ARMword pc, ARMword to)
+{
+        struct rix_prof *pr = PROC(state)->prof;
+        addr_t lr;
+
+        charge(pr);
+        for (unsigned int i = pr->depth; i > 0; i--) {
+                if (pr->frames[i - 1].ret == to) {
+                        pr->depth = i - 1;
+                        return;
+                }
+        }
+        lr = ARMul_GetReg(state, state->Mode, 14) & R15PCBITS;
+        if (lr == pc + 4)
+                push_call(pr, pc, to);
+}
+
+static void     reset_calls(struct rix_prof *pr)
+{
+        if (pr->root)
+                free_nodes(pr->root);
+        pr->root = new_node(NULL, 0);
+        pr->depth = 0;
+        pr->last = pr->state->NumInstrs;
+}
+
+/* Profiles the guest by counting every call (in the interpreter), for
+ * prof_dump() to write to file.  Call before loading the binary.
+ */
+int     rix_proc_profile_calls(struct rix_proc *p, const char *file)
+{
+        struct rix_prof *pr = calloc(1, sizeof(*pr));
+
+        if (!pr)
+                return -1;
+        pr->file = strdup(file);
+        pr->syms = p->syms;
+        pr->state = p->state;
+        pr->calls = 1;
+        reset_calls(pr);
+        if (!pr->root) {
+                free(pr->file);
+                free(pr);
+                return -1;
+        }
+        p->prof = pr;
+        // The block cache and JIT don't see calls
+        ARMul_BlockExit(p->state);
+        p->state->ProfileCalls = 1;
+        return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Results
+
+static struct prof_count *count(struct prof_count **tab, const char *name)
+{
+        struct prof_count **h = &tab[hash(name, strlen(name)) % PROF_HASH];
+        struct prof_count *c;
+
+        for (c = *h; c; c = c->next) {
+                if (!strcmp(c->name, name))
+                        return c;
+        }
+        c = calloc(1, sizeof(*c) + strlen(name) + 1);
+        if (!c)
+                return NULL;
+        strcpy(c->name, name);
+        c->next = *h;
+        *h = c;
+        return c;
+}
+
+/* Adds the counts of n, with names[] naming its callers, to the folded
+ * stacks and functions, returning the instructions run in or under it.
+ */
+static uint64_t fold_node(struct rix_prof *pr, struct prof_node *n,
+                          char (*names)[PROF_NAME_LEN], unsigned int d, char *line)
+{
+        uint64_t total = n->instrs;
+        struct prof_count *c;
+        unsigned int j;
+
+        if (n->addr)
+                syms_name(pr->syms, n->addr, names[d], PROF_NAME_LEN);
+        else
+                snprintf(names[d], PROF_NAME_LEN, "[unknown]");
+        for (struct prof_node *k = n->child; k; k = k->sibling)
+                total += fold_node(pr, k, names, d + 1, line);
+
+        if (n->instrs) {
+                char *l = line;
+
+                for (unsigned int i = 0; i <= d; i++)
+                        l += sprintf(l, "%s%s", names[i], i < d ? ";" : "");
+                if ((c = count(pr->folded, line)))
+                        c->self += n->instrs;
+        }
+        if ((total || n->calls) && (c = count(pr->funcs, names[d]))) {
+                c->self += n->instrs;
+                c->calls += n->calls;
+                // Recursion counts once
+                for (j = 0; j < d && strcmp(names[j], names[d]); j++)
+                        ;
+                if (j == d)
+                        c->total += total;
+        }
+        n->instrs = 0;
+        n->calls = 0;
+        return total;
+}
+
+/* Names the calls counted so far, as fold() does the stacks sampled */
+static void     fold_calls(struct rix_prof *pr)
+{
+        char (*names)[PROF_NAME_LEN] = malloc((PROF_MAX_CALLS + 1) * PROF_NAME_LEN);
+        char *line = malloc((PROF_MAX_CALLS + 1) * PROF_NAME_LEN);
+
+        if (names && line) {
+                charge(pr);
+                pr->samples += fold_node(pr, pr->root, names, 0, line);
+        }
+        free(line);
+        free(names);
+}
+
+/* Names the stacks sampled so far, while their addresses still mean what
+ * they did when sampled, adding them to the folded stacks and functions.
+ */
+static void     fold(struct rix_prof *pr)
+{
+        if (pr->calls) {
+                fold_calls(pr);
+                return;
+        }
+        char names[PROF_MAX_DEPTH][PROF_NAME_LEN];
+        char line[PROF_MAX_DEPTH * PROF_NAME_LEN];
+
+        for (int h = 0; h < PROF_HASH; h++) {
+                struct prof_stack *s, *next;
+
+                for (s = pr->stacks[h]; s; s = next) {
+                        struct prof_count *c;
+                        char *l = line;
+
+                        next = s->next;
+                        // Return addresses are named by their call
+                        for (unsigned int i = 0; i < s->depth; i++)
+                                syms_name(pr->syms, i ? s->pc[i] - 4 : s->pc[i], names[i], PROF_NAME_LEN);
+                        for (int i = s->depth - 1; i >= 0; i--)
+                                l += sprintf(l, "%s%s", names[i], i ? ";" : "");
+                        if ((c = count(pr->folded, line)))
+                                c->self += s->count;
+                        if ((c = count(pr->funcs, names[0])))
+                                c->self += s->count;
+                        for (unsigned int i = 0; i < s->depth; i++) {
+                                unsigned int j;
+
+                                // Recursion counts once
+                                for (j = 0; j < i && strcmp(names[j], names[i]); j++)
+                                        ;
+                                if (j == i && (c = count(pr->funcs, names[i])))
+                                        c->total += s->count;
+                        }
+                        free(s);
+                }
+                pr->stacks[h] = NULL;
+        }
+}
+
+/* From clear_mem():  [lo, hi) no longer holds what it did */
+void    prof_discard(ARMul_State *state, addr_t lo, addr_t hi)
+{
+        struct rix_prof *pr = PROC(state)->prof;
+
+        if (!pr)
+                return;
+        // Name what's been sampled while its symbols are still there
+        fold(pr);
+        // A new program starts with nothing called
+        if (pr->calls)
+                reset_calls(pr);
+}
+
+static void     free_counts(struct prof_count **tab)
+{
+        for (int h = 0; h < PROF_HASH; h++) {
+                struct prof_count *c, *next;
+
+                for (c = tab[h]; c; c = next) {
+                        next = c->next;
+                        free(c);
+                }
+                tab[h] = NULL;
+        }
+}
+
+/* A forked child has a profile of its own, from here */
+void    prof_forked(struct rix_proc *p)
+{
+        struct rix_prof *pr = p->prof;
+
+        if (!pr)
+                return;
+        fold(pr);
+        free_counts(pr->folded);
+        free_counts(pr->funcs);
+        pr->samples = 0;
+        // Timers aren't inherited
+        pr->timer_on = 0;
+        if (!pr->every && !pr->calls)
+                start_timer(p);
+}
+
+static struct prof_count **sorted(struct prof_count **tab, unsigned int *num,
+                                  int (*cmp)(const void *, const void *))
+{
+        struct prof_count **v = NULL;
+        unsigned int n = 0, max = 0;
+
+        for (int h = 0; h < PROF_HASH; h++) {
+                for (struct prof_count *c = tab[h]; c; c = c->next) {
+                        if (n == max) {
+                                struct prof_count **nv;
+
+                                max = max ? 2 * max : 256;
+                                nv = realloc(v, max * sizeof(*v));
+                                if (!nv)
+                                        break;
+                                v = nv;
+                        }
+                        v[n++] = c;
+                }
+        }
+        if (n)
+                qsort(v, n, sizeof(*v), cmp);
+        *num = n;
+        return v;
+}
+
+static int      by_name(const void *a, const void *b)
+{
+        return strcmp((*(struct prof_count **)a)->name, (*(struct prof_count **)b)->name);
+}
+
+static int      by_self(const void *a, const void *b)
+{
+        const struct prof_count *x = *(struct prof_count **)a, *y = *(struct prof_count **)b;
+
+        if (x->self != y->self)
+                return x->self < y->self ? 1 : -1;
+        return x->total < y->total ? 1 : x->total > y->total ? -1 : 0;
+}
+
+/* Writes the folded stacks to the profile's file (with the pid appended,
+ * for a forked child), and the top functions to stderr.
+ */
+void    prof_dump(struct rix_proc *p)
+{
+        struct rix_prof *pr = p->prof;
+        struct prof_count **v;
+        char path[PATH_MAX];
+        unsigned int n;
+        FILE *f;
+
+        if (!pr)
+                return;
+        fold(pr);
+        if (p->forked)
+                snprintf(path, sizeof(path), "%s.%d", pr->file, (int)p->pid);
+        else
+                snprintf(path, sizeof(path), "%s", pr->file);
+
+        f = fopen(path, "w");
+        if (!f) {
+                perror(path);
+                return;
+        }
+        v = sorted(pr->folded, &n, by_name);
+        for (unsigned int i = 0; i < n; i++)
+                fprintf(f, "%s %" PRIu64 "\n", v[i]->name, v[i]->self);
+        free(v);
+        fclose(f);
+
+        v = sorted(pr->funcs, &n, by_self);
+        if (pr->calls) {
+                fprintf(stderr, "\nrixrun: %" PRIu64 " instructions counted by call, "
+                        "folded stacks in %s\n", pr->samples, path);
+                fprintf(stderr, "%7s %7s %10s %12s %12s  %s\n", "self%", "total%",
+                        "calls", "self", "total", "function");
+                for (unsigned int i = 0; i < n && i < PROF_TOP; i++) {
+                        fprintf(stderr, "%6.2f%% %6.2f%% %10" PRIu64 " %12" PRIu64
+                                " %12" PRIu64 "  %s\n",
+                                100.0 * v[i]->self / pr->samples,
+                                100.0 * v[i]->total / pr->samples,
+                                v[i]->calls, v[i]->self, v[i]->total, v[i]->name);
+                }
+                free(v);
+                return;
+        }
+        if (pr->every)
+                fprintf(stderr, "\nrixrun: %" PRIu64 " samples (every %lu instructions)",
+                        pr->samples, pr->every);
+        else
+                fprintf(stderr, "\nrixrun: %" PRIu64 " samples (%d/s of CPU time)",
+                        pr->samples, PROF_HZ);
+        fprintf(stderr, ", folded stacks in %s\n", path);
+        fprintf(stderr, "%7s %7s %9s  %s\n", "self%", "total%", "samples", "function");
+        for (unsigned int i = 0; i < n && i < PROF_TOP; i++) {
+                fprintf(stderr, "%6.2f%% %6.2f%% %9" PRIu64 "  %s\n",
+                        100.0 * v[i]->self / pr->samples, 100.0 * v[i]->total / pr->samples,
+                        v[i]->self, v[i]->name);
+        }
+        free(v);
+}
+
+void    prof_free(struct rix_proc *p)
+{
+        struct rix_prof *pr = p->prof;
+
+        if (!pr)
+                return;
+        stop_timer(pr);
+        p->state->ProfileNext = ~0UL;
+        p->state->ProfileCalls = 0;
+        fold(pr);
+        if (pr->root)
+                free_nodes(pr->root);
+        free_counts(pr->folded);
+        free_counts(pr->funcs);
+        free(pr->file);
+        free(pr);
+        p->prof = NULL;
+}
@@ -0,0 +1,12 @@
+#ifndef PROF_H
+#define PROF_H
+
+#include "armdefs.h"
+#include "rixrun.h"
+
+void    prof_discard(ARMul_State *state, addr_t lo, addr_t hi);
+void    prof_forked(struct rix_proc *p);
+void    prof_dump(struct rix_proc *p);
+void    prof_free(struct rix_proc *p);
+
+#endif
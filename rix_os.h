@@ -2,9 +2,22 @@
 #define RIX_OS_H
 
 #include <inttypes.h>
+#include <stdio.h>
 #include "armdefs.h"
 
+void    os_global_init(void);
+void    os_set_shared(void);
 void    os_init(ARMul_State *state, char *me_realpath, int verbose);
+void    os_reset(ARMul_State *state);
+void    os_free(ARMul_State *state);
+void    os_forked(ARMul_State *state);
+void    os_fault(ARMul_State *state, int sig, const char *format, ...);
+void    os_sc_stats_dump(ARMul_State *state, int json);
+int     os_sc_number(const char *name);
+const char *os_sc_name(int n);
+int     os_snap_write(ARMul_State *state, FILE *f);
+struct os_snap *os_snap_read(ARMul_State *state, FILE *f);
+int     os_snap_restore(ARMul_State *state, struct os_snap *s);
 
 /* RISCiX syscall interface structures/definitions */
 
@@ -5,13 +5,79 @@
 
 // Config
 #define MEM_SIZE        32*1024*1024
+#define MEM_SPAN        0x04000000      // All 26 bits' worth reserved, MEM_SIZE usable
 
 // Globals/types:
-extern uint8_t          *mem_base;
 typedef uint32_t        addr_t;
 
+/* One guest process.  There are no globals: everything about a guest
+ * hangs off here, and its ARMul_State's OSptr points back to it, so
+ * several can run in one host process (each on its own thread).
+ */
+struct rix_proc {
+        ARMul_State     *state;
+        uint8_t         *mem_base;      // MEM_SIZE of guest memory (also state->MemBase)
+        int             verbose;        // 0, 1, 2
+        unsigned int    flags;          // RIX_PROC_*
+        int             forked;         // A host process of its own, from guest fork()
+        int             exited;
+        int             exit_status;
+        int             pid;            // What getpid() says
+        int             cwd;            // Dir fd guest paths are relative to, or AT_FDCWD
+        char            *cwd_path;      // ... and its name (NULL for the host's cwd)
+        int             stdfd[3];       // Host fds for guest stdin/stdout/stderr
+        struct rix_os   *os;            // See os.c
+        struct rix_hle  *hle;           // See hle.c
+        struct rix_image *image;        // What's loaded, see zload.c
+        struct rix_snap *snap;          // Snapshot to take, see snap.c
+        addr_t          arg_space;      // Room to leave for args at the stack top
+        struct rix_prof *prof;          // Profile being taken, see prof.c
+        struct rix_perf *perf;          // Host counters, see perf.c
+        struct rix_trace *trace;        // Instruction trace, see trace.c
+        struct rix_syms *syms;          // Guest symbols, see syms.c
+        int             scstats;        // Dump syscall stats at exit: 1, or 2 as JSON
+};
+
+#define PROC(state)     ((struct rix_proc *)(state)->OSptr)
+
+// Flags for rix_proc_new():
+#define RIX_PROC_INTERP 1               // No block cache (or JIT)
+#define RIX_PROC_NOJIT  2               // Block cache, but no JIT
+#define RIX_PROC_NOHLE  4               // Emulate libc's memcpy() etc.
+
 ////////////////////////////////////////////////////////////////////////////////
 
+void    rix_global_init(void);
+void    rix_global_shared(void);
+struct rix_proc *rix_proc_new(char *rixrun_path, int verbose, unsigned int flags);
+int     rix_proc_chdir(struct rix_proc *p, const char *path);
+int     rix_proc_load(struct rix_proc *p, char *filename,
+                      int argc, char *argv[], int envc, char *envp[]);
+int     rix_proc_exec(struct rix_proc *p, char *filename,
+                      int argc, char *argv[], int envc, char *envp[]);
+int     rix_proc_reuse(struct rix_proc *p, char *filename,
+                       int argc, char *argv[], int envc, char *envp[]);
+int     rix_proc_run(struct rix_proc *p);
+void    rix_proc_free(struct rix_proc *p);
+
+int     rix_proc_snapshot_at(struct rix_proc *p, const char *file, const char *when);
+int     rix_proc_restore(struct rix_proc *p, const char *file, char *filename,
+                         int argc, char *argv[], int envc, char *envp[]);
+
+int     rix_proc_profile(struct rix_proc *p, const char *file, unsigned long every);
+int     rix_proc_profile_calls(struct rix_proc *p, const char *file);
+int     rix_proc_perf(struct rix_proc *p, unsigned long every);
+int     rix_proc_trace(struct rix_proc *p, const char *file, int regs);
+
+int     rix_batch(char *rixrun_path, int verbose, unsigned int flags,
+                  int argc, char *argv[], int envc, char *envp[]);
+
+int     rix_serve(char *rixrun_path, int verbose, unsigned int flags, const char *when,
+                  int argc, char *argv[], int envc, char *envp[]);
+int     rix_daemon(char *rixrun_path, int verbose, unsigned int flags,
+                   int argc, char *argv[]);
+int     rix_client(const char *sock, int argc, char *argv[], int envc, char *envp[]);
+
 void    dump_state(ARMul_State *state);
 
 #endif
@@ -0,0 +1,331 @@
+/* rixtrace, a decoder for rixrun's binary instruction traces
+ *
+ * Reads a trace written with RIX_TRACE (see trace.h) and prints it as
+ * text, an instruction per line, disassembled.  If the trace has register
+ * changes (RIX_TRACE_REGS), each line also gives the registers the
+ * instruction changed, and the address a load or store accessed (worked
+ * out from the registers it started with).
+ *
+ * Copyright (C) 2022 Matt Evans
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "trace.h"
+
+#define R15PCBITS       0x03fffffc
+
+static const char *reg_names[16] = {
+        "r0", "r1", "r2", "r3", "r4", "r5", "r6", "r7",
+        "r8", "r9", "r10", "fp", "ip", "sp", "lr", "pc"
+};
+
+static const char *conds[16] = {
+        "eq", "ne", "cs", "cc", "mi", "pl", "vs", "vc",
+        "hi", "ls", "ge", "lt", "gt", "le", "", "nv"
+};
+
+static const char *dp_ops[16] = {
+        "and", "eor", "sub", "rsb", "add", "adc", "sbc", "rsc",
+        "tst", "teq", "cmp", "cmn", "orr", "mov", "bic", "mvn"
+};
+
+static const char *shifts[4] = { "lsl", "lsr", "asr", "ror" };
+
+static uint32_t ror(uint32_t v, unsigned int n)
+{
+        n &= 31;
+        return n ? (v >> n) | (v << (32 - n)) : v;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Disassembly
+
+/* Operand 2 of a data processing instruction, as text */
+static int      operand2(char *b, uint32_t instr)
+{
+        unsigned int rm = instr & 0xf, amount = (instr >> 7) & 0x1f, type = (instr >> 5) & 3;
+
+        if (instr & (1 << 25))
+                return sprintf(b, "#0x%x", ror(instr & 0xff, 2 * ((instr >> 8) & 0xf)));
+        if (instr & (1 << 4))
+                return sprintf(b, "%s, %s %s", reg_names[rm], shifts[type],
+                               reg_names[(instr >> 8) & 0xf]);
+        if (type == 3 && !amount)
+                return sprintf(b, "%s, rrx", reg_names[rm]);
+        if (!amount && type == 0)
+                return sprintf(b, "%s", reg_names[rm]);
+        return sprintf(b, "%s, %s #%u", reg_names[rm], shifts[type], amount ? amount : 32);
+}
+
+static void     reg_list(char *b, uint32_t instr)
+{
+        int first = 1;
+
+        b += sprintf(b, "{");
+        for (int i = 0; i < 16; i++) {
+                if (!(instr & (1 << i)))
+                        continue;
+                b += sprintf(b, "%s%s", first ? "" : ", ", reg_names[i]);
+                first = 0;
+        }
+        sprintf(b, "}");
+}
+
+static void     disassemble(char *b, uint32_t pc, uint32_t instr)
+{
+        const char *cc = conds[instr >> 28];
+        unsigned int rd = (instr >> 12) & 0xf, rn = (instr >> 16) & 0xf;
+        unsigned int op = (instr >> 21) & 0xf;
+        char o2[64];
+
+        switch ((instr >> 25) & 7) {
+        case 0:
+        case 1:
+                if ((instr & 0x0fc000f0) == 0x00000090) {
+                        if (instr & (1 << 21))
+                                sprintf(b, "mla%s%s %s, %s, %s, %s", cc, (instr & (1 << 20)) ? "s" : "",
+                                        reg_names[rn], reg_names[instr & 0xf],
+                                        reg_names[(instr >> 8) & 0xf], reg_names[rd]);
+                        else
+                                sprintf(b, "mul%s%s %s, %s, %s", cc, (instr & (1 << 20)) ? "s" : "",
+                                        reg_names[rn], reg_names[instr & 0xf],
+                                        reg_names[(instr >> 8) & 0xf]);
+                        return;
+                }
+                if ((instr & 0x0fb00ff0) == 0x01000090) {
+                        sprintf(b, "swp%s%s %s, %s, [%s]", cc, (instr & (1 << 22)) ? "b" : "",
+                                reg_names[rd], reg_names[instr & 0xf], reg_names[rn]);
+                        return;
+                }
+                operand2(o2, instr);
+                if (op >= 8 && op < 12 && !(instr & (1 << 20)))
+                        sprintf(b, "%s%s (psr) %s", (op & 1) ? "msr" : "mrs", cc, o2);
+                else if (op == 13 || op == 15)
+                        sprintf(b, "%s%s%s %s, %s", dp_ops[op], cc, (instr & (1 << 20)) ? "s" : "",
+                                reg_names[rd], o2);
+                else if (op >= 8 && op < 12)
+                        sprintf(b, "%s%s%s %s, %s", dp_ops[op], cc, rd == 15 ? "p" : "",
+                                reg_names[rn], o2);
+                else
+                        sprintf(b, "%s%s%s %s, %s, %s", dp_ops[op], cc,
+                                (instr & (1 << 20)) ? "s" : "", reg_names[rd], reg_names[rn], o2);
+                return;
+
+        case 2:
+        case 3: {
+                const char *sign = (instr & (1 << 23)) ? "" : "-";
+                const char *ls = (instr & (1 << 20)) ? "ldr" : "str";
+                const char *byte = (instr & (1 << 22)) ? "b" : "";
+                int pre = instr & (1 << 24), wb = instr & (1 << 21);
+
+                if (instr & (1 << 25)) {
+                        if (instr & (1 << 4)) {
+                                sprintf(b, "undefined");
+                                return;
+                        }
+                        // The same as a data processing instruction's
+                        strcpy(o2, sign);
+                        operand2(o2 + strlen(sign), instr & ~(1 << 25));
+                } else {
+                        sprintf(o2, "#%s0x%x", sign, instr & 0xfff);
+                }
+                if (pre)
+                        sprintf(b, "%s%s%s %s, [%s, %s]%s", ls, cc, byte, reg_names[rd],
+                                reg_names[rn], o2, wb ? "!" : "");
+                else
+                        sprintf(b, "%s%s%s%s %s, [%s], %s", ls, cc, byte, wb ? "t" : "",
+                                reg_names[rd], reg_names[rn], o2);
+                return;
+        }
+
+        case 4: {
+                static const char *modes[4] = { "da", "ia", "db", "ib" };
+
+                reg_list(o2, instr);
+                sprintf(b, "%s%s%s %s%s, %s%s", (instr & (1 << 20)) ? "ldm" : "stm", cc,
+                        modes[(instr >> 23) & 3], reg_names[rn], (instr & (1 << 21)) ? "!" : "",
+                        o2, (instr & (1 << 22)) ? "^" : "");
+                return;
+        }
+
+        case 5: {
+                int32_t off = (int32_t)(instr << 8) >> 6;
+
+                sprintf(b, "b%s%s 0x%x", (instr & (1 << 24)) ? "l" : "", cc,
+                        (pc + 8 + off) & R15PCBITS);
+                return;
+        }
+
+        case 6:
+                sprintf(b, "%s%s p%u, c%u, [%s]", (instr & (1 << 20)) ? "ldc" : "stc", cc,
+                        (instr >> 8) & 0xf, rd, reg_names[rn]);
+                return;
+
+        case 7:
+                if (instr & (1 << 24))
+                        sprintf(b, "swi%s 0x%x", cc, instr & 0xffffff);
+                else if (instr & (1 << 4))
+                        sprintf(b, "%s%s p%u, %u, %s, c%u, c%u", (instr & (1 << 20)) ? "mrc" : "mcr",
+                                cc, (instr >> 8) & 0xf, (instr >> 21) & 7, reg_names[rd], rn,
+                                instr & 0xf);
+                else
+                        sprintf(b, "cdp%s p%u, %u, c%u, c%u, c%u", cc, (instr >> 8) & 0xf,
+                                (instr >> 20) & 0xf, rd, rn, instr & 0xf);
+                return;
+        }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Addresses
+
+static uint32_t reg(const uint32_t *regs, unsigned int r, uint32_t pc)
+{
+        return r == 15 ? pc + 8 : regs[r];
+}
+
+/* The address a load or store accesses (its first, for LDM/STM), given the
+ * registers it starts with, or 0 if it isn't one.
+ */
+static int      address(const uint32_t *regs, uint32_t pc, uint32_t instr, uint32_t *addr)
+{
+        uint32_t base = reg(regs, (instr >> 16) & 0xf, pc);
+        int up = instr & (1 << 23), pre = instr & (1 << 24);
+
+        switch ((instr >> 25) & 7) {
+        case 2:
+        case 3: {
+                uint32_t off;
+
+                if (instr & (1 << 25)) {
+                        uint32_t rm = reg(regs, instr & 0xf, pc);
+                        unsigned int amount = (instr >> 7) & 0x1f;
+
+                        switch ((instr >> 5) & 3) {
+                        case 0: off = rm << amount;                                     break;
+                        case 1: off = amount ? rm >> amount : 0;                        break;
+                        case 2: off = (uint32_t)((int32_t)rm >> (amount ? amount : 31)); break;
+                        default:
+                                off = amount ? ror(rm, amount) :
+                                        ((regs[15] & (1u << 29)) << 2) | (rm >> 1);
+                        }
+                } else {
+                        off = instr & 0xfff;
+                }
+                *addr = pre ? (up ? base + off : base - off) : base;
+                return 1;
+        }
+
+        case 4: {
+                unsigned int n = __builtin_popcount(instr & 0xffff);
+
+                if (up)
+                        *addr = pre ? base + 4 : base;
+                else
+                        *addr = pre ? base - 4 * n : base - 4 * n + 4;
+                return 1;
+        }
+
+        default:
+                return 0;
+        }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+static int      read_words(FILE *f, uint32_t *w, unsigned int n)
+{
+        return fread(w, sizeof(*w), n, f) == n;
+}
+
+static void     usage(void)
+{
+        fprintf(stderr, "rixtrace <trace file>\n");
+}
+
+int     main(int argc, char *argv[])
+{
+        struct trace_hdr hdr;
+        uint32_t regs[16] = { 0 };
+        uint32_t rec[2];
+        char line[256] = "", dis[128], changed[16 * 16] = "";
+        uint64_t n = 0;
+        FILE *f;
+
+        if (argc != 2) {
+                usage();
+                return 1;
+        }
+        f = fopen(argv[1], "rb");
+        if (!f) {
+                perror(argv[1]);
+                return 1;
+        }
+        if (fread(&hdr, sizeof(hdr), 1, f) != 1 || hdr.magic != TRACE_MAGIC ||
+            hdr.version != TRACE_VERSION) {
+                fprintf(stderr, "%s: not a rixrun trace\n", argv[1]);
+                return 1;
+        }
+        printf("# pid %d%s\n", hdr.pid, (hdr.flags & TRACE_REGS) ? ", with registers" : "");
+
+        while (read_words(f, rec, 2)) {
+                uint32_t pc = rec[0] & ~3u, instr = rec[1], addr;
+
+                // What's changed is what the previous instruction did
+                if (rec[0] & TRACE_REGS) {
+                        char *l = changed;
+                        uint32_t mask;
+
+                        if (!read_words(f, &mask, 1))
+                                break;
+                        for (int i = 0; i < 16; i++) {
+                                if (!(mask & (1 << i)))
+                                        continue;
+                                if (!read_words(f, &regs[i], 1))
+                                        goto out;
+                                l += sprintf(l, " %s=%08x", i == 15 ? "psr" : reg_names[i],
+                                             regs[i]);
+                        }
+                }
+                if (line[0])
+                        printf("%s%s\n", line, changed);
+                else if (changed[0])
+                        printf("#%s\n", changed);
+                changed[0] = '\0';
+
+                disassemble(dis, pc, instr);
+                if (!(hdr.flags & TRACE_REGS))
+                        snprintf(line, sizeof(line), "%08x  %08x  %s", pc, instr, dis);
+                else if (address(regs, pc, instr, &addr))
+                        snprintf(line, sizeof(line), "%08x  %08x  %-36s @%08x ;", pc, instr,
+                                 dis, addr);
+                else
+                        snprintf(line, sizeof(line), "%08x  %08x  %-36s           ;", pc, instr,
+                                 dis);
+                n++;
+        }
+out:
+        if (line[0])
+                printf("%s\n", line);
+        fclose(f);
+        fprintf(stderr, "%" PRIu64 " instructions\n", n);
+        return 0;
+}
@@ -0,0 +1,421 @@
+/* rixrun fork server
+ *
+ * Loads a binary once, runs it through its library loading (and any more
+ * of it, up to the point a snapshot would be taken:  see snap.c), then
+ * waits on a Unix socket.  Each request is served by forking that process, giving the
+ * child the request's args, environment, cwd and stdio, and letting it
+ * carry on to the end.  The guest's text (and everything else not yet
+ * written) stays shared, copy-on-write, with the server.
+ *
+ * A request is a struct srv_msg, carrying the client's stdin, stdout and
+ * stderr, followed by its cwd, args and environment as NUL-terminated
+ * strings.  The reply is the exit status, or -1 if the request couldn't
+ * be run here (in which case the client runs it itself).  rixrund (see
+ * daemon.c) takes the same requests.
+ *
+ * Copyright (C) 2022 Matt Evans
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "armdefs.h"
+#include "armemu.h"
+#include "rixrun.h"
+#include "rix_os.h"
+#include "zload.h"
+#include "snap.h"
+#include "server.h"
+
+#ifndef MSG_NOSIGNAL            // (A client that's gone is an error, not a signal)
+#define MSG_NOSIGNAL    0
+#endif
+#ifndef SOCK_CLOEXEC
+#define SOCK_CLOEXEC    0
+#endif
+
+#define SRV_MAGIC       0x52535852      // "RXSR"
+#define SRV_MAX_LEN     (1024 * 1024)
+
+struct srv_msg {
+        uint32_t        magic;
+        int32_t         argc;
+        int32_t         envc;
+        uint32_t        len;            // Of the strings that follow
+};
+
+struct server {
+        int             sock;
+        uint64_t        id;             // See zmagic_binary_id()
+        struct zm_args  args;           // Those the guest started with
+};
+
+static int      sock_addr(const char *path, struct sockaddr_un *sa)
+{
+        memset(sa, 0, sizeof(*sa));
+        sa->sun_family = AF_UNIX;
+        if (strlen(path) >= sizeof(sa->sun_path)) {
+                fprintf(stderr, "rixrun: Socket path %s is too long\n", path);
+                return -1;
+        }
+        strcpy(sa->sun_path, path);
+        return 0;
+}
+
+/* Listens on a (new) socket at path, returning it or -1 */
+int     srv_listen(const char *path)
+{
+        struct sockaddr_un sa;
+        int fd;
+
+        if (sock_addr(path, &sa) < 0)
+                return -1;
+        unlink(path);
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0 || bind(fd, (struct sockaddr *)&sa, sizeof(sa)) < 0 ||
+            listen(fd, SOMAXCONN) < 0) {
+                perror(path);
+                if (fd >= 0)
+                        close(fd);
+                return -1;
+        }
+        return fd;
+}
+
+static int      read_all(int fd, void *buf, size_t len)
+{
+        while (len) {
+                ssize_t r = read(fd, buf, len);
+
+                if (r < 0 && errno == EINTR)
+                        continue;
+                if (r <= 0)
+                        return -1;
+                buf = (char *)buf + r;
+                len -= r;
+        }
+        return 0;
+}
+
+/* Splits n NUL-terminated strings from buf into v[] */
+static char    *split_strings(char *buf, char *end, char **v, int n)
+{
+        for (int i = 0; i < n; i++) {
+                char *z = memchr(buf, 0, end - buf);
+
+                if (!z)
+                        return NULL;
+                v[i] = buf;
+                buf = z + 1;
+        }
+        v[n] = NULL;
+        return buf;
+}
+
+/* Receives a request, with its stdio fds.  Returns the strings (cwd,
+ * args, then environment) in a malloc()ed buffer.
+ */
+static char    *recv_msg(int conn, struct srv_msg *req, int fds[3])
+{
+        char cbuf[CMSG_SPACE(3 * sizeof(int))];
+        struct iovec iov = { .iov_base = req, .iov_len = sizeof(*req) };
+        struct msghdr msg = {
+                .msg_iov = &iov,
+                .msg_iovlen = 1,
+                .msg_control = cbuf,
+                .msg_controllen = sizeof(cbuf),
+        };
+        struct cmsghdr *c;
+        char *buf;
+
+        if (recvmsg(conn, &msg, MSG_WAITALL) != sizeof(*req))
+                return NULL;
+        c = CMSG_FIRSTHDR(&msg);
+        if (!c || c->cmsg_level != SOL_SOCKET || c->cmsg_type != SCM_RIGHTS ||
+            c->cmsg_len != CMSG_LEN(3 * sizeof(int)))
+                return NULL;
+        memcpy(fds, CMSG_DATA(c), 3 * sizeof(int));
+        if (req->magic != SRV_MAGIC || req->argc < 1 || req->envc < 0 ||
+            req->len > SRV_MAX_LEN) {
+                for (int i = 0; i < 3; i++)
+                        close(fds[i]);
+                return NULL;
+        }
+        buf = malloc(req->len + 1);
+        if (!buf || read_all(conn, buf, req->len) < 0) {
+                for (int i = 0; i < 3; i++)
+                        close(fds[i]);
+                free(buf);
+                return NULL;
+        }
+        buf[req->len] = '\0';
+        return buf;
+}
+
+/* Receives a request from a client on conn */
+int     srv_recv(int conn, struct srv_req *r)
+{
+        struct srv_msg m;
+        char *b, *end;
+
+        memset(r, 0, sizeof(*r));
+        r->buf = recv_msg(conn, &m, r->fds);
+        if (!r->buf)
+                return -1;
+        end = r->buf + m.len + 1;
+        r->argc = m.argc;
+        r->envc = m.envc;
+        r->argv = calloc(m.argc + 1, sizeof(char *));
+        r->envp = calloc(m.envc + 1, sizeof(char *));
+        r->cwd = r->buf;
+        if (!r->argv || !r->envp || !(b = memchr(r->buf, 0, end - r->buf)) ||
+            !(b = split_strings(b + 1, end, r->argv, r->argc)) ||
+            !split_strings(b, end, r->envp, r->envc)) {
+                srv_req_free(r);
+                return -1;
+        }
+        return 0;
+}
+
+/* Frees a request, closing its fds */
+void    srv_req_free(struct srv_req *r)
+{
+        for (int i = 0; i < 3; i++) {
+                if (r->fds[i] >= 0)
+                        close(r->fds[i]);
+                r->fds[i] = -1;
+        }
+        free(r->argv);
+        free(r->envp);
+        free(r->buf);
+        r->argv = r->envp = NULL;
+        r->buf = NULL;
+}
+
+/* Tells the client how it went:  an exit status, or -1 to run it itself */
+void    srv_reply(int conn, int32_t status)
+{
+        while (send(conn, &status, sizeof(status), MSG_NOSIGNAL) < 0 && errno == EINTR)
+                ;
+}
+
+/* Serves one request, in its own process.  Returns (only) in the child to
+ * run it, with the guest set up for it.
+ */
+static void     serve(struct rix_proc *p, struct server *srv, int conn)
+{
+        ARMul_State *state = p->state;
+        struct srv_req req;
+        uint64_t id;
+        int status;
+        pid_t pid;
+
+        if (srv_recv(conn, &req) < 0)
+                _exit(1);
+        // It's only this binary that can be served
+        if (rix_proc_chdir(p, req.cwd) < 0 ||
+            zmagic_binary_id(state, req.argv[0], &id) < 0 || id != srv->id ||
+            !zmagic_args_fit(&srv->args, req.argc, req.argv, req.envc, req.envp)) {
+                if (p->verbose)
+                        printf("rixrun: Can't serve %s\n", req.argv[0]);
+                goto bad;
+        }
+
+        fflush(stdout);
+        fflush(stderr);
+        pid = fork();
+        if (pid < 0)
+                goto bad;
+        if (pid == 0) {
+                for (int i = 0; i < 3; i++) {
+                        dup2(req.fds[i], i);
+                        if (req.fds[i] > 2)
+                                close(req.fds[i]);
+                }
+                close(conn);
+                if (snap_replace_args(p, &srv->args, req.argc, req.argv,
+                                      req.envc, req.envp) < 0)
+                        _exit(127);
+                os_forked(state);
+                return;
+        }
+        srv_req_free(&req);
+        while (waitpid(pid, &status, 0) < 0) {
+                if (errno != EINTR)
+                        _exit(1);
+        }
+        srv_reply(conn, WIFEXITED(status) ? WEXITSTATUS(status) :
+                  128 + WTERMSIG(status));
+        _exit(0);
+bad:
+        srv_reply(conn, -1);
+        _exit(1);
+}
+
+/* Reached the snapshot point:  from here on, the guest is a server, with
+ * a process per request.
+ */
+static void     serve_from_here(struct rix_proc *p, uint32_t r15, void *arg)
+{
+        struct server *srv = arg;
+        pid_t pid;
+        int conn;
+
+        if (zmagic_get_args(p->state, &srv->args) < 0) {
+                fprintf(stderr, "rixrun: Can't serve from here\n");
+                exit(1);
+        }
+        if (p->verbose)
+                printf("rixrun: Serving from PC %08x\n", (unsigned int)(r15 & R15PCBITS));
+        // Handlers are left to the kernel to reap
+        signal(SIGCHLD, SIG_IGN);
+        for (;;) {
+                conn = accept(srv->sock, NULL, NULL);
+                if (conn < 0) {
+                        if (errno == EINTR || errno == ECONNABORTED)
+                                continue;
+                        perror("rixrun: accept");
+                        exit(1);
+                }
+                fflush(stdout);
+                fflush(stderr);
+                pid = fork();
+                if (pid == 0) {
+                        signal(SIGCHLD, SIG_DFL);
+                        close(srv->sock);
+                        serve(p, srv, conn);
+                        return;
+                }
+                if (pid < 0)
+                        perror("rixrun: fork");
+                close(conn);
+        }
+}
+
+/* Server entry, with args following the "-s":  the socket's path, then
+ * the binary and args to start it with.  It serves from when (as for
+ * rix_proc_snapshot_at()), and doesn't return unless it can't start.
+ */
+int     rix_serve(char *rixrun_path, int verbose, unsigned int flags, const char *when,
+                  int argc, char *argv[], int envc, char *envp[])
+{
+        struct server srv = { .sock = -1 };
+        struct rix_proc *p;
+        int r;
+
+        if (argc < 2) {
+                fprintf(stderr, "rixrun -s <socket> <binary> [args ...]\n");
+                return 1;
+        }
+        srv.sock = srv_listen(argv[0]);
+        if (srv.sock < 0)
+                return 1;
+
+        p = rix_proc_new(rixrun_path, verbose, flags);
+        if (!p || snap_at(p, when, serve_from_here, &srv) < 0)
+                return 1;
+        if (rix_proc_load(p, argv[1], argc - 1, &argv[1], envc, envp) < 0 ||
+            zmagic_binary_id(p->state, argv[1], &srv.id) < 0) {
+                printf("Failed loading %s :(\n", argv[1]);
+                return 1;
+        }
+        r = rix_proc_run(p);
+        // Only a request's child gets here, unless the guest never got there
+        if (!p->forked) {
+                fprintf(stderr, "rixrun: %s exited (%d) before it could serve\n",
+                        argv[1], r);
+                unlink(argv[0]);
+                return 1;
+        }
+        return r;
+}
+
+/* Asks the server on sock to run argv, as though it were run here.
+ * Returns its exit status, or -1 if it couldn't.
+ */
+int     rix_client(const char *sock, int argc, char *argv[], int envc, char *envp[])
+{
+        char cwd[PATH_MAX];
+        char cbuf[CMSG_SPACE(3 * sizeof(int))] = { 0 };
+        struct srv_msg req = { .magic = SRV_MAGIC, .argc = argc, .envc = envc };
+        struct sockaddr_un sa;
+        struct cmsghdr *c;
+        struct msghdr msg = { 0 };
+        struct iovec iov;
+        int32_t status = -1;
+        char *buf, *b;
+        int fd, fds[3] = { 0, 1, 2 };
+
+        if (!getcwd(cwd, sizeof(cwd)) || sock_addr(sock, &sa) < 0)
+                return -1;
+        req.len = strlen(cwd) + 1;
+        for (int i = 0; i < argc; i++)
+                req.len += strlen(argv[i]) + 1;
+        for (int i = 0; i < envc; i++)
+                req.len += strlen(envp[i]) + 1;
+        if (req.len > SRV_MAX_LEN || !(buf = malloc(req.len)))
+                return -1;
+        b = stpcpy(buf, cwd) + 1;
+        for (int i = 0; i < argc; i++)
+                b = stpcpy(b, argv[i]) + 1;
+        for (int i = 0; i < envc; i++)
+                b = stpcpy(b, envp[i]) + 1;
+
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0 || connect(fd, (struct sockaddr *)&sa, sizeof(sa)) < 0)
+                goto out;
+        iov.iov_base = &req;
+        iov.iov_len = sizeof(req);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = cbuf;
+        msg.msg_controllen = sizeof(cbuf);
+        c = CMSG_FIRSTHDR(&msg);
+        c->cmsg_level = SOL_SOCKET;
+        c->cmsg_type = SCM_RIGHTS;
+        c->cmsg_len = CMSG_LEN(sizeof(fds));
+        memcpy(CMSG_DATA(c), fds, sizeof(fds));
+        if (sendmsg(fd, &msg, MSG_NOSIGNAL) != sizeof(req))
+                goto out;
+        for (b = buf; b < buf + req.len; ) {
+                ssize_t r = send(fd, b, buf + req.len - b, MSG_NOSIGNAL);
+
+                if (r < 0 && errno == EINTR)
+                        continue;
+                if (r <= 0)
+                        goto out;
+                b += r;
+        }
+        // Hung up on mid-run, it's too late to run it here instead
+        if (read_all(fd, &status, sizeof(status)) < 0) {
+                fprintf(stderr, "rixrun: Server %s hung up\n", sock);
+                status = 127;
+        }
+out:
+        if (fd >= 0)
+                close(fd);
+        free(buf);
+        return status;
+}
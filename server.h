@@ -0,0 +1,22 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <inttypes.h>
+
+/* A request to run a binary, from rix_client() */
+struct srv_req {
+        char            *cwd;
+        int             argc;
+        char            **argv;
+        int             envc;
+        char            **envp;
+        int             fds[3];         // The client's stdin, stdout, stderr
+        char            *buf;           // Holding the strings
+};
+
+int     srv_listen(const char *path);
+int     srv_recv(int conn, struct srv_req *r);
+void    srv_req_free(struct srv_req *r);
+void    srv_reply(int conn, int32_t status);
+
+#endif
@@ -0,0 +1,565 @@
+/* rixrun process snapshots
+ *
+ * Every run of a binary does the same work to get going:  finding and
+ * loading its libraries, hooking their routines (see hle.c), and then
+ * the guest's own startup.  A snapshot is a guest process as it is at a
+ * chosen point, by default its entry point, or before a given syscall or
+ * at a given PC, written out once, so that later runs of the same binary
+ * can start from there.
+ *
+ * It has guest memory (just the pages with something in them, mapped back
+ * in copy-on-write), the user registers and FPA, the break, the host files
+ * behind the guest's fds and the HLE hooks.  A restored process gets the
+ * args and environment it's run with, rather than those the snapshot was
+ * taken with:  their strings and tables are rebuilt in place.  That's only
+ * right if the guest hasn't read the old ones, so until the snapshot is
+ * taken, the pages they're on are kept from it (see snap_guard()).  If it
+ * touches them, no snapshot is taken.  argc and argv[] stay where they
+ * were, so the guest may have worked out where they are (as crt0 does).
+ *
+ * The snapshot is only used if the binary, and all of its libraries, are
+ * as they were when it was taken.
+ *
+ * File layout:
+ * <snap_hdr> <extents> <FPA> <os_snap_write()> <hle_snap_write()>
+ * <guest memory, from data_offset>
+ *
+ * Copyright (C) 2022 Matt Evans
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "armdefs.h"
+#include "armemu.h"
+#include "armblock.h"
+#include "armfpa.h"
+#include "rixrun.h"
+#include "rix_os.h"
+#include "zload.h"
+#include "hle.h"
+#include "snap.h"
+
+#define SNAP_MAGIC      0x4e535852      // "RXSN"
+#define SNAP_VERSION    4
+#define SNAP_ALIGN      0x10000         // Of guest memory in the file, so it can be mmap()ed
+#define SNAP_ARG_SPACE  0x8000          // Kept at the stack top for a restored process' args
+
+/* A snapshot yet to be taken */
+struct rix_snap {
+        snap_fn         *fn;            // What to do when it's reached
+        void            *arg;
+        char            *file;
+        uint64_t        id;             // See zmagic_binary_id()
+        int             sc;             // Syscall to snapshot before, or -1
+        addr_t          pc;             // ... or PC to snapshot at
+        uint32_t        orig;           // The instruction the breakpoint replaced
+        int             armed;
+        int             at_entry;       // ... the binary's entry point, as pc
+        addr_t          guard_lo;       // Pages of args kept from the guest
+        addr_t          guard_hi;
+        volatile sig_atomic_t args_read;        // ... until it touched them
+};
+
+/* A run of guest memory (that's in a snapshot at offset) */
+struct snap_extent {
+        addr_t          addr;
+        uint32_t        len;
+        uint64_t        offset;
+};
+
+struct snap_hdr {
+        uint32_t        magic;
+        uint32_t        version;
+        uint64_t        id;
+        uint32_t        pagesize;
+        uint32_t        regs[16];       // User mode, with r15's PSR bits
+        struct zm_args  args;
+        uint32_t        fpa_len;
+        uint32_t        nextents;
+        uint64_t        data_offset;
+};
+
+#define SWI_INSN(n)     (0xef000000 | (n))
+
+static uint32_t *word(struct rix_proc *p, addr_t a)
+{
+        return (uint32_t *)(p->mem_base + a);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Taking one
+
+static void     snap_take(struct rix_proc *p, uint32_t r15, void *arg);
+
+/* Calls fn when the guest reaches when (a syscall name or number, just
+ * before it's made, a 0x PC, or by default "entry", the binary's entry
+ * point), if it hasn't read its args by then.  Call before loading the
+ * binary, as that leaves room for args.
+ */
+int     snap_at(struct rix_proc *p, const char *when, snap_fn *fn, void *arg)
+{
+        struct rix_snap *s = calloc(1, sizeof(*s));
+
+        if (!s)
+                return -1;
+        s->sc = -1;
+        if (!when || !strcmp(when, "entry")) {
+                s->at_entry = 1;
+        } else if (!strncmp(when, "0x", 2)) {
+                s->pc = strtoul(when, NULL, 16);
+                if (!s->pc || s->pc & 3 || s->pc >= MEM_SIZE)
+                        goto bad;
+        } else if ((s->sc = os_sc_number(when)) < 0) {
+                goto bad;
+        }
+        s->fn = fn;
+        s->arg = arg;
+        p->snap = s;
+        p->arg_space = SNAP_ARG_SPACE;
+        return 0;
+bad:
+        fprintf(stderr, "rixrun: Can't snapshot at '%s'\n", when);
+        free(s);
+        return -1;
+}
+
+/* Takes a snapshot, to file, when reaching when (see snap_at()) */
+int     rix_proc_snapshot_at(struct rix_proc *p, const char *file, const char *when)
+{
+        if (snap_at(p, when, snap_take, NULL) < 0)
+                return -1;
+        p->snap->file = strdup(file);
+        return 0;
+}
+
+/* Keeps the pages the args are on (which the loader gives to them alone)
+ * from the guest until the snapshot, to know if it reads them before then.
+ */
+static void     snap_guard(struct rix_proc *p)
+{
+        struct rix_snap *s = p->snap;
+        addr_t pagesize = sysconf(_SC_PAGESIZE);
+        struct zm_args a;
+
+        if (zmagic_get_args(p->state, &a) < 0) {
+                s->args_read = 1;
+                return;
+        }
+        s->guard_lo = a.sp & ~(pagesize - 1);
+        s->guard_hi = (a.top + pagesize - 1) & ~(pagesize - 1);
+        if (mprotect(p->mem_base + s->guard_lo, s->guard_hi - s->guard_lo, PROT_NONE) < 0) {
+                s->guard_lo = s->guard_hi = 0;
+                s->args_read = 1;
+        }
+}
+
+static void     snap_unguard(struct rix_proc *p)
+{
+        struct rix_snap *s = p->snap;
+
+        if (s->guard_lo == s->guard_hi)
+                return;
+        mprotect(p->mem_base + s->guard_lo, s->guard_hi - s->guard_lo,
+                 PROT_READ | PROT_WRITE);
+        s->guard_lo = s->guard_hi = 0;
+}
+
+/* From the SIGSEGV handler (see flight.c), for a fault at host address a on
+ * p's thread.  Returns 1 if it was the guest touching its guarded args, in
+ * which case they're given back to it, to carry on without a snapshot.
+ */
+int     snap_fault(struct rix_proc *p, void *a)
+{
+        struct rix_snap *s = p->snap;
+        uint8_t *m = a;
+
+        if (!s || s->guard_lo == s->guard_hi ||
+            m < p->mem_base + s->guard_lo || m >= p->mem_base + s->guard_hi)
+                return 0;
+        s->args_read = 1;
+        snap_unguard(p);
+        return 1;
+}
+
+/* Whether the len bytes at guest address a are on guarded pages */
+static int      snap_guarded(struct rix_snap *s, addr_t a, uint32_t len)
+{
+        return len && a < s->guard_hi && (uint64_t)a + len > s->guard_lo;
+}
+
+/* Whether the string at guest address a runs onto guarded pages */
+static int      snap_guarded_str(struct rix_proc *p, addr_t a)
+{
+        struct rix_snap *s = p->snap;
+
+        if (a >= s->guard_lo)
+                return a < s->guard_hi;
+        return strnlen((char *)(p->mem_base + a), s->guard_lo - a) == s->guard_lo - a;
+}
+
+/* Before syscall number is made:  the host kernel can't fault on guest
+ * memory the way rixrun's own accesses do (see snap_fault()), and would
+ * fail it with EFAULT instead.  So, if it's to be given guarded pages, the
+ * guest's reading its args, and they're given back to it first.
+ */
+static void     snap_syscall(ARMul_State *state, ARMword number)
+{
+        struct rix_proc *p = PROC(state);
+        struct rix_snap *s = p->snap;
+        uint32_t a0 = ARMul_GetReg(state, state->Mode, 0);
+        uint32_t a1 = ARMul_GetReg(state, state->Mode, 1);
+        uint32_t a2 = ARMul_GetReg(state, state->Mode, 2);
+        int touches;
+
+        if (s->guard_lo == s->guard_hi)
+                return;
+        switch (number) {
+        case 3:         /* read         */
+        case 4:         /* write        */
+                touches = a1 < MEM_SIZE && snap_guarded(s, a1, a2);
+                break;
+        case 9:         /* link         */
+                touches = (a0 < MEM_SIZE && snap_guarded_str(p, a0)) ||
+                        (a1 < MEM_SIZE && snap_guarded_str(p, a1));
+                break;
+        case 8:         /* creat        */
+        case 10:        /* unlink       */
+        case 28:        /* open         */
+        case 34:        /* access       */
+                touches = a0 < MEM_SIZE && snap_guarded_str(p, a0);
+                break;
+        default:        // Any other guest memory's accessed by rixrun itself
+                touches = 0;
+                break;
+        }
+        if (touches) {
+                s->args_read = 1;
+                snap_unguard(p);
+        }
+}
+
+/* The binary's loaded:  notes what it is, and puts in the breakpoint */
+void    snap_loaded(struct rix_proc *p, char *filename)
+{
+        struct rix_snap *s = p->snap;
+
+        if (zmagic_binary_id(p->state, filename, &s->id) < 0) {
+                snap_free(p);
+                return;
+        }
+        snap_guard(p);
+        if (s->at_entry)
+                s->pc = ARMul_GetPC(p->state);
+        if (!s->pc)
+                return;
+        s->orig = *word(p, s->pc);
+        if ((s->orig & 0x0f000000) == 0x0f000000) {
+                fprintf(stderr, "rixrun: Can't snapshot at %08x, a SWI (or hooked routine)\n",
+                        s->pc);
+                snap_free(p);
+                return;
+        }
+        *word(p, s->pc) = SWI_INSN(SNAP_SWI);
+        ARMul_BlockInvalidate(p->state, s->pc, 4);
+        s->armed = 1;
+}
+
+void    snap_free(struct rix_proc *p)
+{
+        struct rix_snap *s = p->snap;
+
+        if (!s)
+                return;
+        snap_unguard(p);
+        if (s->armed && *word(p, s->pc) == SWI_INSN(SNAP_SWI)) {
+                *word(p, s->pc) = s->orig;
+                ARMul_BlockInvalidate(p->state, s->pc, 4);
+        }
+        free(s->file);
+        free(s);
+        p->snap = NULL;
+        p->arg_space = 0;
+}
+
+static int      page_is_zero(const uint8_t *m, unsigned int len)
+{
+        return !m[0] && !memcmp(m, m + 1, len - 1);
+}
+
+/* Finds the runs of guest pages with something in them, returning how
+ * many (in a malloc()ed *extp), or <0.
+ */
+static int      snap_extents(struct rix_proc *p, struct snap_extent **extp)
+{
+        unsigned int pagesize = sysconf(_SC_PAGESIZE);
+        struct snap_extent *ext = malloc((MEM_SIZE / pagesize) * sizeof(*ext));
+        uint64_t off = 0;
+        int n = 0;
+
+        if (!ext)
+                return -1;
+        for (addr_t a = 0; a < MEM_SIZE; a += pagesize) {
+                if (page_is_zero(p->mem_base + a, pagesize))
+                        continue;
+                if (n && ext[n - 1].addr + ext[n - 1].len == a) {
+                        ext[n - 1].len += pagesize;
+                } else {
+                        ext[n].addr = a;
+                        ext[n].len = pagesize;
+                        ext[n].offset = off;
+                        n++;
+                }
+                off += pagesize;
+        }
+        *extp = ext;
+        return n;
+}
+
+/* Writes the process out, as it would be with r15 (PC and PSR) */
+static void     snap_take(struct rix_proc *p, uint32_t r15, void *arg)
+{
+        ARMul_State *state = p->state;
+        struct rix_snap *s = p->snap;
+        unsigned int pagesize = sysconf(_SC_PAGESIZE);
+        struct snap_extent *ext = NULL;
+        struct snap_hdr h;
+        char tmp[PATH_MAX];
+        void *fpa = NULL;
+        FILE *f = NULL;
+        int fd, n;
+
+        memset(&h, 0, sizeof(h));
+        h.magic = SNAP_MAGIC;
+        h.version = SNAP_VERSION;
+        h.id = s->id;
+        h.pagesize = pagesize;
+        for (int i = 0; i < 15; i++)
+                h.regs[i] = ARMul_GetReg(state, state->Mode, i);
+        h.regs[15] = r15;
+        if (zmagic_get_args(state, &h.args) < 0)
+                return;
+        h.fpa_len = ARMul_FPASave(state, NULL, 0);
+        fpa = malloc(h.fpa_len);
+        // Only pages with something in them are kept
+        if (!fpa || (n = snap_extents(p, &ext)) < 0)
+                goto out;
+        h.nextents = n;
+        ARMul_FPASave(state, fpa, h.fpa_len);
+
+        snprintf(tmp, PATH_MAX, "%s.XXXXXX", s->file);
+        fd = mkstemp(tmp);
+        if (fd < 0 || !(f = fdopen(fd, "w"))) {
+                if (fd >= 0)
+                        close(fd);
+                fd = -1;
+                goto bad;
+        }
+        fchmod(fd, 0644);
+        fwrite(&h, sizeof(h), 1, f);
+        fwrite(ext, sizeof(*ext), h.nextents, f);
+        fwrite(fpa, h.fpa_len, 1, f);
+        if (os_snap_write(state, f) < 0 || hle_snap_write(state, f) < 0)
+                goto bad;
+        h.data_offset = (ftell(f) + SNAP_ALIGN - 1) & ~(uint64_t)(SNAP_ALIGN - 1);
+        rewind(f);
+        fwrite(&h, sizeof(h), 1, f);
+        if (fflush(f) || ferror(f))
+                goto bad;
+        for (unsigned int i = 0; i < h.nextents; i++) {
+                if (pwrite(fd, p->mem_base + ext[i].addr, ext[i].len,
+                           h.data_offset + ext[i].offset) != ext[i].len)
+                        goto bad;
+        }
+        // Others might be restoring from an older one
+        if (rename(tmp, s->file) < 0)
+                goto bad;
+        if (p->verbose)
+                printf("rixrun: Snapshot at PC %08x written to %s\n", (unsigned int)(r15 & R15PCBITS), s->file);
+        goto out;
+bad:
+        fprintf(stderr, "rixrun: Can't write snapshot %s\n", s->file);
+        if (fd >= 0)
+                unlink(tmp);
+out:
+        if (f)
+                fclose(f);
+        free(ext);
+        free(fpa);
+}
+
+/* The snapshot point's reached, with r15 as the guest will carry on with */
+static void     snap_reached(struct rix_proc *p, ARMword r15)
+{
+        struct rix_snap *s = p->snap;
+
+        snap_unguard(p);
+        if (s->args_read)
+                fprintf(stderr, "rixrun: No snapshot at PC %08x, as the guest has read its "
+                        "args by then (see RIX_SNAPSHOT_AT)\n", (unsigned int)(r15 & R15PCBITS));
+        else
+                s->fn(p, r15, s->arg);
+        snap_free(p);
+}
+
+/* From ARMul_OSHandleSWI(), for any SWI while a snapshot is pending.
+ * Returns 1 if it was the breakpoint.
+ */
+int     snap_swi(ARMul_State *state, ARMword number)
+{
+        struct rix_proc *p = PROC(state);
+        struct rix_snap *s = p->snap;
+        ARMword r15 = ARMul_GetR15(state);
+        addr_t pc = (r15 & R15PCBITS) - 8;      // Still ahead in the pipeline
+
+        r15 = (r15 & ~R15PCBITS) | pc;
+        if (s->armed && number == SNAP_SWI && pc == s->pc) {
+                // Put the instruction back, to be run next (and in the snapshot)
+                *word(p, pc) = s->orig;
+                ARMul_BlockInvalidate(state, pc, 4);
+                ARMul_SetR15(state, r15);
+                s->armed = 0;
+                snap_reached(p, r15);
+                return 1;
+        }
+        if (s->sc >= 0 && (number & 0xfffff) == (ARMword)s->sc) {
+                // The restored process makes this syscall itself
+                snap_reached(p, r15);
+                return 0;
+        }
+        snap_syscall(state, number & 0xfffff);
+        return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Restoring one
+
+/* Gives a process that's been snapshotted (with its args in args) its
+ * own.  It hadn't read the old ones, so nothing refers to them but to
+ * where argc and argv[] are, which stays the same.
+ */
+int     snap_replace_args(struct rix_proc *p, const struct zm_args *args,
+                          int argc, char *argv[], int envc, char *envp[])
+{
+        struct zm_args a = *args;
+
+        return zmagic_build_args(p->state, &a, argc, argv, envc, envp);
+}
+
+/* Restores the process from a snapshot of filename, with these args.
+ * Returns 0 if restored, 1 if the snapshot can't be used (leaving the
+ * process as it was, to be loaded as normal), or <0 if it's broken.
+ */
+int     rix_proc_restore(struct rix_proc *p, const char *file, char *filename,
+                         int argc, char *argv[], int envc, char *envp[])
+{
+        ARMul_State *state = p->state;
+        unsigned int pagesize = sysconf(_SC_PAGESIZE);
+        struct snap_extent *ext = NULL;
+        struct os_snap *os = NULL;
+        struct snap_hdr h;
+        void *fpa = NULL;
+        uint64_t id;
+        int can_map, r = 1;
+        FILE *f;
+
+        // (This opens the libs first, as the run that took the snapshot did)
+        if (zmagic_binary_id(state, filename, &id) < 0)
+                return 1;
+        f = fopen(file, "r");
+        if (!f)
+                return 1;
+        if (fread(&h, sizeof(h), 1, f) != 1 || h.magic != SNAP_MAGIC ||
+            h.version != SNAP_VERSION || h.nextents > MEM_SIZE / 4096 ||
+            h.fpa_len != ARMul_FPASave(state, NULL, 0) || id != h.id)
+                goto out;
+        if (!zmagic_args_fit(&h.args, argc, argv, envc, envp)) {
+                if (p->verbose)
+                        printf("rixrun: Args don't fit in snapshot %s\n", file);
+                goto out;
+        }
+        ext = malloc(h.nextents * sizeof(*ext) + 1);
+        fpa = malloc(h.fpa_len);
+        if (!ext || !fpa ||
+            fread(ext, sizeof(*ext), h.nextents, f) != h.nextents ||
+            fread(fpa, h.fpa_len, 1, f) != 1)
+                goto out;
+        for (unsigned int i = 0; i < h.nextents; i++) {
+                if (ext[i].addr >= MEM_SIZE || ext[i].len > MEM_SIZE - ext[i].addr)
+                        goto out;
+        }
+        if (!(os = os_snap_read(state, f)))
+                goto out;
+
+        // From here on, there's no going back (bar the fds, below)
+        r = -1;
+        can_map = h.pagesize == pagesize && !(SNAP_ALIGN % pagesize);
+        for (unsigned int i = 0; i < h.nextents; i++) {
+                void *m = p->mem_base + ext[i].addr;
+                off_t o = h.data_offset + ext[i].offset;
+
+                if (can_map && mmap(m, ext[i].len, PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_FIXED, fileno(f), o) != MAP_FAILED)
+                        continue;
+                if (pread(fileno(f), m, ext[i].len, o) != ext[i].len)
+                        goto out;
+        }
+        if (hle_snap_read(state, f) < 0)
+                goto out;
+        if (snap_replace_args(p, &h.args, argc, argv, envc, envp) < 0)
+                goto out;
+        fclose(f);
+        f = NULL;
+        r = os_snap_restore(state, os);
+        os = NULL;
+        if (r < 0) {
+                // Back to how it was:  nothing's run, so only memory's changed
+                if (mmap(p->mem_base, MEM_SIZE, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED,
+                         -1, 0) == MAP_FAILED)
+                        goto out;
+                hle_discard(state, 0, MEM_SIZE);
+                if (p->verbose)
+                        printf("rixrun: Can't reopen files in snapshot %s\n", file);
+                r = 1;
+                goto out;
+        }
+        ARMul_FPARestore(state, fpa, h.fpa_len);
+        ARMul_SetR15(state, h.regs[15]);
+        for (int i = 0; i < 15; i++)
+                ARMul_SetReg(state, state->Mode, i, h.regs[i]);
+        if (p->verbose)
+                printf("rixrun: Restored %s from snapshot %s, at PC %08x\n",
+                       filename, file, (unsigned int)(h.regs[15] & R15PCBITS));
+        r = 0;
+out:
+        if (r < 0)
+                fprintf(stderr, "rixrun: Can't restore from snapshot %s\n", file);
+        if (f)
+                fclose(f);
+        free(os);
+        free(ext);
+        free(fpa);
+        return r;
+}
@@ -0,0 +1,21 @@
+#ifndef SNAP_H
+#define SNAP_H
+
+#include "armdefs.h"
+#include "rixrun.h"
+#include "zload.h"
+
+/* A breakpoint at the PC a snapshot's to be taken at */
+#define SNAP_SWI        0x7e0000
+
+typedef void snap_fn(struct rix_proc *p, uint32_t r15, void *arg);
+
+int     snap_at(struct rix_proc *p, const char *when, snap_fn *fn, void *arg);
+int     snap_replace_args(struct rix_proc *p, const struct zm_args *args,
+                          int argc, char *argv[], int envc, char *envp[]);
+int     snap_fault(struct rix_proc *p, void *a);
+int     snap_swi(ARMul_State *state, ARMword number);
+void    snap_loaded(struct rix_proc *p, char *filename);
+void    snap_free(struct rix_proc *p);
+
+#endif
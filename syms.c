@@ -0,0 +1,182 @@
+/* rixrun guest symbols
+ *
+ * Keeps the text symbols from the a.out symbol tables of the binary and
+ * libraries a process has loaded, to name guest addresses in profiles and
+ * crash dumps:  as a symbol, or failing that as an offset into the object
+ * they're in.
+ *
+ * Copyright (C) 2022 Matt Evans
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "armdefs.h"
+#include "rixrun.h"
+#include "zload.h"
+#include "syms.h"
+
+struct rix_syms {
+        struct rix_sym  *syms;
+        unsigned int    num_syms;
+        unsigned int    max_syms;
+        struct rix_obj  objs[2 * MAX_SHARED_LIBS];
+        unsigned int    num_objs;
+};
+
+static int      sym_cmp(const void *a, const void *b)
+{
+        const struct rix_sym *x = a, *y = b;
+
+        return x->addr < y->addr ? -1 : x->addr > y->addr;
+}
+
+const struct rix_obj *syms_obj(struct rix_syms *s, addr_t a)
+{
+        if (!s)
+                return NULL;
+        for (unsigned int i = 0; i < s->num_objs; i++) {
+                if (a >= s->objs[i].start && a < s->objs[i].end)
+                        return &s->objs[i];
+        }
+        return NULL;
+}
+
+/* The symbol a is in, if it's named within its object */
+const struct rix_sym *syms_find(struct rix_syms *s, addr_t a)
+{
+        const struct rix_obj *o = syms_obj(s, a);
+        int lo = 0, hi = s->num_syms - 1, best = -1;
+
+        if (!o)
+                return NULL;
+        while (lo <= hi) {
+                int mid = (lo + hi) / 2;
+
+                if (s->syms[mid].addr <= a) {
+                        best = mid;
+                        lo = mid + 1;
+                } else {
+                        hi = mid - 1;
+                }
+        }
+        if (best < 0 || s->syms[best].addr < o->start)
+                return NULL;
+        return &s->syms[best];
+}
+
+/* Names the function a is in, or the object, or failing that gives a */
+void    syms_name(struct rix_syms *s, addr_t a, char *buf, size_t len)
+{
+        const struct rix_sym *sym = syms_find(s, a);
+        const struct rix_obj *o;
+
+        if (sym)
+                snprintf(buf, len, "%s", sym->name);
+        else if ((o = syms_obj(s, a)))
+                snprintf(buf, len, "%s+0x%x", o->name, a - o->start);
+        else
+                snprintf(buf, len, "0x%08x", a);
+}
+
+/* From the loader, for an object with text at [text_start, text_end) */
+void    syms_load(ARMul_State *state, int fd, const struct exec_hdr *hdr,
+                  const char *filename, addr_t text_start, addr_t text_end)
+{
+        struct rix_syms *s = PROC(state)->syms;
+        struct rix_nlist *syms;
+        const char *base;
+        char *strs;
+        uint32_t strsize;
+        unsigned int n;
+
+        if (!s || s->num_objs == sizeof(s->objs) / sizeof(s->objs[0]))
+                return;
+        base = strrchr(filename, '/');
+        s->objs[s->num_objs].start = text_start;
+        s->objs[s->num_objs].end = text_end;
+        s->objs[s->num_objs].name = strdup(base ? base + 1 : filename);
+        s->num_objs++;
+
+        n = zmagic_read_symbols(fd, hdr, &syms, &strs, &strsize);
+        for (unsigned int i = 0; i < n; i++) {
+                struct rix_nlist *nl = &syms[i];
+
+                if ((nl->n_type & RIX_N_TYPE) != RIX_N_TEXT || nl->n_strx >= strsize ||
+                    nl->n_value < text_start || nl->n_value >= text_end)
+                        continue;
+                if (s->num_syms == s->max_syms) {
+                        unsigned int max = s->max_syms ? 2 * s->max_syms : 1024;
+                        struct rix_sym *ns = realloc(s->syms, max * sizeof(*ns));
+
+                        if (!ns)
+                                break;
+                        s->syms = ns;
+                        s->max_syms = max;
+                }
+                s->syms[s->num_syms].addr = nl->n_value;
+                s->syms[s->num_syms].name = strdup(strs + nl->n_strx);
+                s->num_syms++;
+        }
+        free(strs);
+        free(syms);
+        // Now, not when they're looked up:  that's also from fatal signals
+        qsort(s->syms, s->num_syms, sizeof(*s->syms), sym_cmp);
+}
+
+/* From clear_mem():  [lo, hi) no longer holds what it did */
+void    syms_discard(ARMul_State *state, addr_t lo, addr_t hi)
+{
+        struct rix_syms *s = PROC(state)->syms;
+        unsigned int n = 0;
+
+        if (!s)
+                return;
+        for (unsigned int i = 0; i < s->num_objs; ) {
+                if (s->objs[i].start >= lo && s->objs[i].start < hi) {
+                        free(s->objs[i].name);
+                        s->objs[i] = s->objs[--s->num_objs];
+                } else {
+                        i++;
+                }
+        }
+        for (unsigned int i = 0; i < s->num_syms; i++) {
+                if (s->syms[i].addr >= lo && s->syms[i].addr < hi)
+                        free(s->syms[i].name);
+                else
+                        s->syms[n++] = s->syms[i];
+        }
+        s->num_syms = n;
+}
+
+struct rix_syms *syms_new(void)
+{
+        return calloc(1, sizeof(struct rix_syms));
+}
+
+void    syms_free(struct rix_syms *s)
+{
+        if (!s)
+                return;
+        for (unsigned int i = 0; i < s->num_objs; i++)
+                free(s->objs[i].name);
+        for (unsigned int i = 0; i < s->num_syms; i++)
+                free(s->syms[i].name);
+        free(s->syms);
+        free(s);
+}
@@ -0,0 +1,31 @@
+#ifndef SYMS_H
+#define SYMS_H
+
+#include <stddef.h>
+
+#include "armdefs.h"
+#include "rixrun.h"
+#include "zload.h"
+
+struct rix_sym {
+        addr_t          addr;
+        char            *name;
+};
+
+/* An object (binary or library) whose text is at [start, end) */
+struct rix_obj {
+        addr_t          start;
+        addr_t          end;
+        char            *name;
+};
+
+void    syms_load(ARMul_State *state, int fd, const struct exec_hdr *hdr,
+                  const char *filename, addr_t text_start, addr_t text_end);
+void    syms_discard(ARMul_State *state, addr_t lo, addr_t hi);
+const struct rix_obj *syms_obj(struct rix_syms *s, addr_t a);
+const struct rix_sym *syms_find(struct rix_syms *s, addr_t a);
+void    syms_name(struct rix_syms *s, addr_t a, char *buf, size_t len);
+struct rix_syms *syms_new(void);
+void    syms_free(struct rix_syms *s);
+
+#endif
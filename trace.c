@@ -0,0 +1,300 @@
+/* rixrun binary instruction trace
+ *
+ * RIX_VERBOSE=2 prints every instruction run, which is slow enough to hide
+ * the timing-dependent failures it's most wanted for, and makes gigabytes
+ * of text.  Instead, this appends a few words per instruction (its PC and
+ * itself, and optionally the registers it changed; see trace.h) to a ring
+ * of chunks, which a thread of its own writes out to a file.  If the file
+ * can't keep up, the guest waits for a free chunk, so nothing is lost.
+ * rixtrace decodes the file.
+ *
+ * ARMulator calls ARMul_TraceInstr() before each instruction, from the
+ * interpreter's tracing loop (which ARMul_DoProg() picks when state->Trace
+ * is set, and which doesn't use the block cache).  A guest process has
+ * its own trace, on the host thread it runs on; a forked child writes its
+ * own, to the file name with .<pid> added.
+ *
+ * Copyright (C) 2022 Matt Evans
+ *
+ *  This program is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU General Public License
+ *  as published by the Free Software Foundation; either version 2
+ *  of the License, or (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "armdefs.h"
+#include "armemu.h"
+#include "rixrun.h"
+#include "trace.h"
+
+#define TRACE_CHUNK     (256 * 1024)    // Words
+#define TRACE_CHUNKS    8
+#define TRACE_MAX_REC   (2 + 1 + 16)    // Words in the largest record
+
+struct rix_trace {
+        char            *file;
+        int             fd;
+        int             regs;           // Recording register changes
+        int             full;           // ... all of them, next record
+        uint32_t        last[16];
+
+        uint32_t        *chunk[TRACE_CHUNKS];
+        uint32_t        len[TRACE_CHUNKS];      // Words in each, once filled
+        uint32_t        *pos;           // In the chunk being filled
+        uint32_t        *end;
+
+        // Chunks numbered from 0; chunk n is in chunk[n % TRACE_CHUNKS]:
+        pthread_t       writer;
+        pthread_mutex_t lock;
+        pthread_cond_t  cond;
+        unsigned long   filled;         // The one being filled
+        unsigned long   written;        // The next to write
+        int             stop;
+        int             failed;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Writing out
+
+static void    *writer(void *arg)
+{
+        struct rix_trace *t = arg;
+
+        pthread_mutex_lock(&t->lock);
+        for (;;) {
+                unsigned int c;
+
+                while (t->written == t->filled && !t->stop)
+                        pthread_cond_wait(&t->cond, &t->lock);
+                if (t->written == t->filled)
+                        break;
+                c = t->written % TRACE_CHUNKS;
+                pthread_mutex_unlock(&t->lock);
+
+                if (!t->failed) {
+                        size_t n = t->len[c] * sizeof(uint32_t);
+                        uint8_t *b = (uint8_t *)t->chunk[c];
+
+                        while (n) {
+                                ssize_t r = write(t->fd, b, n);
+
+                                if (r < 0) {
+                                        perror(t->file);
+                                        t->failed = 1;
+                                        break;
+                                }
+                                b += r;
+                                n -= r;
+                        }
+                }
+
+                pthread_mutex_lock(&t->lock);
+                t->written++;
+                pthread_cond_broadcast(&t->cond);
+        }
+        pthread_mutex_unlock(&t->lock);
+        return NULL;
+}
+
+/* Hands the chunk being filled to the writer, waiting for the next to be free */
+static void     next_chunk(struct rix_trace *t)
+{
+        unsigned int c = t->filled % TRACE_CHUNKS;
+
+        pthread_mutex_lock(&t->lock);
+        t->len[c] = t->pos - t->chunk[c];
+        t->filled++;
+        pthread_cond_broadcast(&t->cond);
+        while (t->filled - t->written >= TRACE_CHUNKS)
+                pthread_cond_wait(&t->cond, &t->lock);
+        pthread_mutex_unlock(&t->lock);
+
+        c = t->filled % TRACE_CHUNKS;
+        t->pos = t->chunk[c];
+        t->end = t->chunk[c] + TRACE_CHUNK;
+}
+
+/* Opens the file and starts the writer */
+static int      start(struct rix_proc *p)
+{
+        struct rix_trace *t = p->trace;
+        struct trace_hdr hdr = {
+                .magic = TRACE_MAGIC,
+                .version = TRACE_VERSION,
+                .flags = t->regs ? TRACE_REGS : 0,
+                .pid = p->pid,
+        };
+        char path[PATH_MAX];
+
+        if (p->forked)
+                snprintf(path, sizeof(path), "%s.%d", t->file, (int)p->pid);
+        else
+                snprintf(path, sizeof(path), "%s", t->file);
+        t->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (t->fd < 0) {
+                perror(path);
+                return -1;
+        }
+        if (write(t->fd, &hdr, sizeof(hdr)) != sizeof(hdr)) {
+                perror(path);
+                close(t->fd);
+                return -1;
+        }
+        t->filled = 0;
+        t->written = 0;
+        t->stop = 0;
+        t->failed = 0;
+        t->full = 1;
+        t->pos = t->chunk[0];
+        t->end = t->chunk[0] + TRACE_CHUNK;
+        if (pthread_create(&t->writer, NULL, writer, t)) {
+                perror("pthread_create");
+                close(t->fd);
+                return -1;
+        }
+        return 0;
+}
+
+/* Writes out what's left, and stops the writer */
+static void     stop(struct rix_trace *t)
+{
+        unsigned int c = t->filled % TRACE_CHUNKS;
+
+        pthread_mutex_lock(&t->lock);
+        t->len[c] = t->pos - t->chunk[c];
+        t->filled++;
+        t->stop = 1;
+        pthread_cond_broadcast(&t->cond);
+        pthread_mutex_unlock(&t->lock);
+        pthread_join(t->writer, NULL);
+        close(t->fd);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/* From ARMulator's tracing loop, before running instr at pc */
+void    ARMul_TraceInstr(ARMul_State *state, ARMword pc, ARMword instr)
+{
+        struct rix_trace *t = PROC(state)->trace;
+        uint32_t *w;
+
+        if (t->end - t->pos < TRACE_MAX_REC)
+                next_chunk(t);
+        w = t->pos;
+        if (t->regs) {
+                uint32_t mask = 0, *m;
+                uint32_t r15 = ECC | ER15INT | EMODE;
+
+                w[1] = instr;
+                m = &w[2];
+                w += 3;
+                for (int i = 0; i < 15; i++) {
+                        if (state->Reg[i] != t->last[i] || t->full) {
+                                t->last[i] = state->Reg[i];
+                                *w++ = state->Reg[i];
+                                mask |= 1 << i;
+                        }
+                }
+                if (r15 != t->last[15] || t->full) {
+                        t->last[15] = r15;
+                        *w++ = r15;
+                        mask |= 1 << 15;
+                }
+                t->full = 0;
+                if (mask) {
+                        t->pos[0] = pc | TRACE_REGS;
+                        *m = mask;
+                } else {
+                        t->pos[0] = pc;
+                        w = m;
+                }
+        } else {
+                w[0] = pc;
+                w[1] = instr;
+                w += 2;
+        }
+        t->pos = w;
+}
+
+/* Writes a trace of every instruction the guest runs to file, with the
+ * registers each changes if regs is set.
+ */
+int     rix_proc_trace(struct rix_proc *p, const char *file, int regs)
+{
+        struct rix_trace *t = calloc(1, sizeof(*t));
+
+        if (!t)
+                return -1;
+        for (int i = 0; i < TRACE_CHUNKS; i++) {
+                t->chunk[i] = malloc(TRACE_CHUNK * sizeof(uint32_t));
+                if (!t->chunk[i])
+                        goto fail;
+        }
+        t->file = strdup(file);
+        t->regs = regs;
+        pthread_mutex_init(&t->lock, NULL);
+        pthread_cond_init(&t->cond, NULL);
+        p->trace = t;
+        if (start(p) < 0) {
+                p->trace = NULL;
+                goto fail;
+        }
+        p->state->Trace = 1;
+        return 0;
+
+fail:
+        for (int i = 0; i < TRACE_CHUNKS; i++)
+                free(t->chunk[i]);
+        free(t->file);
+        free(t);
+        return -1;
+}
+
+/* A forked child traces to a file of its own, from here */
+void    trace_forked(struct rix_proc *p)
+{
+        struct rix_trace *t = p->trace;
+
+        if (!t)
+                return;
+        // The parent's writer (and what's waiting for it) is the parent's
+        close(t->fd);
+        pthread_mutex_init(&t->lock, NULL);
+        pthread_cond_init(&t->cond, NULL);
+        if (start(p) < 0) {
+                p->state->Trace = 0;
+                p->trace = NULL;
+        }
+}
+
+void    trace_free(struct rix_proc *p)
+{
+        struct rix_trace *t = p->trace;
+
+        if (!t)
+                return;
+        stop(t);
+        p->state->Trace = 0;
+        for (int i = 0; i < TRACE_CHUNKS; i++)
+                free(t->chunk[i]);
+        free(t->file);
+        free(t);
+        p->trace = NULL;
+}
@@ -0,0 +1,31 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+/* A binary instruction trace (see trace.c; rixtrace.c reads one) is a
+ * struct trace_hdr then records of host-endian 32-bit words.  A record is
+ * the PC of an instruction about to run, with TRACE_REGS set in it if the
+ * registers have changed since the last record, then the instruction.  With
+ * TRACE_REGS, a mask of the registers that changed (bit 15 for the flags
+ * and mode in R15) and then their values, lowest first, follow; the first
+ * record has all 16.
+ */
+#define TRACE_MAGIC     0x52545852      // "RXTR"
+#define TRACE_VERSION   1
+
+#define TRACE_REGS      1               // In trace_hdr.flags and a record's PC
+
+struct trace_hdr {
+        uint32_t        magic;
+        uint32_t        version;
+        uint32_t        flags;
+        int32_t         pid;
+};
+
+struct rix_proc;
+
+void    trace_forked(struct rix_proc *p);
+void    trace_free(struct rix_proc *p);
+
+#endif
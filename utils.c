@@ -20,6 +20,7 @@
 #include <stdarg.h>
 #include <stdlib.h>
 #include "utils.h"
+#include "flight.h"
 
 void    panic(char *format, ...)
 {
@@ -27,6 +28,8 @@ void    panic(char *format, ...)
         va_start(ap, format);
         vprintf(format, ap);
         va_end(ap);
+        fflush(stdout);
+        flight_crash();
         exit(1);
 }
 
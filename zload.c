@@ -41,65 +41,153 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <sys/mman.h>
+#include <pthread.h>
 
 #include "armdefs.h"
 #include "rixrun.h"
 #include "rix_os.h"
 #include "zload.h"
+#include "hle.h"
+#include "syms.h"
 
 
 #define DEBUG
 
 #ifdef DEBUG
-#define	DBG_ZM(...)	do { if (zmload_verbose) printf(__VA_ARGS__); } while(0)
+#define	DBG_ZM(...)	do { if (zl->verbose) printf(__VA_ARGS__); } while(0)
 #else
 #define	DBG_ZM(...)
 #endif
 
-static int zmload_verbose = 0;
+/* Libraries, once found, stay open and are shared (read-only) by every
+ * process loaded afterwards, which saves re-walking the library chain
+ * for each one when running many (see batch.c).  One that's changed on
+ * the host since is found and opened again; the old one's left open for
+ * the processes already using it.
+ */
+struct libstuff {
+        struct libstuff *next;
+        struct exec_hdr hdr;
+        int fd;
+        char path[PATH_MAX];
+        char realpath[PATH_MAX]; // Host path
+        dev_t dev;               // ... and the file that was there
+        ino_t ino;
+        struct timespec mtime;
+};
+
+static struct libstuff  *lib_cache;
+static pthread_mutex_t  lib_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* What a process has loaded, so that exec of another binary that uses
+ * the same libraries can keep them (see rix_proc_exec()).
+ */
+struct rix_image {
+        char            shlibname[60];  // The lib chain (all found from its first)
+        unsigned int    nlibs;
+        struct {
+                int     fd;             // The lib's file, or the image cache's
+                off_t   offset;
+                addr_t  addr;
+                uint32_t len;
+        } libdata[MAX_SHARED_LIBS];
+        addr_t          libs_end;       // End of the libs' text (the binary's follows)
+        addr_t          sp;             // Stack top, below the libs' data
+        int             cache_fd;       // Image cache entry loaded from, or -1
+        struct zm_args  args;           // Where the binary's args went
+};
+
+/* Loading one binary, and its libs, into one process */
+struct zm_load {
+        ARMul_State     *state;
+        uint8_t         *mem_base;
+        int             verbose;
+        addr_t          tseg_base;      // Where the next object's text goes
+        const struct libstuff *libi[MAX_SHARED_LIBS];
+        int             keep_libs;      // Libs are already loaded, as in image
+        struct rix_image *image;
+};
 
 
 ////////////////////////////////////////////////////////////////////////////////
 // These routines are, largely, derived from those in QEMU's flatload.c/elfload.c
 
-static void     memcpy_to_target(addr_t dest, void *src, unsigned int len)
+static void     memcpy_to_target(struct zm_load *zl, addr_t dest, void *src, unsigned int len)
 {
-        void *realdest = (void *)mem_base + (uintptr_t)dest;
+        void *realdest = (void *)zl->mem_base + (uintptr_t)dest;
 
         if ((uintptr_t)(dest + len) < MEM_SIZE) {
                 memcpy(realdest, src, len);
         }
 }
 
-static uintptr_t copy_strings(addr_t p, unsigned int n, char **s)
+static uintptr_t copy_strings(struct zm_load *zl, addr_t p, unsigned int n, char **s)
 {
         unsigned int len;
 
         while (n-- > 0) {
                 len = strlen(s[n]) + 1;
                 p -= len;
-                memcpy_to_target(p, s[n], len);
+                memcpy_to_target(zl, p, s[n], len);
         }
 
         return p;
 }
 
-static int      target_pread(int fd, addr_t ptr, unsigned int len,
+static int      target_pread(struct zm_load *zl, int fd, addr_t ptr, unsigned int len,
                         unsigned int offset)
 {
         if ((ptr + len) > MEM_SIZE) {
                 return -EFAULT;
         }
-        int r = pread(fd, mem_base + (uintptr_t)ptr, len, offset);
+        int r = pread(fd, zl->mem_base + (uintptr_t)ptr, len, offset);
         if (r < 0) {
                 return -errno;
         };
         return r;
 }
 
-static unsigned int     target_strlen(addr_t ptr)
+/* Like target_pread(), but maps whole pages of the file over the guest's
+ * memory, copy-on-write, instead of copying them.  This needs the file
+ * offset and guest address to be page-aligned (as ZMAGIC segments are).
+ * Whatever's left over (the partial last page, or anything not aligned)
+ * is read as before, so no file contents land past the end of the segment.
+ */
+static int      target_mmap(struct zm_load *zl, int fd, addr_t ptr, unsigned int len,
+                            unsigned int offset)
+{
+        long pagesize = sysconf(_SC_PAGESIZE);
+        unsigned int maplen = 0;
+        struct stat sb;
+
+        if ((ptr + len) > MEM_SIZE) {
+                return -EFAULT;
+        }
+        if (((ptr | offset) & (pagesize - 1)) == 0 && fstat(fd, &sb) == 0 &&
+            offset < sb.st_size) {
+                maplen = len & ~(pagesize - 1);
+                if (maplen > sb.st_size - offset)
+                        maplen = (sb.st_size - offset) & ~(pagesize - 1);
+        }
+        if (maplen) {
+                void *m = mmap(zl->mem_base + (uintptr_t)ptr, maplen,
+                               PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+                               fd, offset);
+                if (m == MAP_FAILED) {
+                        return -errno;
+                }
+        }
+        if (len == maplen) {
+                return len;
+        }
+        int r = target_pread(zl, fd, ptr + maplen, len - maplen, offset + maplen);
+        return r < 0 ? r : maplen + r;
+}
+
+static unsigned int     target_strlen(struct zm_load *zl, addr_t ptr)
 {
-        uint8_t *p = mem_base + (uintptr_t)ptr;
+        uint8_t *p = zl->mem_base + (uintptr_t)ptr;
         unsigned int l = 0;
 
         while (*p++)
@@ -108,10 +196,10 @@ static unsigned int     target_strlen(addr_t ptr)
         return l;
 }
 
-#define put_user_ual(val, addr) ((uint32_t *)mem_base)[(addr)/4] = (val)
+#define put_user_ual(val, addr) ((uint32_t *)zl->mem_base)[(addr)/4] = (val)
 
 /* Construct the envp and argv tables on the target stack.  */
-static addr_t   loader_build_argptr(int envc, int argc, addr_t sp,
+static addr_t   loader_build_argptr(struct zm_load *zl, int envc, int argc, addr_t sp,
                                     addr_t stringp)
 {
         addr_t      envp;
@@ -139,23 +227,47 @@ static addr_t   loader_build_argptr(int envc, int argc, addr_t sp,
         while (argc-- > 0) {
                 put_user_ual(stringp, argv);
                 argv += 4;
-                stringp += target_strlen(stringp) + 1;
+                stringp += target_strlen(zl, stringp) + 1;
         }
         // Fill in the env array:
         while (envc-- > 0) {
                 put_user_ual(stringp, envp);
                 envp += 4;
-                stringp += target_strlen(stringp) + 1;
+                stringp += target_strlen(zl, stringp) + 1;
         }
 
         return sp;
 }
 
+/* Puts the args and environment on the stack, down from top, returning the
+ * initial SP (where argc is).  That's at most limit, which leaves a gap
+ * between the tables and the strings, for a snapshot's args to be replaced
+ * with longer ones (see zmagic_build_args()).
+ */
+static addr_t   build_args(struct zm_load *zl, addr_t top, addr_t limit,
+                           int argc, char *argv[], int envc, char *envp[])
+{
+        addr_t env_start, arg_start, sp;
+        addr_t tables = 4 * (argc + envc + 3);
+
+        /* Copy argv/envp.  */
+        env_start = copy_strings(zl, top, envc, envp);
+        arg_start = copy_strings(zl, env_start, argc, argv);
+        /* Align stack. (Word is OK.) */
+        sp = arg_start & ~3;
+        if (sp - tables > limit)
+                sp = limit + tables;
+        return loader_build_argptr(zl, envc, argc, sp, arg_start);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
 
-static int get_hdr(char *path, char *newpath, struct exec_hdr *hdr, int rel_path)
+/* Opens path (a lib's path is relative to RIX_ROOT, a binary's to the
+ * process' cwd) and reads its header.  Returns the fd, or <0.
+ */
+static int get_hdr(struct zm_load *zl, char *path, char *newpath, struct exec_hdr *hdr, int rel_path)
 {
         static int have_whined = 0;
         char *rootpath = getenv("RIX_ROOT"); // haxlolz
@@ -174,14 +286,14 @@ static int get_hdr(char *path, char *newpath, struct exec_hdr *hdr, int rel_path
                 snprintf(newpath, PATH_MAX, "%s/%s", rootpath, path);
                 fd = open(newpath, O_RDONLY);
         } else {
-                fd = open(path, O_RDONLY);
+                fd = openat(PROC(zl->state)->cwd, path, O_RDONLY);
         }
 
         if (fd < 0) {
                 return fd;
         }
 
-        int r = read(fd, hdr, sizeof(struct exec_hdr));
+        int r = pread(fd, hdr, sizeof(struct exec_hdr), 0);
 
         if (r < 0) {
                 perror("Can't read lib header");
@@ -193,18 +305,79 @@ static int get_hdr(char *path, char *newpath, struct exec_hdr *hdr, int rel_path
                 goto err;
         }
 
-        r = 0;
+        return fd;
 err:
         close(fd);
         return r;
 }
 
-static int load_zm_file(struct exec_hdr *hdr,
-                        int fd, char *filename,
-                        uint32_t *entrypoint)
+/* Another thread might hold the lock when a guest forks */
+static void     lib_cache_lock_prepare(void)
+{
+        pthread_mutex_lock(&lib_cache_lock);
+}
+
+static void     lib_cache_lock_release(void)
 {
-        static addr_t   current_tseg_base = RX_MAP_START_ADDR;
+        pthread_mutex_unlock(&lib_cache_lock);
+}
+
+void    zload_init(void)
+{
+        pthread_atfork(lib_cache_lock_prepare, lib_cache_lock_release,
+                       lib_cache_lock_release);
+}
+
+/* Whether l's host file is still the one it opened */
+static int      lib_current(const struct libstuff *l)
+{
+        struct stat sb;
+
+        return stat(l->realpath, &sb) == 0 && sb.st_dev == l->dev && sb.st_ino == l->ino &&
+                sb.st_mtim.tv_sec == l->mtime.tv_sec && sb.st_mtim.tv_nsec == l->mtime.tv_nsec;
+}
+
+/* Find a library in lib_cache, or open it and add it */
+static const struct libstuff *get_lib(struct zm_load *zl, char *path)
+{
+        struct libstuff *l, **lp;
+        struct stat sb;
+
+        pthread_mutex_lock(&lib_cache_lock);
+        for (lp = &lib_cache; (l = *lp); lp = &l->next) {
+                if (strcmp(l->path, path))
+                        continue;
+                if (lib_current(l))
+                        goto out;
+                *lp = l->next;  // Stale, but not freed (see above)
+                break;
+        }
+        l = calloc(1, sizeof(*l));
+        if (!l)
+                goto out;
+        strncpy(l->path, path, PATH_MAX - 1);
+        l->fd = get_hdr(zl, l->path, l->realpath, &l->hdr, 1);
+        if (l->fd < 0 || fstat(l->fd, &sb) < 0) {
+                if (l->fd >= 0)
+                        close(l->fd);
+                free(l);
+                l = NULL;
+                goto out;
+        }
+        l->dev = sb.st_dev;
+        l->ino = sb.st_ino;
+        l->mtime = sb.st_mtim;
+        l->next = lib_cache;
+        lib_cache = l;
+out:
+        pthread_mutex_unlock(&lib_cache_lock);
+        return l;
+}
 
+static int load_zm_file(struct zm_load *zl, const struct exec_hdr *hdr,
+                        int fd, const char *filename,
+                        uint32_t *entrypoint)
+{
         addr_t textpos = 0, datapos = 0;
         int result;
         addr_t text_len, data_len, bss_len, entry_addr;
@@ -226,15 +399,15 @@ static int load_zm_file(struct exec_hdr *hdr,
         int is_lib = magic == SLZMAGIC || magic == SLPZMAGIC;
 
         DBG_ZM("BINFMT_ZMAGIC: Text segment mapped to %x (len %x)\n",
-               current_tseg_base, text_len);
+               zl->tseg_base, text_len);
 
-        textpos = current_tseg_base;
-        result = target_pread(fd, textpos, text_len, RX_ZM_TEXT_OFFS);
+        textpos = zl->tseg_base;
+        result = target_mmap(zl, fd, textpos, text_len, RX_ZM_TEXT_OFFS);
         if (result < 0) {
                 fprintf(stderr, "BINFMT_ZMAGIC: Unable to read process text\n");
                 return result;
         }
-        current_tseg_base += text_len;
+        zl->tseg_base += text_len;
 
         if (data_len) {
                 fpos = RX_ZM_TEXT_OFFS + text_len;
@@ -245,7 +418,7 @@ static int load_zm_file(struct exec_hdr *hdr,
                                "to data seg at 0x%x\n",
                                (int)data_len, (int)fpos, entry_addr /* AKA a_sldatabase */);
 
-                        result = target_pread(fd, entry_addr,
+                        result = target_pread(zl, fd, entry_addr,
                                               data_len,
                                               fpos);
                         if (result < 0) {
@@ -254,13 +427,13 @@ static int load_zm_file(struct exec_hdr *hdr,
                         }
                 } else {
                         // Real binary: read it to the next spot after last mapping:
-                        datapos = current_tseg_base;
+                        datapos = zl->tseg_base;
                         DBG_ZM("BINFMT_ZMAGIC: Mapping data (%d bytes) from file offset 0x%x "
                                "at end of text seg, 0x%x\n",
                                (int)data_len, (int)fpos, datapos);
-                        result = target_pread(fd, datapos,
-                                              data_len,
-                                              fpos);
+                        result = target_mmap(zl, fd, datapos,
+                                             data_len,
+                                             fpos);
                         if (result < 0) {
                                 fprintf(stderr, "BINFMT_ZMAGIC: Unable to read process data\n");
                                 return result;
@@ -288,16 +461,471 @@ static int load_zm_file(struct exec_hdr *hdr,
 }
 
 
+/* A squeezed binary has its decompression tables described in the header */
+static int      is_squeezed(const struct exec_hdr *hdr)
+{
+        return hdr->a_sq4items || hdr->a_sq3items;
+}
+
+/* Refreshes the data of the libs kept in a process' image, as exec has
+ * given it a new (empty) data segment.
+ */
+static int      reload_lib_data(struct zm_load *zl)
+{
+        for (unsigned int i = 0; i < zl->image->nlibs; i++) {
+                typeof(zl->image->libdata[0]) *d = &zl->image->libdata[i];
+
+                if (!d->len)
+                        continue;
+                int r = target_pread(zl, d->fd, d->addr, d->len, d->offset);
+                if (r < 0)
+                        return r;
+        }
+        return 0;
+}
+
 /****************************************************************************/
 
-struct libstuff {
-        struct exec_hdr hdr;
-        int fd;
+/* Image cache
+ *
+ * With RIX_CACHE set to a directory, the laid-out text and data of a binary
+ * and its libs (as they are before the stack is built, or HLE hooks are
+ * added) is written there after it's loaded.  Loading the same binary again
+ * is then a couple of mmap()s, without walking the library chain (or
+ * unsqueezing a squeezed binary).  An entry is named by a hash of the
+ * binary's identity and header timestamps, and records the identity of each
+ * lib, so that it's not used once any of them has changed.
+ *
+ * Entry layout:
+ * <zc_hdr, padded to ZC_ALIGN>
+ * <image, from RX_MAP_START_ADDR, up to the end of the binary's data>
+ * <each lib's data, each padded to ZC_ALIGN>
+ */
+
+#define ZC_MAGIC        0x43495852      // "RXIC"
+#define ZC_VERSION      1
+#define ZC_ALIGN        0x8000          // Of segments in the file, so they can be mmap()ed
+
+/* A host file, as of when the entry was written */
+struct zc_id {
+        uint64_t        dev;
+        uint64_t        ino;
+        uint64_t        size;
+        int64_t         mtime;
+        int64_t         ctime;
+};
+
+struct zc_key {
+        struct zc_id    id;
+        rix_time_t      timestamp;      // a_timestamp
+        rix_time_t      shlibtime;      // a_shlibtime
+        uint64_t        root_hash;      // Of RIX_ROOT, where libs are found
+};
+
+struct zc_lib {
+        char            name[60];       // As given to get_lib()
+        char            realpath[PATH_MAX];
+        struct zc_id    id;
+        addr_t          data_addr;
+        uint32_t        data_len;
+        uint32_t        data_offset;    // In the entry
+};
+
+struct zc_hdr {
+        uint32_t        magic;
+        uint32_t        version;
+        struct zc_key   key;
+        char            shlibname[60];
+        addr_t          entry;
+        addr_t          text_end;       // End of the binary's text
+        addr_t          image_end;      // End of the binary's data
+        addr_t          libs_end;
+        addr_t          sp;
+        uint32_t        nlibs;
+        struct zc_lib   libs[MAX_SHARED_LIBS];
+};
+
+_Static_assert(sizeof(struct zc_hdr) <= ZC_ALIGN, "zc_hdr must fit before the image");
+
+#define ZC_HASH_INIT    0xcbf29ce484222325ULL
+
+#define ZC_ROUND(x)     (((x) + ZC_ALIGN - 1) & ~(ZC_ALIGN - 1))
+
+static uint64_t zc_hash(const void *data, size_t len, uint64_t h)
+{
+        const uint8_t *d = data;
+
+        // FNV-1a
+        while (len--)
+                h = (h ^ *d++) * 0x100000001b3ULL;
+        return h;
+}
+
+static void     zc_get_id(const struct stat *sb, struct zc_id *id)
+{
+        memset(id, 0, sizeof(*id));
+        id->dev = sb->st_dev;
+        id->ino = sb->st_ino;
+        id->size = sb->st_size;
+        id->mtime = sb->st_mtime;
+        id->ctime = sb->st_ctime;
+}
+
+static int      zc_get_key(int fd, const struct exec_hdr *hdr, struct zc_key *key)
+{
+        char *root = getenv("RIX_ROOT");
+        struct stat sb;
+
+        if (fstat(fd, &sb) < 0)
+                return -errno;
+        memset(key, 0, sizeof(*key));
+        zc_get_id(&sb, &key->id);
+        key->timestamp = hdr->a_timestamp;
+        key->shlibtime = hdr->a_shlibtime;
+        key->root_hash = zc_hash(root ? root : "", root ? strlen(root) : 0,
+                                 ZC_HASH_INIT);
+        return 0;
+}
+
+static void     zc_path(const char *dir, const struct zc_key *key, char *path)
+{
+        snprintf(path, PATH_MAX, "%s/%016" PRIx64 ".img", dir,
+                 zc_hash(key, sizeof(*key), ZC_HASH_INIT));
+}
+
+/* Lays out the image from a cache entry, if there's a good one, and
+ * returns 0; the binary's symbols still need loading from it.  Otherwise
+ * returns <0, having left nothing that a normal load won't cover.
+ */
+static int      zc_load(struct zm_load *zl, const char *dir, const struct zc_key *key,
+                        addr_t *entry, addr_t *sp)
+{
+        struct rix_image *image = zl->image;
         char path[PATH_MAX];
-        char realpath[PATH_MAX]; // Host path
+        struct zc_hdr *h;
+        struct zc_id id;
+        struct stat sb;
+        int fd, r = -1;
+
+        h = malloc(sizeof(*h));
+        if (!h)
+                return -ENOMEM;
+        zc_path(dir, key, path);
+        fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+                goto out;
+        if (pread(fd, h, sizeof(*h), 0) != sizeof(*h) ||
+            h->magic != ZC_MAGIC || h->version != ZC_VERSION ||
+            memcmp(&h->key, key, sizeof(*key)) || h->nlibs > MAX_SHARED_LIBS ||
+            h->image_end < h->text_end || h->image_end > MEM_SIZE) {
+                DBG_ZM("BINFMT_ZMAGIC: Image cache entry %s is bad\n", path);
+                goto out;
+        }
+        for (unsigned int i = 0; i < h->nlibs; i++) {
+                if (stat(h->libs[i].realpath, &sb) < 0)
+                        goto out;
+                zc_get_id(&sb, &id);
+                if (memcmp(&id, &h->libs[i].id, sizeof(id))) {
+                        DBG_ZM("BINFMT_ZMAGIC: Image cache entry %s is stale (%s)\n",
+                               path, h->libs[i].realpath);
+                        goto out;
+                }
+        }
+
+        // The text (and binary's data) is mapped over anything there now
+        r = target_mmap(zl, fd, RX_MAP_START_ADDR, h->image_end - RX_MAP_START_ADDR,
+                        ZC_ALIGN);
+        for (unsigned int i = 0; i < h->nlibs && r >= 0; i++) {
+                if (h->libs[i].data_len)
+                        r = target_mmap(zl, fd, h->libs[i].data_addr,
+                                        h->libs[i].data_len, h->libs[i].data_offset);
+        }
+        if (r < 0)
+                goto out;
+
+        // Hook libc routines in the libs, as a normal load would
+        addr_t lib_end = RX_MAP_START_ADDR;
+        for (int i = h->nlibs - 1; i >= 0; i--) {
+                const struct libstuff *l = get_lib(zl, h->libs[i].name);
+
+                if (!l)
+                        break;
+                lib_end += l->hdr.a_exec.a_text;
+                hle_load_symbols(zl->state, l->fd, &l->hdr, l->path,
+                                 RX_MAP_START_ADDR, lib_end);
+                syms_load(zl->state, l->fd, &l->hdr, l->path,
+                          lib_end - l->hdr.a_exec.a_text, lib_end);
+        }
+
+        if (image->cache_fd >= 0)
+                close(image->cache_fd);
+        image->cache_fd = fd;
+        memcpy(image->shlibname, h->shlibname, sizeof(image->shlibname));
+        image->nlibs = h->nlibs;
+        for (unsigned int i = 0; i < h->nlibs; i++) {
+                image->libdata[i].fd = fd;
+                image->libdata[i].offset = h->libs[i].data_offset;
+                image->libdata[i].addr = h->libs[i].data_addr;
+                image->libdata[i].len = h->libs[i].data_len;
+        }
+        image->libs_end = h->libs_end;
+        image->sp = h->sp;
+        zl->tseg_base = h->text_end;
+        *entry = h->entry;
+        *sp = h->sp;
+        fd = -1;
+        r = 0;
+out:
+        if (fd >= 0)
+                close(fd);
+        free(h);
+        return r;
+}
+
+/* Writes a cache entry for the image just laid out (best effort) */
+static void     zc_store(struct zm_load *zl, const char *dir, const struct zc_key *key,
+                         const struct exec_hdr *hdr, addr_t entry)
+{
+        struct rix_image *image = zl->image;
+        char path[PATH_MAX], tmp[PATH_MAX];
+        struct zc_hdr *h;
+        struct stat sb;
+        uint32_t off;
+        int fd = -1;
+
+        h = calloc(1, sizeof(*h));
+        if (!h)
+                return;
+        h->magic = ZC_MAGIC;
+        h->version = ZC_VERSION;
+        h->key = *key;
+        memcpy(h->shlibname, hdr->a_shlibname, sizeof(h->shlibname));
+        h->entry = entry;
+        h->text_end = zl->tseg_base;
+        h->image_end = zl->tseg_base + hdr->a_exec.a_data;
+        h->libs_end = image->libs_end;
+        h->sp = image->sp;
+        h->nlibs = image->nlibs;
+        off = ZC_ALIGN + ZC_ROUND(h->image_end - RX_MAP_START_ADDR);
+        for (unsigned int i = 0; i < image->nlibs; i++) {
+                const struct libstuff *l = zl->libi[i];
+
+                if (stat(l->realpath, &sb) < 0)
+                        goto out;
+                // A name that doesn't fit can't be checked later, so don't cache
+                if (snprintf(h->libs[i].name, sizeof(h->libs[i].name), "%s",
+                             l->path) >= (int)sizeof(h->libs[i].name) ||
+                    snprintf(h->libs[i].realpath, sizeof(h->libs[i].realpath), "%s",
+                             l->realpath) >= (int)sizeof(h->libs[i].realpath))
+                        goto out;
+                zc_get_id(&sb, &h->libs[i].id);
+                h->libs[i].data_addr = image->libdata[i].addr;
+                h->libs[i].data_len = image->libdata[i].len;
+                h->libs[i].data_offset = off;
+                off += ZC_ROUND(h->libs[i].data_len);
+        }
+
+        mkdir(dir, 0777);
+        snprintf(tmp, PATH_MAX, "%s/.tmp-XXXXXX", dir);
+        fd = mkstemp(tmp);
+        if (fd < 0)
+                goto out;
+        fchmod(fd, 0644);
+        if (pwrite(fd, h, sizeof(*h), 0) != sizeof(*h) ||
+            pwrite(fd, zl->mem_base + RX_MAP_START_ADDR, h->image_end - RX_MAP_START_ADDR,
+                   ZC_ALIGN) != h->image_end - RX_MAP_START_ADDR)
+                goto bad;
+        for (unsigned int i = 0; i < h->nlibs; i++) {
+                if (pwrite(fd, zl->mem_base + h->libs[i].data_addr, h->libs[i].data_len,
+                           h->libs[i].data_offset) != h->libs[i].data_len)
+                        goto bad;
+        }
+        // Others might be reading an older entry of the same name
+        zc_path(dir, key, path);
+        if (rename(tmp, path) == 0) {
+                DBG_ZM("BINFMT_ZMAGIC: Wrote image cache entry %s\n", path);
+                goto out;
+        }
+bad:
+        unlink(tmp);
+out:
+        if (fd >= 0)
+                close(fd);
+        free(h);
+}
+
+/****************************************************************************/
+
+/* Unsqueezed copies
+ *
+ * RISCiX's squeeze format isn't documented, so squeezed binaries are
+ * unsqueezed by RISCiX's own unsqueeze (itself unsqueezed, and named by
+ * RIX_UNSQUEEZE), run as a guest on a copy.  That's a whole program run, so
+ * it's done once per binary:  the unsqueezed copy is kept open for the rest
+ * of this rixrun (for the next exec, batch job or rixrund command to use),
+ * keyed as an image cache entry is.  With RIX_CACHE set, it's also kept in
+ * that directory, for later rixruns.
+ */
+
+struct unsq {
+        struct unsq     *next;
+        struct zc_key   key;
+        int             fd;
 };
 
-static struct libstuff libi[MAX_SHARED_LIBS];
+static struct unsq      *unsq_cache;    // Under lib_cache_lock
+
+static void     unsq_path(const char *dir, const struct zc_key *key, char *path)
+{
+        snprintf(path, PATH_MAX, "%s/%016" PRIx64 ".unsq", dir,
+                 zc_hash(key, sizeof(*key), ZC_HASH_INIT));
+}
+
+/* Keeps (another fd of) fd, the unsqueezed copy of the binary with key */
+static void     unsq_keep(const struct zc_key *key, int fd)
+{
+        struct unsq *u;
+
+        pthread_mutex_lock(&lib_cache_lock);
+        for (u = unsq_cache; u; u = u->next) {
+                if (!memcmp(&u->key, key, sizeof(*key)))
+                        break;
+        }
+        // (Another thread might have unsqueezed it too, meanwhile)
+        if (!u && (u = malloc(sizeof(*u)))) {
+                u->key = *key;
+                u->fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+                if (u->fd >= 0) {
+                        u->next = unsq_cache;
+                        unsq_cache = u;
+                } else {
+                        free(u);
+                }
+        }
+        pthread_mutex_unlock(&lib_cache_lock);
+}
+
+/* Returns an fd of the unsqueezed copy of the binary with key, with *hdr
+ * read from it, if there's one kept, or <0.
+ */
+static int      unsqueezed_copy(struct zm_load *zl, const struct zc_key *key,
+                                struct exec_hdr *hdr)
+{
+        char *dir = getenv("RIX_CACHE");
+        char path[PATH_MAX];
+        struct unsq *u;
+        int fd = -1;
+
+        pthread_mutex_lock(&lib_cache_lock);
+        for (u = unsq_cache; u; u = u->next) {
+                if (!memcmp(&u->key, key, sizeof(*key))) {
+                        fd = fcntl(u->fd, F_DUPFD_CLOEXEC, 0);
+                        break;
+                }
+        }
+        pthread_mutex_unlock(&lib_cache_lock);
+        if (fd < 0 && dir) {
+                unsq_path(dir, key, path);
+                fd = open(path, O_RDONLY | O_CLOEXEC);
+                if (fd >= 0)
+                        unsq_keep(key, fd);
+        }
+        if (fd < 0)
+                return -1;
+        if (pread(fd, hdr, sizeof(*hdr), 0) != sizeof(*hdr) || is_squeezed(hdr)) {
+                close(fd);
+                return -1;
+        }
+        DBG_ZM("BINFMT_ZMAGIC: Using kept unsqueezed copy\n");
+        return fd;
+}
+
+/* Returns an fd of the unsqueezed copy of a squeezed binary (fd), with *hdr
+ * re-read from it, or <0.  key is the binary's, or NULL not to keep it.
+ */
+static int      unsqueeze_binary(struct zm_load *zl, int fd, char *filename,
+                                 const struct zc_key *key, struct exec_hdr *hdr)
+{
+        char *unsq = getenv("RIX_UNSQUEEZE");
+        char *dir = key ? getenv("RIX_CACHE") : NULL;
+        char tmp[PATH_MAX], path[PATH_MAX];
+        char buf[65536];
+        int t = -1, n, r;
+
+        if (key && (t = unsqueezed_copy(zl, key, hdr)) >= 0)
+                return t;
+        if (!unsq) {
+                fprintf(stderr, "BINFMT_ZMAGIC: %s is squeezed.  Unsqueeze it first, or set\n"
+                        "RIX_UNSQUEEZE to an unsqueezed unsqueeze to do it when loading.\n",
+                        filename);
+                return -ENOEXEC;
+        }
+        // Made in the cache directory, so it can be renamed into place
+        if (dir) {
+                mkdir(dir, 0777);
+                snprintf(tmp, PATH_MAX, "%s/.tmp-XXXXXX", dir);
+                t = mkstemp(tmp);
+        }
+        if (t < 0) {
+                dir = NULL;
+                snprintf(tmp, PATH_MAX, "/tmp/rixrun-sqXXXXXX");
+                t = mkstemp(tmp);
+        }
+        if (t < 0)
+                return -errno;
+        for (off_t o = 0; (n = pread(fd, buf, sizeof(buf), o)) > 0; o += n) {
+                if (write(t, buf, n) != n) {
+                        n = -1;
+                        break;
+                }
+        }
+        close(t);
+        if (n < 0) {
+                unlink(tmp);
+                return -EIO;
+        }
+
+        DBG_ZM("BINFMT_ZMAGIC: Unsqueezing %s with %s\n", filename, unsq);
+        struct rix_proc *p = rix_proc_new(NULL, zl->verbose, PROC(zl->state)->flags);
+        char *argv[] = { unsq, tmp, NULL };
+
+        if (!p) {
+                unlink(tmp);
+                return -ENOMEM;
+        }
+        p->stdfd[1] = 2;        // Keep its chatter off the guest's stdout
+        r = rix_proc_load(p, unsq, 2, argv, 0, &argv[2]);
+        if (r >= 0)
+                r = rix_proc_run(p);
+        rix_proc_free(p);
+
+        fd = r == 0 ? open(tmp, O_RDONLY | O_CLOEXEC) : -1;
+        if (fd >= 0 && (pread(fd, hdr, sizeof(*hdr), 0) != sizeof(*hdr) || is_squeezed(hdr))) {
+                close(fd);
+                fd = -1;
+        }
+        if (fd < 0) {
+                fprintf(stderr, "BINFMT_ZMAGIC: Can't unsqueeze %s\n", filename);
+                unlink(tmp);
+                return -ENOEXEC;
+        }
+        // Others might be reading an older copy of the same name
+        if (dir) {
+                unsq_path(dir, key, path);
+                if (rename(tmp, path) == 0)
+                        DBG_ZM("BINFMT_ZMAGIC: Wrote unsqueezed copy %s\n", path);
+                else
+                        unlink(tmp);
+        } else {
+                unlink(tmp);
+        }
+        if (key)
+                unsq_keep(key, fd);
+        return fd;
+}
+
+/****************************************************************************/
+
 
 
 /* RISCiX binary loading
@@ -341,11 +969,11 @@ static struct libstuff libi[MAX_SHARED_LIBS];
  */
 
 /* Main loader function */
-int load_zmagic_binary(struct ARMul_State *state, char *filename,
-                       int verbose,
-                       int argc, char *argv[],
-                       int envc, char *envp[])
+static int zm_load_binary(struct zm_load *zl, char *filename,
+                          int argc, char *argv[],
+                          int envc, char *envp[])
 {
+        ARMul_State             *state = zl->state;
         addr_t                  stack_len;
         addr_t                  start_addr;
         addr_t                  sp, p;
@@ -353,22 +981,54 @@ int load_zmagic_binary(struct ARMul_State *state, char *filename,
         struct exec_hdr         hdr;
         int                     fd;
         char                    realpath[PATH_MAX]; // huge!
-
-        zmload_verbose = verbose;
+        char                    *cache = NULL;
+        struct zc_key           key;
+        int                     have_key;
+        unsigned int            lnum = 0;
 
         DBG_ZM("BINFMT_ZMAGIC: Loading file: %s\n", filename);
 
-        /* This is all a bit hacky, currently depending on all user
-         * memory being mapped.  It would be better to use mmap
-         * (e.g. MAP_FIXED over a reserved VMA).
+        /* Text and data are mapped (MAP_FIXED) over the reserved VMA of
+         * user memory; everything else in it stays anonymous zero-fill.
          */
 
         sp = RX_MAP_DATA_ADDR + RX_MAP_DATA_LEN;
 
-        if (get_hdr(filename, realpath, &hdr, 0 /* Linux path */) < 0) {
+        fd = get_hdr(zl, filename, realpath, &hdr, 0 /* Linux path */);
+        if (fd < 0) {
                 fprintf(stderr, "Can't open %s\n", filename);
                 return -1;
         }
+        // (Keyed on the file as given, so an unsqueezed image is cached too)
+        have_key = zc_get_key(fd, &hdr, &key) == 0;
+        if (!zl->keep_libs && have_key)
+                cache = getenv("RIX_CACHE");
+        if (cache && zc_load(zl, cache, &key, &start_addr, &sp) == 0) {
+                DBG_ZM("BINFMT_ZMAGIC: Loaded %s from image cache\n", filename);
+                // A squeezed binary's symbols are in its unsqueezed copy, if kept
+                if (is_squeezed(&hdr)) {
+                        int ufd = unsqueezed_copy(zl, &key, &hdr);
+
+                        close(fd);
+                        fd = ufd;
+                }
+                if (fd >= 0) {
+                        hle_load_symbols(state, fd, &hdr, filename,
+                                         RX_MAP_START_ADDR, zl->tseg_base);
+                        syms_load(state, fd, &hdr, filename,
+                                  zl->image->libs_end, zl->tseg_base);
+                        close(fd);
+                }
+                goto build_stack;
+        }
+        if (is_squeezed(&hdr)) {
+                int ufd = unsqueeze_binary(zl, fd, filename, have_key ? &key : NULL, &hdr);
+
+                close(fd);
+                if (ufd < 0)
+                        return ufd;
+                fd = ufd;
+        }
         uint32_t magic = hdr.a_exec.a_magic;
 
         /* Assume originally-given binary is shared (could skip lib search if not).
@@ -378,11 +1038,24 @@ int load_zmagic_binary(struct ARMul_State *state, char *filename,
         if (magic != SPZMAGIC) {
                 fprintf(stderr, "BINFMT_ZMAGIC: bad magic/rev (0x%x, need 0x%x)\n",
                         magic, (int) SPZMAGIC);
+                close(fd);
                 return -ENOEXEC;
         }
         DBG_ZM("BINFMT_ZMAGIC: Uses shared lib %s\n", hdr.a_shlibname);
 
-        unsigned int lnum = 0;
+        if (zl->keep_libs) {
+                res = reload_lib_data(zl);
+                if (res < 0) {
+                        close(fd);
+                        return res;
+                }
+                sp = zl->image->sp;
+                zl->tseg_base = zl->image->libs_end;
+                DBG_ZM("BINFMT_ZMAGIC: Kept %d libs, binary text at 0x%x\n",
+                       zl->image->nlibs, zl->tseg_base);
+                goto load_binary;
+        }
+
         /* Follow library chain:
          * (if) Initial binary is SPZMAGIC, follow path to lib.
          * If lib is SLPZMAGIC, follow path to next lib, else
@@ -390,79 +1063,114 @@ int load_zmagic_binary(struct ARMul_State *state, char *filename,
          */
         char *new_lib = hdr.a_shlibname;
         do {
-                strncpy(libi[lnum].path, new_lib, PATH_MAX);
-
-                if (get_hdr(libi[lnum].path, libi[lnum].realpath, &libi[lnum].hdr, 1) < 0)
+                zl->libi[lnum] = get_lib(zl, new_lib);
+                if (!zl->libi[lnum]) {
+                        close(fd);
                         return -1;
+                }
 
-                uint32_t lmagic = libi[lnum].hdr.a_exec.a_magic;
+                uint32_t lmagic = zl->libi[lnum]->hdr.a_exec.a_magic;
                 if (lmagic == SLZMAGIC) {
                         DBG_ZM("BINFMT_ZMAGIC: Reached final lib\n");
                         new_lib = 0;
                 } else if (lmagic == SLPZMAGIC) {
-                        new_lib = libi[lnum].hdr.a_shlibname;
+                        new_lib = (char *)zl->libi[lnum]->hdr.a_shlibname;
                         DBG_ZM("BINFMT_ZMAGIC: Reached shared lib using shared lib %s\n", new_lib);
                 } else {
                         fprintf(stderr, "BINFMT_ZMAGIC: Unrecognised magic 0x%x in library %s\n",
                                 lmagic, new_lib);
+                        close(fd);
                         return -1;
                 }
                 lnum++;
                 if (lnum == (MAX_SHARED_LIBS-1) && new_lib) {
                         fprintf(stderr, "BINFMT_ZMAGIC: Too many libs, increase max?\n");
+                        close(fd);
                         return -1;
                 }
         } while (new_lib != 0);
 
         // Now, load libs in reverse order from bottom up:
         for (int i = lnum-1; i >= 0; i--) {
-                DBG_ZM("BINFMT_ZMAGIC: Loading lib %s\n", libi[i].realpath);
+                const struct libstuff *l = zl->libi[i];
+
+                DBG_ZM("BINFMT_ZMAGIC: Loading lib %s\n", l->realpath);
 
-                fd = open(libi[i].realpath, O_RDONLY);
-                if (fd < 0) {
-                        perror("BINFMT_ZMAGIC: Library open:");
-                        return fd;
-                }
                 addr_t data_addr = ~0;
-                res = load_zm_file(&libi[i].hdr, fd, libi[i].path, &data_addr);
-                close(fd);
+                res = load_zm_file(zl, &l->hdr, l->fd, l->path, &data_addr);
                 if (res < 0) {
+                        close(fd);
                         return res;
                 }
                 // For a library, this is where data was loaded; move SP below it:
                 if (sp >= data_addr)
                         sp = data_addr - 4;
+                zl->image->libdata[i].fd = l->fd;
+                zl->image->libdata[i].offset = RX_ZM_TEXT_OFFS + l->hdr.a_exec.a_text;
+                zl->image->libdata[i].addr = l->hdr.a_exec.a_entry;
+                zl->image->libdata[i].len = l->hdr.a_exec.a_data;
         }
 
-        // Finally, load the initial binary
-        fd = open(filename, O_RDONLY);
-        if (fd < 0) {
-                perror("BINFMT_ZMAGIC: Main binary open:");
-                return fd;
+        if (zl->image->cache_fd >= 0) {
+                close(zl->image->cache_fd);
+                zl->image->cache_fd = -1;
         }
-        res = load_zm_file(&hdr, fd, filename, &start_addr);
-        close(fd);
+        memcpy(zl->image->shlibname, hdr.a_shlibname, sizeof(zl->image->shlibname));
+        zl->image->nlibs = lnum;
+        zl->image->libs_end = zl->tseg_base;
+        zl->image->sp = sp;
+
+load_binary:
+        // Finally, load the initial binary
+        res = load_zm_file(zl, &hdr, fd, filename, &start_addr);
         if (res < 0) {
+                close(fd);
                 return res;
         }
+        if (cache)
+                zc_store(zl, cache, &key, &hdr, start_addr);
+
+        // Hook libc routines named in symbol tables, if any.  A binary's
+        // table can also name routines in the shared lib loaded before it.
+        // (This is done once the image is cached, which is without hooks.)
+        addr_t lib_end = RX_MAP_START_ADDR;
+        for (int i = lnum-1; i >= 0; i--) {
+                const struct libstuff *l = zl->libi[i];
 
+                lib_end += l->hdr.a_exec.a_text;
+                hle_load_symbols(state, l->fd, &l->hdr, l->path, RX_MAP_START_ADDR, lib_end);
+                syms_load(state, l->fd, &l->hdr, l->path,
+                          lib_end - l->hdr.a_exec.a_text, lib_end);
+        }
+        hle_load_symbols(state, fd, &hdr, filename, RX_MAP_START_ADDR, zl->tseg_base);
+        syms_load(state, fd, &hdr, filename, zl->image->libs_end, zl->tseg_base);
+        close(fd);
+
+build_stack:
         /* Now set up initial stack contents -- args and environment strings. */
         DBG_ZM("BINFMT_ZMAGIC: Stack top 0x%x\n", sp);
         addr_t stack_top = sp;
-        addr_t env_start, arg_start;
-        /* Copy argv/envp.  */
-        env_start = copy_strings(sp, envc, envp);
-        arg_start = copy_strings(env_start, argc, argv);
-        /* Align stack. (Word is OK.) */
-        sp = arg_start & ~3;
-        sp = loader_build_argptr(envc, argc, sp, arg_start);
+        addr_t limit = stack_top - PROC(state)->arg_space;
+        if (PROC(state)->arg_space) {
+                // Args for a snapshot get whole pages, from SP up (see snap_guard())
+                addr_t pagesize = sysconf(_SC_PAGESIZE);
+
+                stack_top &= ~(pagesize - 1);
+                limit = (stack_top - PROC(state)->arg_space) & ~(pagesize - 1);
+        }
+        sp = build_args(zl, stack_top, limit, argc, argv, envc, envp);
+        zl->image->args.top = stack_top;
+        zl->image->args.sp = sp;
+        zl->image->args.argc = argc;
+        zl->image->args.envc = envc;
+        zl->image->args.data = zl->tseg_base;
 
         DBG_ZM("BINFMT_ZMAGIC: Final SP 0x%x, entry point 0x%x\n", sp, start_addr);
 
 #if 0
         // Cheeky dump stack:
         for (addr_t dp = sp; dp < stack_top; dp += 4) {
-                DBG_ZM("%08x:  %08x\n", dp, *(uint32_t *)&mem_base[dp]);
+                DBG_ZM("%08x:  %08x\n", dp, *(uint32_t *)&zl->mem_base[dp]);
         }
 #endif
 
@@ -472,3 +1180,187 @@ int load_zmagic_binary(struct ARMul_State *state, char *filename,
 
         return 0;
 }
+
+/* Reads an object's symbol table, returning how many symbols there are
+ * (in *symsp, with the string table in *strsp, both malloc()ed), or 0
+ * if there are none.
+ */
+unsigned int zmagic_read_symbols(int fd, const struct exec_hdr *hdr, struct rix_nlist **symsp,
+                                 char **strsp, uint32_t *strsizep)
+{
+        uint32_t symsize = hdr->a_exec.a_syms;
+        uint32_t symoff = RX_ZM_TEXT_OFFS + hdr->a_exec.a_text + hdr->a_exec.a_data +
+                hdr->a_exec.a_trsize + hdr->a_exec.a_drsize;
+        struct rix_nlist *syms = NULL;
+        char *strs = NULL;
+        uint32_t strsize;
+
+        *symsp = NULL;
+        *strsp = NULL;
+        if (symsize == 0)
+                return 0;
+
+        // The string table follows the symbols, and starts with its own size
+        syms = malloc(symsize);
+        if (!syms || pread(fd, syms, symsize, symoff) != symsize ||
+            pread(fd, &strsize, 4, symoff + symsize) != 4 || strsize < 4)
+                goto bad;
+        strs = malloc(strsize + 1);
+        if (!strs || pread(fd, strs, strsize, symoff + symsize) != strsize)
+                goto bad;
+        strs[strsize] = '\0';
+        *symsp = syms;
+        *strsp = strs;
+        *strsizep = strsize;
+        return symsize / sizeof(struct rix_nlist);
+bad:
+        free(strs);
+        free(syms);
+        return 0;
+}
+
+/* Whether filename is a binary that can be loaded, for exec.  If it uses
+ * the same libraries as the process has loaded, *libs_end is set to the
+ * end of their text (which can then be kept), else 0.
+ */
+int check_zmagic_binary(struct ARMul_State *state, char *filename, addr_t *libs_end)
+{
+        struct rix_image *image = PROC(state)->image;
+        struct zm_load zl = { .state = state };
+        struct exec_hdr hdr;
+        int fd;
+
+        errno = 0;
+        fd = get_hdr(&zl, filename, NULL, &hdr, 0);
+        if (fd < 0)
+                return errno ? -errno : -ENOEXEC;
+        close(fd);
+        if (hdr.a_exec.a_magic != SPZMAGIC)
+                return -ENOEXEC;
+
+        // The chain is all found from the first lib's name:
+        *libs_end = 0;
+        if (image && image->nlibs &&
+            !strncmp(image->shlibname, hdr.a_shlibname, sizeof(hdr.a_shlibname)))
+                *libs_end = image->libs_end;
+        return 0;
+}
+
+/* Loads a binary (and its libs, unless keep_libs says the process has
+ * them already) into a process.
+ */
+int load_zmagic_binary(struct ARMul_State *state, char *filename,
+                       int verbose, int keep_libs,
+                       int argc, char *argv[],
+                       int envc, char *envp[])
+{
+        struct zm_load *zl = calloc(1, sizeof(*zl));
+        int r;
+
+        if (!zl)
+                return -ENOMEM;
+        if (!PROC(state)->image) {
+                PROC(state)->image = calloc(1, sizeof(struct rix_image));
+                if (!PROC(state)->image) {
+                        free(zl);
+                        return -ENOMEM;
+                }
+                PROC(state)->image->cache_fd = -1;
+        }
+        zl->state = state;
+        zl->image = PROC(state)->image;
+        zl->keep_libs = keep_libs && zl->image->nlibs;
+        zl->mem_base = state->MemBase;
+        zl->verbose = verbose;
+        zl->tseg_base = RX_MAP_START_ADDR;
+        r = zm_load_binary(zl, filename, argc, argv, envc, envp);
+        free(zl);
+        return r;
+}
+
+void    free_zmagic_image(struct rix_image *image)
+{
+        if (!image)
+                return;
+        if (image->cache_fd >= 0)
+                close(image->cache_fd);
+        free(image);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// For snapshots (see snap.c)
+
+int     zmagic_get_args(struct ARMul_State *state, struct zm_args *args)
+{
+        if (!PROC(state)->image || !PROC(state)->image->args.top)
+                return -1;
+        *args = PROC(state)->image->args;
+        return 0;
+}
+
+/* Whether these args would fit in args' area, above its initial SP */
+int     zmagic_args_fit(const struct zm_args *args,
+                        int argc, char *argv[], int envc, char *envp[])
+{
+        addr_t len = 0;
+
+        for (int i = 0; i < argc; i++)
+                len += strlen(argv[i]) + 1;
+        for (int i = 0; i < envc; i++)
+                len += strlen(envp[i]) + 1;
+        return len <= args->top - args->sp &&
+                args->sp + 4 * (argc + envc + 3) <= ((args->top - len) & ~3);
+}
+
+/* Replaces the args in args' area with these, keeping the initial SP where
+ * it was (so args->sp is unchanged).  Returns <0 if they don't fit above it.
+ */
+int     zmagic_build_args(struct ARMul_State *state, struct zm_args *args,
+                          int argc, char *argv[], int envc, char *envp[])
+{
+        struct zm_load zl = { .state = state, .mem_base = state->MemBase };
+
+        if (!zmagic_args_fit(args, argc, argv, envc, envp))
+                return -1;
+        memset(state->MemBase + args->sp, 0, args->top - args->sp);
+        build_args(&zl, args->top, args->sp, argc, argv, envc, envp);
+        args->argc = argc;
+        args->envc = envc;
+        return 0;
+}
+
+/* An identity for a binary and the libs it uses, as they are on disk now,
+ * which changes if any of them does.
+ */
+int     zmagic_binary_id(struct ARMul_State *state, char *filename, uint64_t *id)
+{
+        struct zm_load zl = { .state = state };
+        struct exec_hdr hdr;
+        struct zc_key key;
+        struct zc_id lid;
+        struct stat sb;
+        char *lib = NULL;
+        int fd, r;
+
+        fd = get_hdr(&zl, filename, NULL, &hdr, 0);
+        if (fd < 0)
+                return -ENOENT;
+        r = zc_get_key(fd, &hdr, &key);
+        close(fd);
+        if (r < 0)
+                return r;
+        *id = zc_hash(&key, sizeof(key), ZC_HASH_INIT);
+
+        if (hdr.a_exec.a_magic == SPZMAGIC)
+                lib = hdr.a_shlibname;
+        for (int i = 0; lib && i < MAX_SHARED_LIBS; i++) {
+                const struct libstuff *l = get_lib(&zl, lib);
+
+                if (!l || stat(l->realpath, &sb) < 0)
+                        return -ENOENT;
+                zc_get_id(&sb, &lid);
+                *id = zc_hash(&lid, sizeof(lid), *id);
+                lib = l->hdr.a_exec.a_magic == SLPZMAGIC ? (char *)l->hdr.a_shlibname : NULL;
+        }
+        return 0;
+}
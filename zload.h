@@ -4,13 +4,37 @@
 #include <inttypes.h>
 #include "rix_os.h"
 #include "armdefs.h"
+#include "rixrun.h"
+
+/* Where a binary's args and environment went, at the top of its stack */
+struct zm_args {
+        addr_t          top;            // Stack top, above the strings
+        addr_t          sp;             // Initial SP: argc, argv[], 0, envp[], 0
+        int32_t         argc;
+        int32_t         envc;
+        addr_t          data;           // Start of the binary's data
+};
 
 /* Functions */
 
+void    zload_init(void);
+int     check_zmagic_binary(struct ARMul_State *state, char *filename,
+                            addr_t *libs_end);
 int     load_zmagic_binary(struct ARMul_State *state, char *filename,
-                           int verbose,
+                           int verbose, int keep_libs,
                            int argc, char *argv[],
                            int envc, char *envp[]);
+void    free_zmagic_image(struct rix_image *image);
+int     zmagic_get_args(struct ARMul_State *state, struct zm_args *args);
+int     zmagic_args_fit(const struct zm_args *args,
+                        int argc, char *argv[], int envc, char *envp[]);
+int     zmagic_build_args(struct ARMul_State *state, struct zm_args *args,
+                          int argc, char *argv[], int envc, char *envp[]);
+int     zmagic_binary_id(struct ARMul_State *state, char *filename, uint64_t *id);
+struct exec_hdr;
+struct rix_nlist;
+unsigned int zmagic_read_symbols(int fd, const struct exec_hdr *hdr, struct rix_nlist **symsp,
+                                 char **strsp, uint32_t *strsizep);
 
 
 #define RX_MAP_START_ADDR       0x8000
@@ -55,8 +79,22 @@ struct exec_hdr {
         char                    a_shlibname[60];        /* Path to shared lib */
 };
 
-/* We don't support old binary formats (like IMAGIC/OMAGIC/NMAGIC),
- * and don't support any squeezed binaries.  (Unsqueeze them first!)
+/* Symbol table entry, as <nlist.h>; the string table follows the symbols */
+struct rix_nlist {
+        uint32_t        n_strx;         /* Offset into string table */
+        uint8_t         n_type;
+        int8_t          n_other;
+        int16_t         n_desc;
+        uint32_t        n_value;
+};
+
+#define RIX_N_EXT       01
+#define RIX_N_TEXT      04
+#define RIX_N_TYPE      0x1e
+
+/* We don't support old binary formats (like IMAGIC/OMAGIC/NMAGIC).
+ * Squeezed binaries are unsqueezed as they're loaded, if RIX_UNSQUEEZE
+ * names an unsqueeze to do it with (see unsqueeze_binary()).
  */
 #define ZMAGIC          0413
 #define MF_USES_SL      02000